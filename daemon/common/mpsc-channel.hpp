@@ -0,0 +1,249 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_COMMON_MPSC_CHANNEL_HPP
+#define NFD_DAEMON_COMMON_MPSC_CHANNEL_HPP
+
+#include "core/common.hpp"
+
+#include <atomic>
+
+namespace nfd {
+
+/** \brief A bounded channel that carries typed messages from any thread to one consumer thread.
+ *
+ *  Messages are written in place into preallocated slots of a lock-free ring, so that a message
+ *  type whose members reuse their capacity on assignment (e.g. Name) can be sent without
+ *  allocating once the slots are warm. The consumer side is driven by a post function, such as
+ *  runOnRibIoService: a drain is posted only when the channel goes from idle to non-empty, and
+ *  each drain hands up to \p maxBatchSize messages to the handler.
+ *
+ *  When the ring is full, send() fails and the message is counted as dropped.
+ *
+ *  Slots are not cleared after the handler returns; a handler that must release resources held
+ *  by a message should do so itself.
+ *
+ *  \tparam T message type; must be default-constructible
+ */
+template<typename T>
+class MpscChannel : noncopyable
+{
+public:
+  using PostFunc = std::function<void(const std::function<void()>&)>;
+  using Handler = std::function<void(T& message)>;
+
+  /** \param capacity maximum number of queued messages, rounded up to a power of two
+   *  \param post schedules a callback on the consumer thread
+   *  \param handler invoked on the consumer thread for each message
+   *  \param maxBatchSize maximum number of messages handled per posted drain
+   */
+  MpscChannel(size_t capacity, PostFunc post, Handler handler, size_t maxBatchSize = 64)
+    : m_state(make_shared<State>(capacity, std::move(handler), maxBatchSize))
+    , m_post(std::move(post))
+  {
+  }
+
+  /** \brief Enqueues a message that is written in place by \p fill (any thread).
+   *  \param fill a functor invoked as `fill(T& message)`
+   *  \retval false the channel is full; \p fill is not invoked
+   */
+  template<typename F>
+  bool
+  send(F&& fill)
+  {
+    if (!m_state->tryPush(std::forward<F>(fill))) {
+      m_state->nDropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    m_state->nSent.fetch_add(1, std::memory_order_relaxed);
+    schedule(*m_state);
+    return true;
+  }
+
+  size_t
+  capacity() const noexcept
+  {
+    return m_state->mask + 1;
+  }
+
+  /** \brief number of messages accepted by send()
+   */
+  uint64_t
+  getNSent() const noexcept
+  {
+    return m_state->nSent.load(std::memory_order_relaxed);
+  }
+
+  /** \brief number of messages rejected by send() because the channel was full
+   */
+  uint64_t
+  getNDropped() const noexcept
+  {
+    return m_state->nDropped.load(std::memory_order_relaxed);
+  }
+
+  /** \brief number of messages passed to the handler
+   */
+  uint64_t
+  getNReceived() const noexcept
+  {
+    return m_state->nReceived.load(std::memory_order_relaxed);
+  }
+
+  /** \brief number of drains that handled at least one message
+   */
+  uint64_t
+  getNBatches() const noexcept
+  {
+    return m_state->nBatches.load(std::memory_order_relaxed);
+  }
+
+private:
+  struct Slot
+  {
+    std::atomic<size_t> sequence;
+    T message;
+  };
+
+  /** \brief Ring and consumer state, shared with posted drains so that they can outlive the channel.
+   *
+   *  The ring follows Vyukov's bounded queue: a slot is writable by the producer that claims
+   *  position \c pos when its sequence equals \c pos, and readable when it equals \c pos+1.
+   */
+  struct State
+  {
+    State(size_t capacity, Handler handler, size_t maxBatchSize)
+      : handler(std::move(handler))
+      , maxBatchSize(maxBatchSize)
+    {
+      size_t n = 2;
+      while (n < capacity) {
+        n <<= 1;
+      }
+      slots = make_unique<Slot[]>(n);
+      mask = n - 1;
+      for (size_t i = 0; i < n; ++i) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+      }
+    }
+
+    template<typename F>
+    bool
+    tryPush(F&& fill)
+    {
+      size_t pos = enqueuePos.load(std::memory_order_relaxed);
+      Slot* slot = nullptr;
+      while (true) {
+        slot = &slots[pos & mask];
+        size_t seq = slot->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+        if (diff == 0) {
+          if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+            break;
+          }
+        }
+        else if (diff < 0) {
+          return false;
+        }
+        else {
+          pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+      }
+      fill(slot->message);
+      slot->sequence.store(pos + 1, std::memory_order_release);
+      return true;
+    }
+
+    /** \return whether more messages may be queued
+     */
+    bool
+    drain()
+    {
+      size_t n = 0;
+      for (; n < maxBatchSize; ++n) {
+        Slot& slot = slots[dequeuePos & mask];
+        if (slot.sequence.load(std::memory_order_acquire) != dequeuePos + 1) {
+          break;
+        }
+        handler(slot.message);
+        slot.sequence.store(dequeuePos + mask + 1, std::memory_order_release);
+        ++dequeuePos;
+      }
+      if (n > 0) {
+        nReceived.fetch_add(n, std::memory_order_relaxed);
+        nBatches.fetch_add(1, std::memory_order_relaxed);
+      }
+      return n == maxBatchSize;
+    }
+
+    unique_ptr<Slot[]> slots;
+    size_t mask;
+    Handler handler;
+    const size_t maxBatchSize;
+
+    std::atomic<size_t> enqueuePos{0};
+    size_t dequeuePos = 0; ///< accessed by the consumer only
+    std::atomic<bool> isDrainScheduled{false};
+
+    std::atomic<uint64_t> nSent{0};
+    std::atomic<uint64_t> nDropped{0};
+    std::atomic<uint64_t> nReceived{0};
+    std::atomic<uint64_t> nBatches{0};
+  };
+
+  void
+  schedule(State& state)
+  {
+    if (!state.isDrainScheduled.exchange(true, std::memory_order_acq_rel)) {
+      postDrain(m_state, m_post);
+    }
+  }
+
+  static void
+  postDrain(const weak_ptr<State>& weakState, const PostFunc& post)
+  {
+    post([weakState, post] {
+      auto state = weakState.lock();
+      if (state == nullptr) {
+        return;
+      }
+      // Clear the flag before draining: a producer that finds it cleared posts another drain,
+      // and the release of a producer that found it set is acquired by this exchange.
+      state->isDrainScheduled.exchange(false, std::memory_order_acq_rel);
+      if (state->drain() && !state->isDrainScheduled.exchange(true, std::memory_order_acq_rel)) {
+        // batch limit reached, continue in another drain so that other work can interleave
+        postDrain(weakState, post);
+      }
+    });
+  }
+
+private:
+  shared_ptr<State> m_state;
+  PostFunc m_post;
+};
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_COMMON_MPSC_CHANNEL_HPP
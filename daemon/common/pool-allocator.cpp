@@ -0,0 +1,81 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/pool-allocator.hpp"
+
+namespace nfd {
+
+constexpr size_t FixedSizePool::MAX_BLOCK_SIZE;
+
+FixedSizePool::FixedSizePool(size_t blocksPerChunk)
+  : m_blocksPerChunk(blocksPerChunk)
+{
+  BOOST_ASSERT(m_blocksPerChunk > 0);
+}
+
+FixedSizePool::~FixedSizePool()
+{
+  BOOST_ASSERT(m_nAllocated == 0);
+}
+
+void*
+FixedSizePool::allocate(size_t size)
+{
+  BOOST_ASSERT(canAllocate(size));
+  if (m_objectSize == 0) {
+    m_objectSize = size;
+    // round up so that every block is suitably aligned for any type
+    constexpr size_t align = alignof(std::max_align_t);
+    m_blockSize = std::max((size + align - 1) / align * align, sizeof(FreeBlock));
+    m_nUsedInLastChunk = m_blocksPerChunk;
+  }
+  ++m_nAllocated;
+
+  if (m_freeList != nullptr) {
+    FreeBlock* block = m_freeList;
+    m_freeList = block->next;
+    return block;
+  }
+
+  if (m_nUsedInLastChunk == m_blocksPerChunk) {
+    // the chunk is owned before push_back, which may throw when the vector grows
+    unique_ptr<uint8_t[]> chunk(new uint8_t[m_blockSize * m_blocksPerChunk]);
+    m_chunks.push_back(std::move(chunk));
+    m_nUsedInLastChunk = 0;
+  }
+  return m_chunks.back().get() + m_blockSize * m_nUsedInLastChunk++;
+}
+
+void
+FixedSizePool::deallocate(void* p) noexcept
+{
+  BOOST_ASSERT(m_nAllocated > 0);
+  --m_nAllocated;
+  auto block = static_cast<FreeBlock*>(p);
+  block->next = m_freeList;
+  m_freeList = block;
+}
+
+} // namespace nfd
@@ -0,0 +1,163 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_COMMON_POOL_ALLOCATOR_HPP
+#define NFD_DAEMON_COMMON_POOL_ALLOCATOR_HPP
+
+#include "core/common.hpp"
+
+namespace nfd {
+
+/** \brief allocates blocks of one size from large chunks, and recycles freed blocks
+ *
+ *  The block size is determined by the first allocation; requests for other sizes are
+ *  rejected by canAllocate(). Chunks are released only when the pool is destroyed.
+ *  \warning This class is not thread-safe.
+ */
+class FixedSizePool : noncopyable
+{
+public:
+  explicit
+  FixedSizePool(size_t blocksPerChunk = 1024);
+
+  ~FixedSizePool();
+
+  /** \return whether allocate(size) can be served from this pool
+   */
+  bool
+  canAllocate(size_t size) const noexcept
+  {
+    return m_objectSize == 0 ? size <= MAX_BLOCK_SIZE : size == m_objectSize;
+  }
+
+  /** \pre canAllocate(size)
+   */
+  void*
+  allocate(size_t size);
+
+  void
+  deallocate(void* p) noexcept;
+
+  /** \return number of blocks currently allocated
+   */
+  size_t
+  size() const noexcept
+  {
+    return m_nAllocated;
+  }
+
+  /** \return number of chunks obtained from the global heap
+   */
+  size_t
+  getNChunks() const noexcept
+  {
+    return m_chunks.size();
+  }
+
+public:
+  static constexpr size_t MAX_BLOCK_SIZE = 4096;
+
+private:
+  struct FreeBlock
+  {
+    FreeBlock* next;
+  };
+
+  size_t m_blocksPerChunk;
+  size_t m_objectSize = 0; ///< size of the first allocation
+  size_t m_blockSize = 0;  ///< m_objectSize rounded up for alignment
+  std::vector<unique_ptr<uint8_t[]>> m_chunks;
+  FreeBlock* m_freeList = nullptr;
+  size_t m_nUsedInLastChunk = 0;
+  size_t m_nAllocated = 0;
+};
+
+/** \brief an allocator that serves single-object allocations from a shared FixedSizePool
+ *
+ *  This is intended for std::allocate_shared, where the allocator is rebound to the
+ *  control block type, and every allocation has the same size. The control block keeps
+ *  the pool alive, so objects may outlive the table that created them.
+ */
+template<typename T>
+class PoolAllocator
+{
+public:
+  using value_type = T;
+
+  explicit
+  PoolAllocator(shared_ptr<FixedSizePool> pool) noexcept
+    : m_pool(std::move(pool))
+  {
+  }
+
+  template<typename U>
+  PoolAllocator(const PoolAllocator<U>& other) noexcept
+    : m_pool(other.m_pool)
+  {
+  }
+
+  T*
+  allocate(size_t n)
+  {
+    if (n == 1 && alignof(T) <= alignof(std::max_align_t) && m_pool->canAllocate(sizeof(T))) {
+      return static_cast<T*>(m_pool->allocate(sizeof(T)));
+    }
+    return std::allocator<T>().allocate(n);
+  }
+
+  void
+  deallocate(T* p, size_t n) noexcept
+  {
+    if (n == 1 && alignof(T) <= alignof(std::max_align_t) && m_pool->canAllocate(sizeof(T))) {
+      m_pool->deallocate(p);
+      return;
+    }
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  template<typename U>
+  friend bool
+  operator==(const PoolAllocator& a, const PoolAllocator<U>& b) noexcept
+  {
+    return a.m_pool == b.m_pool;
+  }
+
+  template<typename U>
+  friend bool
+  operator!=(const PoolAllocator& a, const PoolAllocator<U>& b) noexcept
+  {
+    return a.m_pool != b.m_pool;
+  }
+
+private:
+  shared_ptr<FixedSizePool> m_pool;
+
+  template<typename U>
+  friend class PoolAllocator;
+};
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_COMMON_POOL_ALLOCATOR_HPP
@@ -0,0 +1,175 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_COMMON_SPSC_RING_HPP
+#define NFD_DAEMON_COMMON_SPSC_RING_HPP
+
+#include "core/common.hpp"
+
+#include <atomic>
+#include <limits>
+
+namespace nfd {
+
+/** \brief A bounded lock-free queue with one producer thread and one consumer thread.
+ *
+ *  The capacity is rounded up to a power of two. Each side keeps a private copy of the other
+ *  side's index and only reloads the shared index when its copy says the ring is full or empty,
+ *  so that in steady state a push or a pop touches a single shared cache line.
+ *
+ *  \tparam T element type; must be default-constructible and move-assignable
+ *  \warning tryPush must only be called from one thread, and tryPop/consume from one thread.
+ */
+template<typename T>
+class SpscRing : noncopyable
+{
+public:
+  explicit
+  SpscRing(size_t capacity)
+    : m_slots(roundUpToPowerOfTwo(std::max<size_t>(capacity, 2)))
+    , m_mask(m_slots.size() - 1)
+  {
+  }
+
+  size_t
+  capacity() const noexcept
+  {
+    return m_slots.size();
+  }
+
+  /** \brief Returns the number of queued elements.
+   *  \note The value is only a snapshot when the other side is running concurrently.
+   */
+  size_t
+  size() const noexcept
+  {
+    return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+  }
+
+  bool
+  empty() const noexcept
+  {
+    return size() == 0;
+  }
+
+  /** \brief Appends an element (producer side).
+   *  \retval false the ring is full; \p item is left untouched
+   */
+  bool
+  tryPush(T&& item)
+  {
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_producerHead == m_slots.size()) {
+      m_producerHead = m_head.load(std::memory_order_acquire);
+      if (tail - m_producerHead == m_slots.size()) {
+        return false;
+      }
+    }
+    m_slots[tail & m_mask] = std::move(item);
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool
+  tryPush(const T& item)
+  {
+    T copy(item);
+    return tryPush(std::move(copy));
+  }
+
+  /** \brief Removes the oldest element (consumer side).
+   *  \retval false the ring is empty
+   */
+  bool
+  tryPop(T& item)
+  {
+    size_t head = m_head.load(std::memory_order_relaxed);
+    if (head == m_consumerTail) {
+      m_consumerTail = m_tail.load(std::memory_order_acquire);
+      if (head == m_consumerTail) {
+        return false;
+      }
+    }
+    item = std::move(m_slots[head & m_mask]);
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /** \brief Removes up to \p maxItems elements and passes each of them to \p f (consumer side).
+   *
+   *  The consumer index is published once for the whole batch.
+   *  \return number of elements consumed
+   */
+  template<typename F>
+  size_t
+  consume(F&& f, size_t maxItems = std::numeric_limits<size_t>::max())
+  {
+    size_t head = m_head.load(std::memory_order_relaxed);
+    if (head == m_consumerTail) {
+      m_consumerTail = m_tail.load(std::memory_order_acquire);
+    }
+    size_t n = std::min(m_consumerTail - head, maxItems);
+    for (size_t i = 0; i < n; ++i) {
+      T item(std::move(m_slots[(head + i) & m_mask]));
+      f(std::move(item));
+    }
+    m_head.store(head + n, std::memory_order_release);
+    return n;
+  }
+
+private:
+  static size_t
+  roundUpToPowerOfTwo(size_t n)
+  {
+    size_t p = 1;
+    while (p < n) {
+      p <<= 1;
+    }
+    return p;
+  }
+
+private:
+  static constexpr size_t CACHE_LINE_SIZE = 64;
+
+  std::vector<T> m_slots;
+  const size_t m_mask;
+
+  // consumer-owned cache line
+  std::atomic<size_t> m_head{0};
+  size_t m_consumerTail = 0; ///< consumer's copy of m_tail
+  char m_consumerPad[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+
+  // producer-owned cache line
+  std::atomic<size_t> m_tail{0};
+  size_t m_producerHead = 0; ///< producer's copy of m_head
+  char m_producerPad[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+};
+
+template<typename T>
+constexpr size_t SpscRing<T>::CACHE_LINE_SIZE;
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_COMMON_SPSC_RING_HPP
@@ -0,0 +1,250 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "datagram-batch-io.hpp"
+
+#include <sys/socket.h>
+
+namespace nfd {
+namespace face {
+
+static boost::system::error_code
+makeErrorCode(int errnum)
+{
+  if (errnum == EAGAIN || errnum == EWOULDBLOCK) {
+    return boost::asio::error::would_block;
+  }
+  return {errnum, boost::system::system_category()};
+}
+
+struct DatagramReceiveBatch::Impl
+{
+  Impl(size_t capacity, ReceiveBufferPool& pool)
+    : pool(pool)
+    , buffers(capacity)
+    , lengths(capacity)
+    , senders(capacity)
+    , senderLengths(capacity)
+#if defined(__linux__)
+    , iovecs(capacity)
+    , headers(capacity)
+#endif
+  {
+  }
+
+  /** \brief ensures that no received datagram still references the buffer in slot \p i
+   */
+  void
+  refreshBuffer(size_t i)
+  {
+    if (buffers[i] == nullptr || buffers[i].use_count() > 1) {
+      buffers[i] = pool.acquire();
+#if defined(__linux__)
+      iovecs[i].iov_base = buffers[i]->data();
+      iovecs[i].iov_len = buffers[i]->size();
+#endif
+    }
+  }
+
+  ReceiveBufferPool& pool;
+  std::vector<shared_ptr<ndn::Buffer>> buffers;
+  std::vector<size_t> lengths;
+  std::vector<sockaddr_storage> senders;
+  std::vector<socklen_t> senderLengths;
+#if defined(__linux__)
+  std::vector<iovec> iovecs;
+  std::vector<mmsghdr> headers;
+#endif
+};
+
+DatagramReceiveBatch::DatagramReceiveBatch(size_t capacity, ReceiveBufferPool& pool)
+  : m_impl(make_unique<Impl>(capacity, pool))
+{
+  BOOST_ASSERT(capacity > 0);
+}
+
+DatagramReceiveBatch::~DatagramReceiveBatch() = default;
+
+size_t
+DatagramReceiveBatch::capacity() const noexcept
+{
+  return m_impl->lengths.size();
+}
+
+size_t
+DatagramReceiveBatch::receive(int fd, boost::system::error_code& error)
+{
+  Impl& impl = *m_impl;
+  error.clear();
+
+#if defined(__linux__)
+  // msg_namelen and msg_flags are overwritten by each call, so the headers must be reset
+  for (size_t i = 0; i < impl.headers.size(); ++i) {
+    impl.refreshBuffer(i);
+    msghdr& hdr = impl.headers[i].msg_hdr;
+    hdr = {};
+    hdr.msg_name = &impl.senders[i];
+    hdr.msg_namelen = sizeof(sockaddr_storage);
+    hdr.msg_iov = &impl.iovecs[i];
+    hdr.msg_iovlen = 1;
+  }
+
+  int n = ::recvmmsg(fd, impl.headers.data(), impl.headers.size(), MSG_DONTWAIT, nullptr);
+  if (n < 0) {
+    error = makeErrorCode(errno);
+    if (error == boost::asio::error::would_block) {
+      error.clear();
+    }
+    return 0;
+  }
+
+  for (int i = 0; i < n; ++i) {
+    impl.lengths[i] = impl.headers[i].msg_len;
+    impl.senderLengths[i] = impl.headers[i].msg_hdr.msg_namelen;
+  }
+  return static_cast<size_t>(n);
+#else
+  size_t n = 0;
+  for (; n < impl.lengths.size(); ++n) {
+    impl.refreshBuffer(n);
+    impl.senderLengths[n] = sizeof(sockaddr_storage);
+    ssize_t len = ::recvfrom(fd, impl.buffers[n]->data(), impl.buffers[n]->size(),
+                             MSG_DONTWAIT, reinterpret_cast<sockaddr*>(&impl.senders[n]),
+                             &impl.senderLengths[n]);
+    if (len < 0) {
+      // an error after some datagrams were received is reported by the next call
+      if (n == 0) {
+        error = makeErrorCode(errno);
+        if (error == boost::asio::error::would_block) {
+          error.clear();
+        }
+      }
+      break;
+    }
+    impl.lengths[n] = static_cast<size_t>(len);
+  }
+  return n;
+#endif
+}
+
+span<const uint8_t>
+DatagramReceiveBatch::getPayload(size_t i) const
+{
+  BOOST_ASSERT(i < capacity());
+  return {m_impl->buffers[i]->data(), m_impl->lengths[i]};
+}
+
+ndn::ConstBufferPtr
+DatagramReceiveBatch::getBuffer(size_t i) const
+{
+  BOOST_ASSERT(i < capacity());
+  return m_impl->buffers[i];
+}
+
+span<const uint8_t>
+DatagramReceiveBatch::getSenderAddress(size_t i) const
+{
+  BOOST_ASSERT(i < capacity());
+  return {reinterpret_cast<const uint8_t*>(&m_impl->senders[i]), m_impl->senderLengths[i]};
+}
+
+struct DatagramSendBatch::Impl
+{
+  explicit
+  Impl(size_t capacity)
+    : capacity(capacity)
+#if defined(__linux__)
+    , iovecs(capacity)
+    , headers(capacity)
+#endif
+  {
+  }
+
+  const size_t capacity;
+#if defined(__linux__)
+  std::vector<iovec> iovecs;
+  std::vector<mmsghdr> headers;
+#endif
+};
+
+DatagramSendBatch::DatagramSendBatch(size_t capacity)
+  : m_impl(make_unique<Impl>(capacity))
+{
+  BOOST_ASSERT(capacity > 0);
+}
+
+DatagramSendBatch::~DatagramSendBatch() = default;
+
+size_t
+DatagramSendBatch::capacity() const noexcept
+{
+  return m_impl->capacity;
+}
+
+size_t
+DatagramSendBatch::send(int fd, span<const Block> packets, span<const uint8_t> destination,
+                        boost::system::error_code& error)
+{
+  Impl& impl = *m_impl;
+  error.clear();
+  size_t nPackets = std::min(packets.size(), impl.capacity);
+  auto* destAddr = destination.empty() ? nullptr :
+                   reinterpret_cast<const sockaddr*>(destination.data());
+
+#if defined(__linux__)
+  for (size_t i = 0; i < nPackets; ++i) {
+    impl.iovecs[i].iov_base = const_cast<uint8_t*>(packets[i].wire());
+    impl.iovecs[i].iov_len = packets[i].size();
+
+    msghdr& hdr = impl.headers[i].msg_hdr;
+    hdr = {};
+    hdr.msg_name = const_cast<sockaddr*>(destAddr);
+    hdr.msg_namelen = static_cast<socklen_t>(destination.size());
+    hdr.msg_iov = &impl.iovecs[i];
+    hdr.msg_iovlen = 1;
+  }
+
+  // sendmmsg() reports an error only if the first message fails;
+  // a failure on a later message is reported by the next call
+  int n = ::sendmmsg(fd, impl.headers.data(), nPackets, MSG_DONTWAIT);
+  if (n < 0) {
+    error = makeErrorCode(errno);
+    return 0;
+  }
+  return static_cast<size_t>(n);
+#else
+  for (size_t i = 0; i < nPackets; ++i) {
+    if (::sendto(fd, packets[i].wire(), packets[i].size(), MSG_DONTWAIT, destAddr,
+                 static_cast<socklen_t>(destination.size())) < 0) {
+      error = makeErrorCode(errno);
+      return i;
+    }
+  }
+  return nPackets;
+#endif
+}
+
+} // namespace face
+} // namespace nfd
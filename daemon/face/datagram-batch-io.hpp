@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_DATAGRAM_BATCH_IO_HPP
+#define NFD_DAEMON_FACE_DATAGRAM_BATCH_IO_HPP
+
+#include "receive-buffer-pool.hpp"
+
+#include <cstring>
+
+namespace nfd {
+namespace face {
+
+/** \brief Receives up to a fixed number of datagrams from a socket per call.
+ *
+ *  Each datagram is received into its own buffer obtained from a ReceiveBufferPool.
+ *  A buffer that is still referenced when the next batch is received is replaced by a fresh one
+ *  from the pool, so that Blocks wrapping the buffers of a batch stay valid.
+ *  On Linux, a batch is received with a single recvmmsg() system call;
+ *  elsewhere, the socket is drained with one recvfrom() call per datagram.
+ */
+class DatagramReceiveBatch : noncopyable
+{
+public:
+  /** \param capacity maximum number of datagrams per batch
+   *  \param pool the buffer pool; must outlive this object
+   */
+  DatagramReceiveBatch(size_t capacity, ReceiveBufferPool& pool);
+
+  ~DatagramReceiveBatch();
+
+  size_t
+  capacity() const noexcept;
+
+  /** \brief Receives as many datagrams as are queued on \p fd, up to capacity(), without blocking
+   *  \return number of datagrams received
+   *
+   *  If the socket has no queued datagram, zero is returned and \p error is not set.
+   */
+  size_t
+  receive(int fd, boost::system::error_code& error);
+
+  /** \brief Returns the payload of the \p i-th received datagram
+   */
+  span<const uint8_t>
+  getPayload(size_t i) const;
+
+  /** \brief Returns the buffer holding the \p i-th received datagram
+   *
+   *  The datagram occupies the first getPayload(i).size() octets of the buffer.
+   */
+  ndn::ConstBufferPtr
+  getBuffer(size_t i) const;
+
+  /** \brief Copies the sender address of the \p i-th received datagram into \p endpoint
+   *  \tparam Endpoint a Boost.Asio endpoint type
+   */
+  template<typename Endpoint>
+  void
+  getSender(size_t i, Endpoint& endpoint) const
+  {
+    auto addr = getSenderAddress(i);
+    endpoint.resize(addr.size());
+    std::memcpy(endpoint.data(), addr.data(), addr.size());
+  }
+
+private:
+  span<const uint8_t>
+  getSenderAddress(size_t i) const;
+
+private:
+  struct Impl;
+  unique_ptr<Impl> m_impl;
+};
+
+/** \brief Sends up to a fixed number of datagrams to a socket per call.
+ *
+ *  On Linux, a batch is sent with a single sendmmsg() system call;
+ *  elsewhere, one sendto() call is made per datagram.
+ */
+class DatagramSendBatch : noncopyable
+{
+public:
+  explicit
+  DatagramSendBatch(size_t capacity);
+
+  ~DatagramSendBatch();
+
+  size_t
+  capacity() const noexcept;
+
+  /** \brief Sends the first \p packets, up to capacity(), without blocking
+   *  \param destination destination socket address, or empty to send on a connected socket
+   *  \return number of packets passed to the kernel
+   *
+   *  If the socket send buffer is full, sending stops early and \p error is set to
+   *  boost::asio::error::would_block. If the first unsent packet is rejected with any other
+   *  error, sending stops early and \p error is set accordingly.
+   */
+  size_t
+  send(int fd, span<const Block> packets, span<const uint8_t> destination,
+       boost::system::error_code& error);
+
+private:
+  struct Impl;
+  unique_ptr<Impl> m_impl;
+};
+
+} // namespace face
+} // namespace nfd
+
+#endif // NFD_DAEMON_FACE_DATAGRAM_BATCH_IO_HPP
@@ -27,11 +27,11 @@
 #define NFD_DAEMON_FACE_DATAGRAM_TRANSPORT_HPP
 
 #include "transport.hpp"
+#include "datagram-batch-io.hpp"
+#include "receive-buffer-pool.hpp"
 #include "socket-utils.hpp"
 #include "common/global.hpp"
 
-#include <array>
-
 namespace nfd {
 namespace face {
 
@@ -60,10 +60,41 @@ public:
 
   /**
    * \brief Receive datagram, translate buffer into packet, deliver to parent class.
+   *
+   * The datagram is copied out of \p buffer.
    */
   void
   receiveDatagram(span<const uint8_t> buffer, const boost::system::error_code& error);
 
+  /**
+   * \brief Receive datagram held in the first \p nBytes octets of a refcounted buffer.
+   *
+   * The packet delivered to the parent class shares \p buffer only if the datagram covers at
+   * least half of it, see canShareReceiveBuffer(). Otherwise the datagram is copied, so that a
+   * long-lived packet does not pin a mostly unused receive buffer.
+   */
+  void
+  receiveDatagram(ndn::ConstBufferPtr buffer, size_t nBytes, const boost::system::error_code& error);
+
+  size_t
+  getIoBatchSize() const
+  {
+    return m_ioBatchSize;
+  }
+
+  /** \brief Sets the maximum number of datagrams received or sent per system call.
+   *
+   *  When \p n is greater than one, the transport drains up to \p n datagrams from the socket
+   *  each time it becomes readable, and packets sent during the same event loop iteration are
+   *  coalesced into batches of up to \p n datagrams. Each datagram of a batch is received into
+   *  a buffer of the largest size class, so a datagram smaller than half of it is copied.
+   *  When \p n is one, each datagram is received when the socket becomes readable, into a
+   *  buffer of the smallest size class that fits it, and sent with a separate asynchronous
+   *  operation. The new value takes effect at the next receive operation.
+   */
+  void
+  setIoBatchSize(size_t n);
+
 protected:
   void
   doClose() override;
@@ -74,8 +105,23 @@ protected:
   void
   handleSend(const boost::system::error_code& error, size_t nBytesSent);
 
+  /** \brief Queues \p packet to be sent in a batch
+   *  \param socket the socket to send on
+   *  \param destination the destination endpoint, or nullptr if \p socket is connected
+   *
+   *  All packets of a transport must be queued with the same \p socket and \p destination.
+   */
   void
-  handleReceive(const boost::system::error_code& error, size_t nBytesReceived);
+  enqueueSend(const Block& packet, typename protocol::socket& socket,
+              const typename protocol::endpoint* destination);
+
+  /** \brief Returns the total size of packets queued by enqueueSend and not yet sent
+   */
+  size_t
+  getEnqueuedBytes() const
+  {
+    return m_sendQueueBytes;
+  }
 
   void
   processErrorCode(const boost::system::error_code& error);
@@ -89,6 +135,19 @@ protected:
   static EndpointId
   makeEndpointId(const typename protocol::endpoint& ep);
 
+private:
+  void
+  deliverDatagram(const Block& element, size_t nBytes);
+
+  void
+  startReceive();
+
+  void
+  handleReceiveReady(const boost::system::error_code& error);
+
+  void
+  flushSendQueue();
+
 protected:
   typename protocol::socket m_socket;
   typename protocol::endpoint m_sender;
@@ -96,8 +155,18 @@ protected:
   NFD_LOG_MEMBER_DECL();
 
 private:
-  std::array<uint8_t, ndn::MAX_NDN_PACKET_SIZE> m_receiveBuffer;
+  ReceiveBufferPool m_receiveBufferPool;
   bool m_hasRecentlyReceived;
+
+  size_t m_ioBatchSize = 1;
+  unique_ptr<DatagramReceiveBatch> m_receiveBatch;
+  unique_ptr<DatagramSendBatch> m_sendBatch;
+  std::vector<Block> m_sendQueue;
+  size_t m_sendQueueBytes = 0;
+  typename protocol::socket* m_batchSocket = nullptr;
+  const typename protocol::endpoint* m_batchDestination = nullptr;
+  /// whether flushSendQueue has been posted or is waiting for the socket to become writable
+  bool m_isFlushPending = false;
 };
 
 
@@ -117,10 +186,14 @@ DatagramTransport<T, U>::DatagramTransport(typename DatagramTransport::protocol:
     this->setSendQueueCapacity(sendBufferSizeOption.value());
   }
 
-  m_socket.async_receive_from(boost::asio::buffer(m_receiveBuffer), m_sender,
-                              [this] (auto&&... args) {
-                                this->handleReceive(std::forward<decltype(args)>(args)...);
-                              });
+  // a datagram is received synchronously once the socket is readable, which must not block
+  // if the datagram was discarded in the meantime, e.g., because of a bad checksum
+  m_socket.non_blocking(true, error);
+  if (error) {
+    NFD_LOG_FACE_WARN("Failed to make socket non-blocking: " << error.message());
+  }
+
+  startReceive();
 }
 
 template<class T, class U>
@@ -131,9 +204,22 @@ DatagramTransport<T, U>::getSendQueueLength()
   if (queueLength == QUEUE_ERROR) {
     NFD_LOG_FACE_WARN("Failed to obtain send queue length from socket: " << std::strerror(errno));
   }
+  else if (queueLength >= 0) {
+    queueLength += getEnqueuedBytes();
+  }
   return queueLength;
 }
 
+template<class T, class U>
+void
+DatagramTransport<T, U>::setIoBatchSize(size_t n)
+{
+  BOOST_ASSERT(n > 0);
+  m_ioBatchSize = n;
+  // enough idle buffers to refill a whole batch after its packets are released
+  m_receiveBufferPool.setMaxIdle(std::max<size_t>(n, 16));
+}
+
 template<class T, class U>
 void
 DatagramTransport<T, U>::doClose()
@@ -161,6 +247,11 @@ DatagramTransport<T, U>::doSend(const Block& packet)
 {
   NFD_LOG_FACE_TRACE(__func__);
 
+  if (m_ioBatchSize > 1) {
+    enqueueSend(packet, m_socket, nullptr);
+    return;
+  }
+
   m_socket.async_send(boost::asio::buffer(packet),
                       // 'packet' is copied into the lambda to retain the underlying Buffer
                       [this, packet] (auto&&... args) {
@@ -168,6 +259,90 @@ DatagramTransport<T, U>::doSend(const Block& packet)
                       });
 }
 
+template<class T, class U>
+void
+DatagramTransport<T, U>::enqueueSend(const Block& packet, typename protocol::socket& socket,
+                                     const typename protocol::endpoint* destination)
+{
+  BOOST_ASSERT(m_batchSocket == nullptr || m_batchSocket == &socket);
+  m_batchSocket = &socket;
+  m_batchDestination = destination;
+
+  m_sendQueue.push_back(packet);
+  m_sendQueueBytes += packet.size();
+
+  if (!m_isFlushPending) {
+    // packets sent by the rest of the current event loop iteration join this batch
+    m_isFlushPending = true;
+    getGlobalIoService().post([this] { this->flushSendQueue(); });
+  }
+}
+
+template<class T, class U>
+void
+DatagramTransport<T, U>::flushSendQueue()
+{
+  m_isFlushPending = false;
+  if (!m_batchSocket->is_open()) {
+    m_sendQueue.clear();
+    m_sendQueueBytes = 0;
+    return;
+  }
+
+  if (m_sendBatch == nullptr || m_sendBatch->capacity() != m_ioBatchSize) {
+    m_sendBatch = make_unique<DatagramSendBatch>(m_ioBatchSize);
+  }
+
+  span<const uint8_t> destination;
+  if (m_batchDestination != nullptr) {
+    destination = {reinterpret_cast<const uint8_t*>(m_batchDestination->data()),
+                   m_batchDestination->size()};
+  }
+
+  auto first = m_sendQueue.begin();
+  boost::system::error_code error;
+  while (first != m_sendQueue.end()) {
+    span<const Block> unsent(&*first, static_cast<size_t>(m_sendQueue.end() - first));
+    size_t nSent = m_sendBatch->send(m_batchSocket->native_handle(), unsent, destination, error);
+    for (size_t i = 0; i < nSent; ++i, ++first) {
+      NFD_LOG_FACE_TRACE("Successfully sent: " << first->size() << " bytes");
+      m_sendQueueBytes -= first->size();
+    }
+
+    if (error == boost::asio::error::would_block) {
+      break;
+    }
+    if (error) {
+      // the packet that caused the error is dropped, as it would have been by async_send
+      m_sendQueueBytes -= first->size();
+      ++first;
+      m_sendQueue.erase(m_sendQueue.begin(), first);
+      // this may close the transport, in which case the remaining packets are discarded
+      processErrorCode(error);
+      if (m_batchSocket->is_open() && !m_sendQueue.empty()) {
+        m_isFlushPending = true;
+        getGlobalIoService().post([this] { this->flushSendQueue(); });
+      }
+      return;
+    }
+  }
+  m_sendQueue.erase(m_sendQueue.begin(), first);
+
+  if (!m_sendQueue.empty()) {
+    // wait until the socket send buffer has room again
+    m_isFlushPending = true;
+    m_batchSocket->async_send(boost::asio::null_buffers(), [this] (const auto& e, auto) {
+      if (e) {
+        m_isFlushPending = false;
+        m_sendQueue.clear();
+        m_sendQueueBytes = 0;
+        return this->processErrorCode(e);
+      }
+      this->flushSendQueue();
+    });
+  }
+}
+
 template<class T, class U>
 void
 DatagramTransport<T, U>::receiveDatagram(span<const uint8_t> buffer,
@@ -186,7 +361,41 @@ DatagramTransport<T, U>::receiveDatagram(span<const uint8_t> buffer,
     // This packet won't extend the face lifetime
     return;
   }
-  if (element.size() != buffer.size()) {
+  ++this->nInPacketCopies;
+
+  deliverDatagram(element, buffer.size());
+}
+
+template<class T, class U>
+void
+DatagramTransport<T, U>::receiveDatagram(ndn::ConstBufferPtr buffer, size_t nBytes,
+                                         const boost::system::error_code& error)
+{
+  BOOST_ASSERT(nBytes <= buffer->size());
+  if (error || !canShareReceiveBuffer(nBytes, buffer->size())) {
+    return receiveDatagram({buffer->data(), nBytes}, error);
+  }
+
+  NFD_LOG_FACE_TRACE("Received: " << nBytes << " bytes from " << m_sender);
+
+  // the element is parsed from the start of the buffer, and its size is checked below
+  bool isOk = false;
+  Block element;
+  std::tie(isOk, element) = Block::fromBuffer(std::move(buffer));
+  if (!isOk) {
+    NFD_LOG_FACE_WARN("Failed to parse incoming packet from " << m_sender);
+    // This packet won't extend the face lifetime
+    return;
+  }
+
+  deliverDatagram(element, nBytes);
+}
+
+template<class T, class U>
+void
+DatagramTransport<T, U>::deliverDatagram(const Block& element, size_t nBytes)
+{
+  if (element.size() != nBytes) {
     NFD_LOG_FACE_WARN("Received datagram size and decoded element size don't match");
     // This packet won't extend the face lifetime
     return;
@@ -198,15 +407,52 @@ DatagramTransport<T, U>::receiveDatagram(span<const uint8_t> buffer,
 
 template<class T, class U>
 void
-DatagramTransport<T, U>::handleReceive(const boost::system::error_code& error, size_t nBytesReceived)
+DatagramTransport<T, U>::startReceive()
+{
+  m_socket.async_receive(boost::asio::null_buffers(),
+                         [this] (const auto& e, auto) { this->handleReceiveReady(e); });
+}
+
+template<class T, class U>
+void
+DatagramTransport<T, U>::handleReceiveReady(const boost::system::error_code& error)
 {
-  receiveDatagram(ndn::make_span(m_receiveBuffer).first(nBytesReceived), error);
+  if (error) {
+    processErrorCode(error);
+  }
+  else if (m_ioBatchSize > 1) {
+    if (m_receiveBatch == nullptr || m_receiveBatch->capacity() != m_ioBatchSize) {
+      m_receiveBatch = make_unique<DatagramReceiveBatch>(m_ioBatchSize, m_receiveBufferPool);
+    }
+
+    boost::system::error_code recvError;
+    size_t nReceived = m_receiveBatch->receive(m_socket.native_handle(), recvError);
+    this->nInBufferAllocations.set(m_receiveBufferPool.getNAllocations());
+    for (size_t i = 0; i < nReceived && m_socket.is_open(); ++i) {
+      m_receiveBatch->getSender(i, m_sender);
+      receiveDatagram(m_receiveBatch->getBuffer(i), m_receiveBatch->getPayload(i).size(), {});
+    }
+    if (recvError) {
+      processErrorCode(recvError);
+    }
+  }
+  else {
+    // the number of readable octets is the size of the next datagram on Linux, and an upper
+    // bound of it elsewhere; if unknown, the largest buffer is used
+    boost::system::error_code recvError;
+    size_t nReadable = m_socket.available(recvError);
+    auto buffer = m_receiveBufferPool.acquire(nReadable > 0 ? nReadable
+                                                            : m_receiveBufferPool.getBufferSize());
+    this->nInBufferAllocations.set(m_receiveBufferPool.getNAllocations());
+
+    size_t nBytes = m_socket.receive_from(boost::asio::buffer(*buffer), m_sender, 0, recvError);
+    if (recvError != boost::asio::error::would_block) {
+      receiveDatagram(std::move(buffer), nBytes, recvError);
+    }
+  }
 
   if (m_socket.is_open())
-    m_socket.async_receive_from(boost::asio::buffer(m_receiveBuffer), m_sender,
-                                [this] (auto&&... args) {
-                                  this->handleReceive(std::forward<decltype(args)>(args)...);
-                                });
+    startReceive();
 }
 
 template<class T, class U>
@@ -28,6 +28,7 @@
 
 #include "channel.hpp"
 #include "ethernet-protocol.hpp"
+#include "ethernet-transport.hpp"
 #include "pcap-helper.hpp"
 
 #include <ndn-cxx/net/network-interface.hpp>
@@ -75,6 +76,23 @@ public:
     return m_channelFaces.size();
   }
 
+  EthernetTransport::Backend
+  getTransportBackend() const
+  {
+    return m_transportBackend;
+  }
+
+  /**
+   * \brief Set the backend of unicast faces created after this call
+   *
+   * The channel itself always listens for frames from new peers with libpcap.
+   */
+  void
+  setTransportBackend(EthernetTransport::Backend backend)
+  {
+    m_transportBackend = backend;
+  }
+
   /**
    * \brief Create a unicast Ethernet face toward \p remoteEndpoint
    */
@@ -130,6 +148,7 @@ private:
   PcapHelper m_pcap;
   std::map<ethernet::Address, shared_ptr<Face>> m_channelFaces;
   const time::nanoseconds m_idleFaceTimeout; ///< Timeout for automatic closure of idle on-demand faces
+  EthernetTransport::Backend m_transportBackend = EthernetTransport::Backend::PCAP;
 
 #ifdef _DEBUG
   /// number of frames dropped by the kernel, as reported by libpcap
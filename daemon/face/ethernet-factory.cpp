@@ -60,6 +60,7 @@ EthernetFactory::doProcessConfig(OptionalConfigSection configSection,
   // {
   //   listen yes
   //   idle_timeout 600
+  //   backend pcap
   //   mcast yes
   //   mcast_group 01:00:5E:00:17:AA
   //   mcast_ad_hoc no
@@ -74,6 +75,7 @@ EthernetFactory::doProcessConfig(OptionalConfigSection configSection,
 
   UnicastConfig unicastConfig;
   MulticastConfig mcastConfig;
+  auto backend = EthernetTransport::Backend::PCAP;
 
   if (configSection) {
     // listen and mcast default to 'yes' but only if face_system.ether section is present
@@ -89,6 +91,23 @@ EthernetFactory::doProcessConfig(OptionalConfigSection configSection,
       else if (key == "idle_timeout") {
         unicastConfig.idleTimeout = time::seconds(ConfigFile::parseNumber<uint32_t>(pair, "face_system.ether"));
       }
+      else if (key == "backend") {
+        const std::string& valueStr = value.get_value<std::string>();
+        if (valueStr == "pcap") {
+          backend = EthernetTransport::Backend::PCAP;
+        }
+        else if (valueStr == "tpacket") {
+#if defined(__linux__)
+          backend = EthernetTransport::Backend::TPACKET;
+#else
+          NDN_THROW(ConfigFile::Error("face_system.ether.backend: 'tpacket' is only available on Linux"));
+#endif
+        }
+        else {
+          NDN_THROW(ConfigFile::Error("face_system.ether.backend: '" + valueStr +
+                                      "' is not a valid backend, must be 'pcap' or 'tpacket'"));
+        }
+      }
       else if (key == "mcast") {
         mcastConfig.isEnabled = ConfigFile::parseYesNo(pair, "face_system.ether");
       }
@@ -157,10 +176,15 @@ EthernetFactory::doProcessConfig(OptionalConfigSection configSection,
     }
   }
 
+  if (m_backend != backend && (!m_channels.empty() || !m_mcastFaces.empty())) {
+    NFD_LOG_WARN("Backend setting applies to new Ethernet faces only");
+  }
+
   // Even if there's no configuration change, we still need to re-apply configuration because
   // netifs may have changed.
   m_unicastConfig = unicastConfig;
   m_mcastConfig = mcastConfig;
+  m_backend = backend;
   this->applyConfig(context);
 }
 
@@ -251,7 +275,8 @@ EthernetFactory::createMulticastFace(const ndn::net::NetworkInterface& netif,
   opts.allowReassembly = true;
 
   auto linkService = make_unique<GenericLinkService>(opts);
-  auto transport = make_unique<MulticastEthernetTransport>(netif, address, m_mcastConfig.linkType);
+  auto transport = make_unique<MulticastEthernetTransport>(netif, address, m_mcastConfig.linkType,
+                                                           m_backend);
   auto face = make_shared<Face>(std::move(linkService), std::move(transport));
 
   m_mcastFaces[key] = face;
@@ -286,6 +311,7 @@ EthernetFactory::applyUnicastConfigToNetif(const shared_ptr<const ndn::net::Netw
   }
 
   auto channel = this->createChannel(netif, m_unicastConfig.idleTimeout);
+  channel->setTransportBackend(m_backend);
   if (m_unicastConfig.wantListen && !channel->isListening()) {
     try {
       channel->listen(this->addFace, nullptr);
@@ -122,6 +122,9 @@ private:
   };
   MulticastConfig m_mcastConfig;
 
+  /// backend of faces created after the last configuration change
+  EthernetTransport::Backend m_backend = EthernetTransport::Backend::PCAP;
+
   /// (ifname, group) => face
   std::map<std::pair<std::string, ethernet::Address>, shared_ptr<Face>> m_mcastFaces;
 
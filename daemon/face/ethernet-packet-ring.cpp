@@ -0,0 +1,381 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ethernet-packet-ring.hpp"
+#include "ethernet-protocol.hpp"
+
+#include "common/privilege-helper.hpp"
+
+#include <pcap/pcap.h>
+#include <unistd.h>
+
+#include <cerrno>   // for errno
+#include <cstring>  // for memcpy(), memset(), strerror()
+
+#if defined(__linux__)
+#include <arpa/inet.h>        // for htons()
+#include <linux/if_ether.h>   // for ETH_P_ALL
+#include <linux/if_packet.h>  // for TPACKET_V3 structures and struct sockaddr_ll
+#include <linux/filter.h>     // for struct sock_fprog
+#include <net/if.h>           // for if_nametoindex()
+#include <sys/mman.h>         // for mmap()
+#include <sys/socket.h>
+#endif
+
+#if !defined(PCAP_NETMASK_UNKNOWN)
+#define PCAP_NETMASK_UNKNOWN  0xffffffff
+#endif
+
+namespace nfd {
+namespace face {
+
+#if defined(__linux__)
+
+static_assert(sizeof(sock_filter) == sizeof(bpf_insn),
+              "libpcap and kernel BPF instruction layouts differ");
+
+/// offset of the frame data in a transmit ring slot, see packet_mmap documentation
+const size_t TX_DATA_OFFSET = TPACKET_ALIGN(sizeof(tpacket3_hdr));
+
+static size_t
+roundUpToPageSize(size_t n)
+{
+  static const size_t pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+  return (n + pageSize - 1) / pageSize * pageSize;
+}
+
+EthernetPacketRing::EthernetPacketRing(const std::string& interfaceName, const Options& options)
+  : m_options(options)
+{
+  BOOST_ASSERT(options.rxBlockCount > 0);
+  BOOST_ASSERT(options.txFrameCount > 0);
+
+  unsigned int ifIndex = ::if_nametoindex(interfaceName.data());
+  if (ifIndex == 0)
+    NDN_THROW(Error("if_nametoindex(" + interfaceName + "): " + std::strerror(errno)));
+
+  // protocol 0: no frames are received until bind(), i.e., until the rings and filter are set
+  PrivilegeHelper::runElevated([this] {
+    m_fd = ::socket(AF_PACKET, SOCK_RAW, 0);
+  });
+  if (m_fd < 0)
+    NDN_THROW(Error("socket(AF_PACKET): "s + std::strerror(errno)));
+
+  auto fail = [this] (const std::string& what) {
+    std::string msg = what + ": " + std::strerror(errno);
+    close();
+    NDN_THROW(Error(msg));
+  };
+
+  int version = TPACKET_V3;
+  if (::setsockopt(m_fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0)
+    fail("setsockopt(PACKET_VERSION)");
+
+  // skip malformed outgoing frames instead of stalling the transmit ring
+  int discard = 1;
+  if (::setsockopt(m_fd, SOL_PACKET, PACKET_LOSS, &discard, sizeof(discard)) < 0)
+    fail("setsockopt(PACKET_LOSS)");
+
+  // receive ring: frame size is only used by the kernel to validate the request
+  m_rxBlockSize = roundUpToPageSize(std::max(m_options.rxBlockSize, ethernet::HDR_LEN + ndn::MAX_NDN_PACKET_SIZE));
+  tpacket_req3 rxReq{};
+  rxReq.tp_block_size = m_rxBlockSize;
+  rxReq.tp_block_nr = m_options.rxBlockCount;
+  rxReq.tp_frame_size = TPACKET_ALIGNMENT << 7;
+  rxReq.tp_frame_nr = rxReq.tp_block_size / rxReq.tp_frame_size * rxReq.tp_block_nr;
+  rxReq.tp_retire_blk_tov = m_options.rxBlockTimeout;
+  if (::setsockopt(m_fd, SOL_PACKET, PACKET_RX_RING, &rxReq, sizeof(rxReq)) < 0)
+    fail("setsockopt(PACKET_RX_RING)");
+
+  // transmit ring: fixed-size slots that can hold a frame of maximum size;
+  // the kernel places the slots of each block back to back from the block start
+  m_txFrameSize = TPACKET_ALIGN(TX_DATA_OFFSET + ethernet::HDR_LEN + ndn::MAX_NDN_PACKET_SIZE);
+  m_txBlockSize = roundUpToPageSize(m_txFrameSize * 8);
+  m_txFramesPerBlock = m_txBlockSize / m_txFrameSize;
+  size_t txBlockCount = (m_options.txFrameCount + m_txFramesPerBlock - 1) / m_txFramesPerBlock;
+  tpacket_req3 txReq{};
+  txReq.tp_block_size = m_txBlockSize;
+  txReq.tp_block_nr = txBlockCount;
+  txReq.tp_frame_size = m_txFrameSize;
+  txReq.tp_frame_nr = m_txFramesPerBlock * txBlockCount;
+  bool hasTxRing = ::setsockopt(m_fd, SOL_PACKET, PACKET_TX_RING, &txReq, sizeof(txReq)) == 0;
+  if (hasTxRing) {
+    m_txFrameCount = txReq.tp_frame_nr;
+  }
+
+  m_ringSize = m_rxBlockSize * rxReq.tp_block_nr + (hasTxRing ? m_txBlockSize * txBlockCount : 0);
+  void* ring = ::mmap(nullptr, m_ringSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+  if (ring == MAP_FAILED) {
+    m_ringSize = 0;
+    fail("mmap");
+  }
+  m_ring = static_cast<uint8_t*>(ring);
+  if (hasTxRing) {
+    // the transmit ring is mapped right after the receive ring
+    m_txRing = m_ring + m_rxBlockSize * rxReq.tp_block_nr;
+  }
+
+  // the socket is bound by setPacketFilter(), once the filter is in place
+  m_ifIndex = ifIndex;
+}
+
+EthernetPacketRing::~EthernetPacketRing()
+{
+  close();
+}
+
+void
+EthernetPacketRing::close() noexcept
+{
+  if (m_ring != nullptr) {
+    ::munmap(m_ring, m_ringSize);
+    m_ring = nullptr;
+    m_txRing = nullptr;
+  }
+  m_nTxQueued = 0;
+  if (m_fd >= 0) {
+    getNDropped(); // preserve the final statistics
+    ::close(m_fd);
+    m_fd = -1;
+  }
+}
+
+int
+EthernetPacketRing::getFd() const
+{
+  // we need to duplicate the fd, otherwise both close() and the
+  // caller may attempt to close the same fd and one of them will fail
+  int fd = ::dup(m_fd);
+  if (fd < 0)
+    NDN_THROW(Error("dup: "s + std::strerror(errno)));
+  return fd;
+}
+
+void
+EthernetPacketRing::setPacketFilter(const char* filter)
+{
+  pcap_t* dead = pcap_open_dead(DLT_EN10MB, ethernet::HDR_LEN + ndn::MAX_NDN_PACKET_SIZE);
+  if (dead == nullptr)
+    NDN_THROW(Error("pcap_open_dead failed"));
+
+  bpf_program prog;
+  if (pcap_compile(dead, &prog, filter, 1, PCAP_NETMASK_UNKNOWN) < 0) {
+    std::string msg = "pcap_compile: "s + pcap_geterr(dead);
+    pcap_close(dead);
+    NDN_THROW(Error(msg));
+  }
+  pcap_close(dead);
+
+  sock_fprog fprog{};
+  fprog.len = static_cast<unsigned short>(prog.bf_len);
+  fprog.filter = reinterpret_cast<sock_filter*>(prog.bf_insns);
+  int ret = ::setsockopt(m_fd, SOL_SOCKET, SO_ATTACH_FILTER, &fprog, sizeof(fprog));
+  int err = errno;
+  pcap_freecode(&prog);
+  if (ret < 0)
+    NDN_THROW(Error("setsockopt(SO_ATTACH_FILTER): "s + std::strerror(err)));
+
+  if (m_isBound)
+    return;
+
+  // binding only after the filter is attached ensures that no unfiltered frame reaches the ring
+  sockaddr_ll sll{};
+  sll.sll_family = AF_PACKET;
+  sll.sll_protocol = htons(ETH_P_ALL);
+  sll.sll_ifindex = static_cast<int>(m_ifIndex);
+  if (::bind(m_fd, reinterpret_cast<sockaddr*>(&sll), sizeof(sll)) < 0)
+    NDN_THROW(Error("bind: "s + std::strerror(errno)));
+  m_isBound = true;
+}
+
+size_t
+EthernetPacketRing::receive(const std::function<void(span<const uint8_t>)>& receiveFrame)
+{
+  size_t nFrames = 0;
+  while (m_ring != nullptr) {
+    auto block = reinterpret_cast<tpacket_block_desc*>(m_ring + m_rxBlockIndex * m_rxBlockSize);
+    if ((__atomic_load_n(&block->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER) == 0) {
+      break;
+    }
+
+    const uint8_t* pos = reinterpret_cast<const uint8_t*>(block) + block->hdr.bh1.offset_to_first_pkt;
+    for (uint32_t i = 0; i < block->hdr.bh1.num_pkts; ++i) {
+      auto hdr = reinterpret_cast<const tpacket3_hdr*>(pos);
+      auto sll = reinterpret_cast<const sockaddr_ll*>(pos + TPACKET_ALIGN(sizeof(tpacket3_hdr)));
+      // equivalent of pcap_setdirection(PCAP_D_IN)
+      if (sll->sll_pkttype != PACKET_OUTGOING) {
+        ++nFrames;
+        receiveFrame({pos + hdr->tp_mac, hdr->tp_snaplen});
+        if (m_ring == nullptr) {
+          // closed by the callback, the block is no longer mapped
+          return nFrames;
+        }
+      }
+      pos += hdr->tp_next_offset;
+    }
+
+    // return the block to the kernel
+    __atomic_store_n(&block->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+    m_rxBlockIndex = (m_rxBlockIndex + 1) % m_options.rxBlockCount;
+  }
+  return nFrames;
+}
+
+uint8_t*
+EthernetPacketRing::getTxFrame(size_t index) const
+{
+  return m_txRing + (index / m_txFramesPerBlock) * m_txBlockSize +
+                    (index % m_txFramesPerBlock) * m_txFrameSize;
+}
+
+bool
+EthernetPacketRing::enqueue(span<const uint8_t> header, span<const uint8_t> payload, size_t minPayloadSize)
+{
+  size_t paddingSize = payload.size() < minPayloadSize ? minPayloadSize - payload.size() : 0;
+
+  if (m_txRing == nullptr) {
+    if (m_fd < 0) {
+      errno = EBADF;
+      return false;
+    }
+    static const uint8_t padding[ethernet::MIN_DATA_LEN] = {};
+    iovec iov[3] = {
+      {const_cast<uint8_t*>(header.data()), header.size()},
+      {const_cast<uint8_t*>(payload.data()), payload.size()},
+      {const_cast<uint8_t*>(padding), std::min(paddingSize, sizeof(padding))},
+    };
+    msghdr msg{};
+    msg.msg_iov = iov;
+    msg.msg_iovlen = paddingSize > 0 ? 3 : 2;
+    return ::sendmsg(m_fd, &msg, MSG_DONTWAIT) >= 0;
+  }
+
+  size_t frameSize = header.size() + payload.size() + paddingSize;
+  if (TX_DATA_OFFSET + frameSize > m_txFrameSize) {
+    errno = EMSGSIZE;
+    return false;
+  }
+
+  uint8_t* frame = getTxFrame(m_txFrameIndex);
+  auto hdr = reinterpret_cast<tpacket3_hdr*>(frame);
+  if (__atomic_load_n(&hdr->tp_status, __ATOMIC_ACQUIRE) != TP_STATUS_AVAILABLE) {
+    // the kernel has not transmitted the frame previously queued in this slot yet
+    errno = ENOBUFS;
+    return false;
+  }
+
+  uint8_t* data = frame + TX_DATA_OFFSET;
+  std::memcpy(data, header.data(), header.size());
+  std::memcpy(data + header.size(), payload.data(), payload.size());
+  std::memset(data + header.size() + payload.size(), 0, paddingSize);
+  hdr->tp_len = frameSize;
+  hdr->tp_snaplen = frameSize;
+  hdr->tp_next_offset = 0;
+  __atomic_store_n(&hdr->tp_status, TP_STATUS_SEND_REQUEST, __ATOMIC_RELEASE);
+
+  m_txFrameIndex = (m_txFrameIndex + 1) % m_txFrameCount;
+  ++m_nTxQueued;
+  return true;
+}
+
+bool
+EthernetPacketRing::flush() noexcept
+{
+  if (m_nTxQueued == 0)
+    return true;
+
+  m_nTxQueued = 0;
+  // with MSG_DONTWAIT, the kernel transmits the queued frames without waiting for completions
+  if (::send(m_fd, nullptr, 0, MSG_DONTWAIT) < 0 && errno != EAGAIN && errno != ENOBUFS)
+    return false;
+  return true;
+}
+
+size_t
+EthernetPacketRing::getNDropped() const
+{
+  if (m_fd >= 0) {
+    // the kernel resets the statistics every time they are read
+    tpacket_stats_v3 stats{};
+    socklen_t len = sizeof(stats);
+    if (::getsockopt(m_fd, SOL_PACKET, PACKET_STATISTICS, &stats, &len) == 0)
+      m_nDropped += stats.tp_drops;
+  }
+  return m_nDropped;
+}
+
+#else // __linux__
+
+EthernetPacketRing::EthernetPacketRing(const std::string&, const Options&)
+{
+  NDN_THROW(Error("TPACKET_V3 rings are only available on Linux"));
+}
+
+EthernetPacketRing::~EthernetPacketRing() = default;
+
+void
+EthernetPacketRing::close() noexcept
+{
+}
+
+int
+EthernetPacketRing::getFd() const
+{
+  return -1;
+}
+
+void
+EthernetPacketRing::setPacketFilter(const char*)
+{
+}
+
+size_t
+EthernetPacketRing::receive(const std::function<void(span<const uint8_t>)>&)
+{
+  return 0;
+}
+
+bool
+EthernetPacketRing::enqueue(span<const uint8_t>, span<const uint8_t>, size_t)
+{
+  return false;
+}
+
+bool
+EthernetPacketRing::flush() noexcept
+{
+  return false;
+}
+
+size_t
+EthernetPacketRing::getNDropped() const
+{
+  return 0;
+}
+
+#endif // __linux__
+
+} // namespace face
+} // namespace nfd
@@ -0,0 +1,175 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_ETHERNET_PACKET_RING_HPP
+#define NFD_DAEMON_FACE_ETHERNET_PACKET_RING_HPP
+
+#include "core/common.hpp"
+
+namespace nfd {
+namespace face {
+
+/**
+ * @brief AF_PACKET socket with memory-mapped TPACKET_V3 receive and transmit rings.
+ *
+ * The kernel fills each receive block with as many frames as fit, and hands the block over
+ * when it is full or when its timeout expires. One wakeup can therefore process a whole block
+ * of frames without a system call per frame. Outgoing frames are copied into slots of the
+ * transmit ring and handed to the kernel together by flush().
+ *
+ * This is available on Linux only; on other platforms the constructor always throws.
+ */
+class EthernetPacketRing : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  struct Options
+  {
+    /// size of each receive block, rounded up to a multiple of the page size
+    size_t rxBlockSize = 256 * 1024;
+    /// number of receive blocks
+    size_t rxBlockCount = 16;
+    /// how long (in milliseconds) the kernel may hold a partially filled receive block
+    unsigned int rxBlockTimeout = 1;
+    /// number of frame slots in the transmit ring
+    size_t txFrameCount = 256;
+  };
+
+  /**
+   * @brief Open an AF_PACKET socket on a network interface and map its rings.
+   *
+   * If the kernel does not support a TPACKET_V3 transmit ring (Linux < 4.11),
+   * frames are sent with one system call each.
+   *
+   * @throw Error on any error
+   */
+  EthernetPacketRing(const std::string& interfaceName, const Options& options);
+
+  explicit
+  EthernetPacketRing(const std::string& interfaceName)
+    : EthernetPacketRing(interfaceName, Options{})
+  {
+  }
+
+  ~EthernetPacketRing();
+
+  /**
+   * @brief Unmap the rings and close the socket.
+   */
+  void
+  close() noexcept;
+
+  /**
+   * @brief Obtain a file descriptor that can be used in calls such as select(2) and poll(2).
+   * @return A selectable file descriptor. It is the caller's responsibility to close the fd.
+   * @throw Error on any error
+   */
+  int
+  getFd() const;
+
+  /**
+   * @brief Install a BPF filter on the socket.
+   * @param filter Null-terminated string containing the filter expression, see pcap-filter(7).
+   *
+   * The expression is compiled by libpcap, so the installed program is the same one
+   * that PcapHelper::setPacketFilter would install.
+   *
+   * The socket is bound to the interface by the first call, after the filter is attached,
+   * so no frames are received before a filter is installed.
+   *
+   * @throw Error on any error
+   */
+  void
+  setPacketFilter(const char* filter);
+
+  /**
+   * @brief Process every frame in the receive blocks that are ready.
+   * @param receiveFrame Called once per incoming frame with the frame bytes, including the
+   *                     link-layer header. The span is valid only during the call.
+   *                     It may call close(), which stops the processing.
+   * @return Number of frames processed.
+   */
+  size_t
+  receive(const std::function<void(span<const uint8_t>)>& receiveFrame);
+
+  /**
+   * @brief Copy a frame into the next slot of the transmit ring.
+   * @param header Link-layer header
+   * @param payload Frame payload, zero-padded to @p minPayloadSize if shorter
+   * @return Whether the frame was queued. On failure, errno is set to ENOBUFS if the
+   *         transmit ring is full, or to another value describing the error.
+   * @note Queued frames are not sent until flush() is called.
+   */
+  bool
+  enqueue(span<const uint8_t> header, span<const uint8_t> payload, size_t minPayloadSize);
+
+  /**
+   * @brief Ask the kernel to transmit every queued frame with a single system call.
+   * @return Whether the request succeeded. On failure, errno describes the error.
+   */
+  bool
+  flush() noexcept;
+
+  /**
+   * @brief Get the number of frames dropped by the kernel since the socket was opened.
+   */
+  size_t
+  getNDropped() const;
+
+private:
+  uint8_t*
+  getTxFrame(size_t index) const;
+
+private:
+  Options m_options;
+  int m_fd = -1;
+  unsigned int m_ifIndex = 0;
+  bool m_isBound = false;
+  uint8_t* m_ring = nullptr;
+  size_t m_ringSize = 0;
+
+  size_t m_rxBlockSize = 0;
+  size_t m_rxBlockIndex = 0;
+
+  uint8_t* m_txRing = nullptr; ///< nullptr if the transmit ring is unavailable
+  size_t m_txBlockSize = 0;
+  size_t m_txFrameSize = 0;
+  size_t m_txFramesPerBlock = 0;
+  size_t m_txFrameCount = 0;
+  size_t m_txFrameIndex = 0;
+  size_t m_nTxQueued = 0;
+
+  mutable size_t m_nDropped = 0;
+};
+
+} // namespace face
+} // namespace nfd
+
+#endif // NFD_DAEMON_FACE_ETHERNET_PACKET_RING_HPP
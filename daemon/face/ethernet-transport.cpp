@@ -29,7 +29,8 @@
 
 #include <pcap/pcap.h>
 
-#include <cstring> // for memcpy()
+#include <cerrno>  // for errno
+#include <cstring> // for memcpy(), strerror()
 
 #include <boost/endian/conversion.hpp>
 
@@ -39,7 +40,8 @@ namespace face {
 NFD_LOG_INIT(EthernetTransport);
 
 EthernetTransport::EthernetTransport(const ndn::net::NetworkInterface& localEndpoint,
-                                     const ethernet::Address& remoteEndpoint)
+                                     const ethernet::Address& remoteEndpoint,
+                                     Backend backend)
   : m_socket(getGlobalIoService())
   , m_pcap(localEndpoint.getName())
   , m_srcAddress(localEndpoint.getEthernetAddress())
@@ -51,12 +53,22 @@ EthernetTransport::EthernetTransport(const ndn::net::NetworkInterface& localEndp
 #endif
 {
   try {
-    m_pcap.activate(DLT_EN10MB);
-    m_socket.assign(m_pcap.getFd());
+    if (backend == Backend::TPACKET) {
+      m_ring = make_unique<EthernetPacketRing>(m_interfaceName);
+      m_pcap.close();
+      m_socket.assign(m_ring->getFd());
+    }
+    else {
+      m_pcap.activate(DLT_EN10MB);
+      m_socket.assign(m_pcap.getFd());
+    }
   }
   catch (const PcapHelper::Error& e) {
     NDN_THROW_NESTED(Error(e.what()));
   }
+  catch (const EthernetPacketRing::Error& e) {
+    NDN_THROW_NESTED(Error(e.what()));
+  }
 
   // Set initial transport state based upon the state of the underlying NetworkInterface
   handleNetifStateChange(localEndpoint.getState());
@@ -87,6 +99,9 @@ EthernetTransport::doClose()
     m_socket.close(error);
   }
   m_pcap.close();
+  if (m_ring) {
+    m_ring->close();
+  }
 
   // Ensure that the Transport stays alive at least
   // until all pending handlers are dispatched
@@ -95,6 +110,25 @@ EthernetTransport::doClose()
   });
 }
 
+void
+EthernetTransport::setPacketFilter(const char* filter)
+{
+  try {
+    if (m_ring) {
+      m_ring->setPacketFilter(filter);
+    }
+    else {
+      m_pcap.setPacketFilter(filter);
+    }
+  }
+  catch (const PcapHelper::Error& e) {
+    NDN_THROW_NESTED(Error(e.what()));
+  }
+  catch (const EthernetPacketRing::Error& e) {
+    NDN_THROW_NESTED(Error(e.what()));
+  }
+}
+
 void
 EthernetTransport::handleNetifStateChange(ndn::net::InterfaceState netifState)
 {
@@ -120,6 +154,36 @@ EthernetTransport::doSend(const Block& packet)
 void
 EthernetTransport::sendPacket(const ndn::Block& block)
 {
+  if (m_ring) {
+    uint8_t header[ethernet::HDR_LEN];
+    uint16_t ethertype = boost::endian::native_to_big(ethernet::ETHERTYPE_NDN);
+    std::memcpy(header, m_destAddress.data(), ethernet::ADDR_LEN);
+    std::memcpy(header + ethernet::ADDR_LEN, m_srcAddress.data(), ethernet::ADDR_LEN);
+    std::memcpy(header + 2 * ethernet::ADDR_LEN, &ethertype, ethernet::TYPE_LEN);
+
+    auto payload = ndn::make_span(block.data(), block.size());
+    bool isQueued = m_ring->enqueue(header, payload, ethernet::MIN_DATA_LEN);
+    if (!isQueued && errno == ENOBUFS) {
+      // the transmit ring is full: hand the queued frames to the kernel and retry once
+      isQueued = m_ring->flush() && m_ring->enqueue(header, payload, ethernet::MIN_DATA_LEN);
+    }
+    if (!isQueued) {
+      if (errno == ENOBUFS)
+        NFD_LOG_FACE_DEBUG("Transmit ring is full, dropping frame");
+      else
+        handleError("Send operation failed: "s + std::strerror(errno));
+      return;
+    }
+
+    NFD_LOG_FACE_TRACE("Queued for sending: " << block.size() << " bytes");
+    // frames queued during the same event loop iteration are sent with one system call
+    if (!m_isFlushPending) {
+      m_isFlushPending = true;
+      getGlobalIoService().post([this] { flushRing(); });
+    }
+    return;
+  }
+
   ndn::EncodingBuffer buffer(block);
 
   // pad with zeroes if the payload is too short
@@ -146,6 +210,14 @@ EthernetTransport::sendPacket(const ndn::Block& block)
     NFD_LOG_FACE_TRACE("Successfully sent: " << block.size() << " bytes");
 }
 
+void
+EthernetTransport::flushRing()
+{
+  m_isFlushPending = false;
+  if (!m_ring->flush())
+    handleError("Send operation failed: "s + std::strerror(errno));
+}
+
 void
 EthernetTransport::asyncRead()
 {
@@ -168,29 +240,26 @@ EthernetTransport::handleRead(const boost::system::error_code& error)
     return;
   }
 
-  span<const uint8_t> pkt;
-  std::string err;
-  std::tie(pkt, err) = m_pcap.readNextPacket();
-
-  if (pkt.empty()) {
-    NFD_LOG_FACE_WARN("Read error: " << err);
+  if (m_ring) {
+    // process every frame in the blocks handed over by the kernel
+    size_t nFrames = m_ring->receive([this] (span<const uint8_t> frame) { processFrame(frame); });
+    NFD_LOG_FACE_TRACE("Processed " << nFrames << " frame(s)");
   }
   else {
-    const ether_header* eh;
-    std::tie(eh, err) = ethernet::checkFrameHeader(pkt, m_srcAddress,
-                                                   m_destAddress.isMulticast() ? m_destAddress : m_srcAddress);
-    if (eh == nullptr) {
-      NFD_LOG_FACE_WARN(err);
+    span<const uint8_t> pkt;
+    std::string err;
+    std::tie(pkt, err) = m_pcap.readNextPacket();
+
+    if (pkt.empty()) {
+      NFD_LOG_FACE_WARN("Read error: " << err);
     }
     else {
-      ethernet::Address sender(eh->ether_shost);
-      pkt = pkt.subspan(ethernet::HDR_LEN);
-      receivePayload(pkt, sender);
+      processFrame(pkt);
     }
   }
 
 #ifdef _DEBUG
-  size_t nDropped = m_pcap.getNDropped();
+  size_t nDropped = m_ring ? m_ring->getNDropped() : m_pcap.getNDropped();
   if (nDropped - m_nDropped > 0)
     NFD_LOG_FACE_DEBUG("Detected " << nDropped - m_nDropped << " dropped frame(s)");
   m_nDropped = nDropped;
@@ -199,6 +268,22 @@ EthernetTransport::handleRead(const boost::system::error_code& error)
   asyncRead();
 }
 
+void
+EthernetTransport::processFrame(span<const uint8_t> frame)
+{
+  const ether_header* eh;
+  std::string err;
+  std::tie(eh, err) = ethernet::checkFrameHeader(frame, m_srcAddress,
+                                                 m_destAddress.isMulticast() ? m_destAddress : m_srcAddress);
+  if (eh == nullptr) {
+    NFD_LOG_FACE_WARN(err);
+  }
+  else {
+    ethernet::Address sender(eh->ether_shost);
+    receivePayload(frame.subspan(ethernet::HDR_LEN), sender);
+  }
+}
+
 void
 EthernetTransport::receivePayload(span<const uint8_t> payload, const ethernet::Address& sender)
 {
@@ -212,6 +297,7 @@ EthernetTransport::receivePayload(span<const uint8_t> payload, const ethernet::A
     // This packet won't extend the face lifetime
     return;
   }
+  ++this->nInPacketCopies;
   m_hasRecentlyReceived = true;
 
   static_assert(sizeof(EndpointId) >= ethernet::ADDR_LEN, "EndpointId is too small");
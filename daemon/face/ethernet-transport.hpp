@@ -26,6 +26,7 @@
 #ifndef NFD_DAEMON_FACE_ETHERNET_TRANSPORT_HPP
 #define NFD_DAEMON_FACE_ETHERNET_TRANSPORT_HPP
 
+#include "ethernet-packet-ring.hpp"
 #include "ethernet-protocol.hpp"
 #include "pcap-helper.hpp"
 #include "transport.hpp"
@@ -47,6 +48,14 @@ public:
     using std::runtime_error::runtime_error;
   };
 
+  /**
+   * @brief Mechanism used to send and receive frames
+   */
+  enum class Backend {
+    PCAP,    ///< libpcap, one system call per frame
+    TPACKET, ///< memory-mapped TPACKET_V3 rings, see EthernetPacketRing (Linux only)
+  };
+
   /**
    * @brief Processes the payload of an incoming frame
    * @param payload Payload bytes, starting from the first byte after the Ethernet header
@@ -57,11 +66,20 @@ public:
 
 protected:
   EthernetTransport(const ndn::net::NetworkInterface& localEndpoint,
-                    const ethernet::Address& remoteEndpoint);
+                    const ethernet::Address& remoteEndpoint,
+                    Backend backend = Backend::PCAP);
 
   void
   doClose() final;
 
+  /**
+   * @brief Install a BPF filter on the receiving socket of the selected backend.
+   * @param filter Null-terminated string containing the BPF program source, see pcap-filter(7).
+   * @throw Error on any error
+   */
+  void
+  setPacketFilter(const char* filter);
+
   bool
   hasRecentlyReceived() const
   {
@@ -93,12 +111,19 @@ private:
   void
   handleRead(const boost::system::error_code& error);
 
+  void
+  processFrame(span<const uint8_t> frame);
+
+  void
+  flushRing();
+
   void
   handleError(const std::string& errorMessage);
 
 protected:
   boost::asio::posix::stream_descriptor m_socket;
   PcapHelper m_pcap;
+  unique_ptr<EthernetPacketRing> m_ring; ///< non-null if the TPACKET backend is used
   ethernet::Address m_srcAddress;
   ethernet::Address m_destAddress;
   std::string m_interfaceName;
@@ -107,8 +132,9 @@ private:
   signal::ScopedConnection m_netifStateChangedConn;
   signal::ScopedConnection m_netifMtuChangedConn;
   bool m_hasRecentlyReceived;
+  bool m_isFlushPending = false;
 #ifdef _DEBUG
-  /// number of frames dropped by the kernel, as reported by libpcap
+  /// number of frames dropped by the kernel, as reported by libpcap or EthernetPacketRing
   size_t m_nDropped;
 #endif
 };
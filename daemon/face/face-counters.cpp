@@ -41,6 +41,8 @@ FaceCounters::FaceCounters(const LinkService::Counters& linkServiceCounters,
   , nOutPackets(transportCounters.nOutPackets)
   , nInBytes(transportCounters.nInBytes)
   , nOutBytes(transportCounters.nOutBytes)
+  , nInPacketCopies(transportCounters.nInPacketCopies)
+  , nInBufferAllocations(transportCounters.nInBufferAllocations)
   , m_linkServiceCounters(linkServiceCounters)
   , m_transportCounters(transportCounters)
 {
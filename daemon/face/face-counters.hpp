@@ -80,6 +80,8 @@ public:
   const PacketCounter& nOutPackets;
   const ByteCounter& nInBytes;
   const ByteCounter& nOutBytes;
+  const PacketCounter& nInPacketCopies;
+  const PacketCounter& nInBufferAllocations;
 
   /** \brief count of incoming Interests dropped due to HopLimit == 0
    */
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2014-2021,  Regents of the University of California,
+ * Copyright (c) 2014-2022,  Regents of the University of California,
  *                           Arizona Board of Regents,
  *                           Colorado State University,
  *                           University Pierre & Marie Curie, Sorbonne University,
@@ -219,7 +219,8 @@ GenericLinkService::sendNetPacket(lp::Packet&& pkt, bool isInterest)
 
   if (m_options.allowFragmentation && mtu != MTU_UNLIMITED) {
     bool isOk = false;
-    std::tie(isOk, frags) = m_fragmenter.fragmentPacket(pkt, mtu);
+    // fragments are encoded with their sequence numbers, so that they need not be encoded again
+    std::tie(isOk, frags) = m_fragmenter.fragmentPacket(pkt, mtu, m_lastSeqNo + 1);
     if (!isOk) {
       // fragmentation failed (warning is logged by LpFragmenter)
       ++nFragmentationErrors;
@@ -243,8 +244,11 @@ GenericLinkService::sendNetPacket(lp::Packet&& pkt, bool isInterest)
   }
 
   // Only assign sequences to fragments if reliability enabled or if packet contains >1 fragment
-  if (m_options.reliabilityOptions.isEnabled || frags.size() > 1) {
-    // Assign sequences to all fragments
+  if (frags.size() > 1) {
+    // sequences have been assigned by the fragmenter
+    m_lastSeqNo += frags.size();
+  }
+  else if (m_options.reliabilityOptions.isEnabled) {
     this->assignSequences(frags);
   }
 
@@ -306,6 +310,14 @@ void
 GenericLinkService::doReceivePacket(const Block& packet, const EndpointId& endpoint)
 {
   try {
+    if (packet.type() == tlv::Interest || packet.type() == tlv::Data) {
+      // a bare network packet has no NDNLPv2 fields, so it is decoded in place
+      // instead of being wrapped in an LpPacket, which would copy it
+      static const lp::Packet noLpFields;
+      this->decodeNetPacket(packet, noLpFields, endpoint);
+      return;
+    }
+
     lp::Packet pkt(packet);
 
     if (m_options.reliabilityOptions.isEnabled) {
@@ -62,6 +62,7 @@ public:
   SizeCounter<LpReassembler> nReassembling;
 
   /** \brief count of dropped partial network-layer packets due to reassembly timeout
+   *         or to the limit on partial packets
    */
   PacketCounter nReassemblyTimeouts;
 
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2014-2018,  Regents of the University of California,
+ * Copyright (c) 2014-2022,  Regents of the University of California,
  *                           Arizona Board of Regents,
  *                           Colorado State University,
  *                           University Pierre & Marie Curie, Sorbonne University,
@@ -26,6 +26,7 @@
 #include "lp-fragmenter.hpp"
 #include "link-service.hpp"
 
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
 #include <ndn-cxx/encoding/tlv.hpp>
 
 namespace nfd {
@@ -57,6 +58,33 @@ static const size_t MAX_FRAG_OVERHEAD =
   1 + 1 + 8 + // FragCount TLV
   1 + 9; // Fragment TLV-TYPE and TLV-LENGTH
 
+/** \brief encodes an LpPacket with the header fields of \p header,
+ *         and a Fragment field containing [fragBegin, fragEnd)
+ *
+ *  The payload is copied once, directly into the wire encoding of the returned packet.
+ */
+static lp::Packet
+encodeFragment(const lp::Packet& header,
+               ndn::Buffer::const_iterator fragBegin, ndn::Buffer::const_iterator fragEnd)
+{
+  const Block& headerWire = header.wireEncode();
+  size_t fragSize = static_cast<size_t>(std::distance(fragBegin, fragEnd));
+  size_t valueSize = headerWire.value_size() +
+                     tlv::sizeOfVarNumber(lp::tlv::Fragment) + tlv::sizeOfVarNumber(fragSize) +
+                     fragSize;
+
+  ndn::EncodingBuffer encoder(tlv::sizeOfVarNumber(lp::tlv::LpPacket) +
+                              tlv::sizeOfVarNumber(valueSize) + valueSize, 0);
+  encoder.prependRange(fragBegin, fragEnd);
+  encoder.prependVarNumber(fragSize);
+  encoder.prependVarNumber(lp::tlv::Fragment);
+  // header fields are already in the order required by LpPacket, and precede the Fragment field
+  encoder.prependRange(headerWire.value_begin(), headerWire.value_end());
+  encoder.prependVarNumber(valueSize);
+  encoder.prependVarNumber(lp::tlv::LpPacket);
+  return lp::Packet(encoder.block());
+}
+
 LpFragmenter::LpFragmenter(const LpFragmenter::Options& options, const LinkService* linkService)
   : m_options(options)
   , m_linkService(linkService)
@@ -76,7 +104,7 @@ LpFragmenter::getLinkService() const
 }
 
 std::tuple<bool, std::vector<lp::Packet>>
-LpFragmenter::fragmentPacket(const lp::Packet& packet, size_t mtu)
+LpFragmenter::fragmentPacket(const lp::Packet& packet, size_t mtu, optional<lp::Sequence> firstSeq)
 {
   BOOST_ASSERT(packet.has<lp::FragmentField>());
   BOOST_ASSERT(!packet.has<lp::FragIndexField>());
@@ -121,17 +149,24 @@ LpFragmenter::fragmentPacket(const lp::Packet& packet, size_t mtu)
   }
 
   // populate fragments
-  std::vector<lp::Packet> frags(fragCount);
-  frags.front() = packet; // copy input packet to preserve other NDNLPv2 fields
+  std::vector<lp::Packet> frags;
+  frags.reserve(fragCount);
   size_t fragIndex = 0;
   auto fragBegin = netPktBegin,
        fragEnd = fragBegin + firstPayloadSize;
   while (fragBegin < netPktEnd) {
-    lp::Packet& frag = frags[fragIndex];
-    frag.add<lp::FragIndexField>(fragIndex);
-    frag.add<lp::FragCountField>(fragCount);
-    frag.set<lp::FragmentField>({fragBegin, fragEnd});
-    BOOST_ASSERT(frag.wireEncode().size() <= mtu);
+    lp::Packet header;
+    if (fragIndex == 0) {
+      header = packet; // copy input packet to preserve other NDNLPv2 fields
+      header.remove<lp::FragmentField>();
+    }
+    if (firstSeq) {
+      header.set<lp::SequenceField>(*firstSeq + fragIndex);
+    }
+    header.add<lp::FragIndexField>(fragIndex);
+    header.add<lp::FragCountField>(fragCount);
+    frags.push_back(encodeFragment(header, fragBegin, fragEnd));
+    BOOST_ASSERT(frags.back().wireEncode().size() <= mtu);
 
     ++fragIndex;
     fragBegin = fragEnd;
@@ -139,7 +174,7 @@ LpFragmenter::fragmentPacket(const lp::Packet& packet, size_t mtu)
   }
   BOOST_ASSERT(fragIndex == fragCount);
 
-  return std::make_tuple(true, frags);
+  return std::make_tuple(true, std::move(frags));
 }
 
 std::ostream&
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2014-2019,  Regents of the University of California,
+ * Copyright (c) 2014-2022,  Regents of the University of California,
  *                           Arizona Board of Regents,
  *                           Colorado State University,
  *                           University Pierre & Marie Curie, Sorbonne University,
@@ -67,10 +67,16 @@ public:
    *  \param packet an LpPacket that contains a network-layer packet;
    *                must have Fragment field, must not have FragIndex and FragCount fields
    *  \param mtu maximum allowable LpPacket size after fragmentation and sequence number assignment
-   *  \return whether fragmentation succeeded, fragmented packets without sequence number
+   *  \param firstSeq if the packet is fragmented and this is set, fragments are assigned
+   *                  consecutive sequence numbers starting from \p firstSeq
+   *  \return whether fragmentation succeeded, fragmented packets
+   *
+   *  Each fragment is encoded once, with its payload copied directly from \p packet, so that
+   *  sending it does not require encoding it again unless more fields are added.
+   *  If the packet is not fragmented, it is returned unchanged without sequence number.
    */
   std::tuple<bool, std::vector<lp::Packet>>
-  fragmentPacket(const lp::Packet& packet, size_t mtu);
+  fragmentPacket(const lp::Packet& packet, size_t mtu, optional<lp::Sequence> firstSeq = nullopt);
 
 private:
   Options m_options;
@@ -25,9 +25,10 @@
 
 #include "lp-reassembler.hpp"
 #include "link-service.hpp"
+#include "receive-buffer-pool.hpp"
 #include "common/global.hpp"
 
-#include <numeric>
+#include <algorithm>
 
 namespace nfd {
 namespace face {
@@ -70,6 +71,16 @@ LpReassembler::receiveFragment(EndpointId remoteEndpoint, const lp::Packet& pack
   // check for fast path
   if (fragIndex == 0 && fragCount == 1) {
     auto frag = packet.get<lp::FragmentField>();
+    // share the buffer of the received LpPacket, if the fragment lies within it and covers
+    // enough of it; otherwise copy, so that a retained packet does not pin the whole buffer
+    auto buffer = packet.wireEncode().getBuffer();
+    if (buffer != nullptr && frag.first != frag.second &&
+        canShareReceiveBuffer(static_cast<size_t>(frag.second - frag.first), buffer->size()) &&
+        std::less_equal<const uint8_t*>()(buffer->data(), &*frag.first) &&
+        std::less_equal<const uint8_t*>()(&*frag.first + (frag.second - frag.first),
+                                          buffer->data() + buffer->size())) {
+      return {true, Block(buffer, frag.first, frag.second), packet};
+    }
     Block netPkt({frag.first, frag.second});
     return {true, netPkt, packet};
   }
@@ -80,78 +91,170 @@ LpReassembler::receiveFragment(EndpointId remoteEndpoint, const lp::Packet& pack
     return FALSE_RETURN;
   }
   lp::Sequence messageIdentifier = packet.get<lp::SequenceField>() - fragIndex;
-  Key key = std::make_tuple(remoteEndpoint, messageIdentifier);
+  auto frag = packet.get<lp::FragmentField>();
+  size_t fragSize = static_cast<size_t>(std::distance(frag.first, frag.second));
 
-  // add to PartialPacket
-  PartialPacket& pp = m_partialPackets[key];
-  if (pp.fragCount == 0) { // new PartialPacket
-    pp.fragCount = fragCount;
-    pp.nReceivedFragments = 0;
-    pp.fragments.resize(fragCount);
+  // find or allocate PartialPacket
+  size_t index = findPartialPacket(remoteEndpoint, messageIdentifier);
+  if (index == m_nPartialPackets) {
+    index = allocatePartialPacket(remoteEndpoint, messageIdentifier, fragCount, fragSize);
   }
-  else {
-    if (fragCount != pp.fragCount) {
-      NFD_LOG_FACE_WARN("reassembly error, FragCount changed: DROP");
-      return FALSE_RETURN;
-    }
+  else if (fragCount != m_partialPackets[index].fragCount) {
+    NFD_LOG_FACE_WARN("reassembly error, FragCount changed: DROP");
+    return FALSE_RETURN;
   }
+  PartialPacket& pp = m_partialPackets[index];
 
-  if (pp.fragments[fragIndex].has<lp::SequenceField>()) {
+  FragmentRange& range = pp.fragments[fragIndex];
+  if (range.isReceived) {
     NFD_LOG_FACE_TRACE("fragment already received: DROP");
     return FALSE_RETURN;
   }
 
-  pp.fragments[fragIndex] = packet;
+  // append fragment payload to the contiguous buffer
+  range.begin = pp.payload->size();
+  pp.payload->insert(pp.payload->end(), frag.first, frag.second);
+  range.end = pp.payload->size();
+  range.isReceived = true;
+  pp.isInOrder = pp.isInOrder && fragIndex == pp.nReceivedFragments;
+  if (fragIndex == 0) {
+    pp.firstFragment = packet;
+  }
   ++pp.nReceivedFragments;
 
   // check complete condition
   if (pp.nReceivedFragments == pp.fragCount) {
-    Block reassembled = doReassembly(key);
-    lp::Packet firstFrag(std::move(pp.fragments[0]));
-    m_partialPackets.erase(key);
-    return std::make_tuple(true, reassembled, firstFrag);
+    lp::Packet firstFrag(std::move(pp.firstFragment));
+    auto reassembled = doReassembly(pp);
+    releasePartialPacket(index);
+    return std::make_tuple(true, Block(std::move(reassembled)), firstFrag);
   }
 
-  // set drop timer
-  pp.dropTimer = getScheduler().schedule(m_options.reassemblyTimeout, [=] { timeoutPartialPacket(key); });
+  // (re)set expiry
+  pp.expiry = time::steady_clock::now() + m_options.reassemblyTimeout;
+  startTimeoutTimer(pp.expiry);
 
   return FALSE_RETURN;
 }
 
-Block
-LpReassembler::doReassembly(const Key& key)
+size_t
+LpReassembler::findPartialPacket(EndpointId remoteEndpoint, lp::Sequence messageIdentifier) const
+{
+  for (size_t i = 0; i < m_nPartialPackets; ++i) {
+    const PartialPacket& pp = m_partialPackets[i];
+    if (pp.messageIdentifier == messageIdentifier && pp.remoteEndpoint == remoteEndpoint) {
+      return i;
+    }
+  }
+  return m_nPartialPackets;
+}
+
+size_t
+LpReassembler::allocatePartialPacket(EndpointId remoteEndpoint, lp::Sequence messageIdentifier,
+                                     size_t fragCount, size_t fragSize)
 {
-  PartialPacket& pp = m_partialPackets[key];
+  if (m_nPartialPackets == m_partialPackets.size()) {
+    if (m_partialPackets.size() < std::max<size_t>(m_options.nMaxPartialPackets, 1)) {
+      m_partialPackets.emplace_back();
+    }
+    else {
+      auto oldest = std::min_element(m_partialPackets.begin(), m_partialPackets.end(),
+        [] (const PartialPacket& a, const PartialPacket& b) { return a.expiry < b.expiry; });
+      NFD_LOG_FACE_WARN("too many partial packets, dropping one with "
+                        << oldest->nReceivedFragments << " of " << oldest->fragCount
+                        << " fragments");
+      dropPartialPacket(static_cast<size_t>(std::distance(m_partialPackets.begin(), oldest)));
+    }
+  }
+
+  size_t index = m_nPartialPackets++;
+  PartialPacket& pp = m_partialPackets[index];
+  pp.remoteEndpoint = remoteEndpoint;
+  pp.messageIdentifier = messageIdentifier;
+  pp.fragCount = fragCount;
+  pp.nReceivedFragments = 0;
+  pp.isInOrder = true;
+  pp.fragments.assign(fragCount, FragmentRange{});
 
-  size_t payloadSize = std::accumulate(pp.fragments.begin(), pp.fragments.end(), 0U,
-    [&] (size_t sum, const lp::Packet& pkt) -> size_t {
-      ndn::Buffer::const_iterator fragBegin, fragEnd;
-      std::tie(fragBegin, fragEnd) = pkt.get<lp::FragmentField>();
-      return sum + std::distance(fragBegin, fragEnd);
-    });
+  if (pp.payload == nullptr) {
+    pp.payload = make_shared<ndn::Buffer>();
+  }
+  pp.payload->clear();
+  // fragments other than the last one usually have the same size;
+  // the estimate is capped, as a well-formed network-layer packet cannot be larger
+  pp.payload->reserve(std::min(fragCount * fragSize, ndn::MAX_NDN_PACKET_SIZE));
+  return index;
+}
+
+void
+LpReassembler::releasePartialPacket(size_t index)
+{
+  BOOST_ASSERT(index < m_nPartialPackets);
+  --m_nPartialPackets;
+  if (index != m_nPartialPackets) {
+    std::swap(m_partialPackets[index], m_partialPackets[m_nPartialPackets]);
+  }
+  m_partialPackets[m_nPartialPackets].firstFragment = lp::Packet();
+}
 
-  ndn::Buffer fragBuffer(payloadSize);
-  auto it = fragBuffer.begin();
+void
+LpReassembler::dropPartialPacket(size_t index)
+{
+  const PartialPacket& pp = m_partialPackets[index];
+  this->beforeTimeout(pp.remoteEndpoint, pp.nReceivedFragments);
+  releasePartialPacket(index);
+}
 
-  for (const lp::Packet& frag : pp.fragments) {
-    ndn::Buffer::const_iterator fragBegin, fragEnd;
-    std::tie(fragBegin, fragEnd) = frag.get<lp::FragmentField>();
-    it = std::copy(fragBegin, fragEnd, it);
+shared_ptr<ndn::Buffer>
+LpReassembler::doReassembly(PartialPacket& pp)
+{
+  if (pp.isInOrder) {
+    // payloads were appended in FragIndex order, so the buffer already holds the packet
+    return std::move(pp.payload);
   }
 
-  return Block(fragBuffer);
+  auto buffer = make_shared<ndn::Buffer>(pp.payload->size());
+  auto it = buffer->begin();
+  for (size_t i = 0; i < pp.fragCount; ++i) {
+    const FragmentRange& range = pp.fragments[i];
+    it = std::copy(pp.payload->begin() + range.begin, pp.payload->begin() + range.end, it);
+  }
+  return buffer;
 }
 
 void
-LpReassembler::timeoutPartialPacket(const Key& key)
+LpReassembler::startTimeoutTimer(time::steady_clock::TimePoint expiry)
 {
-  auto it = m_partialPackets.find(key);
-  if (it == m_partialPackets.end()) {
+  if (m_timeoutTimer && m_timeoutTimerExpiry <= expiry) {
+    // timer is already running and fires early enough, do nothing
     return;
   }
 
-  this->beforeTimeout(std::get<0>(key), it->second.nReceivedFragments);
-  m_partialPackets.erase(it);
+  m_timeoutTimerExpiry = expiry;
+  auto delay = std::max(expiry - time::steady_clock::now(), time::steady_clock::Duration::zero());
+  m_timeoutTimer = getScheduler().schedule(delay, [this] { onTimeout(); });
+}
+
+void
+LpReassembler::onTimeout()
+{
+  auto now = time::steady_clock::now();
+  for (size_t i = 0; i < m_nPartialPackets;) {
+    if (m_partialPackets[i].expiry <= now) {
+      dropPartialPacket(i); // moves the last partial packet to index i
+    }
+    else {
+      ++i;
+    }
+  }
+
+  if (m_nPartialPackets == 0) {
+    return;
+  }
+  auto next = std::min_element(m_partialPackets.begin(),
+                               m_partialPackets.begin() + m_nPartialPackets,
+    [] (const PartialPacket& a, const PartialPacket& b) { return a.expiry < b.expiry; });
+  startTimeoutTimer(next->expiry);
 }
 
 std::ostream&
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2014-2019,  Regents of the University of California,
+ * Copyright (c) 2014-2022,  Regents of the University of California,
  *                           Arizona Board of Regents,
  *                           Colorado State University,
  *                           University Pierre & Marie Curie, Sorbonne University,
@@ -52,6 +52,13 @@ public:
     /** \brief timeout before a partially reassembled packet is dropped
      */
     time::nanoseconds reassemblyTimeout = 500_ms;
+
+    /** \brief maximum number of partially reassembled packets
+     *
+     *  When this limit is reached, the partial packet closest to its timeout is dropped
+     *  to make room for a new one.
+     */
+    size_t nMaxPartialPackets = 64;
   };
 
   explicit
@@ -92,37 +99,91 @@ public:
    *  within Options::reassemblyTimeout, it would be dropped due to timeout.
    *  Before it's erased, this signal is emitted with the remote endpoint,
    *  and the number of fragments being dropped.
+   *  This signal is also emitted when a partial packet is dropped to make room for a new one
+   *  because Options::nMaxPartialPackets has been reached.
    */
   signal::Signal<LpReassembler, EndpointId, size_t> beforeTimeout;
 
 private:
-  /** \brief holds all fragments of packet until reassembled
+  /** \brief position of a received fragment's payload in PartialPacket::payload
+   */
+  struct FragmentRange
+  {
+    size_t begin = 0;
+    size_t end = 0;
+    bool isReceived = false;
+  };
+
+  /** \brief reassembly slot that holds all fragments of a packet until reassembled
+   *
+   *  Slots are reused for subsequent packets, so that their storage is allocated only once.
    */
   struct PartialPacket
   {
-    std::vector<lp::Packet> fragments;
-    size_t fragCount; ///< total fragments
-    size_t nReceivedFragments; ///< number of received fragments
-    scheduler::ScopedEventId dropTimer;
+    EndpointId remoteEndpoint = 0;
+    lp::Sequence messageIdentifier = 0; ///< sequence of the first fragment
+    size_t fragCount = 0; ///< total fragments
+    size_t nReceivedFragments = 0; ///< number of received fragments
+    bool isInOrder = true; ///< whether fragments have been received in FragIndex order
+    lp::Packet firstFragment;
+    shared_ptr<ndn::Buffer> payload; ///< fragment payloads, in the order they were received
+    std::vector<FragmentRange> fragments; ///< indexed by FragIndex
+    time::steady_clock::TimePoint expiry;
   };
 
-  /** \brief index key for PartialPackets
+  /** \return index of the partial packet in m_partialPackets, or m_nPartialPackets if not found
+   */
+  size_t
+  findPartialPacket(EndpointId remoteEndpoint, lp::Sequence messageIdentifier) const;
+
+  /** \brief takes an unused slot for a new partial packet, dropping one if none is available
+   *  \return index of the partial packet in m_partialPackets
+   */
+  size_t
+  allocatePartialPacket(EndpointId remoteEndpoint, lp::Sequence messageIdentifier,
+                        size_t fragCount, size_t fragSize);
+
+  /** \brief returns a slot to the unused portion of m_partialPackets
+   *  \note This changes the index of the last partial packet in use.
    */
-  typedef std::tuple<
-    EndpointId, // remoteEndpoint
-    lp::Sequence // message identifier (sequence of the first fragment)
-  > Key;
+  void
+  releasePartialPacket(size_t index);
 
-  Block
-  doReassembly(const Key& key);
+  /** \brief drops a partial packet, after emitting beforeTimeout
+   */
+  void
+  dropPartialPacket(size_t index);
 
+  shared_ptr<ndn::Buffer>
+  doReassembly(PartialPacket& pp);
+
+  /** \brief ensures the timeout timer fires no later than \p expiry
+   */
   void
-  timeoutPartialPacket(const Key& key);
+  startTimeoutTimer(time::steady_clock::TimePoint expiry);
+
+  /** \brief drops expired partial packets and restarts the timer for the remaining ones
+   */
+  void
+  onTimeout();
 
 private:
   Options m_options;
   const LinkService* m_linkService;
-  std::map<Key, PartialPacket> m_partialPackets;
+  /** \brief reassembly slots
+   *
+   *  Slots in [0, m_nPartialPackets) are in use, the remaining ones are kept for reuse.
+   *  This container grows on demand up to Options::nMaxPartialPackets slots.
+   */
+  std::vector<PartialPacket> m_partialPackets;
+  size_t m_nPartialPackets = 0;
+  /** \brief a single timer for all partial packets, set to fire at the earliest expiry
+   *
+   *  The timer is not cancelled when a partial packet completes. When it fires,
+   *  it drops the expired partial packets and is rescheduled for the remaining ones.
+   */
+  scheduler::ScopedEventId m_timeoutTimer;
+  time::steady_clock::TimePoint m_timeoutTimerExpiry;
 };
 
 std::ostream&
@@ -143,7 +204,7 @@ LpReassembler::getLinkService() const
 inline size_t
 LpReassembler::size() const
 {
-  return m_partialPackets.size();
+  return m_nPartialPackets;
 }
 
 } // namespace face
@@ -33,10 +33,13 @@ namespace face {
 
 NFD_LOG_INIT(LpReliability);
 
+constexpr size_t LpReliability::UnackedFrags::INITIAL_CAPACITY;
+constexpr size_t LpReliability::RecvSeqWindow::WINDOW_SIZE;
+constexpr size_t LpReliability::RecvSeqWindow::BITS_PER_WORD;
+
 LpReliability::LpReliability(const LpReliability::Options& options, GenericLinkService* linkService)
   : m_options(options)
   , m_linkService(linkService)
-  , m_firstUnackedFrag(m_unackedFrags.begin())
   , m_lastTxSeqNo(-1) // set to "-1" to start TxSequence numbers at 0
 {
   BOOST_ASSERT(m_linkService != nullptr);
@@ -66,10 +69,11 @@ LpReliability::handleOutgoing(std::vector<lp::Packet>& frags, lp::Packet&& pkt,
 {
   BOOST_ASSERT(m_options.isEnabled);
 
-  auto unackedFragsIt = m_unackedFrags.begin();
   auto sendTime = time::steady_clock::now();
+  auto rto = m_rttEst.getEstimatedRto();
 
-  auto netPkt = make_shared<NetPkt>(std::move(pkt), isInterest);
+  auto netPkt = std::allocate_shared<NetPkt>(PoolAllocator<NetPkt>(m_netPktPool),
+                                             std::move(pkt), isInterest);
   netPkt->unackedFrags.reserve(frags.size());
 
   for (lp::Packet& frag : frags) {
@@ -80,27 +84,19 @@ LpReliability::handleOutgoing(std::vector<lp::Packet>& frags, lp::Packet&& pkt,
     lp::Sequence txSeq = assignTxSequence(frag);
 
     // Store LpPacket for future retransmissions
-    unackedFragsIt = m_unackedFrags.emplace_hint(unackedFragsIt,
-                                                 std::piecewise_construct,
-                                                 std::forward_as_tuple(txSeq),
-                                                 std::forward_as_tuple(frag));
-    unackedFragsIt->second.sendTime = sendTime;
-    auto rto = m_rttEst.getEstimatedRto();
+    UnackedFrag& unackedFrag = m_unackedFrags.append(txSeq, frag);
+    unackedFrag.sendTime = sendTime;
+    unackedFrag.rtoExpiry = sendTime + rto;
+    unackedFrag.netPkt = netPkt;
     lp::Sequence seq = frag.get<lp::SequenceField>();
     NFD_LOG_FACE_TRACE("transmitting seq=" << seq << ", txseq=" << txSeq << ", rto=" <<
                        time::duration_cast<time::milliseconds>(rto).count() << "ms");
-    unackedFragsIt->second.rtoTimer = getScheduler().schedule(rto, [=] {
-      onLpPacketLost(txSeq, true);
-    });
-    unackedFragsIt->second.netPkt = netPkt;
-
-    if (m_unackedFrags.size() == 1) {
-      m_firstUnackedFrag = m_unackedFrags.begin();
-    }
 
     // Add to associated NetPkt
-    netPkt->unackedFrags.push_back(unackedFragsIt);
+    netPkt->unackedFrags.push_back(txSeq);
   }
+
+  startRtoTimer(sendTime + rto);
 }
 
 bool
@@ -113,51 +109,41 @@ LpReliability::processIncomingPacket(const lp::Packet& pkt)
 
   // Extract and parse Acks
   for (lp::Sequence ackTxSeq : pkt.list<lp::AckField>()) {
-    auto fragIt = m_unackedFrags.find(ackTxSeq);
-    if (fragIt == m_unackedFrags.end()) {
+    UnackedFrag* frag = m_unackedFrags.find(ackTxSeq);
+    if (frag == nullptr) {
       // Ignore an Ack for an unknown TxSequence number
       NFD_LOG_FACE_DEBUG("received ack for unknown txseq=" << ackTxSeq);
       continue;
     }
-    auto& frag = fragIt->second;
-
-    // Cancel the RTO timer for the acknowledged fragment
-    frag.rtoTimer.cancel();
 
-    if (frag.retxCount == 0) {
-      NFD_LOG_FACE_TRACE("received ack for seq=" << frag.pkt.get<lp::SequenceField>() << ", txseq=" <<
-                         ackTxSeq << ", retx=0, rtt=" <<
-                         time::duration_cast<time::milliseconds>(now - frag.sendTime).count() << "ms");
+    if (frag->retxCount == 0) {
+      NFD_LOG_FACE_TRACE("received ack for seq=" << frag->pkt.get<lp::SequenceField>() <<
+                         ", txseq=" << ackTxSeq << ", retx=0, rtt=" <<
+                         time::duration_cast<time::milliseconds>(now - frag->sendTime).count() <<
+                         "ms");
       // This sequence had no retransmissions, so use it to estimate the RTO
-      m_rttEst.addMeasurement(now - frag.sendTime);
+      m_rttEst.addMeasurement(now - frag->sendTime);
     }
     else {
-      NFD_LOG_FACE_TRACE("received ack for seq=" << frag.pkt.get<lp::SequenceField>() << ", txseq=" <<
-                         ackTxSeq << ", retx=" << frag.retxCount);
+      NFD_LOG_FACE_TRACE("received ack for seq=" << frag->pkt.get<lp::SequenceField>() <<
+                         ", txseq=" << ackTxSeq << ", retx=" << frag->retxCount);
     }
 
     // Look for frags with TxSequence numbers < ackTxSeq (allowing for wraparound) and consider
     // them lost if a configurable number of Acks containing greater TxSequence numbers have been
     // received.
-    auto lostLpPackets = findLostLpPackets(fragIt);
+    auto lostLpPackets = findLostLpPackets(ackTxSeq);
 
-    // Remove the fragment from the map of unacknowledged fragments and from its associated network
-    // packet. Potentially increment the start of the window.
-    onLpPacketAcknowledged(fragIt);
-
-    // This set contains TxSequences that have been removed by onLpPacketLost below because they
-    // were part of a network packet that was removed due to a fragment exceeding retx, as well as
-    // any other TxSequences removed by onLpPacketLost. This prevents onLpPacketLost from being
-    // called later for an invalid iterator.
-    std::set<lp::Sequence> removedLpPackets;
+    // Remove the fragment from the window of unacknowledged fragments and from its associated
+    // network packet. Potentially increment the start of the window.
+    onLpPacketAcknowledged(ackTxSeq);
 
     // Resend or fail fragments considered lost. Potentially increment the start of the window.
+    // A fragment may have left the window already, if another fragment of its network packet
+    // exceeded the allowed number of retransmissions.
     for (lp::Sequence txSeq : lostLpPackets) {
-      if (removedLpPackets.find(txSeq) == removedLpPackets.end()) {
-        auto removedTxSeqs = onLpPacketLost(txSeq, false);
-        for (auto removedTxSeq : removedTxSeqs) {
-          removedLpPackets.insert(removedTxSeq);
-        }
+      if (m_unackedFrags.find(txSeq) != nullptr) {
+        onLpPacketLost(txSeq, false);
       }
     }
   }
@@ -169,18 +155,9 @@ LpReliability::processIncomingPacket(const lp::Packet& pkt)
 
     // Check for received frames with duplicate Sequences
     if (pkt.has<lp::SequenceField>()) {
-      lp::Sequence pktSequence = pkt.get<lp::SequenceField>();
-      isDuplicate = m_recentRecvSeqs.count(pktSequence) > 0;
-      // Check for recent received Sequences to remove
-      auto now = time::steady_clock::now();
-      auto rto = m_rttEst.getEstimatedRto();
-      while (!m_recentRecvSeqsQueue.empty() &&
-             now > m_recentRecvSeqs[m_recentRecvSeqsQueue.front()] + rto) {
-        m_recentRecvSeqs.erase(m_recentRecvSeqsQueue.front());
-        m_recentRecvSeqsQueue.pop();
-      }
-      m_recentRecvSeqs.emplace(pktSequence, now);
-      m_recentRecvSeqsQueue.push(pktSequence);
+      isDuplicate = !m_recentRecvSeqs.insert(pkt.get<lp::SequenceField>(),
+                                             time::steady_clock::now(),
+                                             m_rttEst.getEstimatedRto());
     }
 
     startIdleAckTimer();
@@ -226,7 +203,7 @@ LpReliability::assignTxSequence(lp::Packet& frag)
 {
   lp::Sequence txSeq = ++m_lastTxSeqNo;
   frag.set<lp::TxSequenceField>(txSeq);
-  if (!m_unackedFrags.empty() && m_lastTxSeqNo == m_firstUnackedFrag->first) {
+  if (!m_unackedFrags.empty() && m_lastTxSeqNo == m_unackedFrags.getFirstTxSeq()) {
     NDN_THROW(std::length_error("TxSequence range exceeded"));
   }
   return m_lastTxSeqNo;
@@ -247,44 +224,81 @@ LpReliability::startIdleAckTimer()
   });
 }
 
-std::vector<lp::Sequence>
-LpReliability::findLostLpPackets(LpReliability::UnackedFrags::iterator ackIt)
+void
+LpReliability::startRtoTimer(time::steady_clock::TimePoint expiry)
 {
-  std::vector<lp::Sequence> lostLpPackets;
+  if (m_rtoTimer && m_rtoTimerExpiry <= expiry) {
+    // timer is already running and fires early enough, do nothing
+    return;
+  }
 
-  for (auto it = m_firstUnackedFrag; ; ++it) {
-    if (it == m_unackedFrags.end()) {
-      it = m_unackedFrags.begin();
+  m_rtoTimerExpiry = expiry;
+  auto delay = std::max(expiry - time::steady_clock::now(), time::steady_clock::Duration::zero());
+  m_rtoTimer = getScheduler().schedule(delay, [this] { onRtoTimeout(); });
+}
+
+void
+LpReliability::onRtoTimeout()
+{
+  auto now = time::steady_clock::now();
+
+  // Fragments retransmitted below are appended to the window after the current last TxSequence,
+  // and are not visited again. RTO estimates vary over time, so expiries are not ordered by
+  // TxSequence, and the whole window must be scanned.
+  lp::Sequence end = m_lastTxSeqNo + 1;
+  for (lp::Sequence txSeq = m_unackedFrags.empty() ? end : m_unackedFrags.getFirstTxSeq();
+       txSeq != end && !m_unackedFrags.empty(); ++txSeq) {
+    UnackedFrag* frag = m_unackedFrags.find(txSeq);
+    if (frag != nullptr && frag->rtoExpiry <= now) {
+      onLpPacketLost(txSeq, true);
     }
+  }
 
-    if (it->first == ackIt->first) {
-      break;
+  if (m_unackedFrags.empty()) {
+    return;
+  }
+  auto nextExpiry = time::steady_clock::TimePoint::max();
+  end = m_lastTxSeqNo + 1;
+  for (lp::Sequence txSeq = m_unackedFrags.getFirstTxSeq(); txSeq != end; ++txSeq) {
+    UnackedFrag* frag = m_unackedFrags.find(txSeq);
+    if (frag != nullptr) {
+      nextExpiry = std::min(nextExpiry, frag->rtoExpiry);
     }
+  }
+  startRtoTimer(nextExpiry);
+}
 
-    auto& unackedFrag = it->second;
-    unackedFrag.nGreaterSeqAcks++;
-    NFD_LOG_FACE_TRACE("received ack=" << ackIt->first << " before=" << it->first <<
-                       ", before count=" << unackedFrag.nGreaterSeqAcks);
+std::vector<lp::Sequence>
+LpReliability::findLostLpPackets(lp::Sequence ackTxSeq)
+{
+  std::vector<lp::Sequence> lostLpPackets;
 
-    if (unackedFrag.nGreaterSeqAcks >= m_options.seqNumLossThreshold) {
-      lostLpPackets.push_back(it->first);
+  for (lp::Sequence txSeq = m_unackedFrags.getFirstTxSeq(); txSeq != ackTxSeq; ++txSeq) {
+    UnackedFrag* unackedFrag = m_unackedFrags.find(txSeq);
+    if (unackedFrag == nullptr) {
+      continue;
+    }
+
+    unackedFrag->nGreaterSeqAcks++;
+    NFD_LOG_FACE_TRACE("received ack=" << ackTxSeq << " before=" << txSeq <<
+                       ", before count=" << unackedFrag->nGreaterSeqAcks);
+
+    if (unackedFrag->nGreaterSeqAcks >= m_options.seqNumLossThreshold) {
+      lostLpPackets.push_back(txSeq);
     }
   }
 
   return lostLpPackets;
 }
 
-std::vector<lp::Sequence>
+void
 LpReliability::onLpPacketLost(lp::Sequence txSeq, bool isTimeout)
 {
-  BOOST_ASSERT(m_unackedFrags.count(txSeq) > 0);
-  auto txSeqIt = m_unackedFrags.find(txSeq);
+  UnackedFrag* txFrag = m_unackedFrags.find(txSeq);
+  BOOST_ASSERT(txFrag != nullptr);
 
-  auto& txFrag = txSeqIt->second;
-  txFrag.rtoTimer.cancel();
-  auto netPkt = txFrag.netPkt;
-  std::vector<lp::Sequence> removedThisTxSeq;
-  lp::Sequence seq = txFrag.pkt.get<lp::SequenceField>();
+  auto netPkt = txFrag->netPkt;
+  lp::Sequence seq = txFrag->pkt.get<lp::SequenceField>();
 
   if (isTimeout) {
     NFD_LOG_FACE_TRACE("rto timer expired for seq=" << seq << ", txseq=" << txSeq);
@@ -295,14 +309,11 @@ LpReliability::onLpPacketLost(lp::Sequence txSeq, bool isTimeout)
   }
 
   // Check if maximum number of retransmissions exceeded
-  if (txFrag.retxCount >= m_options.maxRetx) {
+  if (txFrag->retxCount >= m_options.maxRetx) {
     NFD_LOG_FACE_DEBUG("seq=" << seq << " exceeded allowed retransmissions: DROP");
-    // Delete all LpPackets of NetPkt from m_unackedFrags (except this one)
-    for (size_t i = 0; i < netPkt->unackedFrags.size(); i++) {
-      if (netPkt->unackedFrags[i] != txSeqIt) {
-        removedThisTxSeq.push_back(netPkt->unackedFrags[i]->first);
-        deleteUnackedFrag(netPkt->unackedFrags[i]);
-      }
+    // Delete all LpPackets of NetPkt from m_unackedFrags (including this one)
+    for (lp::Sequence fragTxSeq : netPkt->unackedFrags) {
+      m_unackedFrags.erase(fragTxSeq);
     }
 
     ++m_linkService->nRetxExhausted;
@@ -313,67 +324,54 @@ LpReliability::onLpPacketLost(lp::Sequence txSeq, bool isTimeout)
       auto frag = netPkt->pkt.get<lp::FragmentField>();
       onDroppedInterest(Interest(Block({frag.first, frag.second})));
     }
-
-    // Delete this LpPacket from m_unackedFrags
-    removedThisTxSeq.push_back(txSeqIt->first);
-    deleteUnackedFrag(txSeqIt);
   }
   else {
     // Assign new TxSequence
-    lp::Sequence newTxSeq = assignTxSequence(txFrag.pkt);
+    lp::Sequence newTxSeq = assignTxSequence(txFrag->pkt);
     netPkt->didRetx = true;
+    size_t retxCount = txFrag->retxCount + 1;
 
-    // Move fragment to new TxSequence mapping
-    auto newTxFragIt = m_unackedFrags.emplace_hint(
-      m_firstUnackedFrag != m_unackedFrags.end() && m_firstUnackedFrag->first > newTxSeq
-        ? m_firstUnackedFrag
-        : m_unackedFrags.end(),
-      std::piecewise_construct,
-      std::forward_as_tuple(newTxSeq),
-      std::forward_as_tuple(txFrag.pkt));
-    auto& newTxFrag = newTxFragIt->second;
-    newTxFrag.retxCount = txFrag.retxCount + 1;
+    // Move fragment to new TxSequence
+    lp::Packet pkt = std::move(txFrag->pkt);
+    m_unackedFrags.erase(txSeq);
+    UnackedFrag& newTxFrag = m_unackedFrags.append(newTxSeq, std::move(pkt));
+    newTxFrag.retxCount = retxCount;
     newTxFrag.netPkt = netPkt;
+    auto rto = m_rttEst.getEstimatedRto();
+    newTxFrag.rtoExpiry = newTxFrag.sendTime + rto;
 
     // Update associated NetPkt
-    auto fragInNetPkt = std::find(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(), txSeqIt);
+    auto fragInNetPkt = std::find(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(), txSeq);
     BOOST_ASSERT(fragInNetPkt != netPkt->unackedFrags.end());
-    *fragInNetPkt = newTxFragIt;
+    *fragInNetPkt = newTxSeq;
 
-    removedThisTxSeq.push_back(txSeqIt->first);
-    deleteUnackedFrag(txSeqIt);
-
-    // Retransmit fragment
-    m_linkService->sendLpPacket(lp::Packet(newTxFrag.pkt));
-
-    auto rto = m_rttEst.getEstimatedRto();
     NFD_LOG_FACE_TRACE("retransmitting seq=" << seq << ", txseq=" << newTxSeq << ", retx=" <<
-                       txFrag.retxCount << ", rto=" <<
+                       retxCount - 1 << ", rto=" <<
                        time::duration_cast<time::milliseconds>(rto).count() << "ms");
 
-    // Start RTO timer for this sequence
-    newTxFrag.rtoTimer = getScheduler().schedule(rto, [=] {
-      onLpPacketLost(newTxSeq, true);
-    });
-  }
+    startRtoTimer(newTxFrag.rtoExpiry);
 
-  return removedThisTxSeq;
+    // Retransmit fragment
+    m_linkService->sendLpPacket(lp::Packet(newTxFrag.pkt));
+  }
 }
 
 void
-LpReliability::onLpPacketAcknowledged(UnackedFrags::iterator fragIt)
+LpReliability::onLpPacketAcknowledged(lp::Sequence txSeq)
 {
-  auto netPkt = fragIt->second.netPkt;
+  UnackedFrag* frag = m_unackedFrags.find(txSeq);
+  BOOST_ASSERT(frag != nullptr);
+  NetPkt& netPkt = *frag->netPkt;
 
   // Remove from NetPkt unacked fragment list
-  auto fragInNetPkt = std::find(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(), fragIt);
-  BOOST_ASSERT(fragInNetPkt != netPkt->unackedFrags.end());
-  *fragInNetPkt = netPkt->unackedFrags.back();
-  netPkt->unackedFrags.pop_back();
+  auto fragInNetPkt = std::find(netPkt.unackedFrags.begin(), netPkt.unackedFrags.end(), txSeq);
+  BOOST_ASSERT(fragInNetPkt != netPkt.unackedFrags.end());
+  *fragInNetPkt = netPkt.unackedFrags.back();
+  netPkt.unackedFrags.pop_back();
 
   // Check if network-layer packet completely received. If so, increment counters
-  if (netPkt->unackedFrags.empty()) {
-    if (netPkt->didRetx) {
+  if (netPkt.unackedFrags.empty()) {
+    if (netPkt.didRetx) {
       ++m_linkService->nRetransmitted;
     }
     else {
@@ -381,43 +379,157 @@ LpReliability::onLpPacketAcknowledged(UnackedFrags::iterator fragIt)
     }
   }
 
-  deleteUnackedFrag(fragIt);
+  // The RTO timer is left running when the window becomes empty; it will find nothing to do.
+  m_unackedFrags.erase(txSeq);
+}
+
+LpReliability::UnackedFrag::UnackedFrag(lp::Packet pkt)
+  : pkt(std::move(pkt))
+  , sendTime(time::steady_clock::now())
+{
+}
+
+LpReliability::NetPkt::NetPkt(lp::Packet&& pkt, bool isInterest)
+  : pkt(std::move(pkt))
+  , isInterest(isInterest)
+  , didRetx(false)
+{
+}
+
+LpReliability::UnackedFrag*
+LpReliability::UnackedFrags::find(lp::Sequence txSeq)
+{
+  // unsigned arithmetic takes care of TxSequence wraparound
+  if (m_size == 0 || txSeq - m_begin >= m_end - m_begin) {
+    return nullptr;
+  }
+
+  Slot& slot = getSlot(txSeq);
+  return slot.isUsed ? &slot.frag : nullptr;
+}
+
+LpReliability::UnackedFrag&
+LpReliability::UnackedFrags::at(lp::Sequence txSeq)
+{
+  UnackedFrag* frag = find(txSeq);
+  if (frag == nullptr) {
+    NDN_THROW(std::out_of_range("TxSequence " + to_string(txSeq) + " is not in the window"));
+  }
+  return *frag;
+}
+
+LpReliability::UnackedFrag&
+LpReliability::UnackedFrags::append(lp::Sequence txSeq, lp::Packet pkt)
+{
+  if (m_size == 0) {
+    m_begin = m_end = txSeq;
+  }
+  BOOST_ASSERT(txSeq == m_end);
+
+  if (m_end - m_begin == m_ring.size()) {
+    grow();
+  }
+
+  Slot& slot = getSlot(txSeq);
+  BOOST_ASSERT(!slot.isUsed);
+  slot.frag = UnackedFrag(std::move(pkt));
+  slot.isUsed = true;
+  ++m_end;
+  ++m_size;
+  return slot.frag;
 }
 
 void
-LpReliability::deleteUnackedFrag(UnackedFrags::iterator fragIt)
+LpReliability::UnackedFrags::erase(lp::Sequence txSeq)
 {
-  lp::Sequence firstUnackedTxSeq = m_firstUnackedFrag->first;
-  lp::Sequence currentTxSeq = fragIt->first;
-  auto nextFragIt = m_unackedFrags.erase(fragIt);
-
-  if (!m_unackedFrags.empty() && firstUnackedTxSeq == currentTxSeq) {
-    // If "first" fragment in send window (allowing for wraparound), increment window begin
-    if (nextFragIt == m_unackedFrags.end()) {
-      m_firstUnackedFrag = m_unackedFrags.begin();
+  BOOST_ASSERT(find(txSeq) != nullptr);
+
+  // release the packet and the NetPkt now, rather than when the slot is reused
+  Slot& slot = getSlot(txSeq);
+  slot.frag = UnackedFrag();
+  slot.isUsed = false;
+  --m_size;
+
+  if (m_size == 0) {
+    m_begin = m_end;
+  }
+  else if (txSeq == m_begin) {
+    // advance to the next unacknowledged fragment, which exists because the window is not empty
+    do {
+      ++m_begin;
+    } while (!getSlot(m_begin).isUsed);
+  }
+}
+
+void
+LpReliability::UnackedFrags::grow()
+{
+  std::vector<Slot> ring(std::max(INITIAL_CAPACITY, m_ring.size() * 2));
+  for (lp::Sequence txSeq = m_begin; txSeq != m_end; ++txSeq) {
+    Slot& slot = getSlot(txSeq);
+    if (slot.isUsed) {
+      ring[txSeq & (ring.size() - 1)] = std::move(slot);
     }
-    else {
-      m_firstUnackedFrag = nextFragIt;
+  }
+  m_ring = std::move(ring);
+}
+
+bool
+LpReliability::RecvSeqWindow::insert(lp::Sequence seq, time::steady_clock::TimePoint now,
+                                     time::nanoseconds lifetime)
+{
+  if (m_isEmpty) {
+    m_isEmpty = false;
+    m_last = seq;
+  }
+
+  // unsigned arithmetic takes care of Sequence wraparound
+  lp::Sequence behind = m_last - seq;
+  lp::Sequence ahead = seq - m_last;
+  if (behind < WINDOW_SIZE) {
+    // forget the Sequences of this word if none was recorded within the lifetime
+    size_t i = getWordIndex(seq);
+    if (now - m_wordTime[i] > lifetime) {
+      m_bitmap[i] = 0;
+    }
+    else if (testBit(seq)) {
+      return false;
     }
   }
-  else if (m_unackedFrags.empty()) {
-    m_firstUnackedFrag = m_unackedFrags.end();
+  else if (ahead < WINDOW_SIZE) {
+    // slide the window forward, forgetting the Sequences that fall out of it
+    for (lp::Sequence s = m_last + 1; s != seq; ++s) {
+      setBit(s, false);
+    }
+    m_last = seq;
+  }
+  else {
+    m_bitmap.fill(0);
+    m_last = seq;
   }
+
+  setBit(seq, true);
+  m_wordTime[getWordIndex(seq)] = now;
+  return true;
 }
 
-LpReliability::UnackedFrag::UnackedFrag(lp::Packet pkt)
-  : pkt(std::move(pkt))
-  , sendTime(time::steady_clock::now())
-  , retxCount(0)
-  , nGreaterSeqAcks(0)
+bool
+LpReliability::RecvSeqWindow::contains(lp::Sequence seq) const
 {
+  return !m_isEmpty && m_last - seq < WINDOW_SIZE && testBit(seq);
 }
 
-LpReliability::NetPkt::NetPkt(lp::Packet&& pkt, bool isInterest)
-  : pkt(std::move(pkt))
-  , isInterest(isInterest)
-  , didRetx(false)
+void
+LpReliability::RecvSeqWindow::setBit(lp::Sequence seq, bool value)
 {
+  uint64_t& word = m_bitmap[getWordIndex(seq)];
+  uint64_t mask = uint64_t(1) << (seq % BITS_PER_WORD);
+  if (value) {
+    word |= mask;
+  }
+  else {
+    word &= ~mask;
+  }
 }
 
 std::ostream&
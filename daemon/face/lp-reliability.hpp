@@ -27,11 +27,13 @@
 #define NFD_DAEMON_FACE_LP_RELIABILITY_HPP
 
 #include "face-common.hpp"
+#include "common/pool-allocator.hpp"
 
 #include <ndn-cxx/lp/packet.hpp>
 #include <ndn-cxx/lp/sequence.hpp>
 #include <ndn-cxx/util/rtt-estimator.hpp>
 
+#include <array>
 #include <queue>
 
 namespace nfd {
@@ -108,7 +110,8 @@ public:
 NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   class UnackedFrag;
   class NetPkt;
-  using UnackedFrags = std::map<lp::Sequence, UnackedFrag>;
+  class UnackedFrags;
+  class RecvSeqWindow;
 
 NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /** \brief assign TxSequence number to a fragment
@@ -128,39 +131,47 @@ NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   startIdleAckTimer();
 
+  /** \brief start the RTO timer if it is not running
+   *  \param expiry when the timer should fire
+   *
+   *  A single RTO timer serves all unacknowledged fragments. It is armed at or before the
+   *  earliest RTO expiry in the window, and rearmed by onRtoTimeout().
+   */
+  void
+  startRtoTimer(time::steady_clock::TimePoint expiry);
+
+  /** \brief handle the expiry of the RTO timer
+   *
+   *  Every fragment in the window whose RTO has expired is declared lost, in TxSequence order.
+   *  The timer is then rearmed for the earliest remaining RTO expiry.
+   */
+  void
+  onRtoTimeout();
+
   /** \brief find and mark as lost fragments where a configurable number of Acks
    *         (\p m_options.seqNumLossThreshold) have been received for greater TxSequence numbers
-   *  \param ackIt iterator pointing to acknowledged fragment
+   *  \param ackTxSeq TxSequence of the acknowledged fragment
    *  \return vector containing TxSequences of fragments marked lost by this mechanism
    */
   std::vector<lp::Sequence>
-  findLostLpPackets(UnackedFrags::iterator ackIt);
+  findLostLpPackets(lp::Sequence ackTxSeq);
 
   /** \brief resend (or give up on) a lost fragment
-   *  \return vector of the TxSequences of fragments removed due to a network packet being removed
+   *
+   *  If the fragment exceeded the allowed number of retransmissions, all fragments of its
+   *  network packet are removed from the window.
    */
-  std::vector<lp::Sequence>
+  void
   onLpPacketLost(lp::Sequence txSeq, bool isTimeout);
 
-  /** \brief remove the fragment with the given sequence number from the map of unacknowledged
+  /** \brief remove the fragment with the given sequence number from the window of unacknowledged
    *         fragments, as well as its associated network packet (if any)
-   *  \param fragIt iterator to acknowledged fragment
    *
    *  If the given TxSequence marks the beginning of the send window, the window will be incremented.
    *  If the associated network packet has been fully transmitted, it will be removed.
    */
   void
-  onLpPacketAcknowledged(UnackedFrags::iterator fragIt);
-
-  /** \brief delete a fragment from UnackedFrags and advance acknowledge window if necessary
-   *  \param fragIt iterator to an UnackedFrag, must be dereferencable
-   *  \post fragIt is not in m_unackedFrags
-   *  \post if was equal to m_firstUnackedFrag,
-   *        m_firstUnackedFrag is set to the UnackedFrag after fragIt with consideration of
-   *        TxSequence number wraparound, or set to m_unackedFrags.end() if m_unackedFrags is empty
-   */
-  void
-  deleteUnackedFrag(UnackedFrags::iterator fragIt);
+  onLpPacketAcknowledged(lp::Sequence txSeq);
 
 NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /** \brief contains a sent fragment that has not been acknowledged and associated data
@@ -168,15 +179,17 @@ NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   class UnackedFrag
   {
   public:
+    UnackedFrag() = default;
+
     explicit
     UnackedFrag(lp::Packet pkt);
 
   public:
     lp::Packet pkt;
-    scheduler::ScopedEventId rtoTimer;
     time::steady_clock::TimePoint sendTime;
-    size_t retxCount;
-    size_t nGreaterSeqAcks; //!< number of Acks received for sequences greater than this fragment
+    time::steady_clock::TimePoint rtoExpiry;
+    size_t retxCount = 0;
+    size_t nGreaterSeqAcks = 0; //!< number of Acks received for sequences greater than this fragment
     shared_ptr<NetPkt> netPkt;
   };
 
@@ -188,12 +201,159 @@ NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
     NetPkt(lp::Packet&& pkt, bool isInterest);
 
   public:
-    std::vector<UnackedFrags::iterator> unackedFrags;
+    std::vector<lp::Sequence> unackedFrags; //!< TxSequences of unacknowledged fragments
     lp::Packet pkt;
     bool isInterest;
     bool didRetx;
   };
 
+  /** \brief the window of unacknowledged fragments
+   *
+   *  The window spans the TxSequences from the first unacknowledged fragment to the last assigned
+   *  TxSequence. Its fragments are kept in a ring indexed by TxSequence modulo the ring capacity,
+   *  which is a power of two, so that TxSequence wraparound needs no special handling. The ring
+   *  grows when the window outgrows it. Acknowledged fragments in the middle of the window leave
+   *  empty slots behind.
+   */
+  class UnackedFrags : noncopyable
+  {
+  public:
+    /** \return number of unacknowledged fragments
+     */
+    size_t
+    size() const
+    {
+      return m_size;
+    }
+
+    bool
+    empty() const
+    {
+      return m_size == 0;
+    }
+
+    /** \return TxSequence of the first unacknowledged fragment
+     *  \pre !empty()
+     */
+    lp::Sequence
+    getFirstTxSeq() const
+    {
+      BOOST_ASSERT(!empty());
+      return m_begin;
+    }
+
+    /** \return the fragment with the given TxSequence, or nullptr if it is not in the window
+     */
+    UnackedFrag*
+    find(lp::Sequence txSeq);
+
+    size_t
+    count(lp::Sequence txSeq)
+    {
+      return find(txSeq) == nullptr ? 0 : 1;
+    }
+
+    /** \throw std::out_of_range the fragment is not in the window
+     */
+    UnackedFrag&
+    at(lp::Sequence txSeq);
+
+    /** \brief append a fragment to the window
+     *  \pre \p txSeq follows the last TxSequence in the window, or the window is empty
+     */
+    UnackedFrag&
+    append(lp::Sequence txSeq, lp::Packet pkt);
+
+    /** \brief remove a fragment from the window
+     *  \pre find(txSeq) != nullptr
+     *  \post if \p txSeq was the first TxSequence in the window, the window begins at the next
+     *        unacknowledged fragment
+     */
+    void
+    erase(lp::Sequence txSeq);
+
+  private:
+    struct Slot
+    {
+      UnackedFrag frag;
+      bool isUsed = false;
+    };
+
+    Slot&
+    getSlot(lp::Sequence txSeq)
+    {
+      return m_ring[txSeq & (m_ring.size() - 1)];
+    }
+
+    void
+    grow();
+
+  public:
+    static constexpr size_t INITIAL_CAPACITY = 64;
+
+  private:
+    std::vector<Slot> m_ring;
+    lp::Sequence m_begin = 0; ///< TxSequence of the first unacknowledged fragment
+    lp::Sequence m_end = 0;   ///< TxSequence after the last fragment in the window
+    size_t m_size = 0;
+  };
+
+  /** \brief the recently received Sequences, for duplicate detection
+   *
+   *  This is a sliding bitmap covering the WINDOW_SIZE Sequences up to the greatest Sequence
+   *  received so far. A Sequence far outside this range resets the window.
+   *
+   *  A recorded Sequence is forgotten once it is older than a given lifetime, i.e., one RTO.
+   *  Expiry is tracked per bitmap word: a word in which no Sequence was recorded within the
+   *  lifetime is cleared before it is tested. Thus the small Sequences sent by a peer that
+   *  restarted are not mistaken for duplicates, even if they fall within the window.
+   */
+  class RecvSeqWindow
+  {
+  public:
+    /** \brief record a Sequence received at \p now
+     *  \param lifetime how long a recorded Sequence is considered a duplicate
+     *  \return whether \p seq was not already recorded within \p lifetime
+     */
+    bool
+    insert(lp::Sequence seq, time::steady_clock::TimePoint now,
+           time::nanoseconds lifetime);
+
+    /** \return whether \p seq has been recorded and is still in the window, regardless of
+     *          its age
+     */
+    bool
+    contains(lp::Sequence seq) const;
+
+  public:
+    static constexpr size_t WINDOW_SIZE = 1024;
+
+  private:
+    static constexpr size_t BITS_PER_WORD = 64;
+
+    static size_t
+    getWordIndex(lp::Sequence seq)
+    {
+      return (seq / BITS_PER_WORD) % (WINDOW_SIZE / BITS_PER_WORD);
+    }
+
+    bool
+    testBit(lp::Sequence seq) const
+    {
+      return (m_bitmap[getWordIndex(seq)] >> (seq % BITS_PER_WORD)) & 1;
+    }
+
+    void
+    setBit(lp::Sequence seq, bool value);
+
+  private:
+    std::array<uint64_t, WINDOW_SIZE / BITS_PER_WORD> m_bitmap{};
+    /// when a Sequence was last recorded in each word of m_bitmap
+    std::array<time::steady_clock::TimePoint, WINDOW_SIZE / BITS_PER_WORD> m_wordTime{};
+    lp::Sequence m_last = 0;
+    bool m_isEmpty = true;
+  };
+
 public:
   /// TxSequence TLV-TYPE (3 octets) + TLV-LENGTH (1 octet) + lp::Sequence (8 octets)
   static constexpr size_t RESERVED_HEADER_SPACE = tlv::sizeOfVarNumber(lp::tlv::TxSequence) +
@@ -204,18 +364,14 @@ NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   Options m_options;
   GenericLinkService* m_linkService;
   UnackedFrags m_unackedFrags;
-  /** An iterator that points to the first unacknowledged fragment in the current window. The window
-   *  can wrap around so that the beginning of the window is at a TxSequence greater than other
-   *  fragments in the window. When the window is moved past the last item in the iterator, the
-   *  first fragment in the map will become the start of the window.
-   */
-  UnackedFrags::iterator m_firstUnackedFrag;
   std::queue<lp::Sequence> m_ackQueue;
-  std::map<lp::Sequence, time::steady_clock::TimePoint> m_recentRecvSeqs;
-  std::queue<lp::Sequence> m_recentRecvSeqsQueue;
+  RecvSeqWindow m_recentRecvSeqs;
   lp::Sequence m_lastTxSeqNo;
   scheduler::ScopedEventId m_idleAckTimer;
+  scheduler::ScopedEventId m_rtoTimer;
+  time::steady_clock::TimePoint m_rtoTimerExpiry;
   ndn::util::RttEstimator m_rttEst;
+  shared_ptr<FixedSizePool> m_netPktPool = make_shared<FixedSizePool>(64);
 };
 
 std::ostream&
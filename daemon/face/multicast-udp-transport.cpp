@@ -78,6 +78,9 @@ MulticastUdpTransport::getSendQueueLength()
   if (queueLength == QUEUE_ERROR) {
     NFD_LOG_FACE_WARN("Failed to obtain send queue length from socket: " << std::strerror(errno));
   }
+  else if (queueLength >= 0) {
+    queueLength += getEnqueuedBytes();
+  }
   return queueLength;
 }
 
@@ -86,6 +89,11 @@ MulticastUdpTransport::doSend(const Block& packet)
 {
   NFD_LOG_FACE_TRACE(__func__);
 
+  if (getIoBatchSize() > 1) {
+    enqueueSend(packet, m_sendSocket, &m_multicastGroup);
+    return;
+  }
+
   m_sendSocket.async_send_to(boost::asio::buffer(packet), m_multicastGroup,
                              // 'packet' is copied into the lambda to retain the underlying Buffer
                              [this, packet] (auto&&... args) {
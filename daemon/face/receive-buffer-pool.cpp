@@ -0,0 +1,156 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "receive-buffer-pool.hpp"
+#include "common/pool-allocator.hpp"
+
+namespace nfd {
+namespace face {
+
+constexpr size_t ReceiveBufferPool::MIN_BUFFER_SIZE;
+
+struct ReceiveBufferPool::State
+{
+  struct SizeClass
+  {
+    size_t bufferSize;
+    std::vector<unique_ptr<ndn::Buffer>> idle;
+  };
+
+  std::vector<SizeClass> sizeClasses; ///< in decreasing order of bufferSize
+  size_t maxIdle;
+  uint64_t nAllocations = 0;
+  shared_ptr<FixedSizePool> controlBlocks = make_shared<FixedSizePool>(64);
+};
+
+/** \brief returns a buffer to its size class, or frees it if the pool is gone or full
+ */
+class ReceiveBufferPool::Recycler
+{
+public:
+  Recycler(weak_ptr<ReceiveBufferPool::State> state, size_t sizeClass) noexcept
+    : m_state(std::move(state))
+    , m_sizeClass(sizeClass)
+  {
+  }
+
+  void
+  operator()(ndn::Buffer* buffer) const
+  {
+    unique_ptr<ndn::Buffer> owned(buffer);
+    auto state = m_state.lock();
+    if (state == nullptr) {
+      return;
+    }
+    auto& idle = state->sizeClasses[m_sizeClass].idle;
+    if (idle.size() < state->maxIdle) {
+      idle.push_back(std::move(owned));
+    }
+  }
+
+private:
+  weak_ptr<ReceiveBufferPool::State> m_state;
+  size_t m_sizeClass;
+};
+
+ReceiveBufferPool::ReceiveBufferPool(size_t bufferSize, size_t maxIdle)
+  : m_state(make_shared<State>())
+{
+  BOOST_ASSERT(bufferSize > 0);
+  m_state->sizeClasses.push_back({bufferSize, {}});
+  for (size_t size = bufferSize / 2; size >= MIN_BUFFER_SIZE; size /= 2) {
+    m_state->sizeClasses.push_back({size, {}});
+  }
+  m_state->maxIdle = maxIdle;
+}
+
+ReceiveBufferPool::~ReceiveBufferPool() = default;
+
+size_t
+ReceiveBufferPool::getBufferSize() const noexcept
+{
+  return m_state->sizeClasses.front().bufferSize;
+}
+
+void
+ReceiveBufferPool::setMaxIdle(size_t maxIdle) noexcept
+{
+  m_state->maxIdle = maxIdle;
+  for (auto& sizeClass : m_state->sizeClasses) {
+    if (sizeClass.idle.size() > maxIdle) {
+      sizeClass.idle.resize(maxIdle);
+    }
+  }
+}
+
+shared_ptr<ndn::Buffer>
+ReceiveBufferPool::acquire()
+{
+  return acquire(getBufferSize());
+}
+
+shared_ptr<ndn::Buffer>
+ReceiveBufferPool::acquire(size_t minSize)
+{
+  auto& classes = m_state->sizeClasses;
+  size_t i = 0;
+  while (i + 1 < classes.size() && classes[i + 1].bufferSize >= minSize) {
+    ++i;
+  }
+
+  unique_ptr<ndn::Buffer> buffer;
+  auto& idle = classes[i].idle;
+  if (idle.empty()) {
+    buffer = make_unique<ndn::Buffer>(classes[i].bufferSize);
+    ++m_state->nAllocations;
+  }
+  else {
+    buffer = std::move(idle.back());
+    idle.pop_back();
+  }
+
+  // if allocating the control block throws, the Recycler takes care of the buffer
+  return shared_ptr<ndn::Buffer>(buffer.release(), Recycler(m_state, i),
+                                 PoolAllocator<ndn::Buffer>(m_state->controlBlocks));
+}
+
+size_t
+ReceiveBufferPool::getNIdle() const noexcept
+{
+  size_t nIdle = 0;
+  for (const auto& sizeClass : m_state->sizeClasses) {
+    nIdle += sizeClass.idle.size();
+  }
+  return nIdle;
+}
+
+uint64_t
+ReceiveBufferPool::getNAllocations() const noexcept
+{
+  return m_state->nAllocations;
+}
+
+} // namespace face
+} // namespace nfd
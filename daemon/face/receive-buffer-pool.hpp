@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_RECEIVE_BUFFER_POOL_HPP
+#define NFD_DAEMON_FACE_RECEIVE_BUFFER_POOL_HPP
+
+#include "core/common.hpp"
+
+#include <ndn-cxx/encoding/buffer.hpp>
+
+namespace nfd {
+
+class FixedSizePool;
+
+namespace face {
+
+/** \brief A pool of buffers into which packets are received.
+ *
+ *  Buffers come in size classes: getBufferSize(), then half of the previous size, down to
+ *  MIN_BUFFER_SIZE. A receiver that knows the size of the next packet obtains a buffer of the
+ *  smallest class that fits it, so the packet covers more than half of its buffer.
+ *
+ *  A buffer obtained from acquire() goes back to the pool when its last reference is released,
+ *  so that a Block wrapping it can be passed up the stack without copying. The shared_ptr control
+ *  blocks are also allocated from a pool, so a recycled buffer costs no heap allocation.
+ *  Buffers released after the pool has been destroyed are freed.
+ *
+ *  \warning This class is not thread-safe.
+ */
+class ReceiveBufferPool : noncopyable
+{
+public:
+  explicit
+  ReceiveBufferPool(size_t bufferSize = ndn::MAX_NDN_PACKET_SIZE, size_t maxIdle = 16);
+
+  ~ReceiveBufferPool();
+
+  /** \brief Returns the size of the largest buffers
+   */
+  size_t
+  getBufferSize() const noexcept;
+
+  /** \brief Sets the maximum number of idle buffers kept for reuse in each size class
+   *
+   *  Buffers released while the pool already holds this many idle buffers of their size class
+   *  are freed.
+   */
+  void
+  setMaxIdle(size_t maxIdle) noexcept;
+
+  /** \brief Obtains a buffer of getBufferSize() octets with unspecified content
+   */
+  shared_ptr<ndn::Buffer>
+  acquire();
+
+  /** \brief Obtains a buffer of the smallest size class of at least \p minSize octets,
+   *         with unspecified content
+   *
+   *  If \p minSize exceeds getBufferSize(), a buffer of getBufferSize() octets is returned.
+   */
+  shared_ptr<ndn::Buffer>
+  acquire(size_t minSize);
+
+  /** \brief Returns the number of idle buffers in all size classes
+   */
+  size_t
+  getNIdle() const noexcept;
+
+  /** \brief Returns the number of buffers allocated from the heap
+   */
+  uint64_t
+  getNAllocations() const noexcept;
+
+public:
+  /// buffers are not split into size classes smaller than this
+  static constexpr size_t MIN_BUFFER_SIZE = 256;
+
+private:
+  struct State;
+  class Recycler;
+
+  shared_ptr<State> m_state;
+};
+
+/** \brief Determines whether a packet of \p nBytes octets may share a receive buffer of
+ *         \p bufferSize octets
+ *
+ *  A packet sharing its receive buffer keeps all of it alive for as long as the packet is
+ *  retained, e.g., by a PIT entry or the ContentStore. Only a packet covering at least half of
+ *  the buffer may do so, which holds for a buffer of the size class chosen for the packet.
+ *  Buffers of the smallest size class are always shared. Otherwise, the packet must be copied
+ *  into a buffer of its own size.
+ */
+constexpr bool
+canShareReceiveBuffer(size_t nBytes, size_t bufferSize) noexcept
+{
+  return nBytes * 2 >= bufferSize || bufferSize < 2 * ReceiveBufferPool::MIN_BUFFER_SIZE;
+}
+
+} // namespace face
+} // namespace nfd
+
+#endif // NFD_DAEMON_FACE_RECEIVE_BUFFER_POOL_HPP
@@ -30,20 +30,77 @@
 #include "socket-utils.hpp"
 #include "common/global.hpp"
 
-#include <queue>
+#include <deque>
 
 namespace nfd {
 namespace face {
 
+/** \brief Counters provided by StreamTransport.
+ *  \note The type name 'StreamTransportCounters' is implementation detail.
+ *        Use 'StreamTransport<Protocol>::Counters' in public API.
+ */
+class StreamTransportCounters : public virtual Transport::Counters
+{
+public:
+  /** \brief count of gathered write operations, each of which is one system call
+   */
+  PacketCounter nWriteCalls;
+
+  /** \brief count of packets (or unwritten remainders of packets) passed to gathered writes
+   *
+   *  nWritePackets / nWriteCalls is the average batch size.
+   */
+  PacketCounter nWritePackets;
+
+  /** \brief count of bytes written by gathered writes
+   */
+  ByteCounter nWrittenBytes;
+
+  /** \brief count of read operations that returned data
+   */
+  PacketCounter nReadCalls;
+
+  /** \brief count of bytes returned by read operations
+   */
+  ByteCounter nReadBytes;
+};
+
+/** \brief Options that control how StreamTransport coalesces outgoing packets.
+ */
+struct StreamTransportOptions
+{
+  /** \brief maximum number of bytes passed to one gathered write
+   *
+   *  A packet larger than this limit is written alone.
+   */
+  size_t maxWriteBytes = 65536;
+
+  /** \brief maximum time a packet may wait for more packets to be coalesced with it
+   *
+   *  If zero, packets are written as soon as no other write is in progress.
+   *  Otherwise, a write is started when this delay expires or when maxWriteBytes have been queued.
+   */
+  time::nanoseconds maxWriteDelay = 0_ns;
+};
+
 /** \brief Implements Transport for stream-based protocols.
+ *
+ *  Outgoing packets are queued and written with gathered writes: while a write is in progress,
+ *  or while waiting for StreamTransportOptions::maxWriteDelay, newly sent packets accumulate in
+ *  the queue and the next write passes as many of them as allowed to a single system call.
+ *  Incoming bytes are read into a buffer that can hold several packets, so that one read can
+ *  deliver multiple TLV elements.
  *
  *  \tparam Protocol a stream-based protocol in Boost.Asio
  */
 template<class Protocol>
 class StreamTransport : public Transport
+                      , protected virtual StreamTransportCounters
 {
 public:
   using protocol = Protocol;
+  using Options = StreamTransportOptions;
+  using Counters = StreamTransportCounters;
 
   /** \brief Construct stream transport.
    *
@@ -52,9 +109,31 @@ public:
   explicit
   StreamTransport(typename protocol::socket&& socket);
 
+  const Counters&
+  getCounters() const override
+  {
+    return *this;
+  }
+
   ssize_t
   getSendQueueLength() override;
 
+  const Options&
+  getOptions() const
+  {
+    return m_options;
+  }
+
+  /** \brief Set the options used for subsequent writes
+   *  \pre options.maxWriteBytes > 0
+   */
+  void
+  setOptions(const Options& options)
+  {
+    BOOST_ASSERT(options.maxWriteBytes > 0);
+    m_options = options;
+  }
+
 protected:
   void
   doClose() override;
@@ -100,12 +179,35 @@ protected:
   NFD_LOG_MEMBER_DECL();
 
 private:
-  uint8_t m_receiveBuffer[ndn::MAX_NDN_PACKET_SIZE];
+  /** \brief size of the receive buffer, large enough for several packets to be read at once
+   */
+  static constexpr size_t RECEIVE_BUFFER_SIZE = 4 * ndn::MAX_NDN_PACKET_SIZE;
+
+  /** \brief maximum number of buffers passed to one gathered write
+   *
+   *  Boost.Asio does not pass more than 64 buffers to a single system call.
+   */
+  static constexpr size_t MAX_WRITE_BUFFERS = 64;
+
+  Options m_options;
+  uint8_t m_receiveBuffer[RECEIVE_BUFFER_SIZE];
   size_t m_receiveBufferSize;
-  std::queue<Block> m_sendQueue;
+  std::deque<Block> m_sendQueue;
+  /// number of bytes at the front of m_sendQueue.front() that have already been written
+  size_t m_sendOffset = 0;
+  /// number of bytes in m_sendQueue that have not been written yet
   size_t m_sendQueueBytes;
+  std::vector<boost::asio::const_buffer> m_writeBuffers;
+  scheduler::ScopedEventId m_flushEvent;
+  bool m_isWriting = false;
 };
 
+template<class T>
+constexpr size_t StreamTransport<T>::RECEIVE_BUFFER_SIZE;
+
+template<class T>
+constexpr size_t StreamTransport<T>::MAX_WRITE_BUFFERS;
+
 
 template<class T>
 StreamTransport<T>::StreamTransport(typename StreamTransport::protocol::socket&& socket)
@@ -188,19 +290,53 @@ StreamTransport<T>::doSend(const Block& packet)
     return;
 
   bool wasQueueEmpty = m_sendQueue.empty();
-  m_sendQueue.push(packet);
+  m_sendQueue.push_back(packet);
   m_sendQueueBytes += packet.size();
 
-  if (wasQueueEmpty)
+  if (m_isWriting) {
+    // queued packets will be written when the current write completes
+    return;
+  }
+
+  if (m_options.maxWriteDelay <= 0_ns || m_sendQueueBytes >= m_options.maxWriteBytes) {
     sendFromQueue();
+  }
+  else if (wasQueueEmpty) {
+    // otherwise, the flush is already scheduled
+    m_flushEvent = getScheduler().schedule(m_options.maxWriteDelay, [this] { sendFromQueue(); });
+  }
 }
 
 template<class T>
 void
 StreamTransport<T>::sendFromQueue()
 {
-  boost::asio::async_write(m_socket, boost::asio::buffer(m_sendQueue.front()),
-                           [this] (auto&&... args) { this->handleSend(std::forward<decltype(args)>(args)...); });
+  BOOST_ASSERT(!m_sendQueue.empty());
+  BOOST_ASSERT(!m_isWriting);
+  m_flushEvent.cancel();
+
+  // gather as many queued packets as allowed, resuming a partially written packet at the front
+  m_writeBuffers.clear();
+  size_t nBytes = 0;
+  size_t offset = m_sendOffset;
+  for (const Block& packet : m_sendQueue) {
+    auto buffer = boost::asio::buffer(packet.data() + offset, packet.size() - offset);
+    offset = 0;
+    if (m_writeBuffers.size() == MAX_WRITE_BUFFERS ||
+        (!m_writeBuffers.empty() && nBytes + buffer.size() > m_options.maxWriteBytes)) {
+      break;
+    }
+    m_writeBuffers.push_back(buffer);
+    nBytes += buffer.size();
+  }
+
+  ++this->nWriteCalls;
+  this->nWritePackets += m_writeBuffers.size();
+  m_isWriting = true;
+  // Blocks in m_sendQueue stay in place until written, because std::deque::push_back
+  // does not invalidate references to existing elements
+  m_socket.async_write_some(m_writeBuffers,
+                            [this] (auto&&... args) { this->handleSend(std::forward<decltype(args)>(args)...); });
 }
 
 template<class T>
@@ -208,16 +344,31 @@ void
 StreamTransport<T>::handleSend(const boost::system::error_code& error,
                                size_t nBytesSent)
 {
+  m_isWriting = false;
+
   if (error)
     return processErrorCode(error);
 
   NFD_LOG_FACE_TRACE("Successfully sent: " << nBytesSent << " bytes");
 
-  BOOST_ASSERT(!m_sendQueue.empty());
-  BOOST_ASSERT(m_sendQueue.front().size() == nBytesSent);
+  if (m_sendQueue.empty()) {
+    // the queue has been reset while the write was in progress
+    return;
+  }
+
+  BOOST_ASSERT(nBytesSent <= m_sendQueueBytes);
+  this->nWrittenBytes += nBytesSent;
   m_sendQueueBytes -= nBytesSent;
-  m_sendQueue.pop();
 
+  // pop the packets that have been written completely
+  size_t nBytes = m_sendOffset + nBytesSent;
+  while (!m_sendQueue.empty() && nBytes >= m_sendQueue.front().size()) {
+    nBytes -= m_sendQueue.front().size();
+    m_sendQueue.pop_front();
+  }
+  m_sendOffset = nBytes;
+
+  // packets queued during the write have already waited, so write them right away
   if (!m_sendQueue.empty())
     sendFromQueue();
 }
@@ -229,7 +380,7 @@ StreamTransport<T>::startReceive()
   BOOST_ASSERT(getState() == TransportState::UP);
 
   m_socket.async_receive(boost::asio::buffer(m_receiveBuffer + m_receiveBufferSize,
-                                             ndn::MAX_NDN_PACKET_SIZE - m_receiveBufferSize),
+                                             RECEIVE_BUFFER_SIZE - m_receiveBufferSize),
                          [this] (auto&&... args) { this->handleReceive(std::forward<decltype(args)>(args)...); });
 }
 
@@ -243,23 +394,35 @@ StreamTransport<T>::handleReceive(const boost::system::error_code& error,
 
   NFD_LOG_FACE_TRACE("Received: " << nBytesReceived << " bytes");
 
+  ++this->nReadCalls;
+  this->nReadBytes += nBytesReceived;
+
   m_receiveBufferSize += nBytesReceived;
   auto bufferView = ndn::make_span(m_receiveBuffer, m_receiveBufferSize);
   size_t offset = 0;
-  bool isOk = true;
+  bool isTooLarge = false;
   while (offset < bufferView.size()) {
+    bool isOk = false;
     Block element;
     std::tie(isOk, element) = Block::fromBuffer(bufferView.subspan(offset));
-    if (!isOk)
+    if (!isOk) {
+      // an incomplete element that does not fit in MAX_NDN_PACKET_SIZE octets is too large
+      isTooLarge = bufferView.size() - offset >= ndn::MAX_NDN_PACKET_SIZE;
       break;
+    }
+    if (element.size() > ndn::MAX_NDN_PACKET_SIZE) {
+      isTooLarge = true;
+      break;
+    }
 
     offset += element.size();
     BOOST_ASSERT(offset <= bufferView.size());
 
+    ++this->nInPacketCopies;
     this->receive(element);
   }
 
-  if (!isOk && m_receiveBufferSize == ndn::MAX_NDN_PACKET_SIZE && offset == 0) {
+  if (isTooLarge) {
     NFD_LOG_FACE_ERROR("Failed to parse incoming packet or packet too large to process");
     this->setState(TransportState::FAILED);
     doClose();
@@ -321,9 +484,11 @@ template<class T>
 void
 StreamTransport<T>::resetSendQueue()
 {
-  std::queue<Block> emptyQueue;
+  std::deque<Block> emptyQueue;
   std::swap(emptyQueue, m_sendQueue);
+  m_sendOffset = 0;
   m_sendQueueBytes = 0;
+  m_flushEvent.cancel();
 }
 
 template<class T>
@@ -137,6 +137,7 @@ TcpChannel::createFace(ip::tcp::socket&& socket,
     auto faceScope = m_determineFaceScope(socket.local_endpoint().address(),
                                           socket.remote_endpoint().address());
     auto transport = make_unique<TcpTransport>(std::move(socket), params.persistency, faceScope);
+    transport->setOptions(m_transportOptions);
     face = make_shared<Face>(std::move(linkService), std::move(transport));
     face->setChannel(shared_from_this()); // use weak_from_this() in C++17
 
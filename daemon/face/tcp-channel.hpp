@@ -27,6 +27,7 @@
 #define NFD_DAEMON_FACE_TCP_CHANNEL_HPP
 
 #include "channel.hpp"
+#include "stream-transport.hpp"
 
 namespace nfd {
 
@@ -70,6 +71,22 @@ public:
     return m_channelFaces.size();
   }
 
+  const StreamTransportOptions&
+  getTransportOptions() const
+  {
+    return m_transportOptions;
+  }
+
+  /**
+   * \brief Set the transport options of faces created after this call
+   * \sa StreamTransport::setOptions
+   */
+  void
+  setTransportOptions(const StreamTransportOptions& options)
+  {
+    m_transportOptions = options;
+  }
+
   /**
    * \brief Enable listening on the local endpoint, accept connections,
    *        and create faces when remote host makes a connection
@@ -131,6 +148,7 @@ private:
   std::map<tcp::Endpoint, shared_ptr<Face>> m_channelFaces;
   bool m_wantCongestionMarking;
   DetermineFaceScopeFromAddress m_determineFaceScope;
+  StreamTransportOptions m_transportOptions;
 };
 
 } // namespace face
@@ -33,6 +33,11 @@ namespace ip = boost::asio::ip;
 NFD_LOG_INIT(TcpFactory);
 NFD_REGISTER_PROTOCOL_FACTORY(TcpFactory);
 
+/// upper bound of face_system.tcp.max_write_bytes
+const size_t MAX_WRITE_BYTES = 1048576;
+/// upper bound of face_system.tcp.max_write_delay, in microseconds
+const uint32_t MAX_WRITE_DELAY = 100000;
+
 const std::string&
 TcpFactory::getId() noexcept
 {
@@ -50,6 +55,8 @@ TcpFactory::doProcessConfig(OptionalConfigSection configSection,
   //   port 6363
   //   enable_v4 yes
   //   enable_v6 yes
+  //   max_write_bytes 65536
+  //   max_write_delay 0
   // }
 
   m_wantCongestionMarking = context.generalConfig.wantCongestionMarking;
@@ -67,6 +74,7 @@ TcpFactory::doProcessConfig(OptionalConfigSection configSection,
   bool enableV6 = true;
   IpAddressPredicate local;
   bool isLocalConfigured = false;
+  StreamTransportOptions transportOptions;
 
   for (const auto& pair : *configSection) {
     const std::string& key = pair.first;
@@ -83,6 +91,16 @@ TcpFactory::doProcessConfig(OptionalConfigSection configSection,
     else if (key == "enable_v6") {
       enableV6 = ConfigFile::parseYesNo(pair, "face_system.tcp");
     }
+    else if (key == "max_write_bytes") {
+      transportOptions.maxWriteBytes = ConfigFile::parseNumber<size_t>(pair, "face_system.tcp");
+      ConfigFile::checkRange(transportOptions.maxWriteBytes, static_cast<size_t>(1), MAX_WRITE_BYTES,
+                             "max_write_bytes", "face_system.tcp");
+    }
+    else if (key == "max_write_delay") {
+      auto delay = ConfigFile::parseNumber<uint32_t>(pair, "face_system.tcp");
+      ConfigFile::checkRange(delay, 0U, MAX_WRITE_DELAY, "max_write_delay", "face_system.tcp");
+      transportOptions.maxWriteDelay = time::microseconds(delay);
+    }
     else if (key == "local") {
       isLocalConfigured = true;
       for (const auto& localPair : pair.second) {
@@ -121,6 +139,7 @@ TcpFactory::doProcessConfig(OptionalConfigSection configSection,
   if (enableV4) {
     tcp::Endpoint endpoint(ip::tcp::v4(), port);
     auto v4Channel = this->createChannel(endpoint);
+    v4Channel->setTransportOptions(transportOptions);
     if (wantListen && !v4Channel->isListening()) {
       v4Channel->listen(this->addFace, nullptr);
     }
@@ -133,6 +152,7 @@ TcpFactory::doProcessConfig(OptionalConfigSection configSection,
   if (enableV6) {
     tcp::Endpoint endpoint(ip::tcp::v6(), port);
     auto v6Channel = this->createChannel(endpoint);
+    v6Channel->setTransportOptions(transportOptions);
     if (wantListen && !v6Channel->isListening()) {
       v6Channel->listen(this->addFace, nullptr);
     }
@@ -84,6 +84,19 @@ public:
    *  This counter is increased only if transport is UP.
    */
   ByteCounter nOutBytes;
+
+  /** \brief count of incoming packets copied out of the transport's receive buffer
+   *
+   *  A transport that hands its receive buffers to the link service without copying
+   *  does not increment this counter for those packets.
+   */
+  PacketCounter nInPacketCopies;
+
+  /** \brief count of receive buffers allocated from the heap
+   *
+   *  This counter stays at zero for a transport that does not use a ReceiveBufferPool.
+   */
+  PacketCounter nInBufferAllocations;
 };
 
 /** \brief indicates the transport has no limit on payload size
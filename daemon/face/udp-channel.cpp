@@ -188,6 +188,7 @@ UdpChannel::createFace(const udp::Endpoint& remoteEndpoint,
   auto linkService = make_unique<GenericLinkService>(options);
   auto transport = make_unique<UnicastUdpTransport>(std::move(socket), params.persistency,
                                                     m_idleFaceTimeout);
+  transport->setIoBatchSize(m_ioBatchSize);
   auto face = make_shared<Face>(std::move(linkService), std::move(transport));
   face->setChannel(shared_from_this()); // use weak_from_this() in C++17
 
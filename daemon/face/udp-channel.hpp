@@ -64,6 +64,23 @@ public:
     return m_channelFaces.size();
   }
 
+  size_t
+  getIoBatchSize() const
+  {
+    return m_ioBatchSize;
+  }
+
+  /**
+   * \brief Set the I/O batch size of faces created after this call
+   * \sa DatagramTransport::setIoBatchSize
+   */
+  void
+  setIoBatchSize(size_t n)
+  {
+    BOOST_ASSERT(n > 0);
+    m_ioBatchSize = n;
+  }
+
   /**
    * \brief Create a unicast UDP face toward \p remoteEndpoint
    */
@@ -115,6 +132,7 @@ private:
   std::map<udp::Endpoint, shared_ptr<Face>> m_channelFaces;
   const time::nanoseconds m_idleFaceTimeout; ///< Timeout for automatic closure of idle on-demand faces
   bool m_wantCongestionMarking;
+  size_t m_ioBatchSize = 1;
 };
 
 } // namespace face
@@ -40,6 +40,9 @@ namespace net = ndn::net;
 NFD_LOG_INIT(UdpFactory);
 NFD_REGISTER_PROTOCOL_FACTORY(UdpFactory);
 
+/// upper bound of face_system.udp.io_batch_size
+const size_t MAX_IO_BATCH_SIZE = 1024;
+
 const std::string&
 UdpFactory::getId() noexcept
 {
@@ -67,6 +70,7 @@ UdpFactory::doProcessConfig(OptionalConfigSection configSection,
   //   enable_v6 yes
   //   idle_timeout 600
   //   unicast_mtu 8800
+  //   io_batch_size 1
   //   mcast yes
   //   mcast_group 224.0.23.170
   //   mcast_port 56363
@@ -90,6 +94,7 @@ UdpFactory::doProcessConfig(OptionalConfigSection configSection,
   bool enableV6 = false;
   uint32_t idleTimeout = 600;
   size_t unicastMtu = ndn::MAX_NDN_PACKET_SIZE;
+  size_t ioBatchSize = 1;
   MulticastConfig mcastConfig;
 
   if (configSection) {
@@ -120,6 +125,11 @@ UdpFactory::doProcessConfig(OptionalConfigSection configSection,
         ConfigFile::checkRange(unicastMtu, static_cast<size_t>(MIN_MTU), ndn::MAX_NDN_PACKET_SIZE,
                                "unicast_mtu", "face_system.udp");
       }
+      else if (key == "io_batch_size") {
+        ioBatchSize = ConfigFile::parseNumber<size_t>(pair, "face_system.udp");
+        ConfigFile::checkRange(ioBatchSize, static_cast<size_t>(1), MAX_IO_BATCH_SIZE,
+                               "io_batch_size", "face_system.udp");
+      }
       else if (key == "keep_alive_interval") {
         // ignored
       }
@@ -185,10 +195,12 @@ UdpFactory::doProcessConfig(OptionalConfigSection configSection,
   }
 
   m_defaultUnicastMtu = unicastMtu;
+  m_ioBatchSize = ioBatchSize;
 
   if (enableV4) {
     udp::Endpoint endpoint(ip::udp::v4(), port);
     shared_ptr<UdpChannel> v4Channel = this->createChannel(endpoint, time::seconds(idleTimeout));
+    v4Channel->setIoBatchSize(m_ioBatchSize);
     if (wantListen && !v4Channel->isListening()) {
       v4Channel->listen(this->addFace, nullptr);
     }
@@ -202,6 +214,7 @@ UdpFactory::doProcessConfig(OptionalConfigSection configSection,
   if (enableV6) {
     udp::Endpoint endpoint(ip::udp::v6(), port);
     shared_ptr<UdpChannel> v6Channel = this->createChannel(endpoint, time::seconds(idleTimeout));
+    v6Channel->setIoBatchSize(m_ioBatchSize);
     if (wantListen && !v6Channel->isListening()) {
       v6Channel->listen(this->addFace, nullptr);
     }
@@ -367,6 +380,7 @@ UdpFactory::createMulticastFace(const shared_ptr<const net::NetworkInterface>& n
   auto linkService = make_unique<GenericLinkService>(options);
   auto transport = make_unique<MulticastUdpTransport>(mcastEp, std::move(rxSock), std::move(txSock),
                                                       m_mcastConfig.linkType);
+  transport->setIoBatchSize(m_ioBatchSize);
   auto face = make_shared<Face>(std::move(linkService), std::move(transport));
 
   m_mcastFaces[localEp] = face;
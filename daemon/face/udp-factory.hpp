@@ -124,6 +124,7 @@ private:
 private:
   bool m_wantCongestionMarking = false;
   size_t m_defaultUnicastMtu = ndn::MAX_NDN_PACKET_SIZE;
+  size_t m_ioBatchSize = 1;
   std::map<udp::Endpoint, shared_ptr<UdpChannel>> m_channels;
 
   struct MulticastConfig
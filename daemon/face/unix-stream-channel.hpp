@@ -27,6 +27,7 @@
 #define NFD_DAEMON_FACE_UNIX_STREAM_CHANNEL_HPP
 
 #include "channel.hpp"
+#include "stream-transport.hpp"
 
 namespace nfd {
 
@@ -80,6 +81,22 @@ public:
     return m_size;
   }
 
+  const StreamTransportOptions&
+  getTransportOptions() const
+  {
+    return m_transportOptions;
+  }
+
+  /**
+   * \brief Set the transport options of faces created after this call
+   * \sa StreamTransport::setOptions
+   */
+  void
+  setTransportOptions(const StreamTransportOptions& options)
+  {
+    m_transportOptions = options;
+  }
+
   /**
    * \brief Start listening
    *
@@ -116,6 +133,7 @@ private:
   boost::asio::local::stream_protocol::socket m_socket;
   size_t m_size;
   bool m_wantCongestionMarking;
+  StreamTransportOptions m_transportOptions;
 };
 
 } // namespace face
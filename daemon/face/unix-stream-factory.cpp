@@ -33,6 +33,11 @@ namespace face {
 NFD_LOG_INIT(UnixStreamFactory);
 NFD_REGISTER_PROTOCOL_FACTORY(UnixStreamFactory);
 
+/// upper bound of face_system.unix.max_write_bytes
+const size_t MAX_WRITE_BYTES = 1048576;
+/// upper bound of face_system.unix.max_write_delay, in microseconds
+const uint32_t MAX_WRITE_DELAY = 100000;
+
 const std::string&
 UnixStreamFactory::getId() noexcept
 {
@@ -48,6 +53,8 @@ UnixStreamFactory::doProcessConfig(OptionalConfigSection configSection,
   // {
   //   path /run/nfd.sock        ; on Linux
   //   path /var/run/nfd.sock    ; on other platforms
+  //   max_write_bytes 65536
+  //   max_write_delay 0
   // }
 
   m_wantCongestionMarking = context.generalConfig.wantCongestionMarking;
@@ -64,6 +71,7 @@ UnixStreamFactory::doProcessConfig(OptionalConfigSection configSection,
 #else
   std::string path = "/var/run/nfd.sock";
 #endif // __linux__
+  StreamTransportOptions transportOptions;
 
   for (const auto& pair : *configSection) {
     const std::string& key = pair.first;
@@ -72,6 +80,16 @@ UnixStreamFactory::doProcessConfig(OptionalConfigSection configSection,
     if (key == "path") {
       path = value.get_value<std::string>();
     }
+    else if (key == "max_write_bytes") {
+      transportOptions.maxWriteBytes = ConfigFile::parseNumber<size_t>(pair, "face_system.unix");
+      ConfigFile::checkRange(transportOptions.maxWriteBytes, static_cast<size_t>(1), MAX_WRITE_BYTES,
+                             "max_write_bytes", "face_system.unix");
+    }
+    else if (key == "max_write_delay") {
+      auto delay = ConfigFile::parseNumber<uint32_t>(pair, "face_system.unix");
+      ConfigFile::checkRange(delay, 0U, MAX_WRITE_DELAY, "max_write_delay", "face_system.unix");
+      transportOptions.maxWriteDelay = time::microseconds(delay);
+    }
     else {
       NDN_THROW(ConfigFile::Error("Unrecognized option face_system.unix." + key));
     }
@@ -82,6 +100,7 @@ UnixStreamFactory::doProcessConfig(OptionalConfigSection configSection,
   }
 
   auto channel = this->createChannel(path);
+  channel->setTransportOptions(transportOptions);
   if (!channel->isListening()) {
     channel->listen(this->addFace, nullptr);
   }
@@ -104,6 +104,7 @@ WebSocketTransport::receiveMessage(const std::string& msg)
     return;
   }
 
+  ++this->nInPacketCopies;
   this->receive(element);
 }
 
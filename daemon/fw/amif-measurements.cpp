@@ -0,0 +1,282 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "amif-measurements.hpp"
+
+namespace nfd {
+namespace fw {
+namespace amif {
+
+constexpr size_t PathTable::MAX_PATHS;
+
+PathTable::PathTable()
+{
+  m_paths.reserve(MAX_PATHS);
+  m_candidates.reserve(MAX_PATHS);
+  m_selected.reserve(MAX_PATHS);
+}
+
+PathStats*
+PathTable::findPath(FaceId outFace)
+{
+  auto it = std::find_if(m_paths.begin(), m_paths.end(),
+                         [outFace] (const PathStats& path) { return path.outFace == outFace; });
+  return it != m_paths.end() ? &*it : nullptr;
+}
+
+PathStats*
+PathTable::insertPath(FaceId outFace)
+{
+  PathStats* path = findPath(outFace);
+  if (path != nullptr) {
+    return path;
+  }
+  if (m_paths.size() >= MAX_PATHS) {
+    return nullptr;
+  }
+
+  m_paths.emplace_back();
+  path = &m_paths.back();
+  path->outFace = outFace;
+  heapPush(m_candidates, static_cast<uint8_t>(m_paths.size() - 1));
+  return path;
+}
+
+bool
+PathTable::erasePath(FaceId outFace)
+{
+  PathStats* path = findPath(outFace);
+  if (path == nullptr) {
+    return false;
+  }
+
+  heapErase(getHeap(*path), path->heapIndex);
+
+  // fill the hole with the last path, and redirect its heap slot
+  size_t index = static_cast<size_t>(path - m_paths.data());
+  size_t last = m_paths.size() - 1;
+  if (index != last) {
+    m_paths[index] = std::move(m_paths[last]);
+    getHeap(m_paths[index])[m_paths[index].heapIndex] = static_cast<uint8_t>(index);
+  }
+  m_paths.pop_back();
+  return true;
+}
+
+PathStats*
+PathTable::getBestCandidate()
+{
+  return m_candidates.empty() ? nullptr : &m_paths[m_candidates.front()];
+}
+
+PathStats*
+PathTable::getBestSelected()
+{
+  return m_selected.empty() ? nullptr : &m_paths[m_selected.front()];
+}
+
+void
+PathTable::setDegree(PathStats& path, double degree)
+{
+  path.degree = degree;
+  if (!path.isSelected) {
+    heapUpdate(m_candidates, path.heapIndex);
+  }
+}
+
+void
+PathTable::setQuota(PathStats& path, double quota)
+{
+  path.quota = quota;
+  if (path.isSelected) {
+    heapUpdate(m_selected, path.heapIndex);
+  }
+}
+
+void
+PathTable::selectPath(PathStats& path)
+{
+  if (path.isSelected) {
+    return;
+  }
+
+  uint8_t index = m_candidates[path.heapIndex];
+  heapErase(m_candidates, path.heapIndex);
+  path.isSelected = true;
+  heapPush(m_selected, index);
+}
+
+void
+PathTable::unselectAll()
+{
+  for (uint8_t index : m_selected) {
+    m_paths[index].isSelected = false;
+    heapPush(m_candidates, index);
+  }
+  m_selected.clear();
+}
+
+bool
+PathTable::advanceQuotaPeriod(int periodLength)
+{
+  if (++m_periodCount < periodLength) {
+    return false;
+  }
+  m_periodCount = 0;
+  return true;
+}
+
+void
+PathTable::heapPush(Heap& heap, uint8_t index)
+{
+  m_paths[index].heapIndex = static_cast<uint8_t>(heap.size());
+  heap.push_back(index);
+  siftUp(heap, heap.size() - 1);
+}
+
+void
+PathTable::heapErase(Heap& heap, size_t pos)
+{
+  BOOST_ASSERT(pos < heap.size());
+
+  size_t last = heap.size() - 1;
+  if (pos != last) {
+    heapSwap(heap, pos, last);
+  }
+  heap.pop_back();
+
+  if (pos < heap.size()) {
+    heapUpdate(heap, pos);
+  }
+}
+
+void
+PathTable::heapUpdate(Heap& heap, size_t pos)
+{
+  if (pos > 0 && getKey(m_paths[heap[pos]]) > getKey(m_paths[heap[(pos - 1) / 2]])) {
+    siftUp(heap, pos);
+  }
+  else {
+    siftDown(heap, pos);
+  }
+}
+
+void
+PathTable::siftUp(Heap& heap, size_t pos)
+{
+  while (pos > 0) {
+    size_t parent = (pos - 1) / 2;
+    if (!(getKey(m_paths[heap[pos]]) > getKey(m_paths[heap[parent]]))) {
+      break;
+    }
+    heapSwap(heap, pos, parent);
+    pos = parent;
+  }
+}
+
+void
+PathTable::siftDown(Heap& heap, size_t pos)
+{
+  size_t size = heap.size();
+  while (true) {
+    size_t largest = pos;
+    size_t left = 2 * pos + 1;
+    size_t right = left + 1;
+    if (left < size && getKey(m_paths[heap[left]]) > getKey(m_paths[heap[largest]])) {
+      largest = left;
+    }
+    if (right < size && getKey(m_paths[heap[right]]) > getKey(m_paths[heap[largest]])) {
+      largest = right;
+    }
+    if (largest == pos) {
+      break;
+    }
+    heapSwap(heap, pos, largest);
+    pos = largest;
+  }
+}
+
+void
+PathTable::heapSwap(Heap& heap, size_t a, size_t b)
+{
+  std::swap(heap[a], heap[b]);
+  m_paths[heap[a]].heapIndex = static_cast<uint8_t>(a);
+  m_paths[heap[b]].heapIndex = static_cast<uint8_t>(b);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+constexpr time::microseconds AmifMeasurements::MEASUREMENTS_LIFETIME;
+
+AmifMeasurements::AmifMeasurements(MeasurementsAccessor& measurements)
+  : m_measurements(measurements)
+{
+}
+
+PathTable*
+AmifMeasurements::getPathTable(const Name& prefix)
+{
+  auto* me = m_measurements.findLongestPrefixMatch(prefix);
+  if (me == nullptr) {
+    return nullptr;
+  }
+
+  extendLifetime(*me);
+  return me->getStrategyInfo<PathTable>();
+}
+
+PathTable&
+AmifMeasurements::getOrCreatePathTable(const fib::Entry& fibEntry, const Name& prefix)
+{
+  auto* me = m_measurements.get(fibEntry);
+
+  // If the FIB entry is not under the strategy's namespace, find a part of the prefix
+  // that falls under the strategy's namespace
+  for (size_t prefixLen = fibEntry.getPrefix().size() + 1;
+       me == nullptr && prefixLen <= prefix.size();
+       ++prefixLen) {
+    me = m_measurements.get(prefix.getPrefix(prefixLen));
+  }
+
+  // Either the FIB entry or the Interest's name must be under this strategy's namespace
+  BOOST_ASSERT(me != nullptr);
+
+  extendLifetime(*me);
+
+  PathTable* table = me->insertStrategyInfo<PathTable>().first;
+  BOOST_ASSERT(table != nullptr);
+  return *table;
+}
+
+void
+AmifMeasurements::extendLifetime(measurements::Entry& me)
+{
+  m_measurements.extendLifetime(me, MEASUREMENTS_LIFETIME);
+}
+
+} // namespace amif
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,222 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_AMIF_MEASUREMENTS_HPP
+#define NFD_DAEMON_FW_AMIF_MEASUREMENTS_HPP
+
+#include "fw/strategy-info.hpp"
+#include "table/measurements-accessor.hpp"
+
+namespace nfd {
+namespace fw {
+namespace amif {
+
+/** \brief Statistics of one path towards a prefix, identified by its upstream face
+ */
+struct PathStats
+{
+  FaceId outFace = face::INVALID_FACEID;
+  std::string id;          ///< route record collected during path discovery
+  double minBw = 0.0;      ///< bottleneck bandwidth, in kilobytes
+  double delay = 0.0;      ///< in milliseconds
+  double throughput = 0.0;
+  double degree = 0.0;     ///< rank of a candidate path during path selection
+  double quota = 0.0;      ///< remaining Data quota of a selected path
+  bool isSelected = false;
+  uint8_t heapIndex = 0;   ///< position in the candidate or selected heap, managed by PathTable
+};
+
+/** \brief Per-prefix path database of AMIFStrategy
+ *
+ *  Paths are partitioned into candidates, i.e. paths learned during path discovery, and
+ *  selected paths, i.e. paths that carry traffic during data distribution.
+ *  Candidates are kept in a max-heap ordered by degree, and selected paths in a max-heap
+ *  ordered by remaining quota, so that changing the degree or quota of a path costs
+ *  O(log k) in the number of paths. The table holds at most MAX_PATHS paths.
+ */
+class PathTable final : public StrategyInfo
+{
+public:
+  static constexpr int
+  getTypeId()
+  {
+    return 1050;
+  }
+
+  static constexpr size_t MAX_PATHS = 16;
+
+  PathTable();
+
+  size_t
+  size() const
+  {
+    return m_paths.size();
+  }
+
+  size_t
+  getCandidateCount() const
+  {
+    return m_candidates.size();
+  }
+
+  size_t
+  getSelectedCount() const
+  {
+    return m_selected.size();
+  }
+
+  PathStats*
+  findPath(FaceId outFace);
+
+  /** \brief finds or inserts a candidate path through \p outFace
+   *  \return the path, or nullptr if the table is full
+   */
+  PathStats*
+  insertPath(FaceId outFace);
+
+  /** \brief erases the path through \p outFace
+   *  \return whether a path was erased
+   */
+  bool
+  erasePath(FaceId outFace);
+
+  /** \brief returns the candidate path with the highest degree, or nullptr if there is none
+   */
+  PathStats*
+  getBestCandidate();
+
+  /** \brief returns the selected path with the highest remaining quota, or nullptr if there is none
+   */
+  PathStats*
+  getBestSelected();
+
+  void
+  setDegree(PathStats& path, double degree);
+
+  void
+  setQuota(PathStats& path, double quota);
+
+  /** \brief moves a candidate path into the selected set
+   */
+  void
+  selectPath(PathStats& path);
+
+  /** \brief moves all selected paths back into the candidate set
+   */
+  void
+  unselectAll();
+
+  /** \brief counts one quota refresh of this prefix
+   *  \return true once every \p periodLength refreshes, i.e. when quotas should be computed
+   *          from path scores instead of degrees
+   */
+  bool
+  advanceQuotaPeriod(int periodLength);
+
+  std::vector<PathStats>::iterator
+  begin()
+  {
+    return m_paths.begin();
+  }
+
+  std::vector<PathStats>::iterator
+  end()
+  {
+    return m_paths.end();
+  }
+
+private:
+  using Heap = std::vector<uint8_t>;
+
+  Heap&
+  getHeap(const PathStats& path)
+  {
+    return path.isSelected ? m_selected : m_candidates;
+  }
+
+  static double
+  getKey(const PathStats& path)
+  {
+    return path.isSelected ? path.quota : path.degree;
+  }
+
+  void
+  heapPush(Heap& heap, uint8_t index);
+
+  void
+  heapErase(Heap& heap, size_t pos);
+
+  void
+  heapUpdate(Heap& heap, size_t pos);
+
+  void
+  siftUp(Heap& heap, size_t pos);
+
+  void
+  siftDown(Heap& heap, size_t pos);
+
+  void
+  heapSwap(Heap& heap, size_t a, size_t b);
+
+private:
+  std::vector<PathStats> m_paths;
+  Heap m_candidates; ///< max-heap of indices into m_paths, by degree
+  Heap m_selected;   ///< max-heap of indices into m_paths, by quota
+  int m_periodCount = 0;
+};
+
+/** \brief Helper class to retrieve and create AMIF path tables
+ *
+ *  Path tables are attached to Measurements entries, which are erased after
+ *  MEASUREMENTS_LIFETIME without traffic, so that idle prefixes release their paths.
+ */
+class AmifMeasurements : noncopyable
+{
+public:
+  explicit
+  AmifMeasurements(MeasurementsAccessor& measurements);
+
+  PathTable*
+  getPathTable(const Name& prefix);
+
+  PathTable&
+  getOrCreatePathTable(const fib::Entry& fibEntry, const Name& prefix);
+
+private:
+  void
+  extendLifetime(measurements::Entry& me);
+
+public:
+  static constexpr time::microseconds MEASUREMENTS_LIFETIME = 1_min;
+
+private:
+  MeasurementsAccessor& m_measurements;
+};
+
+} // namespace amif
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_AMIF_MEASUREMENTS_HPP
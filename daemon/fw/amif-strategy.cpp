@@ -1,359 +1,309 @@
-
 #include "amif-strategy.hpp"
 #include "algorithm.hpp"
-#include "common/global.hpp"
 #include "common/logger.hpp"
-#include "rib/service.hpp"
+
 #include <ndn-cxx/lp/empty-value.hpp>
-#include <ndn-cxx/lp/prefix-announcement-header.hpp>
 #include <ndn-cxx/lp/tags.hpp>
+
 #include <boost/range/adaptor/reversed.hpp>
+
 namespace nfd {
-  namespace fw {
-
-    int db_index = 0;
-    int db_m_index = 0;
-    string current_prefix = "/prefix";
-    int counter = 0;
-    double alfa = 0.5;
-    double beta = 0.5;
-    // kilo bytes
-    double max_bw = 1000;
-    // mili second
-    double max_delay = 1000;
-    double min_bw;
-    nbw = 0, ndelay = 0, nthroughput;
-    const Data& lastData;
-
-    NFD_LOG_INIT(AMIFStrategy);
-    NFD_REGISTER_STRATEGY(AMIFStrategy);
-
-    // const time::milliseconds AMIFStrategy::ROUTE_RENEW_LIFETIME(10_min);
-
-    AMIFStrategy::AMIFStrategy(Forwarder& forwarder, const Name& name) : Strategy(forwarder) {
-      ParsedInstanceName parsed = parseInstanceName(name);
-      if (!parsed.parameters.empty()) {
-        NDN_THROW(std::invalid_argument("AMIFStrategy does not accept parameters"));
-      }
-      if (parsed.version && *parsed.version != getStrategyName()[-1].toVersion()) {
-        NDN_THROW(std::invalid_argument(
-          "AMIFStrategy does not support version " + to_string(*parsed.version)));
-      }
-      this->setInstanceName(makeInstanceName(name, getStrategyName()));
-      this->multipass_num_max = 4;
-      this->sufNumOfPath = 5;
-      this->period_count = 0;
-      this->pathToSendDataRound = 0;
-    }
+namespace fw {
 
-    const Name& AMIFStrategy::getStrategyName() {
-      static Name strategyName("/localhost/nfd/strategy/amif/%FD%01");
-      return strategyName;
-    }
-    double getdisjointness(int i, PathStats db_m[10]) {
-      
-      double disjointness = 0;
-      for (int j = 0; j < db_m_index; j++) {
-        // ndnsim\ns-3\src\ndnSIM\ndn-cxx\ndn-cxx\interest.hpp line 518
-        double shared = (1 / (1 + shared_node(db[i], db_m[j])));
-        disjointness += shared;
-      }
-    }
-    return disjointness;
-  }
-  //------------------------------------------- AFTER -- RECEIVE -- INTEREST -------------------------------------
-  void AMIFStrategy::afterReceiveInterest(const FaceEndpoint& ingress, const Interest& interest, const shared_ptr<pit::Entry>& pitEntry) {
-    const fib::Entry& fibEntry = this->lookupFib(*pitEntry);
-    const fib::NextHopList& nexthops = fibEntry.getNextHops();
-    //ndnsim\ns-3\src\ndnSIM\ndn-cxx\ndn-cxx\detail\tag-host.hpp line 43
-    bool pathDiscoveryPhase = interest.getTag<lp::PathDiscoveryPhaseTag>() != nullptr;
-    // src/ndnSIM/NFD/daemon/table/strategy-info-host.hpp line 63
-    auto inRecordInfo = pitEntry->getInRecord(ingress.face)->insertStrategyInfo<InRecordInfo>().first;
-    //!! check db 
-    for (int i = 0;i < db_index;i++) {
-      if (db[i].prefix == current_prefix) {
-        counter++;
-      }
-      if (counter >= this->sufNumOfPath) {
-        pathDiscoveryPhase = false;
-        break;
-      }
-    }
-    if (pathDiscoveryPhase) {
-      //!! Discovery Path Phase for incoming intrest
-      inRecordInfo->pathDiscoveryPhase = true;
-      // \ndnsim\ns-3\src\ndnSIM\ndn-cxx\ndn-cxx\detail\tag-host.hpp line  line 79
-      interest.setTag(make_shared<lp::PathDiscoveryPhaseTag>(lp::EmptyValue{}));
-      if (nexthops.empty()) {
-        // broadcast it if no matching FIB entry exists
-        broadcastInterest(interest, ingress.face, pitEntry);
-      }
-      else {
-        // multicast it with "discoveryPhase" mark if matching FIB entry exists
-        multicastInterest(interest, ingress.face, pitEntry, nexthops);
-      }
-    }
-    else {
-      //!! Selection Path Phase for incoming intrest
-      inRecordInfo->pathDiscoveryPhase = false;
-      if (nexthops.empty()) { // return NACK if no matching FIB entry exists
-        NFD_LOG_DEBUG("NACK discoveryPhase Interest=" << interest << " from=" << ingress << " noNextHop");
-        lp::NackHeader nackHeader;
-        nackHeader.setReason(lp::NackReason::NO_ROUTE);
-        this->sendNack(pitEntry, ingress, nackHeader);
-        this->rejectPendingInterest(pitEntry);
-      }
-      else {
-        // selection phase if matching FIB entry exists
-        // set db_m in this phase
-        double disjoin = 1;
-        for (int i = 0; i < db_index; i++) {
-          if (current_prefix != db[i].prefix) {
-            continue;
-          }
-          //ndelay
-        // \ndnsim\ns-3\src\ndnSIM\ndn-cxx\ndn-cxx\interest.hpp line 558
-          ndelay = interest.getDelay() / max_delay;
-          // nbw
-        // \ndnsim\ns-3\src\ndnSIM\ndn-cxx\ndn-cxx\interest.hpp line 547
-          min_bw = interest.getBW();
-          nbw = min_bw / max_bw;
-          db[i].degree = (alfa * nbw) / (beta * ndelay);
-        }
-        // sort db with degree
-        PathStats temp;
-        for (int i = 0; i <= db_index; i++) {
-          if (db[i].prefix == current_prefix) {
-            if (db[i + 1].degree < db[i].degree || db[i + 1].prefix != current_prefix) {
-              temp = db[i + 1];
-              db[i + 1] = db[i];
-              db[i] = temp;
-            }
-          }
-        }
-        db_m_index++;
-        db_m[db_m_index] = db[db_index];
-        // remove db[db_index];
-        db_index--;
-        int prefixCount = 0;
-        while (prefixCount < this->multipass_num_max) {
-          for (int i = 0; i < db_index; i++) {
-            if (current_prefix != db[i].prefix) {
-              continue;
-            }
-            //ndelay
-            ndelay = interest.getDelay() / max_delay;
-            // nbw
-            min_bw = interest.getBW();
-            if (interest.getBW() < min_bw) {
-              min_bw = interest.getBW();
-            }
-            nbw = min_bw / max_bw;
-            // set disjoin
-            disjoin = getdisjointness(i, db_m);
-            db[i].deg = disjoin * (alfa * db[i].nbw) / (beta * db[i].ndelay);
-          }
-          // sort db with deg
-          PathStats temp;
-          for (int i = 0; i <= db_index; i++) {
-            if (db[i + 1].deg < db[i].deg || db[i + 1].prefix != current_prefix) {
-              temp = db[i + 1];
-              db[i + 1] = db[i];
-              db[i] = temp;
-            }
-          }
-          prefixCount++;
-          db_m_index++;
-          db_m[db_m_index] = db[db_index];
-          // remove db[db_index];
-          db_index--;
-        }
-      }
-      for (const auto& nexthop : nexthops) {
-		// ndnsim\ns-3\src\ndnSIM\NFD\daemon\fw\strategy.hpp line 374
-        Face& outFace = nexthop.getFace();
+NFD_LOG_INIT(AMIFStrategy);
+NFD_REGISTER_STRATEGY(AMIFStrategy);
 
-        RetxSuppressionResult suppressResult = m_retxSuppression.decidePerUpstream(*pitEntry, outFace);
+const double ALFA = 0.5;
+const double BETA = 0.5;
+const double MAX_BW = 1000.0;    // kilobytes
+const double MAX_DELAY = 1000.0; // milliseconds
+const double MIN_NDELAY = 1e-6;  // avoids division by zero for unmeasured delay
+const int QUOTA_PERIOD = 500;    // Data packets between quota recomputations from path score
 
-        if (suppressResult == RetxSuppressionResult::SUPPRESS) {
-          // ndnsim\ns-3\src\ndnSIM\NFD\daemon\face\face.hpp line 255
-          NFD_LOG_DEBUG(interest << " from=" << ingress << " to=" << outFace.getId() << " suppressed");
-          isSuppressed = true;
-          continue;
-        }
+AMIFStrategy::AMIFStrategy(Forwarder& forwarder, const Name& name)
+  : Strategy(forwarder)
+  , m_measurements(getMeasurements())
+{
+  ParsedInstanceName parsed = parseInstanceName(name);
+  if (!parsed.parameters.empty()) {
+    NDN_THROW(std::invalid_argument("AMIFStrategy does not accept parameters"));
+  }
+  if (parsed.version && *parsed.version != getStrategyName()[-1].toVersion()) {
+    NDN_THROW(std::invalid_argument(
+      "AMIFStrategy does not support version " + to_string(*parsed.version)));
+  }
+  this->setInstanceName(makeInstanceName(name, getStrategyName()));
+}
 
-        if ((outFace.getId() == ingress.face.getId() && outFace.getLinkType() != ndn::nfd::LINK_TYPE_AD_HOC) ||
-          wouldViolateScope(ingress.face, interest, outFace)) {
-          continue;
-        }
+const Name&
+AMIFStrategy::getStrategyName()
+{
+  static Name strategyName("/localhost/nfd/strategy/amif/%FD%01");
+  return strategyName;
+}
 
-        NFD_LOG_DEBUG(interest << " from=" << ingress << " pitEntry-to=" << outFace.getId());
+static double
+computeDegree(const amif::PathStats& path)
+{
+  double nbw = path.minBw / MAX_BW;
+  double ndelay = std::max(path.delay / MAX_DELAY, MIN_NDELAY);
+  return (ALFA * nbw) / (BETA * ndelay);
+}
 
-        if (suppressResult == RetxSuppressionResult::FORWARD) {
-          m_retxSuppression.incrementIntervalForOutRecord(*pitEntry->getOutRecord(outFace));
+/** \brief count nodes shared by two route records
+ *
+ *  A route record is a '/'-separated list of node identifiers.
+ */
+static size_t
+countSharedNodes(const std::string& a, const std::string& b)
+{
+  size_t nShared = 0;
+  size_t begin = 0;
+  while (begin < a.size()) {
+    size_t end = a.find('/', begin);
+    if (end == std::string::npos) {
+      end = a.size();
+    }
+    if (end > begin) {
+      auto node = a.substr(begin, end - begin);
+      size_t pos = b.find(node);
+      while (pos != std::string::npos) {
+        bool isWholeNode = (pos == 0 || b[pos - 1] == '/') &&
+                           (pos + node.size() == b.size() || b[pos + node.size()] == '/');
+        if (isWholeNode) {
+          ++nShared;
+          break;
         }
-        ++nEligibleNextHops;
+        pos = b.find(node, pos + 1);
       }
-      this->sendInterest(pitEntry, FaceEndpoint(db_m[db_m_index].inFace, 0), interest);
-      db_m[db_m_index].inFace = db_m[db_m_index].outFace;
     }
+    begin = end + 1;
   }
-  //------------------------------------------- AFTER -- RECEIVE -- DATA -------------------------------------
-  void AMIFStrategy::afterReceiveData(const shared_ptr<pit::Entry>& pitEntry, const FaceEndpoint& ingress, const Data& data) {
+  return nShared;
+}
+
+void
+AMIFStrategy::afterReceiveInterest(const Interest& interest, const FaceEndpoint& ingress,
+                                   const shared_ptr<pit::Entry>& pitEntry)
+{
+  const fib::Entry& fibEntry = this->lookupFib(*pitEntry);
+  const fib::NextHopList& nexthops = fibEntry.getNextHops();
+  amif::PathTable& paths = m_measurements.getOrCreatePathTable(fibEntry, interest.getName());
+
+  bool isPathDiscovery = interest.getTag<lp::PathDiscoveryPhaseTag>() != nullptr ||
+                         paths.size() < m_sufficientNumOfPaths;
+  auto inRecordInfo = pitEntry->getInRecord(ingress.face)->insertStrategyInfo<InRecordInfo>().first;
+  inRecordInfo->pathDiscoveryPhase = isPathDiscovery;
 
-    auto outRecord = pitEntry->getOutRecord(ingress.face);
-    if (outRecord == pitEntry->out_end()) {
-      NFD_LOG_DEBUG("Data " << data.getName() << " from=" << ingress << " no out-record");
-      return;
+  if (isPathDiscovery) {
+    interest.setTag(make_shared<lp::PathDiscoveryPhaseTag>(lp::EmptyValue{}));
+    if (nexthops.empty()) { // broadcast it if no matching FIB entry exists
+      broadcastInterest(interest, ingress.face, pitEntry);
     }
-    //src/ndnSIM/NFD/daemon/table/strategy-info-host.hpp line 44
-    OutRecordInfo* outRecordInfo = outRecord->getStrategyInfo<OutRecordInfo>();
-    if (!outRecordInfo || outRecordInfo->pathDiscoveryPhase) {
-      //!! Discovery Path Phase.
-      NFD_LOG_DEBUG("broadcast data is going back!!");
-      //db_index++;
-      // ndnsim\ns-3\src\ndnSIM\ndn-cxx\ndn-cxx\data.hpp line 378
-      this->db[db_index].min_bw = data.getBW();
-      //\ndnsim\ns-3\src\ndnSIM\ndn-cxx\ndn-cxx\data.hpp line 389
-      this->db[db_index].delay = data.getDelay();
-      //\ndnsim\ns-3\src\ndnSIM\ndn-cxx\ndn-cxx\data.hpp line 404
-      this->db[db_index].id += data.getId();
-      //\ndnsim\ns-3\src\ndnSIM\ndn-cxx\ndn-cxx\data.hpp line 374
-      this->db[db_index].prefix = data.getPrefix();
-      sendDataToAll(pitEntry, ingress, data);
+    else { // multicast it with "discoveryPhase" mark if matching FIB entry exists
+      multicastInterest(interest, ingress.face, pitEntry, nexthops);
     }
-    else {
-      //!! Data Distribution phase
+    return;
+  }
 
-      this->beforeSatisfyInterest(pitEntry, ingress, data);
+  if (nexthops.empty()) { // return NACK if no matching FIB entry exists
+    NFD_LOG_DEBUG("NACK Interest=" << interest << " from=" << ingress << " noNextHop");
+    lp::NackHeader nackHeader;
+    nackHeader.setReason(lp::NackReason::NO_ROUTE);
+    this->sendNack(nackHeader, ingress.face, pitEntry);
+    this->rejectPendingInterest(pitEntry);
+    return;
+  }
 
-      for (int i = 0; i <= db_m_index; i++) {
-        if (db_m[i].prefix != current_prefix) {
-          continue;
-        }
-        if (db_m[i].qouta > 0) {
-          sendData(pitEntry, data, db_m[i].outFace);
-          db_m[i].qouta--;
-          return;
-        }
-      }
+  if (paths.getSelectedCount() == 0) {
+    selectPaths(paths);
+  }
+  refreshQuotas(paths);
 
-      if (this->period_count == 500) {
-
-        this->period_count = 0;
-        for (int i = 0; i <= db_m_index; i++) {
-          if (db_m[i].prefix != current_prefix) {
-            continue;
-          }
-          //ndelay
-          ndelay = data.getDelay() / max_delay;
-          // nbw
-          min_bw = data.getBW();
-          nbw = min_bw / max_bw;
-          //nThroughput
-          nthroughput = data.getThroughput();
-          db_m[i].score = (nthroughput + nbw) / ndelay;
-          db_m[i].qouta = db_m[i].score;
-        }
+  // data distribution: forward along the selected path with the most remaining quota
+  while (amif::PathStats* path = paths.getBestSelected()) {
+    Face* outFace = this->getFace(path->outFace);
+    if (outFace == nullptr ||
+        (outFace->getId() == ingress.face.getId() && outFace->getLinkType() != ndn::nfd::LINK_TYPE_AD_HOC) ||
+        wouldViolateScope(ingress.face, interest, *outFace)) {
+      paths.erasePath(path->outFace);
+      continue;
+    }
 
-      }
-      else {
-        for (int i = 0; i <= db_m_index; i++) {
-          if (db_m[i].prefix != current_prefix) {
-            continue;
-          }
-          db_m[i].qouta = db_m[i].deg;
-        }
-      }
-      // sort db_m with qouta
-      PathStats temp;
-      for (int i = 0; i <= db_m_index; i++) {
-        if (db_m[i + 1].qouta > db_m[i].qouta || db_m[i + 1].prefix != current_prefix) {
-          temp = db_m[i + 1];
-          db_m[i + 1] = db_m[i];
-          db_m[i] = temp;
-        }
-      }
-      sendData(pitEntry, data, db_m[i].outFace);
-      this->period_count++;
+    paths.setQuota(*path, path->quota - 1);
+    NFD_LOG_DEBUG(interest << " from=" << ingress << " pitEntry-to=" << outFace->getId());
+    auto outRecord = this->sendInterest(interest, *outFace, pitEntry);
+    if (outRecord != nullptr) {
+      outRecord->insertStrategyInfo<OutRecordInfo>().first->pathDiscoveryPhase = false;
     }
+    return;
   }
 
-  // !! Maintenance 
-  void onDroppedInterest(const FaceEndpoint& egress, const Interest& interest) {
-    // ndnsim\ns-3\src\ndnSIM\NFD\daemon\face\face-endpoint.hpp line 50
-    if (egress.linkFailure == true) {
-      // delete path
-      for (int i = 0; i < db_m_index; i++) {
-    // ndnsim\ns-3\src\ndnSIM\NFD\daemon\face\face-endpoint.hpp line 49
-        if (egress.id == db_m[i]) {
-          // delete path i from db_m
-          for (int j = i; j <= db_m_index; j++) {
-            db_m[i] = db_m[i + 1];
-          }
-          db_m_index--;
-        }
-        if (egress.id == db[i]) {
-          // delete path i from db
-          for (int j = i; j <= db_index; j++) {
-            db[i] = db[i + 1];
-          }
-          db_index--;
-        }
-      }
+  // every learned path is gone, fall back to the FIB
+  multicastInterest(interest, ingress.face, pitEntry, nexthops);
+}
+
+void
+AMIFStrategy::afterReceiveData(const Data& data, const FaceEndpoint& ingress,
+                               const shared_ptr<pit::Entry>& pitEntry)
+{
+  auto outRecord = pitEntry->getOutRecord(ingress.face);
+  if (outRecord == pitEntry->out_end()) {
+    NFD_LOG_DEBUG("Data " << data.getName() << " from=" << ingress << " no out-record");
+    return;
+  }
+
+  OutRecordInfo* outRecordInfo = outRecord->getStrategyInfo<OutRecordInfo>();
+  if (outRecordInfo == nullptr || outRecordInfo->pathDiscoveryPhase) {
+    // path discovery: learn the path through the upstream face
+    amif::PathTable& paths = m_measurements.getOrCreatePathTable(this->lookupFib(*pitEntry),
+                                                                 data.getName());
+    amif::PathStats* path = paths.insertPath(ingress.face.getId());
+    if (path != nullptr) {
+      path->minBw = data.getBW();
+      path->delay = data.getDelay();
+      path->id = data.getId();
+      paths.setDegree(*path, computeDegree(*path));
+      NFD_LOG_DEBUG("learned path via=" << ingress.face.getId() << " prefix=" << data.getName()
+                    << " degree=" << path->degree);
     }
   }
-  // remove db[db_index];
-  db_index--;
-  // int id = searchFaceInPath(egress);
-  // ndnsim\ns-3\src\ndnSIM\ndn-cxx\ndn-cxx\data.hpp line 132
-  // if (lastData.dataCounterSend > thereshod) {
-  //   // 
-    
-  //   return;
-  // }
-}
+  else {
+    // data distribution: update path measurements
+    amif::PathTable* paths = m_measurements.getPathTable(data.getName());
+    amif::PathStats* path = paths == nullptr ? nullptr : paths->findPath(ingress.face.getId());
+    if (path != nullptr) {
+      path->minBw = data.getBW();
+      path->delay = data.getDelay();
+      path->throughput = data.getThroughput();
+    }
+    this->beforeSatisfyInterest(data, ingress, pitEntry);
+  }
+
+  this->sendDataToAll(data, pitEntry, ingress.face);
 }
 
-void AMIFStrategy::afterReceiveNack(const FaceEndpoint& ingress, const lp::Nack& nack, const shared_ptr<pit::Entry>& pitEntry) {
+void
+AMIFStrategy::afterReceiveNack(const lp::Nack& nack, const FaceEndpoint& ingress,
+                               const shared_ptr<pit::Entry>& pitEntry)
+{
   NFD_LOG_DEBUG("Nack for " << nack.getInterest() << " from=" << ingress
-    << " reason=" << nack.getReason());
+                << " reason=" << nack.getReason());
   if (nack.getReason() == lp::NackReason::NO_ROUTE) { // remove FIB entries
     BOOST_ASSERT(this->lookupFib(*pitEntry).hasNextHops());
     NFD_LOG_DEBUG("Send NACK to all downstreams");
-    this->sendNacks(pitEntry, nack.getHeader());
+    this->sendNacks(nack.getHeader(), pitEntry);
     renewRoute(nack.getInterest().getName(), ingress.face.getId(), 0_ms);
   }
 }
 
-void AMIFStrategy::broadcastInterest(const Interest& interest, const Face& inFace, const shared_ptr<pit::Entry>& pitEntry) {
+void
+AMIFStrategy::onDroppedInterest(const Interest& interest, Face& egress)
+{
+  // maintenance: a path whose upstream drops Interests must be discovered again
+  amif::PathTable* paths = m_measurements.getPathTable(interest.getName());
+  if (paths != nullptr && paths->erasePath(egress.getId())) {
+    NFD_LOG_DEBUG("removed path via=" << egress.getId() << " prefix=" << interest.getName());
+  }
+}
+
+void
+AMIFStrategy::selectPaths(amif::PathTable& paths)
+{
+  std::vector<const amif::PathStats*> selected;
+  selected.reserve(m_multipathMax);
+
+  while (selected.size() < m_multipathMax && paths.getCandidateCount() > 0) {
+    if (!selected.empty()) {
+      // re-rank the remaining candidates by disjointness from the selected paths
+      for (amif::PathStats& path : paths) {
+        if (path.isSelected) {
+          continue;
+        }
+        double disjointness = 0.0;
+        for (const amif::PathStats* other : selected) {
+          disjointness += 1.0 / (1.0 + countSharedNodes(path.id, other->id));
+        }
+        paths.setDegree(path, disjointness * computeDegree(path));
+      }
+    }
+
+    amif::PathStats* best = paths.getBestCandidate();
+    paths.setQuota(*best, 0.0);
+    paths.selectPath(*best);
+    selected.push_back(best);
+  }
+}
+
+void
+AMIFStrategy::refreshQuotas(amif::PathTable& paths)
+{
+  amif::PathStats* best = paths.getBestSelected();
+  if (best == nullptr || best->quota > 0) {
+    return;
+  }
+
+  bool useScore = paths.advanceQuotaPeriod(QUOTA_PERIOD);
+  for (amif::PathStats& path : paths) {
+    if (!path.isSelected) {
+      continue;
+    }
+    double quota = path.degree;
+    if (useScore) {
+      double nbw = path.minBw / MAX_BW;
+      double ndelay = std::max(path.delay / MAX_DELAY, MIN_NDELAY);
+      quota = (path.throughput + nbw) / ndelay;
+    }
+    paths.setQuota(path, std::max(quota, 1.0));
+  }
+}
+
+void
+AMIFStrategy::broadcastInterest(const Interest& interest, const Face& inFace,
+                                const shared_ptr<pit::Entry>& pitEntry)
+{
   for (auto& outFace : this->getFaceTable() | boost::adaptors::reversed) {
     if ((outFace.getId() == inFace.getId() && outFace.getLinkType() != ndn::nfd::LINK_TYPE_AD_HOC) ||
-      wouldViolateScope(inFace, interest, outFace) || outFace.getScope() == ndn::nfd::FACE_SCOPE_LOCAL) {
+        wouldViolateScope(inFace, interest, outFace) ||
+        outFace.getScope() == ndn::nfd::FACE_SCOPE_LOCAL) {
       continue;
     }
-    this->sendInterest(pitEntry, FaceEndpoint(outFace, 0), interest);
-    pitEntry->getOutRecord(outFace)->insertStrategyInfo<OutRecordInfo>().first->pathDiscoveryPhase = true;
-    NFD_LOG_DEBUG("send discovery Interest=" << interest << " from="
-      << inFace.getId() << " to=" << outFace.getId());
+
+    NFD_LOG_DEBUG("send discovery Interest=" << interest << " from=" << inFace.getId() <<
+                  " to=" << outFace.getId());
+    auto outRecord = this->sendInterest(interest, outFace, pitEntry);
+    if (outRecord != nullptr) {
+      outRecord->insertStrategyInfo<OutRecordInfo>().first->pathDiscoveryPhase = true;
+    }
   }
 }
 
-void AMIFStrategy::multicastInterest(const Interest& interest, const Face& inFace, const shared_ptr<pit::Entry>& pitEntry, const fib::NextHopList& nexthops) {
+void
+AMIFStrategy::multicastInterest(const Interest& interest, const Face& inFace,
+                                const shared_ptr<pit::Entry>& pitEntry,
+                                const fib::NextHopList& nexthops)
+{
   for (const auto& nexthop : nexthops) {
-    Face& outFace = nexthop.getFace();
-    if ((outFace.getId() == inFace.getId() && outFace.getLinkType() != ndn::nfd::LINK_TYPE_AD_HOC) ||
-      wouldViolateScope(inFace, interest, outFace)) {
+    if (!isNextHopEligible(inFace, interest, nexthop, pitEntry)) {
       continue;
     }
-    this->sendInterest(pitEntry, FaceEndpoint(outFace, 0), interest);
-    pitEntry->getOutRecord(outFace)->insertStrategyInfo<OutRecordInfo>().first->pathDiscoveryPhase = true;
-    NFD_LOG_DEBUG("send interest in discovery phase =" << interest << " from="
-      << inFace.getId() << " to=" << outFace.getId());
+
+    Face& outFace = nexthop.getFace();
+    NFD_LOG_DEBUG("send discovery Interest=" << interest << " from=" << inFace.getId() <<
+                  " to=" << outFace.getId());
+    auto outRecord = this->sendInterest(interest, outFace, pitEntry);
+    if (outRecord != nullptr) {
+      outRecord->insertStrategyInfo<OutRecordInfo>().first->pathDiscoveryPhase = true;
+    }
   }
 }
 
-
+void
+AMIFStrategy::renewRoute(const Name& name, FaceId inFaceId, time::milliseconds maxLifetime)
+{
+  // renew route with PA or ignore PA (if route has no PA)
+  m_routeChannel.renew(name, inFaceId, maxLifetime);
+}
 
 } // namespace fw
-} // namespace nfd
\ No newline at end of file
+} // namespace nfd
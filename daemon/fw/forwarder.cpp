@@ -88,6 +88,10 @@ Forwarder::Forwarder(FaceTable& faceTable)
     this->onNewNextHop(prefix, nextHop);
   });
 
+  m_pit.afterExpire.connect([this] (const shared_ptr<pit::Entry>& pitEntry) {
+    this->onInterestFinalize(pitEntry);
+  });
+
   m_strategyChoice.setDefaultStrategy(getDefaultStrategyName());
 }
 
@@ -204,11 +208,7 @@ Forwarder::onContentStoreMiss(const Interest& interest, const FaceEndpoint& ingr
   pitEntry->insertOrUpdateInRecord(ingress.face, interest);
 
   // set PIT expiry timer to the time that the last PIT in-record expires
-  auto lastExpiring = std::max_element(pitEntry->in_begin(), pitEntry->in_end(),
-                                       [] (const auto& a, const auto& b) {
-                                         return a.getExpiry() < b.getExpiry();
-                                       });
-  auto lastExpiryFromNow = lastExpiring->getExpiry() - time::steady_clock::now();
+  auto lastExpiryFromNow = pitEntry->getLastInRecordExpiry() - time::steady_clock::now();
   this->setExpiryTimer(pitEntry, time::duration_cast<time::milliseconds>(lastExpiryFromNow));
 
   // has NextHopFaceId?
@@ -301,8 +301,7 @@ Forwarder::onInterestFinalize(const shared_ptr<pit::Entry>& pitEntry)
     ++m_counters.nUnsatisfiedInterests;
   }
 
-  // PIT delete
-  pitEntry->expiryTimer.cancel();
+  // PIT delete, which also cancels the expiry timer
   m_pit.erase(pitEntry.get());
 }
 
@@ -581,8 +580,7 @@ Forwarder::setExpiryTimer(const shared_ptr<pit::Entry>& pitEntry, time::millisec
   BOOST_ASSERT(pitEntry);
   duration = std::max(duration, 0_ms);
 
-  pitEntry->expiryTimer.cancel();
-  pitEntry->expiryTimer = getScheduler().schedule(duration, [=] { onInterestFinalize(pitEntry); });
+  m_pit.setExpiryTimer(*pitEntry, duration);
 }
 
 void
@@ -0,0 +1,268 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "lamdp-measurements.hpp"
+
+namespace nfd {
+namespace fw {
+namespace lamdp {
+
+constexpr time::nanoseconds Action::RTT_NO_MEASUREMENT;
+constexpr size_t Automaton::MAX_ACTIONS;
+constexpr double Automaton::REWARD_RATE;
+constexpr double Automaton::PENALTY_RATE;
+constexpr double Automaton::RTT_ALPHA;
+
+size_t
+Automaton::find(FaceId face) const
+{
+  for (size_t i = 0; i < m_size; ++i) {
+    if (m_actions[i].face == face) {
+      return i;
+    }
+  }
+  return MAX_ACTIONS;
+}
+
+void
+Automaton::syncActions(const fib::NextHopList& nexthops)
+{
+  size_t n = std::min(nexthops.size(), MAX_ACTIONS);
+  if (n == m_size &&
+      std::equal(m_actions.begin(), m_actions.begin() + n, nexthops.begin(),
+                 [] (const Action& action, const fib::NextHop& nh) {
+                   return action.face == nh.getFace().getId();
+                 })) {
+    return;
+  }
+
+  std::array<Action, MAX_ACTIONS> actions;
+  double sum = 0.0;
+  for (size_t i = 0; i < n; ++i) {
+    FaceId face = nexthops[i].getFace().getId();
+    size_t old = find(face);
+    if (old != MAX_ACTIONS) {
+      actions[i] = m_actions[old];
+    }
+    else {
+      actions[i].face = face;
+      actions[i].probability = 1.0 / n;
+    }
+    sum += actions[i].probability;
+  }
+  for (size_t i = 0; i < n; ++i) {
+    actions[i].probability = sum > 0.0 ? actions[i].probability / sum : 1.0 / n;
+  }
+
+  m_actions = actions;
+  m_size = n;
+  m_isCdfValid = false;
+}
+
+double
+Automaton::getWeightedProbability(size_t i)
+{
+  BOOST_ASSERT(i < m_size);
+  if (!m_isCdfValid) {
+    updateDistribution();
+  }
+  double lower = i == 0 ? 0.0 : m_cdf[i - 1];
+  return (m_cdf[i] - lower) / m_cdf[m_size - 1];
+}
+
+size_t
+Automaton::choose(double u)
+{
+  if (m_size == 0) {
+    return MAX_ACTIONS;
+  }
+  if (!m_isCdfValid) {
+    updateDistribution();
+  }
+
+  double target = u * m_cdf[m_size - 1];
+  auto it = std::upper_bound(m_cdf.begin(), m_cdf.begin() + m_size, target);
+  return std::min<size_t>(std::distance(m_cdf.begin(), it), m_size - 1);
+}
+
+void
+Automaton::beforeSend(size_t i)
+{
+  BOOST_ASSERT(i < m_size);
+  ++m_actions[i].nPending;
+  m_isCdfValid = false;
+}
+
+void
+Automaton::endPending(size_t i)
+{
+  BOOST_ASSERT(i < m_size);
+  Action& action = m_actions[i];
+  if (action.nPending > 0) {
+    --action.nPending;
+    m_isCdfValid = false;
+  }
+}
+
+void
+Automaton::afterData(size_t i, time::nanoseconds rtt)
+{
+  BOOST_ASSERT(i < m_size);
+  Action& action = m_actions[i];
+  if (action.srtt == Action::RTT_NO_MEASUREMENT) {
+    action.srtt = rtt;
+  }
+  else {
+    action.srtt += time::duration_cast<time::nanoseconds>(RTT_ALPHA * (rtt - action.srtt));
+  }
+  reward(i);
+}
+
+void
+Automaton::afterFailure(size_t i)
+{
+  BOOST_ASSERT(i < m_size);
+  penalize(i);
+}
+
+void
+Automaton::reward(size_t i)
+{
+  // linear reward-inaction: p_i += a * (1 - p_i), p_j = (1 - a) * p_j
+  for (size_t j = 0; j < m_size; ++j) {
+    m_actions[j].probability *= 1.0 - REWARD_RATE;
+  }
+  m_actions[i].probability += REWARD_RATE;
+  m_isCdfValid = false;
+}
+
+void
+Automaton::penalize(size_t i)
+{
+  if (m_size < 2) {
+    m_isCdfValid = false;
+    return;
+  }
+
+  // linear reward-penalty: p_i = (1 - b) * p_i, p_j = b / (r - 1) + (1 - b) * p_j
+  double share = PENALTY_RATE / (m_size - 1);
+  for (size_t j = 0; j < m_size; ++j) {
+    m_actions[j].probability = (1.0 - PENALTY_RATE) * m_actions[j].probability + share;
+  }
+  m_actions[i].probability -= share;
+  m_isCdfValid = false;
+}
+
+void
+Automaton::updateDistribution()
+{
+  BOOST_ASSERT(m_size > 0);
+
+  double sumRtt = 0.0;
+  size_t nMeasured = 0;
+  double sumPending = 0.0;
+  for (size_t i = 0; i < m_size; ++i) {
+    if (m_actions[i].srtt != Action::RTT_NO_MEASUREMENT) {
+      sumRtt += time::duration<double, time::milliseconds::period>(m_actions[i].srtt).count();
+      ++nMeasured;
+    }
+    sumPending += m_actions[i].nPending;
+  }
+  // unmeasured actions are assumed to have the mean RTT, so they are neither favored nor penalized
+  double meanRtt = nMeasured > 0 ? sumRtt / nMeasured : 0.0;
+  sumRtt += meanRtt * (m_size - nMeasured);
+
+  double sum = 0.0;
+  for (size_t i = 0; i < m_size; ++i) {
+    Action& action = m_actions[i];
+    double rtt = action.srtt == Action::RTT_NO_MEASUREMENT ? meanRtt :
+                 time::duration<double, time::milliseconds::period>(action.srtt).count();
+    // normalized RTT and load both lower the reward
+    action.reward = 1.0 / (1.0 + rtt / (sumRtt + 1.0) + action.nPending / (sumPending + 1.0));
+    sum += action.probability * action.reward;
+    m_cdf[i] = sum;
+  }
+
+  if (sum <= 0.0) {
+    // degenerate distribution, fall back to uniform
+    for (size_t i = 0; i < m_size; ++i) {
+      m_cdf[i] = static_cast<double>(i + 1);
+    }
+  }
+  m_isCdfValid = true;
+}
+
+constexpr time::microseconds LamdpMeasurements::MEASUREMENTS_LIFETIME;
+
+LamdpMeasurements::LamdpMeasurements(MeasurementsAccessor& measurements)
+  : m_measurements(measurements)
+{
+}
+
+Automaton*
+LamdpMeasurements::getAutomaton(const Name& prefix)
+{
+  auto* me = m_measurements.findLongestPrefixMatch(prefix,
+                                                   measurements::EntryWithStrategyInfo<Automaton>());
+  if (me == nullptr) {
+    return nullptr;
+  }
+
+  extendLifetime(*me);
+  return me->getStrategyInfo<Automaton>();
+}
+
+Automaton&
+LamdpMeasurements::getOrCreateAutomaton(const fib::Entry& fibEntry, const Name& prefix)
+{
+  auto* me = m_measurements.get(fibEntry);
+
+  // If the FIB entry is not under the strategy's namespace, find a part of the prefix
+  // that falls under the strategy's namespace
+  for (size_t prefixLen = fibEntry.getPrefix().size() + 1;
+       me == nullptr && prefixLen <= prefix.size();
+       ++prefixLen) {
+    me = m_measurements.get(prefix.getPrefix(prefixLen));
+  }
+
+  // Either the FIB entry or the Interest's name must be under this strategy's namespace
+  BOOST_ASSERT(me != nullptr);
+
+  extendLifetime(*me);
+
+  Automaton* automaton = me->insertStrategyInfo<Automaton>().first;
+  BOOST_ASSERT(automaton != nullptr);
+  return *automaton;
+}
+
+void
+LamdpMeasurements::extendLifetime(measurements::Entry& me)
+{
+  m_measurements.extendLifetime(me, MEASUREMENTS_LIFETIME);
+}
+
+} // namespace lamdp
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,203 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_LAMDP_MEASUREMENTS_HPP
+#define NFD_DAEMON_FW_LAMDP_MEASUREMENTS_HPP
+
+#include "fw/strategy-info.hpp"
+#include "table/measurements-accessor.hpp"
+
+#include <array>
+
+namespace nfd {
+namespace fw {
+namespace lamdp {
+
+/** \brief State of one action of the learning automaton, i.e. forwarding to one nexthop
+ */
+struct Action
+{
+  FaceId face = face::INVALID_FACEID;
+  double probability = 0.0; ///< action probability learned by the automaton
+  double reward = 0.0;      ///< instantaneous reward, derived from RTT and pending Interests
+  time::nanoseconds srtt = RTT_NO_MEASUREMENT;
+  size_t nPending = 0;      ///< number of Interests forwarded and not yet answered
+
+  static constexpr time::nanoseconds RTT_NO_MEASUREMENT = -1_ns;
+};
+
+/** \brief Per-prefix learning automaton of LAMDPStrategy
+ *
+ *  The automaton has one action per nexthop. An action is chosen with its weighted
+ *  probability, i.e. its probability multiplied by its reward and normalized. Actions
+ *  are rewarded with the linear reward-inaction scheme when Data comes back, and penalized
+ *  with the linear reward-penalty scheme upon Nack or retransmission.
+ *
+ *  Actions are stored inline, so that no operation allocates memory. Updates cost
+ *  O(n) in the number of actions; the cumulative distribution of the weighted
+ *  probabilities is cached and rebuilt only after an update, so that choosing an action
+ *  costs O(log n) otherwise. The automaton has at most MAX_ACTIONS actions.
+ */
+class Automaton final : public StrategyInfo
+{
+public:
+  static constexpr int
+  getTypeId()
+  {
+    return 1070;
+  }
+
+  static constexpr size_t MAX_ACTIONS = 16;
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  const Action&
+  operator[](size_t i) const
+  {
+    BOOST_ASSERT(i < m_size);
+    return m_actions[i];
+  }
+
+  /** \return index of the action forwarding to \p face, or MAX_ACTIONS if it does not exist
+   */
+  size_t
+  find(FaceId face) const;
+
+  /** \brief makes the actions match \p nexthops
+   *
+   *  Actions of vanished nexthops are dropped. New nexthops start with the probability
+   *  of a uniform distribution, then all probabilities are normalized.
+   *  This is a no-op if the nexthops did not change.
+   */
+  void
+  syncActions(const fib::NextHopList& nexthops);
+
+  /** \return weighted probability of action \p i
+   */
+  double
+  getWeightedProbability(size_t i);
+
+  /** \brief chooses an action
+   *  \param u a number uniformly distributed in [0, 1)
+   *  \return index of the chosen action, or MAX_ACTIONS if there is no action
+   */
+  size_t
+  choose(double u);
+
+  /** \brief records that an Interest was forwarded with action \p i
+   */
+  void
+  beforeSend(size_t i);
+
+  /** \brief records that an Interest forwarded with action \p i is no longer pending,
+   *         because it was answered, Nacked, retransmitted elsewhere, or its PIT entry expired
+   */
+  void
+  endPending(size_t i);
+
+  /** \brief records that Data came back through action \p i after \p rtt, and rewards it
+   */
+  void
+  afterData(size_t i, time::nanoseconds rtt);
+
+  /** \brief records that action \p i failed to bring Data back, and penalizes it
+   */
+  void
+  afterFailure(size_t i);
+
+private:
+  void
+  reward(size_t i);
+
+  void
+  penalize(size_t i);
+
+  void
+  updateDistribution();
+
+public:
+  static constexpr double REWARD_RATE = 0.1;  ///< step size of the reward-inaction scheme
+  static constexpr double PENALTY_RATE = 0.05; ///< step size of the reward-penalty scheme
+  static constexpr double RTT_ALPHA = 0.125;  ///< gain of the smoothed RTT, as in RFC 6298
+
+private:
+  std::array<Action, MAX_ACTIONS> m_actions;
+  std::array<double, MAX_ACTIONS> m_cdf; ///< cumulative weighted probabilities
+  size_t m_size = 0;
+  bool m_isCdfValid = false;
+};
+
+/** \brief StrategyInfo on pit::OutRecord, marks an Interest counted in Action::nPending
+ */
+class OutRecordInfo final : public StrategyInfo
+{
+public:
+  static constexpr int
+  getTypeId()
+  {
+    return 1071;
+  }
+
+public:
+  bool isPending = false;
+};
+
+/** \brief Helper class to retrieve and create LAMDP automata
+ *
+ *  Automata are attached to Measurements entries, so that they persist across packets
+ *  and are released after MEASUREMENTS_LIFETIME without traffic.
+ */
+class LamdpMeasurements : noncopyable
+{
+public:
+  explicit
+  LamdpMeasurements(MeasurementsAccessor& measurements);
+
+  Automaton*
+  getAutomaton(const Name& prefix);
+
+  Automaton&
+  getOrCreateAutomaton(const fib::Entry& fibEntry, const Name& prefix);
+
+private:
+  void
+  extendLifetime(measurements::Entry& me);
+
+public:
+  static constexpr time::microseconds MEASUREMENTS_LIFETIME = 5_min;
+
+private:
+  MeasurementsAccessor& m_measurements;
+};
+
+} // namespace lamdp
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_LAMDP_MEASUREMENTS_HPP
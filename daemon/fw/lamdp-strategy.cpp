@@ -1,261 +1,223 @@
-
-
-#define RoutingMetric 1
-
-#include "lamdp-strategy.hpp"
-#include "algorithm.hpp"
-#include "core/logger.hpp"
-
-
-namespace nfd {
-namespace fw {
-
-NFD_LOG_INIT(LAMDPStrategy);
-NFD_REGISTER_STRATEGY(LAMDPStrategy);
-
-const time::milliseconds LAMDPStrategy::RETX_SUPPRESSION_INITIAL(10);
-const time::milliseconds LAMDPStrategy::RETX_SUPPRESSION_MAX(250);
-
-ns3::QueueSize faceInterests;
-/**
- * \brief constructor of lamdp-strategy
- * @param forwarder instance for run strategy
- * @param name of strategy
- */
-LAMDPStrategy::LAMDPStrategy(Forwarder& forwarder, const Name& name)
-:Strategy(forwarder)
-, m_measurements(getMeasurements())
-, m_retxSuppression(RETX_SUPPRESSION_INITIAL,
-        RetxSuppressionExponential::DEFAULT_MULTIPLIER,
-        RETX_SUPPRESSION_MAX)
-{
-
-	ParsedInstanceName parsed = parseInstanceName(name);
-	 if (!parsed.parameters.empty()) {
-	    BOOST_THROW_EXCEPTION(std::invalid_argument("LAMDP strategy does not accept parameters"));
-	 }
-	 if (parsed.version && *parsed.version != getStrategyName()[-1].toVersion()) {
-	    BOOST_THROW_EXCEPTION(std::invalid_argument(
-	      "LAMDP strategy does not support version " + to_string(*parsed.version)));
-	 }
-	 this->setInstanceName(makeInstanceName(name, getStrategyName()));
-}
-
-/**
- * \brief create name for use in scenario
- * @return strategyName
- */
-const Name&
-LAMDPStrategy::getStrategyName(){
-	static Name strategyName("/localhost/nfd/strategy/lamdp/%FD%01");
-	return strategyName;
-}
-
-/**
- * \brief trigger after receiving Interest
- * @param inface
- * @param interest
- * @param pitEntry
- */
-void
-LAMDPStrategy::afterReceiveInterest(const Face& inFace, const Interest& interest,
-                       const shared_ptr<pit::Entry>& pitEntry){
-  /* todo interest can three kinds:
-   * NEW, FORWARD, SUppress
-	*/
-  RetxSuppressionResult suppressResult = m_retxSuppression.decidePerPitEntry(*pitEntry);
-
-  switch (suppressResult) {
-  case RetxSuppressionResult::NEW:
-  case RetxSuppressionResult::FORWARD:
-	break;
-  case RetxSuppressionResult::SUPPRESS:
-	NFD_LOG_DEBUG("SUPPRESS Interest:" << interest << " from=" << inFace.getId() << "DROPED");
-	return;
-  }
-
-  // find fibentry with pitEntry Pointer
-  const fib::Entry& fibEntry = this->lookupFib(*pitEntry);
-  const fib::NextHopList& nexthops = fibEntry.getNextHops();
-
-  // if vector size is zero, send NO_ROUTE NACK and return
-  if (nexthops.size() == 0) {
-	sendNoRouteNack(inFace, interest, pitEntry);
-	this->rejectPendingInterest(pitEntry);
-	return;
-  }
-
-  // call function to set output face to choose best face
-  Face* faceToUse = getBestFaceForForwarding(fibEntry, interest, inFace);
-
-  if (faceToUse == nullptr) {
-		sendNoRouteNack(inFace, interest, pitEntry);
-		this->rejectPendingInterest(pitEntry);
-		return;
-	  }
-
-  this->sendInterest(pitEntry, *faceToUse, interest);
-  NFD_LOG_DEBUG(interest << " from=" << inFace.getId()
-                         << " pitEntry-to=" << faceToUse->getId());
-
-}
-
-/**
- * \brief trigger after receiving Data
- * @param pitEntry
- * @param inface
- * @param data
- */
-void
-LAMDPStrategy::afterReceiveData (const shared_ptr< pit::Entry > &pitEntry,
-					const Face &inFace, const Data &data){
-	
-	int select = this->selectedFace;
-    int lambda = 0.5;
-	int i = 0;
-	 // find fibentry with pitEntry Pointer
-  	const fib::Entry& fibEntry = this->lookupFib(*pitEntry);
-	const fib::NextHopList& nexthops = fibEntry.getNextHops();
-	FaceStats* stats = new FaceStats[10]; 
-	stats[select].unsatisfiedInterest = stats[select].unsatisfiedInterest - 1;
-		// prob[select] + x //nokay
-	stats[select].prob = 1 - lambda*(Math.sum(prob) - stats[select].prob);
-
-	for (const fib::NextHop& hop : nexthops) {
-		if(i != select){
-			// 			prob[i] - x/(num - 1)
-			stats[i].prob = lambda*stats[i].prob;
-		}
-		i++;
-	}
-	// send data to inFace Interest
-	Face* faceToUse = stats[i].inFace;
-	//sendData(pitEntry, data, faceToUse);
-
-}
-
-/**
- * \brief this function find output interface for sendind interest with Learning automata and MDP
- * @param FaceStats
- * @param rows
- * @return actionNum
- */
-int lamdpresult(FaceStats* stats, int rows) {
-
-	float rnd = rand();
-	int rnd_level = 0;
-	int actionNum = 1;
-	for (int i = 0; i < rows; i++){
-		actionNum = 1;
-		if((rnd >= rnd_level) && (rnd < stats[i].wprob + rnd_level)){
-			actionNum = i;
-			break;
-		}else{
-			rnd_level = rnd_level + stats[i].wprob;
-		}
-	}
-    return actionNum;
-}
-
-/**
- * \brief the main function for send interest
- * @param fibEntry
- * @param interest
- * @param inface
- * @return the best face for sending Interest
- */
-Face*
-LAMDPStrategy::getBestFaceForForwarding(const fib::Entry& fibEntry, const Interest& interest, const Face& inFace){
-
-
-	const fib::NextHopList& nexthops = fibEntry.getNextHops();
-	FaceStats* stats = new FaceStats[10]; 
-
-	int i = 0;
-	int bw = 0;
-	int sumBW = 0;
-	int sumUnsatisfied = 0;
-	int sumRTT = 0;
-
-	for (const fib::NextHop& hop : nexthops) {
-		// ndnsim\ns-3\src\ndnSIM\NFD\daemon\fw\strategy.hpp line 374
-		Face& hopFace = hop.getFace();
-		// set band width of interface
-		// ndnsim\ns-3\src\network\utils\packetbb.cc line 103
-		bw = hopFace.getQueue.Size();
-		// set rtt for delay
-		// ndnsim\ns-3\src\ndnSIM\NFD\daemon\fw\asf-measurements.cpp line 95
-		asf::FaceInfo* info = m_measurements.getFaceInfo(fibEntry, interest, hopFace.getId());
-		// set Facestate structure
-
-		stats[i].outFace = &hopFace;
-		stats[i].availBW = bw;
-		// src\ndnSIM\NFD\daemon\fw\lamdp-strategy.hpp line 31
-		stats[bestRow].unsatisfiedInterest = stats[bestRow].unsatisfiedInterest + 1;
-		// set rtt info is nullptr or no
-		if(info == nullptr){
-			stats[i].rtt = 0;
-		}else{
-			// ndnsim\ns-3\src\ndnSIM\NFD\daemon\fw\asf-measurements.hpp line 49
-			stats[i].rtt = info->getRtt();
-		}
-		sumBW += bw;
-		sumUnsatisfied += stats[i].unsatisfiedInterest;
-		sumRTT += stats[i].rtt;
-		i++; 
-	}
-	
-	int bwn = 0;
-	int unsatisfiedn = 0;
-	int rttn = 0;
-	int sumProReward = 0;
-
-	for (const fib::NextHop& hop : nexthops) {
-		Face& hopFace = hop.getFace();
-		// normalization
-		bwn = stats[i].availBW /(sumBW+1);
-		unsatisfiedn = stats[i].unsatisfiedInterest /(sumUnsatisfied+1);
-		rttn = stats[i].rtt/ (sumRTT + 1);
-		// calculate reward
-		stats[i].reward = bwn/(rttn + unsatisfiedn + 1);
-
-		// calculate sumProReward from  simple probality and reward
-		sumProReward = sumProReward + stats[i].prob * stats[i].reward;
-		i++;
-	}
-
-	for (const fib::NextHop& hop : nexthops) {
-		// calculate wpro for each output interface
-		stats[i].wprob = stats[i].prob * stats[i].reward/(sumProReward);
-		i++;
-	}
-	// return best wpro of states array
-	int bestRow = lamdpresult(stats, nexthops.size());
-	// set output face for send interest
-	Face* faceToUse = stats[bestRow].outFace;
-	this->selectedFace = bestRow;
-	// for save inFace in FaceStates //nokay
-	stats[bestRow].inFace = &inFace;
-	return faceToUse;
-}
-
-
-/**
- * \brief send the NoRoute packet to faces
- * @param inface
- * @param interest
- * @param pitEntity
- */
-void
-LAMDPStrategy::sendNoRouteNack(const Face& inFace, const Interest& interest,
-                             const shared_ptr<pit::Entry>& pitEntry)
-{
-  NFD_LOG_DEBUG(interest << " from=" << inFace.getId() << " noNextHop");
-  lp::NackHeader nackHeader;
-  nackHeader.setReason(lp::NackReason::NO_ROUTE);
-  this->sendNack(pitEntry, inFace, nackHeader);
-}
-
-} /* namespace fw */
-} /* namespace nfd */
-
+#include "lamdp-strategy.hpp"
+#include "algorithm.hpp"
+#include "forwarder.hpp"
+#include "common/logger.hpp"
+
+#include <ndn-cxx/util/random.hpp>
+
+namespace nfd {
+namespace fw {
+
+NFD_LOG_INIT(LAMDPStrategy);
+NFD_REGISTER_STRATEGY(LAMDPStrategy);
+
+const time::milliseconds LAMDPStrategy::RETX_SUPPRESSION_INITIAL(10);
+const time::milliseconds LAMDPStrategy::RETX_SUPPRESSION_MAX(250);
+
+LAMDPStrategy::LAMDPStrategy(Forwarder& forwarder, const Name& name)
+  : Strategy(forwarder)
+  , ProcessNackTraits(this)
+  , m_retxSuppression(RETX_SUPPRESSION_INITIAL,
+                      RetxSuppressionExponential::DEFAULT_MULTIPLIER,
+                      RETX_SUPPRESSION_MAX)
+  , m_measurements(getMeasurements())
+  , m_beforeExpireConn(forwarder.beforeExpirePendingInterest.connect(
+      [this] (const pit::Entry& pitEntry) { beforeExpirePendingInterest(pitEntry); }))
+{
+  ParsedInstanceName parsed = parseInstanceName(name);
+  if (!parsed.parameters.empty()) {
+    NDN_THROW(std::invalid_argument("LAMDPStrategy does not accept parameters"));
+  }
+  if (parsed.version && *parsed.version != getStrategyName()[-1].toVersion()) {
+    NDN_THROW(std::invalid_argument(
+      "LAMDPStrategy does not support version " + to_string(*parsed.version)));
+  }
+  this->setInstanceName(makeInstanceName(name, getStrategyName()));
+}
+
+const Name&
+LAMDPStrategy::getStrategyName()
+{
+  static Name strategyName("/localhost/nfd/strategy/lamdp/%FD%01");
+  return strategyName;
+}
+
+/** \brief ends the pending Interest of \p outRecord in \p automaton, if it is counted there
+ *  \return index of the action of \p outRecord, or lamdp::Automaton::MAX_ACTIONS if
+ *          \p outRecord is not pending
+ */
+static size_t
+endPending(lamdp::Automaton& automaton, const pit::OutRecord& outRecord)
+{
+  auto info = outRecord.getStrategyInfo<lamdp::OutRecordInfo>();
+  if (info == nullptr || !info->isPending) {
+    return lamdp::Automaton::MAX_ACTIONS;
+  }
+  info->isPending = false;
+
+  size_t i = automaton.find(outRecord.getFace().getId());
+  if (i != lamdp::Automaton::MAX_ACTIONS) {
+    automaton.endPending(i);
+  }
+  return i;
+}
+
+void
+LAMDPStrategy::afterReceiveInterest(const Interest& interest, const FaceEndpoint& ingress,
+                                    const shared_ptr<pit::Entry>& pitEntry)
+{
+  RetxSuppressionResult suppression = m_retxSuppression.decidePerPitEntry(*pitEntry);
+  if (suppression == RetxSuppressionResult::SUPPRESS) {
+    NFD_LOG_DEBUG(interest << " from=" << ingress << " suppressed");
+    return;
+  }
+
+  const fib::Entry& fibEntry = this->lookupFib(*pitEntry);
+  const fib::NextHopList& nexthops = fibEntry.getNextHops();
+  if (nexthops.empty()) {
+    sendNoRouteNack(interest, ingress, pitEntry);
+    return;
+  }
+
+  lamdp::Automaton& automaton = m_measurements.getOrCreateAutomaton(fibEntry, interest.getName());
+  automaton.syncActions(nexthops);
+
+  if (suppression == RetxSuppressionResult::FORWARD) {
+    // the downstream retransmitted, so the upstreams still pending have failed
+    for (const auto& outRecord : pitEntry->getOutRecords()) {
+      size_t i = endPending(automaton, outRecord);
+      if (i != lamdp::Automaton::MAX_ACTIONS) {
+        automaton.afterFailure(i);
+      }
+    }
+  }
+
+  size_t i = chooseAction(automaton, nexthops, interest, ingress.face, pitEntry);
+  if (i == lamdp::Automaton::MAX_ACTIONS) {
+    sendNoRouteNack(interest, ingress, pitEntry);
+    return;
+  }
+
+  Face* outFace = this->getFace(automaton[i].face);
+  BOOST_ASSERT(outFace != nullptr);
+  NFD_LOG_DEBUG(interest << " from=" << ingress << " to=" << outFace->getId()
+                << " wprob=" << automaton.getWeightedProbability(i));
+  pit::OutRecord* outRecord = this->sendInterest(interest, *outFace, pitEntry);
+  if (outRecord == nullptr) {
+    return;
+  }
+
+  auto info = outRecord->insertStrategyInfo<lamdp::OutRecordInfo>().first;
+  if (!info->isPending) {
+    info->isPending = true;
+    automaton.beforeSend(i);
+  }
+}
+
+size_t
+LAMDPStrategy::chooseAction(lamdp::Automaton& automaton, const fib::NextHopList& nexthops,
+                            const Interest& interest, const Face& inFace,
+                            const shared_ptr<pit::Entry>& pitEntry)
+{
+  std::uniform_real_distribution<double> dist(0.0, 1.0);
+  size_t chosen = automaton.choose(dist(ndn::random::getRandomNumberEngine()));
+  // actions are in the same order as nexthops, see Automaton::syncActions
+  if (chosen != lamdp::Automaton::MAX_ACTIONS &&
+      isNextHopEligible(inFace, interest, nexthops[chosen], pitEntry)) {
+    return chosen;
+  }
+
+  // fall back to the eligible action with the highest weighted probability
+  size_t best = lamdp::Automaton::MAX_ACTIONS;
+  double bestWprob = -1.0;
+  for (size_t i = 0; i < automaton.size(); ++i) {
+    if (!isNextHopEligible(inFace, interest, nexthops[i], pitEntry)) {
+      continue;
+    }
+    double wprob = automaton.getWeightedProbability(i);
+    if (wprob > bestWprob) {
+      best = i;
+      bestWprob = wprob;
+    }
+  }
+  return best;
+}
+
+void
+LAMDPStrategy::beforeSatisfyInterest(const Data& data, const FaceEndpoint& ingress,
+                                     const shared_ptr<pit::Entry>& pitEntry)
+{
+  auto outRecord = pitEntry->getOutRecord(ingress.face);
+  if (outRecord == pitEntry->out_end()) {
+    return;
+  }
+
+  lamdp::Automaton* automaton = m_measurements.getAutomaton(pitEntry->getName());
+  if (automaton == nullptr) {
+    return;
+  }
+
+  // the PIT entry is satisfied, so none of its Interests is pending any longer
+  for (const auto& other : pitEntry->getOutRecords()) {
+    endPending(*automaton, other);
+  }
+
+  size_t i = automaton->find(ingress.face.getId());
+  if (i != lamdp::Automaton::MAX_ACTIONS) {
+    auto rtt = time::steady_clock::now() - outRecord->getLastRenewed();
+    NFD_LOG_TRACE(pitEntry->getName() << " data from=" << ingress << " rtt=" << rtt);
+    automaton->afterData(i, rtt);
+  }
+}
+
+void
+LAMDPStrategy::afterReceiveNack(const lp::Nack& nack, const FaceEndpoint& ingress,
+                                const shared_ptr<pit::Entry>& pitEntry)
+{
+  lamdp::Automaton* automaton = m_measurements.getAutomaton(pitEntry->getName());
+  if (automaton != nullptr) {
+    size_t i = automaton->find(ingress.face.getId());
+    if (i != lamdp::Automaton::MAX_ACTIONS) {
+      auto outRecord = pitEntry->getOutRecord(ingress.face);
+      if (outRecord != pitEntry->out_end()) {
+        endPending(*automaton, *outRecord);
+      }
+      automaton->afterFailure(i);
+    }
+  }
+
+  this->processNack(nack, ingress.face, pitEntry);
+}
+
+void
+LAMDPStrategy::sendNoRouteNack(const Interest& interest, const FaceEndpoint& ingress,
+                               const shared_ptr<pit::Entry>& pitEntry)
+{
+  NFD_LOG_DEBUG(interest << " from=" << ingress << " noNextHop");
+  lp::NackHeader nackHeader;
+  nackHeader.setReason(lp::NackReason::NO_ROUTE);
+  this->sendNack(nackHeader, ingress.face, pitEntry);
+  this->rejectPendingInterest(pitEntry);
+}
+
+void
+LAMDPStrategy::beforeExpirePendingInterest(const pit::Entry& pitEntry)
+{
+  if (!pitEntry.hasOutRecords()) {
+    return;
+  }
+
+  // the signal is emitted for every PIT entry; entries outside this strategy's namespace
+  // have no automaton here
+  lamdp::Automaton* automaton = m_measurements.getAutomaton(pitEntry.getName());
+  if (automaton == nullptr) {
+    return;
+  }
+
+  for (const auto& outRecord : pitEntry.getOutRecords()) {
+    endPending(*automaton, outRecord);
+  }
+}
+
+} // namespace fw
+} // namespace nfd
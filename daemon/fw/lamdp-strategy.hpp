@@ -1,69 +1,83 @@
-/*
- * 
- *
- *  Created on: Jun 30, 2019
- *      Author: reza
- */
-
-#ifndef NDNSIM_NFD_DAEMON_FW_LAMDP_STRATEGY_HPP_
-#define NDNSIM_NFD_DAEMON_FW_LAMDP_STRATEGY_HPP_
-
-#include "strategy.hpp"
-#include "asf-measurements.hpp"
-#include "fw/retx-suppression-exponential.hpp"
-// for queue size : calculating load
-
-
-namespace nfd {
-namespace fw {
-
-	typedef time::duration<double, boost::micro> myRtt;
-
-	/**
-	 * this is Structure of strategy prameters
-	 */
-
-	struct FaceStats{
-		Face* outFace;
-		Face* inFace;
-		int reward;
-		int availBW;
-		int unsatisfiedInterest;
-		int rtt;
-		float prob;
-		float wprob;
-	};
-
-
-	class LAMDPStrategy: public Strategy {
-		public:
-		explicit
-		LAMDPStrategy(Forwarder& forwarder, const Name& name = getStrategyName());
-
-		static const Name& getStrategyName();
-
-		void afterReceiveInterest(const Face& inFace, const Interest& interest,
-							const shared_ptr<pit::Entry>& pitEntry) override;
-
-
-		void afterReceiveData (const shared_ptr< pit::Entry > &pitEntry,
-							const Face &inFace, const Data &data) override;
-
-		private:
-
-		Face* getBestFaceForForwarding(const fib::Entry& fibEntry, const Interest& interest, const Face& inFace);
-
-		void sendNoRouteNack(const Face& inFace, const Interest& interest,
-									const shared_ptr<pit::Entry>& pitEntry);
-
-		int selectedFace;
-		RetxSuppressionExponential m_retxSuppression;
-		asf::AsfMeasurements m_measurements;
-		static const time::milliseconds RETX_SUPPRESSION_INITIAL;
-		static const time::milliseconds RETX_SUPPRESSION_MAX;
-
-	}; /* LAMDP class*/
-	} /* namespace fw */
-	} /* namespace nfd */
-
-	#endif /* NDNSIM_NFD_DAEMON_FW_LAMDP_STRATEGY_HPP_ */
+/*
+ *
+ *
+ *  Created on: Jun 30, 2019
+ *      Author: reza
+ */
+
+#ifndef NFD_DAEMON_FW_LAMDP_STRATEGY_HPP
+#define NFD_DAEMON_FW_LAMDP_STRATEGY_HPP
+
+#include "fw/strategy.hpp"
+#include "fw/lamdp-measurements.hpp"
+#include "fw/process-nack-traits.hpp"
+#include "fw/retx-suppression-exponential.hpp"
+
+namespace nfd {
+namespace fw {
+
+/** \brief Learning automata and MDP based multipath forwarding strategy
+ *
+ *  Each prefix has a learning automaton (lamdp::Automaton) kept in Measurements entries,
+ *  whose actions are the FIB nexthops. An Interest is forwarded to one nexthop chosen
+ *  with the weighted probability of its action, i.e. its learned probability scaled by a
+ *  reward that decreases with the RTT and the number of pending Interests of the nexthop.
+ *  Data rewards the action that brought it back; Nacks and retransmissions penalize it.
+ *
+ *  \note This strategy is not EndpointId-aware
+ */
+class LAMDPStrategy : public Strategy
+                    , public ProcessNackTraits<LAMDPStrategy>
+{
+public:
+  explicit
+  LAMDPStrategy(Forwarder& forwarder, const Name& name = getStrategyName());
+
+  static const Name&
+  getStrategyName();
+
+public: // triggers
+  void
+  afterReceiveInterest(const Interest& interest, const FaceEndpoint& ingress,
+                       const shared_ptr<pit::Entry>& pitEntry) override;
+
+  void
+  beforeSatisfyInterest(const Data& data, const FaceEndpoint& ingress,
+                        const shared_ptr<pit::Entry>& pitEntry) override;
+
+  void
+  afterReceiveNack(const lp::Nack& nack, const FaceEndpoint& ingress,
+                   const shared_ptr<pit::Entry>& pitEntry) override;
+
+private:
+  /** \brief chooses the nexthop to forward \p interest to
+   *  \return index of the chosen action, or lamdp::Automaton::MAX_ACTIONS if no nexthop is eligible
+   */
+  size_t
+  chooseAction(lamdp::Automaton& automaton, const fib::NextHopList& nexthops,
+               const Interest& interest, const Face& inFace,
+               const shared_ptr<pit::Entry>& pitEntry);
+
+  void
+  sendNoRouteNack(const Interest& interest, const FaceEndpoint& ingress,
+                  const shared_ptr<pit::Entry>& pitEntry);
+
+  /** \brief ends the pending Interests of all out-records of \p pitEntry, which is expiring
+   */
+  void
+  beforeExpirePendingInterest(const pit::Entry& pitEntry);
+
+NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  static const time::milliseconds RETX_SUPPRESSION_INITIAL;
+  static const time::milliseconds RETX_SUPPRESSION_MAX;
+  RetxSuppressionExponential m_retxSuppression;
+  lamdp::LamdpMeasurements m_measurements;
+  signal::ScopedConnection m_beforeExpireConn;
+
+  friend ProcessNackTraits<LAMDPStrategy>;
+};
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_LAMDP_STRATEGY_HPP
@@ -0,0 +1,67 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pending-interest-count.hpp"
+
+namespace nfd {
+namespace fw {
+
+constexpr double PendingInterestCount::ALPHA;
+
+PendingInterestCount*
+FacePicTable::find(FaceId faceId)
+{
+  for (auto& item : m_items) {
+    if (item.first == faceId) {
+      return &item.second;
+    }
+  }
+  return nullptr;
+}
+
+PendingInterestCount&
+FacePicTable::insert(FaceId faceId)
+{
+  PendingInterestCount* pic = find(faceId);
+  if (pic != nullptr) {
+    return *pic;
+  }
+  m_items.emplace_back(faceId, PendingInterestCount());
+  return m_items.back().second;
+}
+
+void
+FacePicTable::erase(FaceId faceId)
+{
+  auto it = std::find_if(m_items.begin(), m_items.end(),
+                         [faceId] (const value_type& item) { return item.first == faceId; });
+  if (it != m_items.end()) {
+    *it = m_items.back();
+    m_items.pop_back();
+  }
+}
+
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,163 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_PENDING_INTEREST_COUNT_HPP
+#define NFD_DAEMON_FW_PENDING_INTEREST_COUNT_HPP
+
+#include "face/face-common.hpp"
+
+namespace nfd {
+namespace fw {
+
+/** \brief Pending Interest Count (PIC) of one upstream face for one prefix
+ *
+ *  The smoothed count is an exponentially weighted moving average of the instantaneous count,
+ *  updated whenever the count changes.
+ *  \sa Carofiglio et al., Optimal Multipath Congestion Control and Request Forwarding
+ *      in Information-Centric Networks, ICNP 2013
+ */
+class PendingInterestCount
+{
+public:
+  void
+  increase()
+  {
+    ++m_count;
+    update();
+  }
+
+  void
+  decrease()
+  {
+    if (m_count > 0) {
+      --m_count;
+    }
+    update();
+  }
+
+  size_t
+  getCount() const
+  {
+    return m_count;
+  }
+
+  double
+  getSmoothedCount() const
+  {
+    return m_smoothed;
+  }
+
+  /** \brief forwarding weight, inversely proportional to the smoothed count
+   */
+  double
+  getWeight() const
+  {
+    return 1.0 / (1.0 + m_smoothed);
+  }
+
+private:
+  void
+  update()
+  {
+    m_smoothed = ALPHA * m_smoothed + (1.0 - ALPHA) * static_cast<double>(m_count);
+  }
+
+public:
+  static constexpr double ALPHA = 0.9;
+
+private:
+  size_t m_count = 0;
+  double m_smoothed = 0.0;
+};
+
+/** \brief PendingInterestCounts of all upstream faces of one prefix
+ *
+ *  Counters are stored contiguously and looked up by a linear scan,
+ *  which is faster than a node-based map for the handful of nexthops of a prefix.
+ */
+class FacePicTable
+{
+public:
+  using value_type = std::pair<FaceId, PendingInterestCount>;
+  using iterator = std::vector<value_type>::iterator;
+  using const_iterator = std::vector<value_type>::const_iterator;
+
+  /** \return the counter of \p faceId, or nullptr if it does not exist
+   */
+  PendingInterestCount*
+  find(FaceId faceId);
+
+  /** \return the counter of \p faceId, which is created if it does not exist
+   */
+  PendingInterestCount&
+  insert(FaceId faceId);
+
+  void
+  erase(FaceId faceId);
+
+  size_t
+  size() const
+  {
+    return m_items.size();
+  }
+
+  bool
+  empty() const
+  {
+    return m_items.empty();
+  }
+
+  iterator
+  begin()
+  {
+    return m_items.begin();
+  }
+
+  iterator
+  end()
+  {
+    return m_items.end();
+  }
+
+  const_iterator
+  begin() const
+  {
+    return m_items.begin();
+  }
+
+  const_iterator
+  end() const
+  {
+    return m_items.end();
+  }
+
+private:
+  std::vector<value_type> m_items;
+};
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_PENDING_INTEREST_COUNT_HPP
@@ -0,0 +1,229 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_PREFIX_STATE_TABLE_HPP
+#define NFD_DAEMON_FW_PREFIX_STATE_TABLE_HPP
+
+#include "table/name-tree-hashtable.hpp"
+
+#include <unordered_map>
+
+namespace nfd {
+namespace fw {
+
+/** \brief a per-prefix state store for forwarding strategies
+ *
+ *  Each item is keyed by the first \c getPrefixLength() components of a name. Lookups hash
+ *  the name components with the same function as the NameTree and compare components in
+ *  place, so that neither a truncated Name nor a URI string is constructed per packet.
+ *  A Name is only copied when a new item is inserted.
+ *
+ *  \tparam T type of per-prefix state, must be default-constructible
+ */
+template<typename T>
+class PrefixStateTable : noncopyable
+{
+public:
+  /** \param prefixLen number of leading name components that form the key;
+   *                   use std::numeric_limits<size_t>::max() to key on the full name
+   */
+  explicit
+  PrefixStateTable(size_t prefixLen = std::numeric_limits<size_t>::max())
+    : m_prefixLen(prefixLen)
+  {
+  }
+
+  size_t
+  getPrefixLength() const
+  {
+    return m_prefixLen;
+  }
+
+  size_t
+  size() const
+  {
+    return m_items.size();
+  }
+
+  /** \return state of the prefix of \p name, or nullptr if it does not exist
+   */
+  T*
+  find(const Name& name)
+  {
+    size_t len = std::min(name.size(), m_prefixLen);
+    auto it = findImpl(name, len, name_tree::computeHash(name, len));
+    return it == m_items.end() ? nullptr : &it->second.state;
+  }
+
+  /** \return state of the prefix of \p name, and true if it was newly created
+   */
+  std::pair<T*, bool>
+  insert(const Name& name)
+  {
+    size_t len = std::min(name.size(), m_prefixLen);
+    name_tree::HashValue h = name_tree::computeHash(name, len);
+    auto it = findImpl(name, len, h);
+    if (it != m_items.end()) {
+      return {&it->second.state, false};
+    }
+
+    it = m_items.emplace(std::piecewise_construct,
+                         std::forward_as_tuple(h),
+                         std::forward_as_tuple(name.getPrefix(len)));
+    return {&it->second.state, true};
+  }
+
+  /** \brief erases state of the prefix of \p name
+   *  \return number of items erased
+   */
+  size_t
+  erase(const Name& name)
+  {
+    size_t len = std::min(name.size(), m_prefixLen);
+    auto it = findImpl(name, len, name_tree::computeHash(name, len));
+    if (it == m_items.end()) {
+      return 0;
+    }
+    m_items.erase(it);
+    return 1;
+  }
+
+  /** \brief erases the state of every prefix for which \p pred returns true
+   *  \param pred a predicate invoked as `pred(T& state)`, which may modify the state
+   *  \return number of items erased
+   */
+  template<typename Pred>
+  size_t
+  eraseIf(Pred&& pred)
+  {
+    size_t nErased = 0;
+    for (auto it = m_items.begin(); it != m_items.end();) {
+      if (pred(it->second.state)) {
+        it = m_items.erase(it);
+        ++nErased;
+      }
+      else {
+        ++it;
+      }
+    }
+    return nErased;
+  }
+
+  void
+  clear()
+  {
+    m_items.clear();
+  }
+
+private:
+  struct Item
+  {
+    explicit
+    Item(Name prefix)
+      : prefix(std::move(prefix))
+    {
+    }
+
+    Name prefix;
+    T state;
+  };
+
+  using Container = std::unordered_multimap<name_tree::HashValue, Item>;
+
+  typename Container::iterator
+  findImpl(const Name& name, size_t len, name_tree::HashValue h)
+  {
+    auto range = m_items.equal_range(h);
+    for (auto it = range.first; it != range.second; ++it) {
+      const Name& prefix = it->second.prefix;
+      if (prefix.size() == len && prefix.compare(0, len, name, 0, len) == 0) {
+        return it;
+      }
+    }
+    return m_items.end();
+  }
+
+private:
+  size_t m_prefixLen;
+  Container m_items;
+};
+
+/** \brief remembers the downstream faces from which an Interest name was received
+ *
+ *  This is used by strategies to tell a retransmission from an aggregated Interest
+ *  coming from another downstream.
+ */
+class KnownInFaceTable : noncopyable
+{
+public:
+  /** \return whether \p faceId is known as a downstream of \p interestName
+   */
+  bool
+  contains(const Name& interestName, FaceId faceId)
+  {
+    const auto* faces = m_table.find(interestName);
+    return faces != nullptr && std::find(faces->begin(), faces->end(), faceId) != faces->end();
+  }
+
+  void
+  add(const Name& interestName, FaceId faceId)
+  {
+    auto& faces = *m_table.insert(interestName).first;
+    if (std::find(faces.begin(), faces.end(), faceId) == faces.end()) {
+      faces.push_back(faceId);
+    }
+  }
+
+  void
+  clear(const Name& interestName)
+  {
+    m_table.erase(interestName);
+  }
+
+  /** \brief forgets \p faceId as a downstream of every Interest name, e.g. when the face is removed
+   */
+  void
+  removeFace(FaceId faceId)
+  {
+    m_table.eraseIf([faceId] (std::vector<FaceId>& faces) {
+      faces.erase(std::remove(faces.begin(), faces.end(), faceId), faces.end());
+      return faces.empty();
+    });
+  }
+
+  size_t
+  size() const
+  {
+    return m_table.size();
+  }
+
+private:
+  PrefixStateTable<std::vector<FaceId>> m_table;
+};
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_PREFIX_STATE_TABLE_HPP
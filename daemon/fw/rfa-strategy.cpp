@@ -1,238 +1,216 @@
 #include "rfa-strategy.hpp"
+#include "algorithm.hpp"
+#include "common/logger.hpp"
 
-using namespace nfd;
-using namespace nfd::fw;
+#include <ndn-cxx/util/random.hpp>
 
-const Name RFAStrategy::STRATEGY_NAME("ndn:/localhost/nfd/strategy/rfa");
+namespace nfd {
+namespace fw {
 
-RFAStrategy::RFAStrategy(Forwarder &forwarder, const Name &name) : Strategy(forwarder, name)
+NFD_LOG_INIT(RFAStrategy);
+NFD_REGISTER_STRATEGY(RFAStrategy);
+
+constexpr size_t RFAStrategy::PREFIX_LENGTH;
+constexpr time::microseconds RFAStrategy::MEASUREMENTS_LIFETIME;
+
+RFAStrategy::PrefixInfo::~PrefixInfo()
 {
-  prefixComponents = ParameterConfiguration::getInstance ()->getParameter ("PREFIX_COMPONENT");
+  auto registry = this->registry.lock();
+  if (registry != nullptr) {
+    registry->erase(pics.get());
+  }
 }
 
-RFAStrategy::~RFAStrategy()
+RFAStrategy::PitEntryInfo::~PitEntryInfo()
 {
+  settle();
 }
 
-void RFAStrategy::afterReceiveInterest(const Face& inFace, const Interest& interest ,shared_ptr<fib::Entry> fibEntry, shared_ptr<pit::Entry> pitEntry)
+void
+RFAStrategy::PitEntryInfo::settle()
 {
-  /* Attention!!! interest != pitEntry->interest*/ // necessary to emulate NACKs in ndnSIM2.0
-  /* interst could be /NACK/suffix, while pitEntry->getInterest is /suffix */
-
-  if(!fibEntry->hasNextHops()) // check if nexthop(s) exist(s)
-  {
-    fprintf(stderr, "No next hop for prefix!\n");
-    //rejectPendingInterest(pitEntry); this would create a nack we dont need it so just return
+  if (outFace == face::INVALID_FACEID) {
     return;
   }
 
-  if(pitEntry->hasUnexpiredOutRecords()) //possible rtx or just the same request from a "different" source
-    {
-      if(!isRtx(inFace, interest))
-      {
-        addToKnownInFaces(inFace, interest); // other client/node requests same content
-        return; // this aggregates the interest
-      }
-      //else just continue as it was a normal interest..
-    }
-  addToKnownInFaces(inFace, interest);
-
-  std::string prefix = extractContentPrefix(pitEntry->getInterest().getName());
-
-  if(pmap.find (prefix) == pmap.end ()) //check if prefix is listed if not create it
-  {
-    //create new entry
-    pmap[prefix] = FacePicEntryMap();
-
-    //add all new hops
-    std::vector<fib::NextHop> nhops = fibEntry->getNextHops ();
-    for(unsigned int i = 0; i < nhops.size(); i++)
-    {
-      pmap[prefix][nhops.at (i).getFace()->getId()] = boost::shared_ptr<PIC>(new PIC());
+  // PICs are released with their Measurements entry, or when the strategy changes
+  auto pics = this->pics.lock();
+  if (pics != nullptr) {
+    PendingInterestCount* pic = pics->find(outFace);
+    if (pic != nullptr) {
+      pic->decrease();
     }
   }
+  outFace = face::INVALID_FACEID;
+}
 
-  // now prepare everything for inverse transform sampling to choose the outgoing face
+RFAStrategy::RFAStrategy(Forwarder& forwarder, const Name& name)
+  : Strategy(forwarder)
+  , m_picTables(make_shared<std::unordered_set<FacePicTable*>>())
+  , m_removeFaceConn(beforeRemoveFace.connect([this] (const Face& face) {
+      for (FacePicTable* pics : *m_picTables) {
+        pics->erase(face.getId());
+      }
+    }))
+{
+  ParsedInstanceName parsed = parseInstanceName(name);
+  if (!parsed.parameters.empty()) {
+    NDN_THROW(std::invalid_argument("RFAStrategy does not accept parameters"));
+  }
+  if (parsed.version && *parsed.version != getStrategyName()[-1].toVersion()) {
+    NDN_THROW(std::invalid_argument(
+      "RFAStrategy does not support version " + to_string(*parsed.version)));
+  }
+  this->setInstanceName(makeInstanceName(name, getStrategyName()));
+}
 
-  //calc sum for normalization and store weights in map
-  std::vector<int> inFaces = getAllInFaces(pitEntry); // in faces are not considerd as outgoing face
-  std::map<int /*face_id*/, double /*weight*/> wmap;
-  double sum = 0.0;
+const Name&
+RFAStrategy::getStrategyName()
+{
+  static const auto strategyName = Name("/localhost/nfd/strategy/rfa").appendVersion(1);
+  return strategyName;
+}
 
-  for(FacePicEntryMap::iterator it = pmap[prefix].begin(); it != pmap[prefix].end(); it++)
-  {
-    if(std::find(inFaces.begin (), inFaces.end (), it->first) == inFaces.end ()) // add only if not a inface
-    {
-      wmap[it->first]=it->second->getWeight();
-      sum += it->second->getWeight();
+const shared_ptr<FacePicTable>&
+RFAStrategy::getPics(const pit::Entry& pitEntry, const fib::Entry& fibEntry)
+{
+  MeasurementsAccessor& measurements = this->getMeasurements();
+
+  static const shared_ptr<FacePicTable> noPics;
+  const Name& name = pitEntry.getName();
+
+  // only content prefixes carry a PrefixInfo, so this finds the content prefix of pitEntry
+  // without constructing its Name, unless the prefix is new
+  size_t prefixLen = std::min(name.size(), PREFIX_LENGTH);
+  measurements::Entry* me = measurements.findLongestPrefixMatch(pitEntry,
+                              measurements::EntryWithStrategyInfo<PrefixInfo>());
+  if (me == nullptr || me->getName().size() < prefixLen) {
+    // If the content prefix is not under the strategy's namespace, find a longer prefix
+    // that falls under the strategy's namespace
+    me = nullptr;
+    for (; me == nullptr && prefixLen <= name.size(); ++prefixLen) {
+      me = measurements.get(name.getPrefix(prefixLen));
+    }
+    if (me == nullptr) {
+      NFD_LOG_WARN("no Measurements entry for " << name);
+      return noPics;
     }
   }
-
-  //normalize values in wMap
-  for(std::map<int, double>::iterator k = wmap.begin (); k!=wmap.end (); k++)
-  {
-    wmap[k->first] = (k->second/sum);
+  measurements.extendLifetime(*me, MEASUREMENTS_LIFETIME);
+
+  auto inserted = me->insertStrategyInfo<PrefixInfo>();
+  PrefixInfo* info = inserted.first;
+  // an existing PrefixInfo may have been registered by a previous instance of this strategy
+  if (inserted.second || info->registry.expired()) {
+    info->registry = m_picTables;
+    m_picTables->insert(info->pics.get());
   }
 
-  //now draw a random number and choose outgoing face
-  double rvalue = randomVariable.GetValue ();
-  sum = 0.0;
-  int out_face_id = -1;
-  for(std::map<int, double>::iterator k = wmap.begin (); k!=wmap.end (); k++)
-  {
-    sum += k->second;
-    if(rvalue <= sum)
-    {
-      out_face_id = k->first;
-      break;
+  // pick up nexthops added since the prefix was first seen
+  FacePicTable& pics = *info->pics;
+  if (pics.size() < fibEntry.getNextHops().size()) {
+    for (const auto& nexthop : fibEntry.getNextHops()) {
+      pics.insert(nexthop.getFace().getId());
     }
   }
-
-  if(out_face_id == -1) // no suitable face found
-  {
-    //rejectPendingInterest(pitEntry); this would create a nack we dont need it so just return
-    return;
-  }
-
-  //entry must exist no need to use find method
-  pmap[prefix][out_face_id]->increase();
-  pmap[prefix][out_face_id]->update();
-
-  sendInterest(pitEntry, getFaceTable ().get (out_face_id));
+  return info->pics;
 }
 
-void RFAStrategy::beforeSatisfyInterest(shared_ptr<pit::Entry> pitEntry,const Face& inFace, const Data& data)
+void
+RFAStrategy::afterReceiveInterest(const Interest& interest, const FaceEndpoint& ingress,
+                                  const shared_ptr<pit::Entry>& pitEntry)
 {
-  if(inFace.getId () <= 255) // this are virtual faces like the content store/ skip it
-  {
-    Strategy::beforeSatisfyInterest (pitEntry, inFace, data);
+  const fib::Entry& fibEntry = this->lookupFib(*pitEntry);
+  if (!fibEntry.hasNextHops()) {
+    NFD_LOG_DEBUG(interest << " from=" << ingress << " noNextHop");
     return;
   }
 
-  boost::shared_ptr<PIC> p = findPICEntry(inFace.getId (), extractContentPrefix (data.getName ()));
-
-  if(p != NULL)
-  {
-    p->decrease ();
-    p->update ();
+  PitEntryInfo* info = pitEntry->insertStrategyInfo<PitEntryInfo>().first;
+  auto& known = info->knownInFaces;
+  bool isKnownInFace = std::find(known.begin(), known.end(), ingress.face.getId()) != known.end();
+  if (!isKnownInFace) {
+    known.push_back(ingress.face.getId());
+  }
+  if (hasPendingOutRecords(*pitEntry) && !isKnownInFace) {
+    // same content requested by another downstream, aggregate
+    NFD_LOG_DEBUG(interest << " from=" << ingress << " aggregated");
+    return;
   }
-  clearKnownFaces(pitEntry->getInterest());
-  Strategy::beforeSatisfyInterest (pitEntry,inFace, data);
-}
-
-void RFAStrategy::beforeExpirePendingInterest(shared_ptr< pit::Entry > pitEntry)
-{
 
-  std::vector<int> faces = getAllOutFaces (pitEntry);
+  const shared_ptr<FacePicTable>& picsPtr = getPics(*pitEntry, fibEntry);
+  if (picsPtr == nullptr) {
+    NFD_LOG_DEBUG(interest << " from=" << ingress << " noMeasurements");
+    return;
+  }
+  FacePicTable& pics = *picsPtr;
 
-  for(unsigned int i = 0; i < faces.size (); i++)
-  {
-    boost::shared_ptr<PIC> p = findPICEntry((*faces.begin ()), extractContentPrefix (pitEntry->getName ()));
-    if(p != NULL)
-    {
-      p->decrease ();
-      p->update ();
+  // inverse transform sampling over the weights of eligible upstreams
+  double sum = 0.0;
+  for (const auto& item : pics) {
+    if (std::find(known.begin(), known.end(), item.first) == known.end()) {
+      sum += item.second.getWeight();
     }
   }
-  clearKnownFaces(pitEntry->getInterest());
-  Strategy::beforeExpirePendingInterest (pitEntry);
-}
-
-boost::shared_ptr<PIC> RFAStrategy::findPICEntry(int face_id, std::string prefix)
-{
-  PrefixMap::iterator it = pmap.find (prefix);
-
-  if(it == pmap.end())
-  {
-    fprintf(stderr, "Error could not find prefix in pmap!\n");
-    return NULL;
+  if (sum <= 0.0) {
+    NFD_LOG_DEBUG(interest << " from=" << ingress << " noEligibleNextHop");
+    return;
   }
 
-  FacePicEntryMap::iterator k = pmap[prefix].find(face_id);
-
-  if(k == pmap[prefix].end())
-  {
-    fprintf(stderr, "Error could not find PICEntry for face\n");
-    return NULL;
+  std::uniform_real_distribution<double> dist(0.0, sum);
+  double rvalue = dist(ndn::random::getRandomNumberEngine());
+  FacePicTable::value_type* chosen = nullptr;
+  sum = 0.0;
+  for (auto& item : pics) {
+    if (std::find(known.begin(), known.end(), item.first) != known.end()) {
+      continue;
+    }
+    sum += item.second.getWeight();
+    chosen = &item;
+    if (rvalue <= sum) {
+      break;
+    }
   }
 
-  return pmap[prefix][face_id];
-}
-
-
-std::string RFAStrategy::extractContentPrefix(nfd::Name name)
-{
-  std::string prefix = "";
-  for(int i=0; i <= prefixComponents; i++)
-  {
-    prefix.append ("/");
-    prefix.append (name.get (i).toUri ());
+  Face* outFace = chosen == nullptr ? nullptr : this->getFace(chosen->first);
+  if (outFace == nullptr) {
+    NFD_LOG_DEBUG(interest << " from=" << ingress << " noEligibleNextHop");
+    if (chosen != nullptr) {
+      pics.erase(chosen->first);
+    }
+    return;
   }
-  return prefix;
-}
 
-std::vector<int> RFAStrategy::getAllOutFaces(shared_ptr<pit::Entry> pitEntry)
-{
-  std::vector<int> faces;
-  const nfd::pit::OutRecordCollection records = pitEntry->getOutRecords();
-
-  for(nfd::pit::OutRecordCollection::const_iterator it = records.begin (); it!=records.end (); ++it)
-    faces.push_back((*it).getFace()->getId());
+  // a retransmission releases the PIC of its previous upstream
+  info->settle();
+  chosen->second.increase();
+  info->pics = picsPtr;
+  info->outFace = outFace->getId();
 
-  return faces;
+  NFD_LOG_DEBUG(interest << " from=" << ingress << " to=" << outFace->getId());
+  this->sendInterest(interest, *outFace, pitEntry);
 }
 
-std::vector<int> RFAStrategy::getAllInFaces(shared_ptr<pit::Entry> pitEntry)
+void
+RFAStrategy::beforeSatisfyInterest(const Data& data, const FaceEndpoint& ingress,
+                                   const shared_ptr<pit::Entry>& pitEntry)
 {
-  std::vector<int> faces;
-  const nfd::pit::InRecordCollection records = pitEntry->getInRecords();
-
-  for(nfd::pit::InRecordCollection::const_iterator it = records.begin (); it!=records.end (); ++it)
-  {
-    if(! (*it).getFace()->isLocal())
-      faces.push_back((*it).getFace()->getId());
+  PitEntryInfo* info = pitEntry->getStrategyInfo<PitEntryInfo>();
+  if (info != nullptr) {
+    info->settle();
   }
-  return faces;
-}
-
-bool RFAStrategy::isRtx (const nfd::Face& inFace, const ndn::Interest& interest)
-{
-  KnownInFaceMap::iterator it = inFaceMap.find (interest.getName ().toUri());
-  if(it == inFaceMap.end ())
-    return false;
-
-  for(std::list<int>::iterator k = it->second.begin(); k != it->second.end(); k++)
-  {
-    if((*k) == inFace.getId ())
-      return true;
-  }
-
-  return false;
 }
 
-void RFAStrategy::addToKnownInFaces(const nfd::Face& inFace, const ndn::Interest&interest)
+void
+RFAStrategy::afterReceiveNack(const lp::Nack& nack, const FaceEndpoint& ingress,
+                              const shared_ptr<pit::Entry>& pitEntry)
 {
-  KnownInFaceMap::iterator it = inFaceMap.find (interest.getName ().toUri());
-
-  if(it == inFaceMap.end ())
-    inFaceMap[interest.getName ().toUri ()] = std::list<int>();
-
-  std::list<int> list = inFaceMap[interest.getName ().toUri ()];
-
-  if(std::find(list.begin (),list.end (), inFace.getId()) == list.end ()) //if face not known as in face
-    inFaceMap[interest.getName ().toUri ()].push_back(inFace.getId());    //remember it
-}
-
-void RFAStrategy::clearKnownFaces(const ndn::Interest&interest)
-{
-  KnownInFaceMap::iterator it = inFaceMap.find (interest.getName ().toUri());
-
-  if(it == inFaceMap.end ())
-  {
-    //This may happen due to bad behavior of NDN core code!
-    //beforeSatisfyInterest may be called multiple times for 1 pit entry..
-    return;
+  PitEntryInfo* info = pitEntry->getStrategyInfo<PitEntryInfo>();
+  if (info != nullptr) {
+    info->settle();
   }
-  inFaceMap.erase (it);
+  this->sendNacks(nack.getHeader(), pitEntry);
 }
 
+} // namespace fw
+} // namespace nfd
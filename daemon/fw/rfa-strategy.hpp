@@ -18,69 +18,118 @@
 #ifndef RFAStrategy_H
 #define RFAStrategy_H
 
-#include "face/face.hpp"
 #include "fw/strategy.hpp"
-#include "pic.h"
+#include "fw/pending-interest-count.hpp"
 
-#include "boost/shared_ptr.hpp"
-#include "ns3/random-variable.h"
-#include "../../../utils/parameterconfiguration.h"
+#include <unordered_set>
 
 namespace nfd
 {
 namespace fw
 {
 
-class RFAStrategy : public nfd::fw::Strategy
+/** \brief Request Forwarding Algorithm (RFA) strategy
+ *
+ *  Interests are forwarded to one upstream, drawn at random with a probability proportional
+ *  to the weight of its Pending Interest Count (PIC) for the content prefix, i.e. the first
+ *  PREFIX_LENGTH components of the Interest name.
+ *  PICs are kept in a flat per-face array on the Measurements entry of the content prefix,
+ *  so that they are released after MEASUREMENTS_LIFETIME without traffic. Removed faces are
+ *  pruned from all PICs.
+ */
+class RFAStrategy : public Strategy
 {
 public:
-  RFAStrategy(Forwarder &forwarder, const Name &name = STRATEGY_NAME);
-
-  virtual ~RFAStrategy();
-  virtual void afterReceiveInterest(const nfd::Face& inFace, const ndn::Interest& interest,shared_ptr<fib::Entry> fibEntry, shared_ptr<pit::Entry> pitEntry);
-  virtual void beforeSatisfyInterest(shared_ptr<pit::Entry> pitEntry,const nfd::Face& inFace, const ndn::Data& data);
-  virtual void beforeExpirePendingInterest(shared_ptr< pit::Entry > pitEntry);
-
-  static const Name STRATEGY_NAME;
-
-protected:
-
-  typedef std::map
-    < int, /*face ID*/
-      boost::shared_ptr<PIC> /*Pending Interest Count*/
-    > FacePicEntryMap;
-
-  typedef std::map
-    < std::string, /*prefix*/
-      FacePicEntryMap
-    > PrefixMap;
+  explicit
+  RFAStrategy(Forwarder& forwarder, const Name& name = getStrategyName());
+
+  static const Name&
+  getStrategyName();
+
+  /// StrategyInfo on measurements::Entry of a content prefix
+  class PrefixInfo final : public StrategyInfo
+  {
+  public:
+    static constexpr int
+    getTypeId()
+    {
+      return 1061;
+    }
+
+    ~PrefixInfo() final;
+
+  public:
+    /// PICs are shared with PIT entries, which may outlive the Measurements entry
+    shared_ptr<FacePicTable> pics = make_shared<FacePicTable>();
+    weak_ptr<std::unordered_set<FacePicTable*>> registry;
+  };
+
+  /// StrategyInfo on pit::Entry
+  class PitEntryInfo final : public StrategyInfo
+  {
+  public:
+    static constexpr int
+    getTypeId()
+    {
+      return 1060;
+    }
+
+    ~PitEntryInfo() final;
+
+    /** \brief decreases the PIC of the upstream the Interest was forwarded to, at most once
+     *
+     *  This is invoked when Data or Nack arrives, and from the destructor if the PIT entry
+     *  expires without either.
+     */
+    void
+    settle();
+
+  public:
+    std::vector<FaceId> knownInFaces;
+    weak_ptr<FacePicTable> pics;
+    FaceId outFace = face::INVALID_FACEID;
+  };
+
+public: // triggers
+  void
+  afterReceiveInterest(const Interest& interest, const FaceEndpoint& ingress,
+                       const shared_ptr<pit::Entry>& pitEntry) override;
+
+  void
+  beforeSatisfyInterest(const Data& data, const FaceEndpoint& ingress,
+                        const shared_ptr<pit::Entry>& pitEntry) override;
+
+  void
+  afterReceiveNack(const lp::Nack& nack, const FaceEndpoint& ingress,
+                   const shared_ptr<pit::Entry>& pitEntry) override;
+
+NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /** \brief returns the PICs of the content prefix of \p pitEntry, creating them from
+   *         \p fibEntry, and extends the lifetime of their Measurements entry
+   *
+   *  If the strategy is chosen on a namespace longer than PREFIX_LENGTH, the PICs are kept
+   *  on the prefix of \p pitEntry at the depth of that namespace.
+   *  \return the PICs, or nullptr if no prefix of \p pitEntry is under this strategy
+   */
+  const shared_ptr<FacePicTable>&
+  getPics(const pit::Entry& pitEntry, const fib::Entry& fibEntry);
 
-  std::string extractContentPrefix(nfd::Name name);
-  std::vector<int> getAllOutFaces(shared_ptr<pit::Entry> pitEntry);
-  std::vector<int> getAllInFaces(shared_ptr<pit::Entry> pitEntry);
-
-  boost::shared_ptr<PIC> findPICEntry(int face_id, std::string prefix);
-
-  PrefixMap pmap;
-
-  ns3::UniformVariable randomVariable;
-
-  typedef std::map<
-  std::string /*interest name*/,
-  std::list<int> /*known infaces*/
-  > KnownInFaceMap;
+public:
+  /// number of leading name components that identify the content
+  static constexpr size_t PREFIX_LENGTH = 2;
 
-  KnownInFaceMap inFaceMap;
+  static constexpr time::microseconds MEASUREMENTS_LIFETIME = 5_min;
 
-  bool isRtx(const nfd::Face& inFace, const ndn::Interest&interest);
-  void addToKnownInFaces(const nfd::Face& inFace, const ndn::Interest&interest);
-  void clearKnownFaces(const ndn::Interest&interest);
+NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /// PICs of all live PrefixInfos, for pruning removed faces; shared with PrefixInfo
+  /// destructors, which may run after the strategy is destroyed
+  shared_ptr<std::unordered_set<FacePicTable*>> m_picTables;
 
-  int prefixComponents;
+private:
+  signal::ScopedConnection m_removeFaceConn;
 };
 
+} // namespace fw
+} // namespace nfd
 
-}
-}
-#endif
-
+#endif // RFAStrategy_H
@@ -18,6 +18,7 @@ SAFStrategy::SAFStrategy(Forwarder &forwarder, const Name &name) : Strategy(forw
   this->beforeRemoveFace.connect([this] (shared_ptr<Face> face)
   {
     engine->removeFace (face);
+    inFaceMap.removeFace (face->getId ());
   });
 }
 
@@ -92,7 +93,7 @@ void SAFStrategy::afterReceiveInterest(const Face& inFace, const Interest& inter
 
 void SAFStrategy::beforeSatisfyInterest(shared_ptr<pit::Entry> pitEntry,const Face& inFace, const Data& data)
 {  
-  const std::list<nfd::pit::OutRecord> outRecords = pitEntry->getOutRecords ();
+  const nfd::pit::OutRecordCollection& outRecords = pitEntry->getOutRecords ();
   for(nfd::pit::OutRecordCollection::const_iterator it = outRecords.begin (); it!=outRecords.end (); ++it)
   {
     if((*it).getFace()->getId() != inFace.getId ())
@@ -114,7 +115,7 @@ void SAFStrategy::beforeExpirePendingInterest(shared_ptr< pit::Entry > pitEntry)
 std::vector<int> SAFStrategy::getAllInFaces(shared_ptr<pit::Entry> pitEntry)
 {
   std::vector<int> faces;
-  const nfd::pit::InRecordCollection records = pitEntry->getInRecords();
+  const nfd::pit::InRecordCollection& records = pitEntry->getInRecords();
 
   for(nfd::pit::InRecordCollection::const_iterator it = records.begin (); it!=records.end (); ++it)
   {
@@ -127,7 +128,7 @@ std::vector<int> SAFStrategy::getAllInFaces(shared_ptr<pit::Entry> pitEntry)
 std::vector<int> SAFStrategy::getAllOutFaces(shared_ptr<pit::Entry> pitEntry)
 {
   std::vector<int> faces;
-  const nfd::pit::OutRecordCollection records = pitEntry->getOutRecords();
+  const nfd::pit::OutRecordCollection& records = pitEntry->getOutRecords();
 
   for(nfd::pit::OutRecordCollection::const_iterator it = records.begin (); it!=records.end (); ++it)
     faces.push_back((*it).getFace()->getId());
@@ -137,43 +138,18 @@ std::vector<int> SAFStrategy::getAllOutFaces(shared_ptr<pit::Entry> pitEntry)
 
 bool SAFStrategy::isRtx (const nfd::Face& inFace, const ndn::Interest& interest)
 {
-  KnownInFaceMap::iterator it = inFaceMap.find (interest.getName ().toUri());
-  if(it == inFaceMap.end ())
-    return false;
-
-  for(std::list<int>::iterator k = it->second.begin(); k != it->second.end(); k++)
-  {
-    if((*k) == inFace.getId ())
-      return true;
-  }
-
-  return false;
+  return inFaceMap.contains(interest.getName(), inFace.getId());
 }
 
 void SAFStrategy::addToKnownInFaces(const nfd::Face& inFace, const ndn::Interest&interest)
 {
-  KnownInFaceMap::iterator it = inFaceMap.find (interest.getName ().toUri());
-
-  if(it == inFaceMap.end ())
-    inFaceMap[interest.getName ().toUri ()] = std::list<int>();
-
-  std::list<int> list = inFaceMap[interest.getName ().toUri ()];
-
-  if(std::find(list.begin (),list.end (), inFace.getId()) == list.end ()) //if face not known as in face
-    inFaceMap[interest.getName ().toUri ()].push_back(inFace.getId());    //remember it
+  inFaceMap.add(interest.getName(), inFace.getId());
 }
 
 void SAFStrategy::clearKnownFaces(const ndn::Interest&interest)
 {
-  KnownInFaceMap::iterator it = inFaceMap.find (interest.getName ().toUri());
-
-  if(it == inFaceMap.end ())
-  {
-    //This may happen due to bad behavior of NDN core code!
-    //beforeSatisfyInterest may be called multiple times for 1 pit entry..
-    return;
-  }
-  inFaceMap.erase (it);
+  //beforeSatisfyInterest may be called multiple times for 1 pit entry, clearing twice is harmless
+  inFaceMap.clear(interest.getName());
 }
 
 signal::Signal< FaceTable, shared_ptr< Face > > & afterAddFace();
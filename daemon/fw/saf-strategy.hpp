@@ -20,6 +20,7 @@
 
 #include "face/face.hpp"
 #include "fw/strategy.hpp"
+#include "fw/prefix-state-table.hpp"
 #include "boost/shared_ptr.hpp"
 #include "safengine.h"
 
@@ -53,12 +54,7 @@ protected:
 
   boost::shared_ptr<SAFEngine> engine;
 
-  typedef std::map<
-  std::string /*interest name*/,
-  std::list<int> /*known infaces*/
-  > KnownInFaceMap;
-
-  KnownInFaceMap inFaceMap;
+  KnownInFaceTable inFaceMap;
 
 };
 
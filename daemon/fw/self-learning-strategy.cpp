@@ -121,7 +121,7 @@ SelfLearningStrategy::afterReceiveData(const Data& data, const FaceEndpoint& ing
   else { // outgoing Interest was discovery
     auto paTag = data.getTag<lp::PrefixAnnouncementTag>();
     if (paTag != nullptr) {
-      addRoute(pitEntry, ingress.face, data, *paTag->get().getPrefixAnn());
+      addRoute(ingress.face, *paTag->get().getPrefixAnn());
     }
     else { // Data contains no PrefixAnnouncement, upstreams do not support self-learning
     }
@@ -235,27 +235,16 @@ SelfLearningStrategy::needPrefixAnn(const shared_ptr<pit::Entry>& pitEntry)
 }
 
 void
-SelfLearningStrategy::addRoute(const shared_ptr<pit::Entry>& pitEntry, const Face& inFace,
-                               const Data& data, const ndn::PrefixAnnouncement& pa)
+SelfLearningStrategy::addRoute(const Face& inFace, const ndn::PrefixAnnouncement& pa)
 {
-  runOnRibIoService([pitEntryWeak = weak_ptr<pit::Entry>{pitEntry}, inFaceId = inFace.getId(), data, pa] {
-    rib::Service::get().getRibManager().slAnnounce(pa, inFaceId, ROUTE_RENEW_LIFETIME,
-      [] (RibManager::SlAnnounceResult res) {
-        NFD_LOG_DEBUG("Add route via PrefixAnnouncement with result=" << res);
-      });
-  });
+  m_routeChannel.announce(pa, inFace.getId(), ROUTE_RENEW_LIFETIME);
 }
 
 void
 SelfLearningStrategy::renewRoute(const Name& name, FaceId inFaceId, time::milliseconds maxLifetime)
 {
   // renew route with PA or ignore PA (if route has no PA)
-  runOnRibIoService([name, inFaceId, maxLifetime] {
-    rib::Service::get().getRibManager().slRenew(name, inFaceId, maxLifetime,
-      [] (RibManager::SlAnnounceResult res) {
-        NFD_LOG_DEBUG("Renew route with result=" << res);
-      });
-  });
+  m_routeChannel.renew(name, inFaceId, maxLifetime);
 }
 
 } // namespace fw
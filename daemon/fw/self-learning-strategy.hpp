@@ -26,6 +26,7 @@
 #ifndef NFD_DAEMON_FW_SELF_LEARNING_STRATEGY_HPP
 #define NFD_DAEMON_FW_SELF_LEARNING_STRATEGY_HPP
 
+#include "fw/sl-route-channel.hpp"
 #include "fw/strategy.hpp"
 
 #include <ndn-cxx/lp/prefix-announcement-header.hpp>
@@ -129,8 +130,7 @@ private: // operations
   /** \brief Add a route using RibManager::slAnnounce on the RIB thread
    */
   void
-  addRoute(const shared_ptr<pit::Entry>& pitEntry, const Face& inFace,
-           const Data& data, const ndn::PrefixAnnouncement& pa);
+  addRoute(const Face& inFace, const ndn::PrefixAnnouncement& pa);
 
   /** \brief renew a route using RibManager::slRenew on the RIB thread
    */
@@ -139,6 +139,8 @@ private: // operations
 
 private:
   static const time::milliseconds ROUTE_RENEW_LIFETIME;
+
+  SlRouteChannel m_routeChannel;
 };
 
 } // namespace fw
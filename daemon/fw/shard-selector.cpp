@@ -0,0 +1,68 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "shard-selector.hpp"
+#include "table/name-tree-hashtable.hpp"
+
+namespace nfd {
+namespace fw {
+
+ShardSelector::ShardSelector(size_t nShards, size_t prefixLength)
+  : m_nShards(nShards)
+  , m_prefixLength(prefixLength)
+{
+  BOOST_ASSERT(nShards > 0);
+}
+
+size_t
+ShardSelector::operator()(const Name& name) const
+{
+  return select(name_tree::computeHash(name, m_prefixLength));
+}
+
+size_t
+ShardSelector::operator()(const Interest& interest) const
+{
+  const auto& hashes = name_tree::getHashes(interest);
+  return select(hashes[std::min(m_prefixLength, hashes.size() - 1)]);
+}
+
+size_t
+ShardSelector::operator()(const Data& data) const
+{
+  const auto& hashes = name_tree::getHashes(data);
+  return select(hashes[std::min(m_prefixLength, hashes.size() - 1)]);
+}
+
+size_t
+ShardSelector::select(size_t hash) const
+{
+  // Fibonacci hashing spreads any input bits into the high half of the product
+  uint64_t mixed = static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ULL;
+  return static_cast<size_t>((mixed >> 32) % m_nShards);
+}
+
+} // namespace fw
+} // namespace nfd
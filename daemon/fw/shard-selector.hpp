@@ -0,0 +1,85 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_SHARD_SELECTOR_HPP
+#define NFD_DAEMON_FW_SHARD_SELECTOR_HPP
+
+#include "core/common.hpp"
+
+namespace nfd {
+namespace fw {
+
+/** \brief Partitions the name space into shards by a hash of a fixed-length name prefix
+ *
+ *  An Interest and the Data that satisfies it are assigned to the same shard as long as the
+ *  Interest name has at least \p prefixLength components, so that each shard can own a private
+ *  PIT, CS and Measurements. Names shorter than \p prefixLength are hashed in full.
+ *
+ *  The shard is taken from the high bits of the mixed name hash, so that the low bits used by the
+ *  NameTree hashtable of each shard remain evenly distributed.
+ */
+class ShardSelector
+{
+public:
+  ShardSelector(size_t nShards, size_t prefixLength);
+
+  size_t
+  getNShards() const
+  {
+    return m_nShards;
+  }
+
+  size_t
+  getPrefixLength() const
+  {
+    return m_prefixLength;
+  }
+
+  size_t
+  operator()(const Name& name) const;
+
+  /** \note This reuses and populates the hash sequence cached on \p interest.
+   */
+  size_t
+  operator()(const Interest& interest) const;
+
+  /** \note This reuses and populates the hash sequence cached on \p data.
+   */
+  size_t
+  operator()(const Data& data) const;
+
+private:
+  size_t
+  select(size_t hash) const;
+
+private:
+  size_t m_nShards;
+  size_t m_prefixLength;
+};
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_SHARD_SELECTOR_HPP
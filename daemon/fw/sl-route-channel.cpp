@@ -0,0 +1,102 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sl-route-channel.hpp"
+
+#include "common/global.hpp"
+#include "common/logger.hpp"
+#include "rib/service.hpp"
+
+namespace nfd {
+namespace fw {
+
+NFD_LOG_INIT(SlRouteChannel);
+
+constexpr size_t SlRouteChannel::DEFAULT_CAPACITY;
+
+SlRouteChannel::SlRouteChannel(size_t capacity)
+  : SlRouteChannel(capacity, &runOnRibIoService, &SlRouteChannel::process)
+{
+}
+
+SlRouteChannel::SlRouteChannel(size_t capacity, MpscChannel<SlRouteRequest>::PostFunc post,
+                               MpscChannel<SlRouteRequest>::Handler handler)
+  : m_channel(capacity, std::move(post), std::move(handler))
+{
+}
+
+bool
+SlRouteChannel::announce(const ndn::PrefixAnnouncement& pa, FaceId faceId,
+                         time::milliseconds maxLifetime)
+{
+  bool isQueued = m_channel.send([&] (SlRouteRequest& request) {
+    request.action = SlRouteRequest::Action::ANNOUNCE;
+    request.faceId = faceId;
+    request.maxLifetime = maxLifetime;
+    request.announcement = pa;
+  });
+  if (!isQueued) {
+    NFD_LOG_DEBUG("Channel full, dropping announce " << pa.getAnnouncedName() << " face=" << faceId);
+  }
+  return isQueued;
+}
+
+bool
+SlRouteChannel::renew(const Name& name, FaceId faceId, time::milliseconds maxLifetime)
+{
+  bool isQueued = m_channel.send([&] (SlRouteRequest& request) {
+    request.action = SlRouteRequest::Action::RENEW;
+    request.faceId = faceId;
+    request.maxLifetime = maxLifetime;
+    request.name = name;
+  });
+  if (!isQueued) {
+    NFD_LOG_DEBUG("Channel full, dropping renew " << name << " face=" << faceId);
+  }
+  return isQueued;
+}
+
+void
+SlRouteChannel::process(SlRouteRequest& request)
+{
+  auto& ribManager = rib::Service::get().getRibManager();
+  switch (request.action) {
+    case SlRouteRequest::Action::ANNOUNCE:
+      ribManager.slAnnounce(*request.announcement, request.faceId, request.maxLifetime,
+        [] (RibManager::SlAnnounceResult res) {
+          NFD_LOG_DEBUG("Add route via PrefixAnnouncement with result=" << res);
+        });
+      break;
+    case SlRouteRequest::Action::RENEW:
+      ribManager.slRenew(request.name, request.faceId, request.maxLifetime,
+        [] (RibManager::SlAnnounceResult res) {
+          NFD_LOG_DEBUG("Renew route with result=" << res);
+        });
+      break;
+  }
+}
+
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,111 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_SL_ROUTE_CHANNEL_HPP
+#define NFD_DAEMON_FW_SL_ROUTE_CHANNEL_HPP
+
+#include "common/mpsc-channel.hpp"
+#include "face/face-common.hpp"
+
+#include <ndn-cxx/prefix-announcement.hpp>
+
+namespace nfd {
+namespace fw {
+
+/** \brief A route update requested by a self-learning strategy
+ */
+struct SlRouteRequest
+{
+  enum class Action {
+    ANNOUNCE, ///< RibManager::slAnnounce with \c announcement
+    RENEW,    ///< RibManager::slRenew with \c name
+  };
+
+  Action action = Action::RENEW;
+  FaceId faceId = face::INVALID_FACEID;
+  time::milliseconds maxLifetime = 0_ms;
+  Name name;
+  optional<ndn::PrefixAnnouncement> announcement;
+};
+
+/** \brief Carries route updates of a self-learning strategy to the RIB thread
+ *
+ *  Requests are copied into slots of an MpscChannel and handed to RibManager in batches,
+ *  instead of posting one closure per request. A slot keeps its contents after its request
+ *  has been handled, so that the next request overwrites the Name and PrefixAnnouncement in
+ *  place and reuses their capacity. The memory retained this way is bounded by the number of
+ *  slots. When the channel is full, requests are dropped; the route is announced or renewed
+ *  again by a later Data or Nack.
+ */
+class SlRouteChannel
+{
+public:
+  explicit
+  SlRouteChannel(size_t capacity = DEFAULT_CAPACITY);
+
+NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /** \brief constructs a channel that hands requests to \p handler via \p post
+   */
+  SlRouteChannel(size_t capacity, MpscChannel<SlRouteRequest>::PostFunc post,
+                 MpscChannel<SlRouteRequest>::Handler handler);
+
+public:
+  /** \brief request RibManager::slAnnounce
+   *  \return whether the request was queued
+   */
+  bool
+  announce(const ndn::PrefixAnnouncement& pa, FaceId faceId, time::milliseconds maxLifetime);
+
+  /** \brief request RibManager::slRenew
+   *  \return whether the request was queued
+   */
+  bool
+  renew(const Name& name, FaceId faceId, time::milliseconds maxLifetime);
+
+  const MpscChannel<SlRouteRequest>&
+  getChannel() const
+  {
+    return m_channel;
+  }
+
+private:
+  static void
+  process(SlRouteRequest& request);
+
+public:
+  /** \brief default number of slots, one drain's worth of requests
+   *
+   *  Every strategy instance owns a channel, so the default is kept small.
+   */
+  static constexpr size_t DEFAULT_CAPACITY = 64;
+
+private:
+  MpscChannel<SlRouteRequest> m_channel;
+};
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_SL_ROUTE_CHANNEL_HPP
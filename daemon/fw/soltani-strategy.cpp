@@ -9,6 +9,7 @@
 
 #include "soltani-strategy.hpp"
 #include "algorithm.hpp"
+#include "topsis.hpp"
 #include "core/logger.hpp"
 
 namespace nfd
@@ -23,6 +24,11 @@ namespace nfd
 		const time::milliseconds SoltaniStrategy::RETX_SUPPRESSION_MAX(250);
 
 		ns3::QueueSize qz;
+
+		static const float WEIGHT_BW = 0.4f;
+		static const float WEIGHT_COST = 0.2f;
+		static const float WEIGHT_RTT = 0.4f;
+
 		/**
 		 * \brief constructor of soltani-strategy
 		 * @param forwarder instance for run strategy
@@ -141,74 +147,32 @@ namespace nfd
 			this->countBeforeSatisfyInterest++;
 		}
 
-		/**
-		 * \brief for calculate method for soltani forwarding strategy
-		 * @param states
-		 * @param rows the number of faces in fibEntry
-		 * @return rows choose best face row.
-		 */
-		int result(FaceStats *stats, int rows)
-		{
-
-			static const myRtt S_RTT_TIMEOUT = time::microseconds::max();
-			static const myRtt S_RTT_NO_MEASUREMENT = S_RTT_TIMEOUT / 2;
-			int col = 3;
-			float *q;
-			for (int var = 0; var < rows; ++var)
-			{
-				B[var] = stats->BW;
-				H[var] = stats->hopCount;
-				if (stats->rtt == asf::RttStats::RTT_NO_MEASUREMENT)
-				{
-					T[var] = (float)S_RTT_NO_MEASUREMENT.count();
-				}
-				else
-				{
-					T[var] = (float)stats->rtt.count();
-				}
-			}
-			for (int var = 0; var < rows; ++var)
-			{
-				if (methed == 1)
-				{
-				float a = (1 - ((-1 / LN[M])*(B[var] * Ln[B[var]]))) + (1 - ((-1/LN(M))*((1-H[var])*(LN(1-H[var]))) + (1-((-1/LN(M))((1-T[var]*[LN(1-T[var])])))))));
-				float q[var] = (WB / a) * (B[var] + 1 / ((WT * T[var] + WH * H[var]) * (1 / WT * T[var] + WH * H[var])));
-				}
-				else if (method == 2)
-				{
-					float q[var] = B[var] * (1 - ((-1 / LN(M)) * B[var] * (LN(B[var]))) + (1 - H[var]) * (1 - ((-1 / LN(M)) * (1 - H[var]) * (LN(1 - H[var]))) + (1 - T[var]) * (1 - ((-1 / LN(M)) * (1 - T[var]) * (LN(1 - T[var]))))));
-				}
-			}
-
-			float bestValue = 0;
-			int bestRow = 0;
-			for (int l = 0; l < rows; ++l)
-			{
-				if (q[l] > bestValue)
-				{
-					bestRow = l;
-					bestValue = q[l];
-				}
-			}
-			return bestRow;
-		}
-
 		/**
 		 * \brief the main strategy for send interest
+		 *
+		 * Eligible nexthops are ranked with TOPSIS over bandwidth (benefit), routing cost (cost)
+		 * and smoothed RTT (cost). The engine lives on the stack, so ranking does not allocate.
 		 * @param fibEntry
 		 * @param interest
 		 * @param inface
-		 * @return the best face for sending Interest
+		 * @return the best face for sending Interest, or nullptr if no nexthop is eligible
 		 */
 		Face *
 		SoltaniStrategy::getBestFaceForForwarding(const fib::Entry &fibEntry, const Interest &interest, const Face &inFace)
 		{
+			// a face without measurements ranks as if its RTT were one second
+			static const myRtt S_RTT_NO_MEASUREMENT = time::seconds(1);
 
-			const fib::NextHopList &nexthops = fibEntry.getNextHops();
-			FaceStats *stats = new FaceStats[10];
-			int i = 0;
+			enum { CRITERION_BW, CRITERION_COST, CRITERION_RTT };
+
+			Topsis topsis;
+			topsis.setCriterion(CRITERION_BW, WEIGHT_BW, Topsis::CriterionType::BENEFIT);
+			topsis.setCriterion(CRITERION_COST, WEIGHT_COST, Topsis::CriterionType::COST);
+			topsis.setCriterion(CRITERION_RTT, WEIGHT_RTT, Topsis::CriterionType::COST);
 
-			for (const fib::NextHop &hop : nexthops)
+			std::array<Face *, Topsis::MAX_ALTERNATIVES> faces;
+
+			for (const fib::NextHop &hop : fibEntry.getNextHops())
 			{
 				Face &hopFace = hop.getFace();
 				if ((hopFace.getId() == inFace.getId() && hopFace.getLinkType() != ndn::nfd::LINK_TYPE_AD_HOC) ||
@@ -216,27 +180,32 @@ namespace nfd
 				{
 					continue;
 				}
-				float hopCount++;
-				asf::FaceInfo *info = m_measurements.getFaceInfo(fibEntry, interest, hopFace.getId());
-				if (info == nullptr)
+
+				size_t i = topsis.addAlternative();
+				if (i == Topsis::MAX_ALTERNATIVES)
 				{
-					// set Facestate structure Rank if info is null
-					stats[i] = {&hopFace, hopCount, BW, asf::RttStats::RTT_NO_MEASUREMENT, RoutingMetric};
+					break;
 				}
-				else
+				faces[i] = &hopFace;
+
+				myRtt rtt = S_RTT_NO_MEASUREMENT;
+				asf::FaceInfo *info = m_measurements.getFaceInfo(fibEntry, interest, hopFace.getId());
+				if (info != nullptr && info->getLastRtt() != asf::FaceInfo::RTT_NO_MEASUREMENT)
 				{
-					// set Facestate structure for Rank
-					stats[i] = {&hopFace, hopCount, BW, info->getRtt(), RoutingMetric};
+					rtt = info->getSrtt();
 				}
-				i++;
-			}
 
-			// return best row of states array
-			int bestRow = result(stats, nexthops.size());
-			// set output face for send interest
-			Face *faceToUse = stats[bestRow].face;
+				topsis.setValue(i, CRITERION_BW, BW);
+				topsis.setValue(i, CRITERION_COST, hop.getCost() + RoutingMetric);
+				topsis.setValue(i, CRITERION_RTT, static_cast<float>(rtt.count()));
+			}
 
-			return faceToUse;
+			size_t best = topsis.rank();
+			if (best == Topsis::MAX_ALTERNATIVES)
+			{
+				return nullptr;
+			}
+			return faces[best];
 		}
 
 		/**
@@ -21,17 +21,6 @@ namespace nfd
 
 		typedef time::duration<double, boost::micro> myRtt;
 
-		/**
-		 * this is Structure of parameter to set for soltani input
-		 */
-		struct FaceStats
-		{
-			Face *face;
-			double hopCount;
-			int bw;
-			myRtt rtt;
-		};
-
 		class SoltaniStrategy : public Strategy
 		{
 		public:
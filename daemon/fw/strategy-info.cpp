@@ -0,0 +1,80 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/strategy-info.hpp"
+#include "common/pool-allocator.hpp"
+
+#include <array>
+
+namespace nfd {
+namespace fw {
+
+constexpr size_t StrategyInfo::MAX_POOLED_SIZE;
+
+namespace {
+
+constexpr size_t SIZE_CLASS_GRANULARITY = alignof(std::max_align_t);
+constexpr size_t N_SIZE_CLASSES = StrategyInfo::MAX_POOLED_SIZE / SIZE_CLASS_GRANULARITY;
+
+size_t
+getSizeClass(size_t size)
+{
+  BOOST_ASSERT(size > 0 && size <= StrategyInfo::MAX_POOLED_SIZE);
+  return (size - 1) / SIZE_CLASS_GRANULARITY;
+}
+
+FixedSizePool&
+getPool(size_t sizeClass)
+{
+  // The pools are never destroyed, because StrategyInfo items may be placed on
+  // table entries that are destroyed after this translation unit's static objects.
+  static auto pools = new std::array<FixedSizePool, N_SIZE_CLASSES>;
+  return (*pools)[sizeClass];
+}
+
+} // namespace
+
+void*
+StrategyInfo::operator new(size_t size)
+{
+  if (size > MAX_POOLED_SIZE) {
+    return ::operator new(size);
+  }
+  size_t sizeClass = getSizeClass(size);
+  return getPool(sizeClass).allocate((sizeClass + 1) * SIZE_CLASS_GRANULARITY);
+}
+
+void
+StrategyInfo::operator delete(void* p, size_t size) noexcept
+{
+  if (size > MAX_POOLED_SIZE) {
+    ::operator delete(p);
+    return;
+  }
+  getPool(getSizeClass(size)).deallocate(p);
+}
+
+} // namespace fw
+} // namespace nfd
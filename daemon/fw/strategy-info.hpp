@@ -32,9 +32,20 @@ namespace nfd {
 namespace fw {
 
 /** \brief Contains arbitrary information placed by the forwarding strategy on table entries
+ *
+ *  StrategyInfo items are allocated from pools of fixed-size blocks, one pool per size class,
+ *  so that creating an item for each forwarded packet does not go through the global heap.
+ *  \warning Allocation of StrategyInfo items is not thread-safe.
  */
 class StrategyInfo
 {
+public:
+  static void*
+  operator new(size_t size);
+
+  static void
+  operator delete(void* p, size_t size) noexcept;
+
 public:
 #ifdef DOXYGEN
   /** \return an integer that uniquely identifies this StrategyInfo type
@@ -49,6 +60,10 @@ public:
 
 protected:
   StrategyInfo() = default;
+
+public:
+  /// items larger than this are allocated from the global heap
+  static constexpr size_t MAX_POOLED_SIZE = 256;
 };
 
 } // namespace fw
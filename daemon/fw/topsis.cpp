@@ -1,225 +1,120 @@
-//
-// Created by reza011 on 7/1/2019.
-//
-#include <math.h>
-#include "topsis.hpp"
-#include <iostream>
-
-using namespace std;
-
-/**
- * \brief it is normalization of input array
- * @param parameters is base structure of inputs
- * @return normalization array[][]
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-float** Topsis::normalization (float** array, int rows, int col)
-{
-    float** norm = new float*[255];
-    for (int i = 0; i < rows; i++){
-
-        norm[i] = new float[255];
-        for (int j = 0; j < col; j++){
-
-            float normalNumber = 0;
-            double jazrSigma = 0;
-            for (int c = 0; c < rows; c++){
-
-                jazrSigma += array[c][j] * array[c][j];
-            }
-            normalNumber = (array[i][j] / (float)sqrt(jazrSigma));
-            norm[i][j] = normalNumber;
-        }
-    }
-    return norm;
-}
-
-/**
- * \brief this is matrix for weight
- * @param weightArr
- * @param col
- * @return weightMatrix[]
- */
-float** Topsis::weightMatrix(float weightArr[], int col){
-    float** m=new float*[255];
-
-    for (int i = 0; i < col; i++){
-
-        m[i] = new float[255];
-        for (int j = 0; j < col; j++){
-
-            if (i == j) m[i][j] = weightArr[j];
-            else m[i][j] = 0;
-        }
-    }
-
-    return m;
-}
-
-/**
- * \brief For multiplex wight in rows
- * @param norm
- * @param row1
- * @param col1
- * @param weightMatx
- * @param row2
- * @param col2
- * @return multiplex array
- */
-float** Topsis::multiplexToWeight(float** norm, int row1, int col1, float** weightMatx, int row2, int col2){
+#include "topsis.hpp"
 
-    float** c=new float*[256];
-    for (int i = 0; i < row1; i++){
+#include <algorithm>
+#include <cmath>
 
-        c[i] = new float[255];
-        for (int j = 0; j < col2; j++){
+namespace nfd {
+namespace fw {
 
-            c[i][j] = 0;
-            for (int k = 0; k <col1; k++){
+constexpr size_t Topsis::MAX_ALTERNATIVES;
+constexpr size_t Topsis::MAX_CRITERIA;
 
-                c[i][j] += norm[i][k] * weightMatx[k][j];
-            }
-        }
-    }
+void
+Topsis::setCriterion(size_t criterion, float weight, CriterionType type)
+{
+  BOOST_ASSERT(criterion < MAX_CRITERIA);
+  BOOST_ASSERT(weight >= 0.0f);
 
-    return c;
+  m_weights[criterion] = weight;
+  m_types[criterion] = type;
+  m_nCriteria = std::max(m_nCriteria, criterion + 1);
 }
 
-/**
- * \brief for positive ideal
- * @param multiWeightMatrix
- * @param row
- * @param col
- * @param type
- * @return
- */
-float* Topsis::idealPositive(float** multiWeightMatrix, int row, int col, char type[]){
-
-    float* ap=new float[256];
-    for (int j = 0; j < col; j++){
-
-        if (type[j] == '+'){
-            float max = multiWeightMatrix[0][j];
-            for (int i = 0; i < row; i++){
-
-                max = fmax(multiWeightMatrix[i][j], max);
-            }
-            ap[j] = max;
-        }
-        else{
-            float min = multiWeightMatrix[0][j];
-
-            for (int i = 0; i < row; i++){
-
-                min = fmin(multiWeightMatrix[i][j], min);
-            }
-            ap[j] = min;
-        }
-    }
-    return ap;
+size_t
+Topsis::addAlternative()
+{
+  if (m_nAlternatives >= MAX_ALTERNATIVES) {
+    return MAX_ALTERNATIVES;
+  }
+
+  size_t i = m_nAlternatives++;
+  for (size_t j = 0; j < m_nCriteria; ++j) {
+    m_values[j][i] = 0.0f;
+  }
+  return i;
 }
 
-/**
- * \brief for positive ideal
- * @param multiWeightMatrix
- * @param row
- * @param col
- * @param type
- * @return
- */
-float* Topsis::idealNegative(float**  multiWeightMatrix, int row, int col, char type[]){
-
-    float* am=new float[256];
-    for (int j = 0; j < col; j++){
-
-        if(type[j] == '-'){
-            float max = multiWeightMatrix[0][j];
-            for (int i = 0; i < row; i++){
-
-                max = fmax(multiWeightMatrix[i][j], max);
-            }
-            am[j] = max;
-        }
-        else{
-            float min = multiWeightMatrix[0][j];
-            for (int i = 0; i < row; i++){
-
-                min = fmin(multiWeightMatrix[i][j], min);
-            }
-            am[j] = min;
-        }
+size_t
+Topsis::rank()
+{
+  const size_t n = m_nAlternatives;
+  if (n == 0) {
+    return MAX_ALTERNATIVES;
+  }
+
+  std::fill_n(m_distPositive.begin(), n, 0.0f);
+  std::fill_n(m_distNegative.begin(), n, 0.0f);
+
+  for (size_t j = 0; j < m_nCriteria; ++j) {
+    const float* col = m_values[j].data();
+
+    // vector normalization factor and column extremes, in one pass
+    float sumSq = 0.0f;
+    float maxVal = col[0];
+    float minVal = col[0];
+    for (size_t i = 0; i < n; ++i) {
+      sumSq += col[i] * col[i];
+      maxVal = std::max(maxVal, col[i]);
+      minVal = std::min(minVal, col[i]);
     }
-    return am;
-}
-
-/**
- * \brief distance from positive ideal
- * @param multiWeightMatrix
- * @param row
- * @param col
- * @param idealPos
- * @return dip
- */
-float* Topsis::distanceFromPositive(float** multiWeightMatrix, int row, int col, float idealPos[]){
-
-    float* posDis=new float[256];
-    for (int i = 0; i < row; i++){
-
-        posDis[i] = 0;
-        double temp = 0;
-        for (int j = 0; j < col; j++){
-
-            temp = temp + (fabs(static_cast<double>((multiWeightMatrix[i][j] - idealPos[j])))* fabs(static_cast<double>((multiWeightMatrix[i][j] - idealPos[j]))));
-        }
-        posDis[i] = (float)sqrt(temp);
+    if (sumSq <= 0.0f) {
+      // all values are zero: this criterion cannot discriminate between alternatives
+      continue;
     }
-    return posDis;
-}
-
-/**
- * \brief distance from Negative ideal
- * @param multiWeightMatrix
- * @param row
- * @param col
- * @param idealNeg
- * @return
- */
-float* Topsis::distanceFromNegative(float** multiWeightMatrix, int row, int col, float idealNeg[256]){
 
-    float* negDis=new float[256];
-    for (int i = 0; i < row; i++){
-
-        negDis[i] = 0;
-        double temp = 0;
-        for (int j = 0; j < col; j++){
-
-            temp = temp + (fabs(static_cast<double>((multiWeightMatrix[i][j] - idealNeg[j])))* fabs(static_cast<double>((multiWeightMatrix[i][j] - idealNeg[j]))));
-        }
-        negDis[i] = (float)sqrt(temp);
+    // weighting by a diagonal matrix is a per-column scale
+    const float scale = m_weights[j] / std::sqrt(sumSq);
+    const bool isBenefit = m_types[j] == CriterionType::BENEFIT;
+    const float idealPos = scale * (isBenefit ? maxVal : minVal);
+    const float idealNeg = scale * (isBenefit ? minVal : maxVal);
+
+    float* dPos = m_distPositive.data();
+    float* dNeg = m_distNegative.data();
+    for (size_t i = 0; i < n; ++i) {
+      float v = col[i] * scale;
+      float dp = v - idealPos;
+      float dn = v - idealNeg;
+      dPos[i] += dp * dp;
+      dNeg[i] += dn * dn;
     }
-    return negDis;
-}
-
-/**
- * \brief final ranking of Negative distances and positive distances
- * @param disNeg
- * @param disPos
- * @param count
- * @return array of ranking values
- */
-float* Topsis::finalRank(float disNeg[], float disPos[], int count){
-
-    float* c=new float[256];
-
-    for (int i = 0; i < count; i++){
-
-    	if(disNeg[i]==0){
-    		c[i] = 0;
-    	}else{
-        c[i] = disNeg[i] / (disNeg[i] + disPos[i]);
-    	}
+  }
+
+  size_t best = 0;
+  for (size_t i = 0; i < n; ++i) {
+    float dp = std::sqrt(m_distPositive[i]);
+    float dn = std::sqrt(m_distNegative[i]);
+    m_closeness[i] = dn > 0.0f ? dn / (dn + dp) : 0.0f;
+    if (m_closeness[i] > m_closeness[best]) {
+      best = i;
     }
-    return c;
+  }
+  return best;
 }
 
-
+} // namespace fw
+} // namespace nfd
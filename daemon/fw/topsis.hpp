@@ -1,36 +1,130 @@
-//
-// Created by reza011 on 7/1/2019.
-//
-
-#ifndef TOPSIS_TOPSIS_H
-#define TOPSIS_TOPSIS_H
-
-
-/**
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
  *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
  */
-class Topsis {
-
-public:
-
-    static float **normalization(float** arr, int rows, int col);
 
-    static float **weightMatrix(float *weightArr, int col);
+#ifndef NFD_DAEMON_FW_TOPSIS_HPP
+#define NFD_DAEMON_FW_TOPSIS_HPP
 
-    static float **multiplexToWeight(float **norm, int row1, int col1, float **weightMatx, int row2, int col2);
+#include "core/common.hpp"
 
-    static float *idealPositive(float **multiWeightMatrix, int row, int col, char *type);
-
-    static float *idealNegative(float **multiWeightMatrix, int row, int col, char *type);
-
-    static float *distanceFromPositive(float **multiWeightMatrix, int row, int col, float *idealPos);
-
-    static float *distanceFromNegative(float **multiWeightMatrix, int row, int col, float *idealNeg);
-
-    static float *finalRank(float *disNeg, float *disPos, int count);
+#include <array>
 
+namespace nfd {
+namespace fw {
 
+/** \brief fixed-capacity TOPSIS multi-criteria ranking engine
+ *
+ *  TOPSIS (Technique for Order of Preference by Similarity to Ideal Solution) ranks
+ *  alternatives, e.g. the nexthops of a FIB entry, by their relative closeness to an ideal
+ *  alternative that has the best observed value of every criterion.
+ *
+ *  The decision matrix is stored in structure-of-arrays layout: the values of one criterion
+ *  for all alternatives are contiguous, so that normalization, weighting, ideal points, and
+ *  separation measures are computed with straight-line loops over each column.
+ *  All storage is inline; a Topsis object can be placed on the stack and reused across
+ *  packets without any heap allocation.
+ */
+class Topsis
+{
+public:
+  static constexpr size_t MAX_ALTERNATIVES = 32;
+  static constexpr size_t MAX_CRITERIA = 8;
+
+  enum class CriterionType {
+    BENEFIT, ///< larger value is better
+    COST,    ///< smaller value is better
+  };
+
+  /** \brief declares criterion \p criterion
+   *  \pre criterion < MAX_CRITERIA
+   *  \param weight relative importance of this criterion, must not be negative
+   */
+  void
+  setCriterion(size_t criterion, float weight, CriterionType type);
+
+  /** \brief removes all alternatives, but keeps criteria
+   */
+  void
+  clearAlternatives()
+  {
+    m_nAlternatives = 0;
+  }
+
+  /** \brief appends an alternative
+   *  \return index of the new alternative, or MAX_ALTERNATIVES if the engine is full
+   *  \note values of the new alternative are initialized to zero
+   */
+  size_t
+  addAlternative();
+
+  /** \brief sets the value of \p criterion for \p alternative
+   */
+  void
+  setValue(size_t alternative, size_t criterion, float value)
+  {
+    BOOST_ASSERT(alternative < m_nAlternatives && criterion < m_nCriteria);
+    m_values[criterion][alternative] = value;
+  }
+
+  size_t
+  getAlternativeCount() const
+  {
+    return m_nAlternatives;
+  }
+
+  /** \brief computes relative closeness of every alternative
+   *  \return index of the alternative with the highest closeness,
+   *          or MAX_ALTERNATIVES if there is no alternative
+   *  \note Ties are resolved in favor of the alternative with the smaller index.
+   */
+  size_t
+  rank();
+
+  /** \brief returns relative closeness of \p alternative computed by the last rank() call
+   *  \return a value in [0,1], where 1 means the alternative is the ideal solution
+   */
+  float
+  getCloseness(size_t alternative) const
+  {
+    BOOST_ASSERT(alternative < m_nAlternatives);
+    return m_closeness[alternative];
+  }
+
+private:
+  using Column = std::array<float, MAX_ALTERNATIVES>;
+
+  std::array<Column, MAX_CRITERIA> m_values{};
+  std::array<float, MAX_CRITERIA> m_weights{};
+  std::array<CriterionType, MAX_CRITERIA> m_types{};
+  Column m_distPositive{};
+  Column m_distNegative{};
+  Column m_closeness{};
+  size_t m_nCriteria = 0;
+  size_t m_nAlternatives = 0;
 };
 
+} // namespace fw
+} // namespace nfd
 
-#endif //TOPSIS_TOPSIS_H
+#endif // NFD_DAEMON_FW_TOPSIS_HPP
@@ -34,6 +34,8 @@
 
 #include <boost/range/adaptor/transformed.hpp>
 
+#include <algorithm>
+
 namespace nfd {
 
 NFD_LOG_INIT(FibManager);
@@ -58,49 +60,95 @@ FibManager::addNextHop(const Name& topPrefix, const Interest& interest,
                        const ndn::mgmt::CommandContinuation& done)
 {
   setFaceForSelfRegistration(interest, parameters);
-  const Name& prefix = parameters.getName();
-  FaceId faceId = parameters.getFaceId();
-  uint64_t cost = parameters.getCost();
 
+  switch (addNextHopToFib(parameters.getName(), parameters.getFaceId(), parameters.getCost())) {
+    case 414:
+      return done(ControlResponse(414, "FIB entry prefix cannot exceed " +
+                                  to_string(Fib::getMaxDepth()) + " components"));
+    case 410:
+      return done(ControlResponse(410, "Face not found"));
+    default:
+      return done(ControlResponse(200, "Success").setBody(parameters.wireEncode()));
+  }
+}
+
+void
+FibManager::removeNextHop(const Name& topPrefix, const Interest& interest,
+                          ControlParameters parameters,
+                          const ndn::mgmt::CommandContinuation& done)
+{
+  setFaceForSelfRegistration(interest, parameters);
+
+  done(ControlResponse(200, "Success").setBody(parameters.wireEncode()));
+
+  removeNextHopFromFib(parameters.getName(), parameters.getFaceId());
+}
+
+std::vector<uint32_t>
+FibManager::applyFibUpdates(const std::list<rib::FibUpdate>& updates)
+{
+  NFD_LOG_DEBUG("Applying " << updates.size() << " FIB updates");
+
+  std::vector<uint32_t> codes;
+  codes.reserve(updates.size());
+  for (const auto& update : updates) {
+    if (update.action == rib::FibUpdate::ADD_NEXTHOP) {
+      codes.push_back(addNextHopToFib(update.name, update.faceId, update.cost));
+    }
+    else {
+      removeNextHopFromFib(update.name, update.faceId);
+      codes.push_back(200);
+    }
+  }
+  return codes;
+}
+
+std::pair<std::vector<uint32_t>, std::vector<uint32_t>>
+FibManager::applyFibUpdates(const std::list<rib::FibUpdate>& batchFaceUpdates,
+                            const std::list<rib::FibUpdate>& otherUpdates)
+{
+  auto batchFaceCodes = applyFibUpdates(batchFaceUpdates);
+  bool isBatchFaceApplied = std::all_of(batchFaceCodes.begin(), batchFaceCodes.end(),
+                                        [] (uint32_t code) { return code == 200; });
+  if (!isBatchFaceApplied) {
+    return {std::move(batchFaceCodes), {}};
+  }
+  return {std::move(batchFaceCodes), applyFibUpdates(otherUpdates)};
+}
+
+uint32_t
+FibManager::addNextHopToFib(const Name& prefix, FaceId faceId, uint64_t cost)
+{
   if (prefix.size() > Fib::getMaxDepth()) {
     NFD_LOG_DEBUG("fib/add-nexthop(" << prefix << ',' << faceId << ',' << cost <<
                   "): FAIL prefix-too-long");
-    return done(ControlResponse(414, "FIB entry prefix cannot exceed " +
-                                to_string(Fib::getMaxDepth()) + " components"));
+    return 414;
   }
 
   Face* face = m_faceTable.get(faceId);
   if (face == nullptr) {
     NFD_LOG_DEBUG("fib/add-nexthop(" << prefix << ',' << faceId << ',' << cost <<
                   "): FAIL unknown-faceid");
-    return done(ControlResponse(410, "Face not found"));
+    return 410;
   }
 
   fib::Entry* entry = m_fib.insert(prefix).first;
   m_fib.addOrUpdateNextHop(*entry, *face, cost);
 
   NFD_LOG_TRACE("fib/add-nexthop(" << prefix << ',' << faceId << ',' << cost << "): OK");
-  return done(ControlResponse(200, "Success").setBody(parameters.wireEncode()));
+  return 200;
 }
 
 void
-FibManager::removeNextHop(const Name& topPrefix, const Interest& interest,
-                          ControlParameters parameters,
-                          const ndn::mgmt::CommandContinuation& done)
+FibManager::removeNextHopFromFib(const Name& prefix, FaceId faceId)
 {
-  setFaceForSelfRegistration(interest, parameters);
-  const Name& prefix = parameters.getName();
-  FaceId faceId = parameters.getFaceId();
-
-  done(ControlResponse(200, "Success").setBody(parameters.wireEncode()));
-
   Face* face = m_faceTable.get(faceId);
   if (face == nullptr) {
     NFD_LOG_TRACE("fib/remove-nexthop(" << prefix << ',' << faceId << "): OK no-face");
     return;
   }
 
-  fib::Entry* entry = m_fib.findExactMatch(parameters.getName());
+  fib::Entry* entry = m_fib.findExactMatch(prefix);
   if (entry == nullptr) {
     NFD_LOG_TRACE("fib/remove-nexthop(" << prefix << ',' << faceId << "): OK no-entry");
     return;
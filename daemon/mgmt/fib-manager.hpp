@@ -27,6 +27,7 @@
 #define NFD_DAEMON_MGMT_FIB_MANAGER_HPP
 
 #include "manager-base.hpp"
+#include "rib/fib-update.hpp"
 
 namespace nfd {
 
@@ -46,6 +47,25 @@ public:
   FibManager(fib::Fib& fib, const FaceTable& faceTable,
              Dispatcher& dispatcher, CommandAuthenticator& authenticator);
 
+  /** @brief Applies nexthop updates computed by the RIB directly to the FIB.
+   *
+   *  This is the in-process counterpart of one add-nexthop or remove-nexthop command per update.
+   *  @return ControlResponse status code of each update, in the order of @p updates
+   */
+  std::vector<uint32_t>
+  applyFibUpdates(const std::list<rib::FibUpdate>& updates);
+
+  /** @brief Applies all nexthop updates computed by the RIB for one RibUpdateBatch.
+   *
+   *  Both lists are applied within one call, so that forwarding never observes a partially
+   *  applied batch. As with the command-based path, @p otherUpdates are applied only if every
+   *  update in @p batchFaceUpdates succeeded; otherwise, the second vector is empty.
+   *  @return ControlResponse status codes of @p batchFaceUpdates and @p otherUpdates
+   */
+  std::pair<std::vector<uint32_t>, std::vector<uint32_t>>
+  applyFibUpdates(const std::list<rib::FibUpdate>& batchFaceUpdates,
+                  const std::list<rib::FibUpdate>& otherUpdates);
+
 private:
   void
   addNextHop(const Name& topPrefix, const Interest& interest,
@@ -65,6 +85,14 @@ private:
   void
   setFaceForSelfRegistration(const Interest& request, ControlParameters& parameters);
 
+  /** @return ControlResponse status code
+   */
+  uint32_t
+  addNextHopToFib(const Name& prefix, FaceId faceId, uint64_t cost);
+
+  void
+  removeNextHopFromFib(const Name& prefix, FaceId faceId);
+
 private:
   fib::Fib& m_fib;
   const FaceTable& m_faceTable;
@@ -54,6 +54,7 @@ TablesConfigSection::ensureConfigured()
   m_forwarder.getCs().setLimit(DEFAULT_CS_MAX_PACKETS);
   // Don't set default cs_policy because it's already created by CS itself.
   m_forwarder.setUnsolicitedDataPolicy(make_unique<fw::DefaultUnsolicitedDataPolicy>());
+  m_forwarder.getDeadNonceList().useFilter(nullopt);
 
   m_isConfigured = true;
 }
@@ -77,6 +78,12 @@ TablesConfigSection::processConfig(const ConfigSection& section, bool isDryRun,
     }
   }
 
+  bool hasCsExactIndex = false;
+  OptionalConfigSection csExactIndexNode = section.get_child_optional("cs_exact_index");
+  if (csExactIndexNode) {
+    hasCsExactIndex = ConfigFile::parseYesNo(*csExactIndexNode, "cs_exact_index", "tables");
+  }
+
   unique_ptr<fw::UnsolicitedDataPolicy> unsolicitedDataPolicy;
   OptionalConfigSection unsolicitedDataPolicyNode = section.get_child_optional("cs_unsolicited_policy");
   if (unsolicitedDataPolicyNode) {
@@ -90,6 +97,40 @@ TablesConfigSection::processConfig(const ConfigSection& section, bool isDryRun,
     unsolicitedDataPolicy = make_unique<fw::DefaultUnsolicitedDataPolicy>();
   }
 
+  bool useDnlFilter = false;
+  OptionalConfigSection dnlTypeNode = section.get_child_optional("dnl_type");
+  if (dnlTypeNode) {
+    std::string dnlType = dnlTypeNode->get_value<std::string>();
+    if (dnlType == "filter") {
+      useDnlFilter = true;
+    }
+    else if (dnlType != "exact") {
+      NDN_THROW(ConfigFile::Error("Unknown dnl_type '" + dnlType + "' in section 'tables'"));
+    }
+  }
+
+  DeadNonceFilter::Options dnlFilterOptions;
+  OptionalConfigSection dnlFilterMemoryNode = section.get_child_optional("dnl_filter_memory");
+  if (dnlFilterMemoryNode) {
+    dnlFilterOptions.memoryBudget = ConfigFile::parseNumber<size_t>(*dnlFilterMemoryNode,
+                                                                    "dnl_filter_memory", "tables");
+    ConfigFile::checkRange(dnlFilterOptions.memoryBudget, DeadNonceFilter::MIN_MEMORY_BUDGET,
+                           DeadNonceFilter::MAX_MEMORY_BUDGET, "dnl_filter_memory", "tables");
+  }
+
+  OptionalConfigSection dnlFilterFpRateNode = section.get_child_optional("dnl_filter_fp_rate");
+  if (dnlFilterFpRateNode) {
+    dnlFilterOptions.falsePositiveRate = ConfigFile::parseNumber<double>(*dnlFilterFpRateNode,
+                                                                         "dnl_filter_fp_rate",
+                                                                         "tables");
+    if (!(dnlFilterOptions.falsePositiveRate > 0.0 && dnlFilterOptions.falsePositiveRate < 1.0)) {
+      NDN_THROW(ConfigFile::Error("Invalid value '" +
+                                  dnlFilterFpRateNode->get_value<std::string>() +
+                                  "' for option 'dnl_filter_fp_rate' in section 'tables': "
+                                  "must be between 0 and 1 exclusive"));
+    }
+  }
+
   OptionalConfigSection strategyChoiceSection = section.get_child_optional("strategy_choice");
   if (strategyChoiceSection) {
     processStrategyChoiceSection(*strategyChoiceSection, isDryRun);
@@ -109,9 +150,17 @@ TablesConfigSection::processConfig(const ConfigSection& section, bool isDryRun,
   if (cs.size() == 0 && csPolicy != nullptr) {
     cs.setPolicy(std::move(csPolicy));
   }
+  cs.enableExactIndex(hasCsExactIndex);
 
   m_forwarder.setUnsolicitedDataPolicy(std::move(unsolicitedDataPolicy));
 
+  if (useDnlFilter) {
+    m_forwarder.getDeadNonceList().useFilter(dnlFilterOptions);
+  }
+  else {
+    m_forwarder.getDeadNonceList().useFilter(nullopt);
+  }
+
   m_isConfigured = true;
 }
 
@@ -39,7 +39,11 @@ namespace nfd {
  *  {
  *    cs_max_packets 65536
  *    cs_policy lru
+ *    cs_exact_index no
  *    cs_unsolicited_policy drop-all
+ *    dnl_type exact
+ *    dnl_filter_memory 4194304
+ *    dnl_filter_fp_rate 0.0001
  *
  *    strategy_choice
  *    {
@@ -58,8 +62,9 @@ namespace nfd {
  *  \endcode
  *
  *  During a configuration reload,
- *  \li cs_max_packets, cs_policy, and cs_unsolicited_policy are applied;
- *      defaults are used if an option is omitted.
+ *  \li cs_max_packets, cs_policy, cs_exact_index, cs_unsolicited_policy, and the dnl_* options
+ *      are applied; defaults are used if an option is omitted. Changing the Dead Nonce List
+ *      storage discards its entries.
  *  \li strategy_choice entries are inserted, but old entries are not deleted.
  *  \li network_region is applied; it's kept unchanged if the section is omitted.
  *
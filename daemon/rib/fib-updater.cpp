@@ -58,6 +58,7 @@ FibUpdater::computeAndSendFibUpdates(const RibUpdateBatch& batch,
   // Erase previously calculated FIB updates
   m_updatesForBatchFaceId.clear();
   m_updatesForNonBatchFaceId.clear();
+  m_updateIndex.clear();
 
   computeUpdates(batch);
 
@@ -83,6 +84,9 @@ FibUpdater::computeUpdates(const RibUpdateBatch& batch)
 
         // Do not apply updates with the same face ID as the destroyed face
         // since they will be rejected by the FIB
+        for (const FibUpdate& fibUpdate : m_updatesForBatchFaceId) {
+          m_updateIndex.erase({fibUpdate.name, fibUpdate.faceId});
+        }
         m_updatesForBatchFaceId.clear();
         break;
     }
@@ -124,19 +128,8 @@ FibUpdater::computeUpdatesForRegistration(const RibUpdate& update)
   }
   else {
     // New name in RIB
-    // Find prefix's parent
-    shared_ptr<RibEntry> parent = m_rib.findParent(prefix);
-
-    Rib::RibEntryList descendants = m_rib.findDescendantsForNonInsertedName(prefix);
-    Rib::RibEntryList children;
-
-    for (const auto& descendant : descendants) {
-      // If the child has the same parent as the new entry,
-      // the new entry must be the child's new parent
-      if (descendant->getParent() == parent) {
-        children.push_back(descendant);
-      }
-    }
+    // The topmost entries under prefix will become the new entry's children
+    Rib::RibEntryList children = m_rib.findChildren(prefix);
 
     createFibUpdatesForNewRibEntry(prefix, route, children);
   }
@@ -202,11 +195,64 @@ FibUpdater::sendUpdates(const FibUpdateList& updates,
   }
 }
 
+void
+FibUpdater::sendBulkUpdates(const FibUpdateSuccessCallback& onSuccess,
+                            const FibUpdateFailureCallback& onFailure)
+{
+  NFD_LOG_DEBUG("Applying " << m_updatesForBatchFaceId.size() + m_updatesForNonBatchFaceId.size()
+                << " FIB updates in bulk");
+
+  m_bulkFibUpdate(m_updatesForBatchFaceId, m_updatesForNonBatchFaceId,
+                  [=] (const std::vector<uint32_t>& batchFaceCodes,
+                       const std::vector<uint32_t>& otherCodes) {
+    BOOST_ASSERT(batchFaceCodes.size() == m_updatesForBatchFaceId.size());
+    auto code = batchFaceCodes.begin();
+    for (const FibUpdate& update : m_updatesForBatchFaceId) {
+      if (*code == ERROR_FACE_NOT_FOUND) {
+        NFD_LOG_DEBUG("Failed to apply " << update << " (code: " << *code << ")");
+        return onFailure(*code, "Face not found");
+      }
+      else if (*code != 200) {
+        NDN_THROW(Error("Non-recoverable error applying FIB update for " + update.name.toUri() +
+                        " code: " + to_string(*code)));
+      }
+      ++code;
+    }
+
+    BOOST_ASSERT(otherCodes.size() == m_updatesForNonBatchFaceId.size());
+    code = otherCodes.begin();
+    for (const FibUpdate& update : m_updatesForNonBatchFaceId) {
+      if (*code == ERROR_FACE_NOT_FOUND) {
+        // the FIB entry for this face was removed when the face was destroyed
+        NFD_LOG_DEBUG("Failed to apply " << update << " (code: " << *code << ")");
+      }
+      else if (*code != 200) {
+        NDN_THROW(Error("Non-recoverable error applying FIB update for " + update.name.toUri() +
+                        " code: " + to_string(*code)));
+      }
+      ++code;
+    }
+
+    m_updatesForBatchFaceId.clear();
+    m_updatesForNonBatchFaceId.clear();
+    m_updateIndex.clear();
+    onSuccess(m_inheritedRoutes);
+  });
+}
+
 void
 FibUpdater::sendUpdatesForBatchFaceId(const FibUpdateSuccessCallback& onSuccess,
                                       const FibUpdateFailureCallback& onFailure)
 {
-  if (m_updatesForBatchFaceId.size() > 0) {
+  if (m_bulkFibUpdate) {
+    if (m_updatesForBatchFaceId.empty() && m_updatesForNonBatchFaceId.empty()) {
+      onSuccess(m_inheritedRoutes);
+    }
+    else {
+      sendBulkUpdates(onSuccess, onFailure);
+    }
+  }
+  else if (m_updatesForBatchFaceId.size() > 0) {
     sendUpdates(m_updatesForBatchFaceId, onSuccess, onFailure);
   }
   else {
@@ -313,18 +359,15 @@ FibUpdater::addFibUpdate(const FibUpdate& update)
                                                               m_updatesForNonBatchFaceId;
 
   // If an update with the same name and route already exists, replace it
-  auto it = std::find_if(updates.begin(), updates.end(),
-    [&update] (const FibUpdate& other) {
-      return update.name == other.name && update.faceId == other.faceId;
-    });
-
-  if (it != updates.end()) {
-    FibUpdate& existingUpdate = *it;
+  auto it = m_updateIndex.find({update.name, update.faceId});
+  if (it != m_updateIndex.end()) {
+    FibUpdate& existingUpdate = *it->second;
     existingUpdate.action = update.action;
     existingUpdate.cost = update.cost;
   }
   else {
     updates.push_back(update);
+    m_updateIndex.emplace(std::make_pair(update.name, update.faceId), std::prev(updates.end()));
   }
 }
 
@@ -634,56 +677,82 @@ FibUpdater::modifyChildrensInheritedRoutes(const Rib::RibEntryList& children,
                                            const Rib::RouteSet& routesToAdd,
                                            const Rib::RouteSet& routesToRemove)
 {
+  // Nothing to propagate, the subtree is left untouched
+  if (routesToAdd.empty() && routesToRemove.empty()) {
+    return;
+  }
+
   for (const auto& child : children) {
     traverseSubTree(*child, routesToAdd, routesToRemove);
   }
 }
 
+/** \brief returns the routes of \p routes that propagate past \p entry
+ *
+ *  A route stops propagating at an entry that has a route with the same face ID and
+ *  child inheritance set. The set is copied only if at least one route stops here,
+ *  otherwise \p routes itself is returned.
+ */
+static const Rib::RouteSet&
+filterShadowedRoutes(const RibEntry& entry, const Rib::RouteSet& routes,
+                     optional<Rib::RouteSet>& filtered)
+{
+  auto isShadowed = [&entry] (const Route& route) {
+    return entry.hasChildInheritOnFaceId(route.faceId);
+  };
+
+  if (std::none_of(routes.begin(), routes.end(), isShadowed)) {
+    return routes;
+  }
+
+  // Erase by iterator, the set may have been default constructed without a comparator
+  filtered.emplace(routes);
+  for (auto it = filtered->begin(); it != filtered->end(); ) {
+    if (isShadowed(*it)) {
+      it = filtered->erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+
+  return *filtered;
+}
+
 void
-FibUpdater::traverseSubTree(const RibEntry& entry, Rib::Rib::RouteSet routesToAdd,
-                            Rib::Rib::RouteSet routesToRemove)
+FibUpdater::traverseSubTree(const RibEntry& entry, const Rib::RouteSet& routesToAdd,
+                            const Rib::RouteSet& routesToRemove)
 {
   // If a route on the namespace has the capture flag set, ignore self and children
   if (entry.hasCapture()) {
     return;
   }
 
-  // Remove inherited routes from current namespace
-  for (auto removeIt = routesToRemove.begin(); removeIt != routesToRemove.end(); ) {
-    // If a route on the namespace has the same face ID and child inheritance set,
-    // ignore this route
-    if (entry.hasChildInheritOnFaceId(removeIt->faceId)) {
-      removeIt = routesToRemove.erase(removeIt);
-      continue;
-    }
+  optional<Rib::RouteSet> filteredToRemove;
+  const Rib::RouteSet& toRemove = filterShadowedRoutes(entry, routesToRemove, filteredToRemove);
 
+  // Remove inherited routes from current namespace
+  for (const Route& route : toRemove) {
     // Only remove route if it removes an existing inherited route
-    if (entry.hasInheritedRoute(*removeIt)) {
-      removeInheritedRoute(entry.getName(), *removeIt);
-      addFibUpdate(FibUpdate::createRemoveUpdate(entry.getName(), removeIt->faceId));
+    if (entry.hasInheritedRoute(route)) {
+      removeInheritedRoute(entry.getName(), route);
+      addFibUpdate(FibUpdate::createRemoveUpdate(entry.getName(), route.faceId));
     }
-
-    ++removeIt;
   }
 
-  // Add inherited routes to current namespace
-  for (auto addIt = routesToAdd.begin(); addIt != routesToAdd.end(); ) {
-    // If a route on the namespace has the same face ID and child inherit set, ignore this face
-    if (entry.hasChildInheritOnFaceId(addIt->faceId)) {
-      addIt = routesToAdd.erase(addIt);
-      continue;
-    }
+  optional<Rib::RouteSet> filteredToAdd;
+  const Rib::RouteSet& toAdd = filterShadowedRoutes(entry, routesToAdd, filteredToAdd);
 
+  // Add inherited routes to current namespace
+  for (const Route& route : toAdd) {
     // Only add route if it does not override an existing route
-    if (!entry.hasFaceId(addIt->faceId)) {
-      addInheritedRoute(entry.getName(), *addIt);
-      addFibUpdate(FibUpdate::createAddUpdate(entry.getName(), addIt->faceId, addIt->cost));
+    if (!entry.hasFaceId(route.faceId)) {
+      addInheritedRoute(entry.getName(), route);
+      addFibUpdate(FibUpdate::createAddUpdate(entry.getName(), route.faceId, route.cost));
     }
-
-    ++addIt;
   }
 
-  modifyChildrensInheritedRoutes(entry.getChildren(), routesToAdd, routesToRemove);
+  modifyChildrensInheritedRoutes(entry.getChildren(), toAdd, toRemove);
 }
 
 void
@@ -52,6 +52,25 @@ public:
   using FibUpdateSuccessCallback = std::function<void(RibUpdateList inheritedRoutes)>;
   using FibUpdateFailureCallback = std::function<void(uint32_t code, const std::string& error)>;
 
+  /** \brief receives the ControlResponse status code of each update passed to a BulkFibUpdateFunc,
+   *         in the same order
+   *
+   *  \p otherCodes is empty if the updates for the batch face ID were not all applied.
+   */
+  using BulkFibUpdateCallback = std::function<void(const std::vector<uint32_t>& batchFaceCodes,
+                                                   const std::vector<uint32_t>& otherCodes)>;
+
+  /** \brief applies the FibUpdates for the batch face ID and then the other FibUpdates to NFD's
+   *         FIB in one step, and invokes the callback on the RIB thread when done
+   *
+   *  The other FibUpdates must not be applied unless every FibUpdate for the batch face ID
+   *  succeeded.
+   *  \sa FibManager::applyFibUpdates
+   */
+  using BulkFibUpdateFunc = std::function<void(const FibUpdateList& batchFaceUpdates,
+                                               const FibUpdateList& otherUpdates,
+                                               const BulkFibUpdateCallback& done)>;
+
   FibUpdater(Rib& rib, ndn::nfd::Controller& controller);
 
   NFD_VIRTUAL_WITH_TESTS
@@ -68,6 +87,17 @@ public:
                            const FibUpdateSuccessCallback& onSuccess,
                            const FibUpdateFailureCallback& onFailure);
 
+  /** \brief sends the FibUpdates computed for each RibUpdateBatch through \p f in one step,
+   *         instead of one FibAddNextHopCommand or FibRemoveNextHopCommand per update
+   *
+   *  An empty function restores the command-based path.
+   */
+  void
+  setBulkFibUpdateFunc(BulkFibUpdateFunc f)
+  {
+    m_bulkFibUpdate = std::move(f);
+  }
+
 private:
   /** \brief determines the type of action that will be performed on the RIB and calls the
   *          corresponding computation method
@@ -88,6 +118,16 @@ private:
               const FibUpdateSuccessCallback& onSuccess,
               const FibUpdateFailureCallback& onFailure);
 
+  /** \brief sends the updates in m_updatesForBatchFaceId and m_updatesForNonBatchFaceId
+   *         to NFD in one call to m_bulkFibUpdate
+   *
+   *   Per-update results are handled as in onUpdateSuccess and onUpdateError, except that
+   *   the updates are removed from their lists only after both lists have been applied.
+   */
+  void
+  sendBulkUpdates(const FibUpdateSuccessCallback& onSuccess,
+                  const FibUpdateFailureCallback& onFailure);
+
   /** \brief sends the updates in m_updatesForBatchFaceId to NFD if any exist,
   *          otherwise calls FibUpdater::sendUpdatesForNonBatchFaceId.
   */
@@ -238,9 +278,13 @@ private:
                                  const Rib::RouteSet& routesToRemove);
 
   /** \brief traverses the entry's children adding and removing the passed routes
+   *
+   *  The route sets are shared by all levels of the traversal and copied only at entries
+   *  that stop some of the routes from propagating further.
   */
   void
-  traverseSubTree(const RibEntry& entry, Rib::RouteSet routesToAdd, Rib::RouteSet routesToRemove);
+  traverseSubTree(const RibEntry& entry, const Rib::RouteSet& routesToAdd,
+                  const Rib::RouteSet& routesToRemove);
 
   /** \brief creates a record of a calculated inherited route that should be added to the entry
   */
@@ -257,7 +301,12 @@ private:
   ndn::nfd::Controller& m_controller;
   uint64_t m_batchFaceId;
 
+  /** \brief index of pending updates by name and Face ID, used by addFibUpdate
+   */
+  std::map<std::pair<Name, uint64_t>, FibUpdateList::iterator> m_updateIndex;
+
 NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  BulkFibUpdateFunc m_bulkFibUpdate;
   FibUpdateList m_updatesForBatchFaceId;
   FibUpdateList m_updatesForNonBatchFaceId;
 
@@ -139,17 +139,15 @@ Rib::insert(const Name& prefix, const Route& route)
       parent->addChild(entry);
     }
 
-    RibEntryList children = findDescendants(prefix);
+    for (const auto& child : findChildren(prefix)) {
+      BOOST_ASSERT(child->getParent() == parent);
 
-    for (const auto& child : children) {
-      if (child->getParent() == parent) {
-        // Remove child from parent and inherit parent's child
-        if (parent != nullptr) {
-          parent->removeChild(child);
-        }
-
-        entry->addChild(child);
+      // Remove child from parent and inherit parent's child
+      if (parent != nullptr) {
+        parent->removeChild(child);
       }
+
+      entry->addChild(child);
     }
 
     // Register with face lookup table
@@ -225,35 +223,16 @@ Rib::findParent(const Name& prefix) const
 }
 
 std::list<shared_ptr<RibEntry>>
-Rib::findDescendants(const Name& prefix) const
+Rib::findChildren(const Name& prefix) const
 {
   std::list<shared_ptr<RibEntry>> children;
 
-  RibTable::const_iterator it = m_rib.find(prefix);
-  if (it != m_rib.end()) {
-    ++it;
-    for (; it != m_rib.end(); ++it) {
-      if (prefix.isPrefixOf(it->first)) {
-        children.push_back((it->second));
-      }
-      else {
-        break;
-      }
-    }
-  }
+  auto it = m_rib.upper_bound(prefix);
+  while (it != m_rib.end() && prefix.isPrefixOf(it->first)) {
+    children.push_back(it->second);
 
-  return children;
-}
-
-std::list<shared_ptr<RibEntry>>
-Rib::findDescendantsForNonInsertedName(const Name& prefix) const
-{
-  std::list<shared_ptr<RibEntry>> children;
-
-  for (const auto& pair : m_rib) {
-    if (prefix.isPrefixOf(pair.first)) {
-      children.push_back(pair.second);
-    }
+    // Skip the namespace under this entry, it belongs to the entry's own children
+    it = m_rib.lower_bound(it->first.getSuccessor());
   }
 
   return children;
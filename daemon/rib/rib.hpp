@@ -168,17 +168,14 @@ private:
   using RouteComparePredicate = bool (*)(const Route&, const Route&);
   using RouteSet = std::set<Route, RouteComparePredicate>;
 
-  /** \brief find entries under \p prefix
-   *  \pre a RIB entry exists at \p prefix
-   */
-  std::list<shared_ptr<RibEntry>>
-  findDescendants(const Name& prefix) const;
-
-  /** \brief find entries under \p prefix
-   *  \pre a RIB entry does not exist at \p prefix
+  /** \brief find the topmost entries under \p prefix
+   *
+   *  These are the children of the entry at \p prefix, or the entries that would become its
+   *  children if it does not exist yet. The namespace under each of them is skipped, so the
+   *  cost does not depend on the size of the subtree.
    */
   std::list<shared_ptr<RibEntry>>
-  findDescendantsForNonInsertedName(const Name& prefix) const;
+  findChildren(const Name& prefix) const;
 
   RibTable::iterator
   eraseEntry(RibTable::iterator it);
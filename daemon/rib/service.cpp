@@ -33,6 +33,7 @@
 
 #include "common/global.hpp"
 #include "common/logger.hpp"
+#include "mgmt/fib-manager.hpp"
 
 #include "ns3/node-list.h"
 #include "ns3/node.h"
@@ -51,6 +52,7 @@ const std::string CFG_LOCALHOP_SECURITY = "localhop_security";
 const std::string CFG_PA_VALIDATION = "prefix_announcement_validation";
 const std::string CFG_PREFIX_PROPAGATE = "auto_prefix_propagate";
 const std::string CFG_READVERTISE_NLSR = "readvertise_nlsr";
+const std::string CFG_BULK_FIB_UPDATES = "bulk_fib_updates";
 const Name READVERTISE_NLSR_PREFIX = "/localhost/nlsr";
 const uint64_t PROPAGATE_DEFAULT_COST = 15;
 const time::milliseconds PROPAGATE_DEFAULT_TIMEOUT = 10_s;
@@ -96,6 +98,27 @@ Service::get()
   return l3->getRibService();
 }
 
+void
+Service::enableBulkFibUpdates(FibManager& fibManager)
+{
+  setBulkFibUpdateFunc([&fibManager] () -> FibManager& { return fibManager; });
+}
+
+void
+Service::setBulkFibUpdateFunc(std::function<FibManager&()> getFibManager)
+{
+  m_fibUpdater.setBulkFibUpdateFunc([getFibManager] (const auto& batchFaceUpdates,
+                                                     const auto& otherUpdates,
+                                                     const auto& done) {
+    // both lists are applied in one main thread call, so that forwarding never observes
+    // a partially applied RibUpdateBatch
+    runOnMainIoService([getFibManager, batchFaceUpdates, otherUpdates, done] {
+      auto codes = getFibManager().applyFibUpdates(batchFaceUpdates, otherUpdates);
+      runOnRibIoService([done, codes = std::move(codes)] { done(codes.first, codes.second); });
+    });
+  });
+}
+
 void
 Service::processConfig(const ConfigSection& section, bool isDryRun, const std::string& filename)
 {
@@ -132,6 +155,9 @@ Service::checkConfig(const ConfigSection& section, const std::string& filename)
     else if (key == CFG_READVERTISE_NLSR) {
       ConfigFile::parseYesNo(item, CFG_RIB + "." + CFG_READVERTISE_NLSR);
     }
+    else if (key == CFG_BULK_FIB_UPDATES) {
+      ConfigFile::parseYesNo(item, CFG_RIB + "." + CFG_BULK_FIB_UPDATES);
+    }
     else {
       NDN_THROW(ConfigFile::Error("Unrecognized option " + CFG_RIB + "." + key));
     }
@@ -148,6 +174,7 @@ Service::applyConfig(const ConfigSection& section, const std::string& filename)
 {
   bool wantPrefixPropagate = false;
   bool wantReadvertiseNlsr = false;
+  bool wantBulkFibUpdates = false;
 
   for (const auto& item : section) {
     const std::string& key = item.first;
@@ -186,6 +213,9 @@ Service::applyConfig(const ConfigSection& section, const std::string& filename)
     else if (key == CFG_READVERTISE_NLSR) {
       wantReadvertiseNlsr = ConfigFile::parseYesNo(item, CFG_RIB + "." + CFG_READVERTISE_NLSR);
     }
+    else if (key == CFG_BULK_FIB_UPDATES) {
+      wantBulkFibUpdates = ConfigFile::parseYesNo(item, CFG_RIB + "." + CFG_BULK_FIB_UPDATES);
+    }
     else {
       NDN_THROW(ConfigFile::Error("Unrecognized option " + CFG_RIB + "." + key));
     }
@@ -208,6 +238,23 @@ Service::applyConfig(const ConfigSection& section, const std::string& filename)
     NFD_LOG_DEBUG("Disabling readvertise-to-nlsr");
     m_readvertiseNlsr.reset();
   }
+
+  if (wantBulkFibUpdates && !m_hasConfigBulkFibUpdates) {
+    NFD_LOG_DEBUG("Enabling bulk FIB updates");
+    // The node's FibManager is looked up when the updates are applied, because the Service
+    // is constructed before the simulation runs in the context of that node.
+    setBulkFibUpdateFunc([] () -> FibManager& {
+      auto node = ::ns3::NodeList::GetNode(::ns3::Simulator::GetContext());
+      return node->GetObject<::ns3::ndn::L3Protocol>()->getFibManager();
+    });
+    m_hasConfigBulkFibUpdates = true;
+  }
+  else if (!wantBulkFibUpdates && m_hasConfigBulkFibUpdates) {
+    NFD_LOG_DEBUG("Disabling bulk FIB updates");
+    // FIB updates are sent as one command Interest per route again
+    m_fibUpdater.setBulkFibUpdateFunc(nullptr);
+    m_hasConfigBulkFibUpdates = false;
+  }
 }
 
 } // namespace rib
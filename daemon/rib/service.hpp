@@ -39,6 +39,9 @@
 #include <ndn-cxx/util/scheduler.hpp>
 
 namespace nfd {
+
+class FibManager;
+
 namespace rib {
 
 class Readvertise;
@@ -73,6 +76,16 @@ public:
     return m_ribManager;
   }
 
+  /**
+   * \brief Apply FIB updates through \p fibManager on the main thread, one call per
+   *        RibUpdateBatch, instead of sending one signed command Interest per update.
+   *
+   * \p fibManager must outlive this Service. The `rib.bulk_fib_updates` option enables this
+   * for the FibManager of the node that runs this Service.
+   */
+  void
+  enableBulkFibUpdates(FibManager& fibManager);
+
 private:
   template<typename ConfigParseFunc>
   Service(ndn::KeyChain& keyChain, ndn::Face& face,
@@ -84,9 +97,18 @@ private:
   void
   checkConfig(const ConfigSection& section, const std::string& filename);
 
+NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   applyConfig(const ConfigSection& section, const std::string& filename);
 
+private:
+  /**
+   * \brief Apply FIB updates on the main thread through the FibManager returned by
+   *        \p getFibManager, which is invoked on the main thread.
+   */
+  void
+  setBulkFibUpdateFunc(std::function<FibManager&()> getFibManager);
+
 private:
   ndn::KeyChain& m_keyChain;
   ndn::Face& m_face;
@@ -94,9 +116,13 @@ private:
   ndn::nfd::Controller m_nfdController;
 
   Rib m_rib;
+NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   FibUpdater m_fibUpdater;
+private:
   unique_ptr<Readvertise> m_readvertiseNlsr;
   unique_ptr<Readvertise> m_readvertisePropagation;
+  /// whether bulk FIB updates were enabled by the `rib.bulk_fib_updates` option
+  bool m_hasConfigBulkFibUpdates = false;
   ndn::mgmt::Dispatcher m_dispatcher;
   RibManager m_ribManager;
 };
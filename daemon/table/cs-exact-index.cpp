@@ -0,0 +1,154 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-exact-index.hpp"
+
+namespace nfd {
+namespace cs {
+
+constexpr size_t ExactIndex::MIN_CAPACITY;
+
+ExactIndex::ExactIndex(const Table& table)
+  : m_table(table)
+{
+  clear();
+}
+
+void
+ExactIndex::insert(Table::const_iterator entry)
+{
+  if ((m_size + 1) * 2 > m_slots.size()) {
+    resize(m_slots.size() * 2);
+  }
+  insertImpl(name_tree::getHashes(entry->getData()).back(), entry);
+  ++m_size;
+}
+
+void
+ExactIndex::insertImpl(name_tree::HashValue hash, Table::const_iterator entry)
+{
+  size_t mask = m_slots.size() - 1;
+  size_t i = getBucket(hash);
+  while (!isEmpty(m_slots[i])) {
+    i = (i + 1) & mask;
+  }
+  m_slots[i] = {hash, entry};
+}
+
+void
+ExactIndex::erase(Table::const_iterator entry)
+{
+  size_t mask = m_slots.size() - 1;
+  size_t hole = getBucket(name_tree::getHashes(entry->getData()).back());
+  while (!isEmpty(m_slots[hole]) && m_slots[hole].entry != entry) {
+    hole = (hole + 1) & mask;
+  }
+  if (isEmpty(m_slots[hole])) {
+    return;
+  }
+
+  // backward-shift deletion: move subsequent slots of the probe sequence into the hole,
+  // unless their home bucket lies cyclically in (hole, j]
+  for (size_t j = (hole + 1) & mask; !isEmpty(m_slots[j]); j = (j + 1) & mask) {
+    size_t home = getBucket(m_slots[j].hash);
+    bool canStay = hole < j ? (hole < home && home <= j) : (hole < home || home <= j);
+    if (!canStay) {
+      m_slots[hole] = m_slots[j];
+      hole = j;
+    }
+  }
+  m_slots[hole].entry = m_table.end();
+  --m_size;
+}
+
+void
+ExactIndex::clear()
+{
+  m_slots.assign(MIN_CAPACITY, {0, m_table.end()});
+  m_size = 0;
+}
+
+void
+ExactIndex::rebuild()
+{
+  size_t capacity = MIN_CAPACITY;
+  while (capacity < m_table.size() * 2) {
+    capacity *= 2;
+  }
+
+  m_slots.assign(capacity, {0, m_table.end()});
+  for (auto it = m_table.begin(); it != m_table.end(); ++it) {
+    insertImpl(name_tree::getHashes(it->getData()).back(), it);
+  }
+  m_size = m_table.size();
+}
+
+void
+ExactIndex::resize(size_t newCapacity)
+{
+  BOOST_ASSERT(newCapacity >= m_size * 2);
+  std::vector<Slot> oldSlots(newCapacity, {0, m_table.end()});
+  m_slots.swap(oldSlots);
+  for (const Slot& slot : oldSlots) {
+    if (!isEmpty(slot)) {
+      insertImpl(slot.hash, slot.entry);
+    }
+  }
+}
+
+Table::const_iterator
+ExactIndex::find(const Interest& interest) const
+{
+  BOOST_ASSERT(!interest.getCanBePrefix());
+  if (m_size == 0) {
+    return m_table.end();
+  }
+
+  // a full name query is keyed on the Data name, i.e. without the implicit digest
+  const Name& name = interest.getName();
+  bool isFullName = !name.empty() && name[-1].isImplicitSha256Digest();
+  size_t nameLen = isFullName ? name.size() - 1 : name.size();
+  name_tree::HashValue hash = name_tree::getHashes(interest)[nameLen];
+
+  // several entries can share a Data name, so that all of them have to be examined
+  auto match = m_table.end();
+  size_t mask = m_slots.size() - 1;
+  for (size_t i = getBucket(hash); !isEmpty(m_slots[i]); i = (i + 1) & mask) {
+    const Slot& slot = m_slots[i];
+    if (slot.hash != hash ||
+        slot.entry->getName().size() != nameLen ||
+        name.compare(0, nameLen, slot.entry->getName()) != 0 ||
+        !slot.entry->canSatisfy(interest)) {
+      continue;
+    }
+    if (match == m_table.end() || *slot.entry < *match) {
+      match = slot.entry;
+    }
+  }
+  return match;
+}
+
+} // namespace cs
+} // namespace nfd
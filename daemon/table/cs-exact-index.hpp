@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_EXACT_INDEX_HPP
+#define NFD_DAEMON_TABLE_CS_EXACT_INDEX_HPP
+
+#include "cs-entry.hpp"
+#include "name-tree-hashtable.hpp"
+
+namespace nfd {
+namespace cs {
+
+/** \brief a hash index of ContentStore entries by Data name
+ *
+ *  This index serves lookups of Interests with CanBePrefix=false, whose name is either the
+ *  exact Data name or the Data full name (including implicit digest). Both are keyed on the
+ *  hash of the Data name without digest, so that a lookup costs O(1) hash probes instead of
+ *  O(log n) Name comparisons in the Table. Prefix lookups must still use the Table.
+ *
+ *  The index is an open-addressing hashtable with linear probing and backward-shift deletion.
+ *  Its capacity is a power of two, and it grows when the load factor exceeds 1/2.
+ */
+class ExactIndex : noncopyable
+{
+public:
+  explicit
+  ExactIndex(const Table& table);
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  size_t
+  getCapacity() const
+  {
+    return m_slots.size();
+  }
+
+  /** \brief adds \p entry to the index
+   *  \pre \p entry is not in the index
+   */
+  void
+  insert(Table::const_iterator entry);
+
+  /** \brief removes \p entry from the index, if it exists
+   */
+  void
+  erase(Table::const_iterator entry);
+
+  /** \brief removes all entries from the index
+   */
+  void
+  clear();
+
+  /** \brief indexes all entries of the Table
+   */
+  void
+  rebuild();
+
+  /** \brief finds the best matching Data packet of \p interest
+   *  \pre interest.getCanBePrefix() == false
+   *  \return the first matching entry in Table order, or Table::end() if there is none;
+   *          this is the same entry that a lookup in the Table would find
+   */
+  Table::const_iterator
+  find(const Interest& interest) const;
+
+private:
+  struct Slot
+  {
+    name_tree::HashValue hash;
+    Table::const_iterator entry;
+  };
+
+  bool
+  isEmpty(const Slot& slot) const
+  {
+    return slot.entry == m_table.end();
+  }
+
+  size_t
+  getBucket(name_tree::HashValue hash) const
+  {
+    return hash & (m_slots.size() - 1);
+  }
+
+  void
+  insertImpl(name_tree::HashValue hash, Table::const_iterator entry);
+
+  void
+  resize(size_t newCapacity);
+
+public:
+  static constexpr size_t MIN_CAPACITY = 16;
+
+private:
+  const Table& m_table;
+  std::vector<Slot> m_slots;
+  size_t m_size = 0;
+};
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_EXACT_INDEX_HPP
@@ -1,256 +1,330 @@
-
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
 
 #include "cs-policy-soltani.hpp"
 #include "cs.hpp"
-#include "core/logger.hpp"
-#include "math.h"
 
-NFD_LOG_INIT("SoltaniPolicy");
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace nfd {
 namespace cs {
 namespace soltani {
 
-const std::string SoltaniPolicy::POLICY_NAME = "soltani";
-NFD_REGISTER_CS_POLICY(SoltaniPolicy);
+EntryInfo*
+EntryInfoPool::allocate()
+{
+  if (m_freeList.empty()) {
+    m_storage.emplace_back();
+    return &m_storage.back();
+  }
 
-SoltaniPolicy::SoltaniPolicy()
-  : Policy(POLICY_NAME)
+  EntryInfo* info = m_freeList.back();
+  m_freeList.pop_back();
+  *info = EntryInfo();
+  return info;
+}
+
+void
+EntryInfoPool::deallocate(EntryInfo* info)
 {
+  BOOST_ASSERT(info != nullptr);
+  m_freeList.push_back(info);
 }
 
-SoltaniPolicy::~SoltaniPolicy()
+EntryInfo*
+EntryInfoIndex::find(const Entry* entry) const
 {
-  for (auto entryInfoMapPair : m_entryInfoMap) {
-    delete entryInfoMapPair.second;
+  if (m_slots.empty()) {
+    return nullptr;
   }
+
+  size_t mask = m_slots.size() - 1;
+  for (size_t i = getBucket(entry); m_slots[i] != nullptr; i = (i + 1) & mask) {
+    if (&*m_slots[i]->entry == entry) {
+      return m_slots[i];
+    }
+  }
+  return nullptr;
 }
 
-//Not Yet
 void
-SoltaniPolicy::doBeforeErase(iterator i)
+EntryInfoIndex::insert(EntryInfo* info)
 {
-  NFD_LOG_INFO("Before Erase Function" );
+  BOOST_ASSERT(this->find(&*info->entry) == nullptr);
+
+  // keep the load factor at or below 1/2
+  if ((m_size + 1) * 2 > m_slots.size()) {
+    this->rehash(std::max<size_t>(16, m_slots.size() * 2));
+  }
 
-  this->detachQueue(i);
+  size_t mask = m_slots.size() - 1;
+  size_t i = getBucket(&*info->entry);
+  while (m_slots[i] != nullptr) {
+    i = (i + 1) & mask;
+  }
+  m_slots[i] = info;
+  ++m_size;
 }
 
 void
-SoltaniPolicy::doAfterRefresh(iterator i)
+EntryInfoIndex::erase(EntryInfo* info)
 {
-  NFD_LOG_INFO("After Refresh Function" );
-
-  EntryInfo* entryInfo = m_entryInfoMap[i];
+  BOOST_ASSERT(this->find(&*info->entry) == info);
 
-  if(entryInfo->queueType == linkedlist){
-    NFD_LOG_INFO("Linked List Location");
-    this->updateDI(i);
-    this->replaceCs(true);
+  size_t mask = m_slots.size() - 1;
+  size_t i = getBucket(&*info->entry);
+  while (m_slots[i] != info) {
+    i = (i + 1) & mask;
   }
 
-  else if (entryInfo->queueType == heaplist){
-    NFD_LOG_INFO("Already in HeapList");
-    this->updateDI(i);
-    this->replaceCs(false);
+  // move back every later slot of the probe sequence whose bucket is not in (i, j]
+  for (size_t j = (i + 1) & mask; m_slots[j] != nullptr; j = (j + 1) & mask) {
+    size_t k = getBucket(&*m_slots[j]->entry);
+    bool canStay = i <= j ? (i < k && k <= j) : (i < k || k <= j);
+    if (!canStay) {
+      m_slots[i] = m_slots[j];
+      i = j;
+    }
   }
-  
+  m_slots[i] = nullptr;
+  --m_size;
 }
 
-
-void
-SoltaniPolicy::doAfterInsert(iterator i)
+size_t
+EntryInfoIndex::getBucket(const Entry* entry) const
 {
-  NFD_LOG_INFO("After Insert Function" );
-
-  this->attachQueue(i);
-  this->evictEntries();
+  // Fibonacci hashing spreads the aligned, evenly spaced addresses of Table nodes
+  auto key = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(entry));
+  return static_cast<size_t>((key * UINT64_C(0x9E3779B97F4A7C15)) >> m_shift);
 }
 
 void
-SoltaniPolicy::doBeforeUse(iterator i)
+EntryInfoIndex::rehash(size_t nSlots)
 {
-  NFD_LOG_INFO("Before Use Function" );
-
-  EntryInfo* entryInfo = m_entryInfoMap[i];
+  BOOST_ASSERT(nSlots >= 2 && (nSlots & (nSlots - 1)) == 0);
 
-  if(entryInfo->queueType == linkedlist){
-    NFD_LOG_INFO("Linked List Location");
-    this->updateDI(i);
-    this->replaceCs(true);
+  std::vector<EntryInfo*> oldSlots(nSlots, nullptr);
+  oldSlots.swap(m_slots);
+  m_shift = 64;
+  for (size_t n = nSlots; n > 1; n >>= 1) {
+    --m_shift;
   }
 
-  else if (entryInfo->queueType == heaplist){
-    NFD_LOG_INFO("Already in HeapList");
-    this->updateDI(i);
-    this->replaceCs(false);
+  m_size = 0;
+  for (EntryInfo* info : oldSlots) {
+    if (info != nullptr) {
+      this->insert(info);
+    }
   }
+}
+
+const std::string SoltaniPolicy::POLICY_NAME = "soltani";
+NFD_REGISTER_CS_POLICY(SoltaniPolicy);
+
+constexpr double SoltaniPolicy::LAMBDA;
 
+SoltaniPolicy::SoltaniPolicy()
+  : Policy(POLICY_NAME)
+  , m_epoch(time::steady_clock::now())
+{
 }
 
 void
-SoltaniPolicy::evictEntries()
+SoltaniPolicy::doAfterInsert(EntryRef i)
 {
-  BOOST_ASSERT(this->getCs() != nullptr);
-
-  while (this->getCs()->size() > this->getLimit()) {
-    this->evictOne();
-  }
+  this->attach(i);
+  this->evictEntries();
 }
 
 void
-SoltaniPolicy::evictOne()
+SoltaniPolicy::doAfterRefresh(EntryRef i)
 {
-  BOOST_ASSERT(!m_queues[heaplist].empty()||
-               !m_queues[linkedlist].empty());
-
-   iterator i;
-    if(!m_queues[linkedlist].empty()){
-       i = m_queues[linkedlist].front();
-     }
-
-   this->detachQueue(i);
-   this->emitSignal(beforeEvict, i);
+  EntryInfo& info = this->getInfo(i);
+  this->updateDi(info);
+  this->heapUpdate(&info);
 }
 
 void
-SoltaniPolicy::attachQueue(iterator i)
+SoltaniPolicy::doBeforeErase(EntryRef i)
 {
-  BOOST_ASSERT(m_entryInfoMap.find(i) == m_entryInfoMap.end());
-
-  ndn::time::steady_clock::TimePoint init_now = ::ndn::time::steady_clock::now();
-  ndn::time::milliseconds init_milliseconds = ::ndn::time::duration_cast<::ndn::time::milliseconds>(init_now.time_since_epoch());
-  double init_time_ms = init_milliseconds.count();
-  double init_currentTime = init_time_ms/1000;
-
-  EntryInfo* entryInfo = new EntryInfo();
-    entryInfo->Di = 1.0;
-    entryInfo->lastReferencedTime=init_currentTime;
+  this->detach(i);
+}
 
-    if(this->getCs()->size() == this->getLimit()+1){
-      NFD_LOG_INFO("** New Interest **");
-      this->replaceCs(true);
-      entryInfo->queueType = heaplist;
-    }
-    else if (this->getCs()->size() > 7) {
-      entryInfo->queueType = linkedlist;
-      NFD_LOG_INFO("Type : LinkedList");
-    }
-    else{
-      entryInfo->queueType = heaplist;
-      NFD_LOG_INFO("Type : HeapList");
-    }
+void
+SoltaniPolicy::doBeforeUse(EntryRef i)
+{
+  EntryInfo& info = this->getInfo(i);
+  this->updateDi(info);
+  this->heapUpdate(&info);
+}
 
-  Queue& queue = m_queues[entryInfo->queueType];
-  entryInfo->queueIt = queue.insert(queue.end(), i);
-  m_entryInfoMap[i] = entryInfo;
+void
+SoltaniPolicy::evictEntries()
+{
+  BOOST_ASSERT(this->getCs() != nullptr);
 
-  for(auto it = m_queues[heaplist].begin(); it != m_queues[heaplist].end(); ++it)
-     {
-      if(m_entryInfoMap[*it]->queueType == heaplist){
-      NFD_LOG_INFO("EntryInfo HeapList " << m_entryInfoMap[*it]);
-     }
+  while (this->getCs()->size() > this->getLimit()) {
+    BOOST_ASSERT(!m_heap.empty());
+    EntryRef i = m_heap.front()->entry;
+    this->detach(i);
+    this->emitSignal(beforeEvict, i);
   }
- 
-  for(auto it = m_queues[linkedlist].begin(); it != m_queues[linkedlist].end(); ++it)
-  {
-    if(m_entryInfoMap[*it]->queueType == linkedlist){
-    NFD_LOG_INFO("EntryInfo LinkedList " << m_entryInfoMap[*it]);
-    }
-  }          
-
-
-  NFD_LOG_DEBUG("Size: "<< this->getCs()->size() <<"Di : "<< m_entryInfoMap[i]->Di << ", entryInfo: "<< m_entryInfoMap[i]);
+}
 
+double
+SoltaniPolicy::getCurrentTime() const
+{
+  return time::duration_cast<time::duration<double>>(time::steady_clock::now() - m_epoch).count();
 }
 
 void
-SoltaniPolicy::detachQueue(iterator i)
+SoltaniPolicy::updateDi(EntryInfo& info)
 {
-  BOOST_ASSERT(m_entryInfoMap.find(i) != m_entryInfoMap.end());
-
-  EntryInfo* entryInfo = m_entryInfoMap[i];
+  double now = this->getCurrentTime();
+  info.di = 1.0 + info.di * std::exp2(-LAMBDA * (now - info.lastReferencedTime));
+  info.lastReferencedTime = now;
 
-  m_queues[entryInfo->queueType].erase(entryInfo->queueIt);
+  if (info.entry->isUnsolicited()) {
+    info.priority = -std::numeric_limits<double>::infinity();
+  }
+  else {
+    info.priority = std::log2(info.di) + LAMBDA * info.lastReferencedTime;
+  }
+}
 
-  NFD_LOG_DEBUG("Erased " << m_entryInfoMap[i]);
-  m_entryInfoMap.erase(i);
-  delete entryInfo;
+void
+SoltaniPolicy::attach(EntryRef i)
+{
+  EntryInfo* info = m_pool.allocate();
+  info->entry = i;
+  info->lastReferencedTime = this->getCurrentTime();
+  this->updateDi(*info);
 
+  m_index.insert(info);
+  this->heapPush(info);
 }
 
 void
-SoltaniPolicy::updateDI(iterator i)
+SoltaniPolicy::detach(EntryRef i)
 {
-  BOOST_ASSERT(m_entryInfoMap.find(i) != m_entryInfoMap.end());
-
-  EntryInfo* entryInfo = m_entryInfoMap[i];
+  EntryInfo* info = &this->getInfo(i);
+  this->heapErase(info);
+  m_index.erase(info);
+  m_pool.deallocate(info);
+}
 
-  double initTime = entryInfo->lastReferencedTime;
-  double favorite = entryInfo->lastReferenceFavorite;
-  double lastDi = entryInfo->di;
-  double A = -1/log(cacheCounter);
-  double tnormi, Tt, lnormi, Lt;
-  set(tnormi, Tt, lnormi, Lt);
-  ndn::time::steady_clock::TimePoint now = ::ndn::time::steady_clock::now();
-  ndn::time::milliseconds milliseconds = ::ndn::time::duration_cast<::ndn::time::milliseconds>(now.time_since_epoch());
-  double time_ms = milliseconds.count();
-  double currentTime = time_ms/1000;
+EntryInfo&
+SoltaniPolicy::getInfo(EntryRef i) const
+{
+  EntryInfo* info = m_index.find(&*i);
+  BOOST_ASSERT(info != nullptr);
+  return *info;
+}
 
-  double newReferencedTime = currentTime - initTime;
+void
+SoltaniPolicy::heapPush(EntryInfo* info)
+{
+  info->heapIndex = m_heap.size();
+  m_heap.push_back(info);
+  this->siftUp(info->heapIndex);
+}
 
-  entryInfo->di = tnorm*(1-A*Tt)+lnorm*(1-A*Lt);
-  entryInfo->lastReferencedTime = currentTime;
+void
+SoltaniPolicy::heapErase(EntryInfo* info)
+{
+  size_t pos = info->heapIndex;
+  BOOST_ASSERT(pos < m_heap.size() && m_heap[pos] == info);
 
-  NFD_LOG_DEBUG("Update Di : "<< m_entryInfoMap[i]->Di << " New Referenced: " <<m_entryInfoMap[i]->lastReferencedTime);
-  NFD_LOG_DEBUG("currentTime: " <<currentTime << " Di: " << lastDi << " lastReferencedTime: " <<initTime);
+  size_t last = m_heap.size() - 1;
+  if (pos != last) {
+    this->heapSwap(pos, last);
+  }
+  m_heap.pop_back();
 
+  if (pos < m_heap.size()) {
+    this->heapUpdate(m_heap[pos]);
+  }
 }
 
 void
-SoltaniPolicy::replaceCs(bool status)
+SoltaniPolicy::heapUpdate(EntryInfo* info)
 {
-  BOOST_ASSERT(!m_queues[heaplist].empty());
-
-  iterator lowestDiPointer;
-  double tempDi = 9999.0;
-  double getDi;
-  int list = 1;
-
-  for(auto it = m_queues[heaplist].begin(); it != m_queues[heaplist].end(); ++it)
-  {
-      if(m_entryInfoMap[*it]->queueType == heaplist){
-        NFD_LOG_INFO( list << ". HeapList Di Value: " << m_entryInfoMap[*it]->di);
-
-        getDi = m_entryInfoMap[*it]->Di;
-          if ( tempDi > getDi)
-          {
-            tempDi = getDi;
-            lowestDiPointer = *it;
-          }
-      }
-      list ++;
+  size_t pos = info->heapIndex;
+  if (pos > 0 && m_heap[pos]->priority < m_heap[(pos - 1) / 2]->priority) {
+    this->siftUp(pos);
+  }
+  else {
+    this->siftDown(pos);
   }
-  NFD_LOG_INFO("-- Lowest Di: " << tempDi);
-  NFD_LOG_INFO("-- delete data with lowest DI in CS: " << m_entryInfoMap[lowestDiPointer]);
-
 }
 
-
 void
-SoltaniPolicy::replaceCs(iterator i)
+SoltaniPolicy::siftUp(size_t pos)
 {
-    EntryInfo* entryInfo = m_entryInfoMap[i];
-    m_queues[linkedlist].erase(entryInfo->queueIt);
-
-    entryInfo->queueType = heaplist;
-    Queue&queue = m_queues[heaplist];
-    entryInfo->queueIt = queue.insert(queue.end(),i);
-    m_entryInfoMap[i] = entryInfo;
+  while (pos > 0) {
+    size_t parent = (pos - 1) / 2;
+    if (!(m_heap[pos]->priority < m_heap[parent]->priority)) {
+      break;
+    }
+    this->heapSwap(pos, parent);
+    pos = parent;
+  }
+}
 
-    NFD_LOG_INFO("Move To HeapList (0) ; Di = " <<m_entryInfoMap[i]->Di);
+void
+SoltaniPolicy::siftDown(size_t pos)
+{
+  size_t size = m_heap.size();
+  while (true) {
+    size_t smallest = pos;
+    size_t left = 2 * pos + 1;
+    size_t right = left + 1;
+    if (left < size && m_heap[left]->priority < m_heap[smallest]->priority) {
+      smallest = left;
+    }
+    if (right < size && m_heap[right]->priority < m_heap[smallest]->priority) {
+      smallest = right;
+    }
+    if (smallest == pos) {
+      break;
+    }
+    this->heapSwap(pos, smallest);
+    pos = smallest;
+  }
+}
 
+void
+SoltaniPolicy::heapSwap(size_t a, size_t b)
+{
+  std::swap(m_heap[a], m_heap[b]);
+  m_heap[a]->heapIndex = a;
+  m_heap[b]->heapIndex = b;
 }
 
-} // namespace lrfu
+} // namespace soltani
 } // namespace cs
-} // namespace nfd
\ No newline at end of file
+} // namespace nfd
@@ -1,120 +1,224 @@
-
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
 
 #ifndef NFD_DAEMON_TABLE_CS_POLICY_SOLTANI_HPP
 #define NFD_DAEMON_TABLE_CS_POLICY_SOLTANI_HPP
 
 #include "cs-policy.hpp"
-#include "core/scheduler.hpp"
 
+#include <deque>
 
 namespace nfd {
 namespace cs {
 namespace soltani {
 
-typedef std::list<iterator> Queue;
-typedef Queue::iterator QueueIt;
-
-enum QueueType{
-  heaplist,
-  linkedlist,
-  my
-};
-
+/** \brief per-entry state of the Soltani policy
+ *
+ *  EntryInfo objects are owned by an EntryInfoPool, and are referenced from the eviction heap
+ *  and from an EntryInfoIndex.
+ */
 struct EntryInfo
 {
-  QueueType queueType;
-  double Di;
-  double lastReferencedTime;
-  QueueIt queueIt;
-  scheduler::EventId moveListEventId;
+  Policy::EntryRef entry;
+  double di = 0.0;                  ///< Di value at lastReferencedTime
+  double lastReferencedTime = 0.0;  ///< in seconds, relative to policy creation
+  double priority = 0.0;            ///< eviction key, time-invariant (see SoltaniPolicy)
+  size_t heapIndex = 0;             ///< position in the eviction heap
 };
 
-struct EntryItComparator
+/** \brief a free-list allocator of EntryInfo
+ *
+ *  Objects are stored in a std::deque, which never relocates existing elements on push_back,
+ *  so that a released EntryInfo can be handed out again without touching the heap allocator.
+ */
+class EntryInfoPool : noncopyable
 {
+public:
+  EntryInfo*
+  allocate();
+
+  void
+  deallocate(EntryInfo* info);
 
-  bool
-  operator()(const iterator& a, const iterator& b) const
+  /** \return number of EntryInfo objects currently handed out
+   */
+  size_t
+  size() const
   {
-    return *a < *b;
+    return m_storage.size() - m_freeList.size();
   }
 
+private:
+  std::deque<EntryInfo> m_storage;
+  std::vector<EntryInfo*> m_freeList;
 };
 
-typedef std::map<iterator, EntryInfo*, EntryItComparator> EntryInfoMapmy;
+/** \brief an open-addressing hash index from CS entries to their EntryInfo
+ *
+ *  Slots hold EntryInfo pointers, and the key of a slot is the address of EntryInfo::entry.
+ *  Collisions are resolved by linear probing, and erase() shifts later slots of the probe
+ *  sequence backward, so there are no tombstones. The slot array only grows, so that once
+ *  the CS has reached its limit, inserting and erasing make no heap allocations.
+ */
+class EntryInfoIndex : noncopyable
+{
+public:
+  /** \return EntryInfo of \p entry, or nullptr if not indexed
+   */
+  EntryInfo*
+  find(const Entry* entry) const;
 
-/** \brief Priority my cs replacement policy
+  /** \pre the entry of \p info is not indexed
+   */
+  void
+  insert(EntryInfo* info);
+
+  /** \pre \p info is indexed
+   */
+  void
+  erase(EntryInfo* info);
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+private:
+  size_t
+  getBucket(const Entry* entry) const;
+
+  void
+  rehash(size_t nSlots);
+
+private:
+  std::vector<EntryInfo*> m_slots; ///< size is zero or a power of two
+  size_t m_size = 0;
+  int m_shift = 0;                 ///< 64 - log2(m_slots.size())
+};
+
+/** \brief Soltani replacement policy
+ *
+ *  Each entry carries a Di value that combines recency and frequency of references:
+ *  on every reference at time t, Di := 1 + Di * 2^(-LAMBDA * (t - lastReferencedTime)).
+ *  The entry with the lowest decayed Di is evicted first; unsolicited Data is evicted
+ *  before any solicited Data.
  *
- * The entries that get removed first are unsolicited Data packets,
- * which are the Data packets that got cached opportunistically without preceding
- * forwarding of the corresponding Interest packet.
- * Next, the Data packets with expired freshness are removed.
- * Last, the Data packets are removed from the Content Store on a pure my basis.
+ *  Because all decayed values shrink by the same factor over time, comparing decayed Di
+ *  of two entries is equivalent to comparing log2(Di) + LAMBDA * lastReferencedTime,
+ *  which only changes when the entry itself is referenced. This key is kept in an indexed
+ *  binary min-heap, so that both a cache hit and an eviction cost O(log n).
  */
-class SoltaniPolicy : public Policy
+class SoltaniPolicy final : public Policy
 {
 public:
   SoltaniPolicy();
 
-  virtual
-  ~SoltaniPolicy();
-
 public:
   static const std::string POLICY_NAME;
 
+  /** \brief decay rate of Di, per second
+   */
+  static constexpr double LAMBDA = 0.1;
+
 private:
-  virtual void
-  doAfterInsert(iterator i) override;
+  void
+  doAfterInsert(EntryRef i) final;
 
-  virtual void
-  doAfterRefresh(iterator i) override;
+  void
+  doAfterRefresh(EntryRef i) final;
 
-  virtual void
-  doBeforeErase(iterator i) override;
+  void
+  doBeforeErase(EntryRef i) final;
 
-  virtual void
-  doBeforeUse(iterator i) override;
+  void
+  doBeforeUse(EntryRef i) final;
 
-  virtual void
-  evictEntries() override;
+  void
+  evictEntries() final;
 
 private:
-  /** \brief evicts one entry
-   *  \pre CS is not empty
+  /** \brief current time in seconds, relative to policy creation
+   */
+  double
+  getCurrentTime() const;
+
+  /** \brief records a reference to \p info at the current time, and recomputes its priority
    */
   void
-  evictOne();
+  updateDi(EntryInfo& info);
 
-  /** \brief attaches the entry to an appropriate queue
-   *  \pre the entry is not in any queue
+  /** \brief creates EntryInfo for \p i and inserts it into the heap
+   *  \pre the entry is not in the heap
    */
   void
-  attachQueue(iterator i);
+  attach(EntryRef i);
 
-  /** \brief detaches the entry from its current queue
-   *  \post the entry is not in any queue
+  /** \brief removes the entry from the heap and releases its EntryInfo
+   *  \post the entry is not in the heap
    */
   void
-  detachQueue(iterator i);
+  detach(EntryRef i);
+
+NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  EntryInfo&
+  getInfo(EntryRef i) const;
+
+private: // indexed min-heap keyed on EntryInfo::priority
+  void
+  heapPush(EntryInfo* info);
+
+  void
+  heapErase(EntryInfo* info);
 
-  /** \brief moves an entry from my queue to STALE queue
+  /** \brief restores heap order after the priority of \p info has changed
    */
   void
-  updateDi(iterator i);
+  heapUpdate(EntryInfo* info);
+
+  void
+  siftUp(size_t pos);
+
+  void
+  siftDown(size_t pos);
 
   void
-  replaceCs(bool status);
+  heapSwap(size_t a, size_t b);
 
 private:
-  // Queue m_queues[QUEUE_MAX];
-  Queue m_queues[my];
-  EntryInfoMapmy m_entryInfoMap;
+  time::steady_clock::TimePoint m_epoch;
+  EntryInfoPool m_pool;
+  std::vector<EntryInfo*> m_heap;
+  EntryInfoIndex m_index;
 };
 
-} // namespace priority_my
+} // namespace soltani
 
 using soltani::SoltaniPolicy;
 
 } // namespace cs
 } // namespace nfd
 
-#endif // NFD_DAEMON_TABLE_CS_POLICY_SOLTANI_HPP
\ No newline at end of file
+#endif // NFD_DAEMON_TABLE_CS_POLICY_SOLTANI_HPP
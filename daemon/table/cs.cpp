@@ -80,6 +80,9 @@ Cs::insert(const Data& data, bool isUnsolicited)
     m_policy->afterRefresh(it);
   }
   else {
+    if (m_hasExactIndex) {
+      m_exactIndex.insert(it);
+    }
     m_policy->afterInsert(it);
   }
 }
@@ -104,12 +107,21 @@ Cs::eraseImpl(const Name& prefix, size_t limit)
   size_t nErased = 0;
   while (i != last && nErased < limit) {
     m_policy->beforeErase(i);
-    i = m_table.erase(i);
+    eraseEntry(i++);
     ++nErased;
   }
   return nErased;
 }
 
+void
+Cs::eraseEntry(const_iterator it)
+{
+  if (m_hasExactIndex) {
+    m_exactIndex.erase(it);
+  }
+  m_table.erase(it);
+}
+
 Cs::const_iterator
 Cs::findImpl(const Interest& interest) const
 {
@@ -118,6 +130,17 @@ Cs::findImpl(const Interest& interest) const
   }
 
   const Name& prefix = interest.getName();
+  if (m_hasExactIndex && !interest.getCanBePrefix()) {
+    auto match = m_exactIndex.find(interest);
+    if (match == m_table.end()) {
+      NFD_LOG_DEBUG("find " << prefix << " no-match");
+      return m_table.end();
+    }
+    NFD_LOG_DEBUG("find " << prefix << " matching " << match->getName());
+    m_policy->beforeUse(match);
+    return match;
+  }
+
   auto range = findPrefixRange(prefix);
   auto match = std::find_if(range.first, range.second,
                             [&interest] (const auto& entry) { return entry.canSatisfy(interest); });
@@ -155,7 +178,7 @@ Cs::setPolicyImpl(unique_ptr<Policy> policy)
 {
   NFD_LOG_DEBUG("set-policy " << policy->getName());
   m_policy = std::move(policy);
-  m_beforeEvictConnection = m_policy->beforeEvict.connect([this] (auto it) { m_table.erase(it); });
+  m_beforeEvictConnection = m_policy->beforeEvict.connect([this] (auto it) { eraseEntry(it); });
 
   m_policy->setCs(this);
   BOOST_ASSERT(m_policy->getCs() == this);
@@ -181,5 +204,21 @@ Cs::enableServe(bool shouldServe)
   NFD_LOG_INFO((shouldServe ? "Enabling" : "Disabling") << " Data serving");
 }
 
+void
+Cs::enableExactIndex(bool hasExactIndex)
+{
+  if (m_hasExactIndex == hasExactIndex) {
+    return;
+  }
+  m_hasExactIndex = hasExactIndex;
+  if (hasExactIndex) {
+    m_exactIndex.rebuild();
+  }
+  else {
+    m_exactIndex.clear();
+  }
+  NFD_LOG_INFO((hasExactIndex ? "Enabling" : "Disabling") << " exact-match index");
+}
+
 } // namespace cs
 } // namespace nfd
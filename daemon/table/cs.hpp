@@ -26,6 +26,7 @@
 #ifndef NFD_DAEMON_TABLE_CS_HPP
 #define NFD_DAEMON_TABLE_CS_HPP
 
+#include "cs-exact-index.hpp"
 #include "cs-policy.hpp"
 
 namespace nfd {
@@ -40,6 +41,9 @@ namespace cs {
  *  and a few additional attributes such as when the Data becomes non-fresh.
  *
  *  The replacement policy is implemented in a subclass of \c Policy.
+ *
+ *  Optionally, entries are also indexed by the hash of their Data name in an \c ExactIndex,
+ *  which serves lookups of Interests with CanBePrefix=false without searching the Table.
  */
 class Cs : noncopyable
 {
@@ -157,6 +161,21 @@ public: // configuration
   void
   enableServe(bool shouldServe);
 
+  /** \brief get whether the exact-match index is enabled
+   */
+  bool
+  hasExactIndex() const
+  {
+    return m_hasExactIndex;
+  }
+
+  /** \brief enable or disable the exact-match index
+   *
+   *  Enabling the index builds it from the stored packets.
+   */
+  void
+  enableExactIndex(bool hasExactIndex);
+
 public: // enumeration
   using const_iterator = Table::const_iterator;
 
@@ -182,6 +201,9 @@ private:
   const_iterator
   findImpl(const Interest& interest) const;
 
+  void
+  eraseEntry(const_iterator it);
+
   void
   setPolicyImpl(unique_ptr<Policy> policy);
 
@@ -191,11 +213,13 @@ NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
 private:
   Table m_table;
+  ExactIndex m_exactIndex{m_table};
   unique_ptr<Policy> m_policy;
   signal::ScopedConnection m_beforeEvictConnection;
 
   bool m_shouldAdmit = true; ///< if false, no Data will be admitted
   bool m_shouldServe = true; ///< if false, all lookups will miss
+  bool m_hasExactIndex = false; ///< if true, m_exactIndex is kept up to date
 };
 
 } // namespace cs
@@ -0,0 +1,230 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dead-nonce-filter.hpp"
+#include "common/global.hpp"
+#include "common/logger.hpp"
+
+#include <cmath>
+
+namespace nfd {
+
+NFD_LOG_INIT(DeadNonceFilter);
+
+const size_t DeadNonceFilter::WORDS_PER_BLOCK;
+const size_t DeadNonceFilter::MAX_HASHES;
+const size_t DeadNonceFilter::N_SLICES;
+const size_t DeadNonceFilter::BLOCK_SIZE;
+const size_t DeadNonceFilter::MIN_MEMORY_BUDGET;
+const size_t DeadNonceFilter::MAX_MEMORY_BUDGET;
+
+DeadNonceFilter::DeadNonceFilter(time::nanoseconds lifetime, const Options& options)
+  : m_options(options)
+  , m_rotateInterval(lifetime / (N_SLICES - 1))
+{
+  if (options.memoryBudget < MIN_MEMORY_BUDGET || options.memoryBudget > MAX_MEMORY_BUDGET) {
+    NDN_THROW(std::invalid_argument("memoryBudget is out of range"));
+  }
+  if (!(options.falsePositiveRate > 0.0 && options.falsePositiveRate < 1.0)) {
+    NDN_THROW(std::invalid_argument("falsePositiveRate must be in (0, 1)"));
+  }
+
+  m_nBlocks = options.memoryBudget / (N_SLICES * BLOCK_SIZE);
+
+  // A lookup checks every slice, so each slice gets an equal share of the false positive rate.
+  // Pick the number of bits per entry that lets a slice hold the most entries within that rate.
+  const double sliceRate = options.falsePositiveRate / N_SLICES;
+  double bestLoad = 0.0;
+  m_nHashes = 1;
+  for (size_t k = 1; k <= MAX_HASHES; ++k) {
+    double load = computeMaxLoad(k, sliceRate);
+    if (load > bestLoad) {
+      bestLoad = load;
+      m_nHashes = k;
+    }
+  }
+  m_sliceCapacity = std::max(static_cast<size_t>(bestLoad * m_nBlocks), size_t(1));
+
+  m_words.assign(N_SLICES * m_nBlocks * WORDS_PER_BLOCK, 0);
+
+  NFD_LOG_DEBUG("slices=" << N_SLICES << " blocks=" << m_nBlocks << " hashes=" << m_nHashes <<
+                " slice-capacity=" << m_sliceCapacity);
+
+  m_rotateEvent = getScheduler().schedule(m_rotateInterval, [this] { rotate(); });
+}
+
+/** \brief Returns the false positive rate of a blocked Bloom filter
+ *  \param load average number of entries per block
+ *  \param nHashes number of bits set per entry
+ */
+static double
+computeFalsePositiveRate(double load, size_t nHashes)
+{
+  // The number of entries in a block follows a Poisson distribution,
+  // and each block is a standard Bloom filter of BLOCK_SIZE * 8 bits
+  const double bitsPerBlock = DeadNonceFilter::BLOCK_SIZE * 8;
+  const size_t maxEntries = static_cast<size_t>(load + 10 * std::sqrt(load)) + 20;
+
+  double rate = 0.0;
+  double probability = std::exp(-load);
+  for (size_t j = 0; j <= maxEntries; ++j) {
+    double bitIsSet = 1.0 - std::pow(1.0 - 1.0 / bitsPerBlock, static_cast<double>(j * nHashes));
+    rate += probability * std::pow(bitIsSet, static_cast<double>(nHashes));
+    probability *= load / (j + 1);
+  }
+  return rate;
+}
+
+double
+DeadNonceFilter::computeMaxLoad(size_t nHashes, double falsePositiveRate)
+{
+  double low = 0.0;
+  double high = BLOCK_SIZE * 8;
+  for (int i = 0; i < 50; ++i) {
+    double mid = (low + high) / 2;
+    if (computeFalsePositiveRate(mid, nHashes) <= falsePositiveRate) {
+      low = mid;
+    }
+    else {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+DeadNonceFilter::BlockMask
+DeadNonceFilter::makeMask(uint64_t entry) const
+{
+  // Bit positions are drawn 9 bits at a time from a SplitMix64 sequence seeded by the entry.
+  // Double hashing is not used: its arithmetic progressions overlap within a small block
+  // and raise the false positive rate well above the computed one.
+  constexpr unsigned BITS_PER_POSITION = 9;
+  constexpr unsigned POSITIONS_PER_WORD = 64 / BITS_PER_POSITION;
+  static_assert(BLOCK_SIZE * 8 == 1 << BITS_PER_POSITION, "a position must address one block");
+
+  BlockMask mask{};
+  uint64_t state = entry;
+  uint64_t random = 0;
+  for (size_t i = 0; i < m_nHashes; ++i) {
+    if (i % POSITIONS_PER_WORD == 0) {
+      state += 0x9E3779B97F4A7C15;
+      random = state;
+      random = (random ^ (random >> 30)) * 0xBF58476D1CE4E5B9;
+      random = (random ^ (random >> 27)) * 0x94D049BB133111EB;
+      random ^= random >> 31;
+    }
+    auto bit = static_cast<unsigned>(random & ((1 << BITS_PER_POSITION) - 1));
+    random >>= BITS_PER_POSITION;
+    mask[bit / 64] |= uint64_t(1) << (bit % 64);
+  }
+  return mask;
+}
+
+size_t
+DeadNonceFilter::getBlockIndex(uint64_t entry) const
+{
+  // Maps the upper half of the hash onto [0, m_nBlocks) without a division
+  return static_cast<size_t>(((entry >> 32) * m_nBlocks) >> 32);
+}
+
+bool
+DeadNonceFilter::sliceHas(size_t slice, size_t block, const BlockMask& mask) const
+{
+  const uint64_t* words = &m_words[(slice * m_nBlocks + block) * WORDS_PER_BLOCK];
+  for (size_t i = 0; i < WORDS_PER_BLOCK; ++i) {
+    if ((words[i] & mask[i]) != mask[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool
+DeadNonceFilter::has(uint64_t entry) const
+{
+  const BlockMask mask = makeMask(entry);
+  const size_t block = getBlockIndex(entry);
+  for (size_t slice = 0; slice < N_SLICES; ++slice) {
+    if (m_sliceSizes[slice] > 0 && sliceHas(slice, block, mask)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void
+DeadNonceFilter::add(uint64_t entry)
+{
+  const BlockMask mask = makeMask(entry);
+  const size_t block = getBlockIndex(entry);
+  if (sliceHas(m_activeSlice, block, mask)) {
+    // already in the active slice, it cannot be kept any longer
+    return;
+  }
+
+  if (m_sliceSizes[m_activeSlice] >= m_sliceCapacity) {
+    NFD_LOG_DEBUG("active slice is full after " << m_sliceCapacity << " entries, rotating early");
+    rotate();
+  }
+
+  uint64_t* words = &m_words[(m_activeSlice * m_nBlocks + block) * WORDS_PER_BLOCK];
+  for (size_t i = 0; i < WORDS_PER_BLOCK; ++i) {
+    words[i] |= mask[i];
+  }
+  ++m_sliceSizes[m_activeSlice];
+}
+
+size_t
+DeadNonceFilter::size() const
+{
+  size_t n = 0;
+  for (size_t sliceSize : m_sliceSizes) {
+    n += sliceSize;
+  }
+  return n;
+}
+
+void
+DeadNonceFilter::rotate()
+{
+  m_activeSlice = (m_activeSlice + 1) % N_SLICES;
+
+  auto first = m_words.begin() + m_activeSlice * m_nBlocks * WORDS_PER_BLOCK;
+  std::fill(first, first + m_nBlocks * WORDS_PER_BLOCK, 0);
+  m_sliceSizes[m_activeSlice] = 0;
+
+  NFD_LOG_TRACE("rotate active=" << m_activeSlice << " size=" << size());
+
+  m_rotateEvent = getScheduler().schedule(m_rotateInterval, [this] { rotate(); });
+}
+
+bool
+operator==(const DeadNonceFilter::Options& lhs, const DeadNonceFilter::Options& rhs)
+{
+  return lhs.memoryBudget == rhs.memoryBudget &&
+         lhs.falsePositiveRate == rhs.falsePositiveRate;
+}
+
+} // namespace nfd
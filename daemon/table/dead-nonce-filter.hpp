@@ -0,0 +1,162 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_DEAD_NONCE_FILTER_HPP
+#define NFD_DAEMON_TABLE_DEAD_NONCE_FILTER_HPP
+
+#include "core/common.hpp"
+
+#include <array>
+
+namespace nfd {
+
+/**
+ * \brief Fixed-size probabilistic storage for Dead Nonce List entries.
+ *
+ * Entries are the 64-bit hashes of Interest Name and Nonce computed by DeadNonceList.
+ * They are kept in a ring of #N_SLICES blocked Bloom filters that share one allocation made
+ * at construction. An entry sets a few bits within a single cache-line-sized block of the
+ * active slice, and a lookup reads one block per slice, so neither operation allocates memory
+ * or depends on the number of stored entries.
+ *
+ * Every lifetime / (#N_SLICES - 1) the oldest slice is cleared and becomes the active slice.
+ * An entry is thus remembered for at least the lifetime and at most
+ * lifetime * #N_SLICES / (#N_SLICES - 1). The capacity of a slice is derived from its share
+ * of the memory budget and the requested false positive rate. If the active slice fills up
+ * before its interval ends, the filter rotates early: under overload, the entry lifetime is
+ * shortened rather than exceeding the false positive rate.
+ */
+class DeadNonceFilter : noncopyable
+{
+public:
+  struct Options
+  {
+    /// Total size of the filter in bytes
+    size_t memoryBudget = 4 * 1024 * 1024;
+    /// Probability that has() reports an entry that was not added
+    double falsePositiveRate = 1e-4;
+  };
+
+  /**
+   * \throw std::invalid_argument the memory budget is less than #MIN_MEMORY_BUDGET or more
+   *        than #MAX_MEMORY_BUDGET, or the false positive rate is not in (0, 1)
+   */
+  DeadNonceFilter(time::nanoseconds lifetime, const Options& options);
+
+  bool
+  has(uint64_t entry) const;
+
+  void
+  add(uint64_t entry);
+
+  /** \brief Returns the number of entries added to all slices
+   *  \note An entry added again after the active slice changed is counted again.
+   */
+  size_t
+  size() const;
+
+  const Options&
+  getOptions() const
+  {
+    return m_options;
+  }
+
+  /// Returns the number of entries a slice holds before the filter rotates early
+  size_t
+  getSliceCapacity() const
+  {
+    return m_sliceCapacity;
+  }
+
+  /// Returns the number of bits set per entry
+  size_t
+  getNHashes() const
+  {
+    return m_nHashes;
+  }
+
+  /// Returns the size of the filter in bytes
+  size_t
+  getMemoryUsage() const
+  {
+    return m_words.size() * sizeof(uint64_t);
+  }
+
+private:
+  static constexpr size_t WORDS_PER_BLOCK = 8;
+  static constexpr size_t MAX_HASHES = 16;
+  using BlockMask = std::array<uint64_t, WORDS_PER_BLOCK>;
+
+  /** \brief Returns the highest average number of entries per block at which a slice stays
+   *         within \p falsePositiveRate
+   */
+  static double
+  computeMaxLoad(size_t nHashes, double falsePositiveRate);
+
+  BlockMask
+  makeMask(uint64_t entry) const;
+
+  size_t
+  getBlockIndex(uint64_t entry) const;
+
+  bool
+  sliceHas(size_t slice, size_t block, const BlockMask& mask) const;
+
+  void
+  rotate();
+
+public:
+  /// Number of slices, one of which receives new entries
+  static constexpr size_t N_SLICES = 5;
+  /// Size of a block in bytes, all bits of an entry are within one block
+  static constexpr size_t BLOCK_SIZE = WORDS_PER_BLOCK * sizeof(uint64_t);
+  static constexpr size_t MIN_MEMORY_BUDGET = N_SLICES * BLOCK_SIZE;
+  static constexpr size_t MAX_MEMORY_BUDGET = size_t(1) << 30;
+
+private:
+  const Options m_options;
+  const time::nanoseconds m_rotateInterval;
+  size_t m_nBlocks; ///< blocks per slice
+  size_t m_nHashes;
+  size_t m_sliceCapacity;
+
+  std::vector<uint64_t> m_words;
+  std::array<size_t, N_SLICES> m_sliceSizes{};
+  size_t m_activeSlice = 0;
+  scheduler::ScopedEventId m_rotateEvent;
+};
+
+bool
+operator==(const DeadNonceFilter::Options& lhs, const DeadNonceFilter::Options& rhs);
+
+inline bool
+operator!=(const DeadNonceFilter::Options& lhs, const DeadNonceFilter::Options& rhs)
+{
+  return !(lhs == rhs);
+}
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_DEAD_NONCE_FILTER_HPP
@@ -53,12 +53,7 @@ DeadNonceList::DeadNonceList(time::nanoseconds lifetime)
     NDN_THROW(std::invalid_argument("lifetime is less than MIN_LIFETIME"));
   }
 
-  for (size_t i = 0; i < EXPECTED_MARK_COUNT; ++i) {
-    m_queue.push_back(MARK);
-  }
-
-  m_markEvent = getScheduler().schedule(m_markInterval, [this] { mark(); });
-  m_adjustCapacityEvent = getScheduler().schedule(m_adjustCapacityInterval, [this] { adjustCapacity(); });
+  startIndex();
 
   BOOST_ASSERT_MSG(DEFAULT_LIFETIME >= MIN_LIFETIME, "DEFAULT_LIFETIME is too small");
   static_assert(INITIAL_CAPACITY >= MIN_CAPACITY, "INITIAL_CAPACITY is too small");
@@ -72,9 +67,51 @@ DeadNonceList::DeadNonceList(time::nanoseconds lifetime)
   static_assert(EVICT_LIMIT >= 1, "EVICT_LIMIT must be at least 1");
 }
 
+void
+DeadNonceList::startIndex()
+{
+  BOOST_ASSERT(m_index.empty());
+  for (size_t i = 0; i < EXPECTED_MARK_COUNT; ++i) {
+    m_queue.push_back(MARK);
+  }
+
+  m_markEvent = getScheduler().schedule(m_markInterval, [this] { mark(); });
+  m_adjustCapacityEvent = getScheduler().schedule(m_adjustCapacityInterval, [this] { adjustCapacity(); });
+}
+
+void
+DeadNonceList::useFilter(const optional<DeadNonceFilter::Options>& options)
+{
+  if (!options) {
+    if (m_filter == nullptr) {
+      return;
+    }
+    m_filter.reset();
+    startIndex();
+    NFD_LOG_INFO("Using exact index");
+    return;
+  }
+
+  if (m_filter != nullptr && m_filter->getOptions() == *options) {
+    return;
+  }
+
+  m_filter = make_unique<DeadNonceFilter>(m_lifetime, *options);
+  m_index.clear();
+  m_actualMarkCounts.clear();
+  m_markEvent.cancel();
+  m_adjustCapacityEvent.cancel();
+  NFD_LOG_INFO("Using filter memory=" << m_filter->getMemoryUsage() <<
+               " fp-rate=" << options->falsePositiveRate <<
+               " slice-capacity=" << m_filter->getSliceCapacity());
+}
+
 size_t
 DeadNonceList::size() const
 {
+  if (m_filter != nullptr) {
+    return m_filter->size();
+  }
   return m_queue.size() - countMarks();
 }
 
@@ -82,6 +119,9 @@ bool
 DeadNonceList::has(const Name& name, Interest::Nonce nonce) const
 {
   Entry entry = DeadNonceList::makeEntry(name, nonce);
+  if (m_filter != nullptr) {
+    return m_filter->has(entry);
+  }
   return m_ht.find(entry) != m_ht.end();
 }
 
@@ -89,6 +129,12 @@ void
 DeadNonceList::add(const Name& name, Interest::Nonce nonce)
 {
   Entry entry = DeadNonceList::makeEntry(name, nonce);
+  if (m_filter != nullptr) {
+    NFD_LOG_TRACE("adding " << name << " nonce=" << nonce << " to filter");
+    m_filter->add(entry);
+    return;
+  }
+
   const auto iter = m_ht.find(entry);
   bool isDuplicate = iter != m_ht.end();
 
@@ -26,7 +26,7 @@
 #ifndef NFD_DAEMON_TABLE_DEAD_NONCE_LIST_HPP
 #define NFD_DAEMON_TABLE_DEAD_NONCE_LIST_HPP
 
-#include "core/common.hpp"
+#include "dead-nonce-filter.hpp"
 
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/hashed_index.hpp>
@@ -50,6 +50,9 @@ namespace nfd {
  * At fixed intervals, a MARK (an entry with a special value) is inserted into the container.
  * The number of MARKs stored in the container reflects the lifetime of the entries,
  * because MARKs are inserted at fixed intervals.
+ *
+ * Alternatively, the entries can be kept in a DeadNonceFilter, which has a fixed memory
+ * footprint and a configurable false positive rate. See useFilter().
  */
 class DeadNonceList : noncopyable
 {
@@ -93,12 +96,36 @@ public:
     return m_lifetime;
   }
 
+  /**
+   * \brief Selects where entries are stored
+   * \param options if set, entries are kept in a DeadNonceFilter created with these options;
+   *                otherwise they are kept in the exact index
+   * \throw std::invalid_argument the filter options are invalid
+   * \note Stored entries are discarded, unless the storage is unchanged.
+   */
+  void
+  useFilter(const optional<DeadNonceFilter::Options>& options);
+
+  /**
+   * \brief Returns the filter in use, or nullptr if entries are kept in the exact index
+   */
+  const DeadNonceFilter*
+  getFilter() const
+  {
+    return m_filter.get();
+  }
+
 private:
   using Entry = uint64_t;
 
   static Entry
   makeEntry(const Name& name, Interest::Nonce nonce);
 
+  /** \brief Insert the initial MARKs into the empty index and start the periodic events
+   */
+  void
+  startIndex();
+
   /** \brief Return the number of MARKs in the index
    */
   size_t
@@ -205,6 +232,11 @@ NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
   /// Maximum number of entries to evict at each operation if the index is over capacity
   static constexpr size_t EVICT_LIMIT = 64;
+
+  // ---- probabilistic storage
+
+  /// If set, entries are kept in this filter and the index is empty
+  unique_ptr<DeadNonceFilter> m_filter;
 };
 
 } // namespace nfd
@@ -44,6 +44,7 @@ nteHasFibEntry(const name_tree::Entry& nte)
 
 Fib::Fib(NameTree& nameTree)
   : m_nameTree(nameTree)
+  , m_version(name_tree::makeLookupCacheVersion())
 {
 }
 
@@ -58,6 +59,22 @@ Fib::findLongestPrefixMatchImpl(const K& key) const
   return *s_emptyEntry;
 }
 
+const Entry&
+Fib::findLongestPrefixMatchCached(name_tree::Entry& nte) const
+{
+  auto& cache = nte.getFibLookupCache();
+  if (cache.version != m_version) {
+    name_tree::Entry* match = m_nameTree.findLongestPrefixMatch(nte, &nteHasFibEntry);
+    cache.entry = match == nullptr ? nullptr : match->getFibEntry();
+    cache.version = m_version;
+  }
+
+  if (cache.entry != nullptr) {
+    return *cache.entry;
+  }
+  return *s_emptyEntry;
+}
+
 const Entry&
 Fib::findLongestPrefixMatch(const Name& prefix) const
 {
@@ -67,13 +84,23 @@ Fib::findLongestPrefixMatch(const Name& prefix) const
 const Entry&
 Fib::findLongestPrefixMatch(const pit::Entry& pitEntry) const
 {
-  return this->findLongestPrefixMatchImpl(pitEntry);
+  name_tree::Entry* nte = m_nameTree.getEntry(pitEntry);
+  BOOST_ASSERT(nte != nullptr);
+
+  // A PIT entry whose name ends with an implicit digest or exceeds the depth limit is attached
+  // to a shorter name, and a longer FIB entry may still match; the cache cannot tell.
+  if (nte->getName().size() != pitEntry.getName().size()) {
+    return this->findLongestPrefixMatchImpl(pitEntry);
+  }
+  return this->findLongestPrefixMatchCached(*nte);
 }
 
 const Entry&
 Fib::findLongestPrefixMatch(const measurements::Entry& measurementsEntry) const
 {
-  return this->findLongestPrefixMatchImpl(measurementsEntry);
+  name_tree::Entry* nte = m_nameTree.getEntry(measurementsEntry);
+  BOOST_ASSERT(nte != nullptr);
+  return this->findLongestPrefixMatchCached(*nte);
 }
 
 Entry*
@@ -97,6 +124,7 @@ Fib::insert(const Name& prefix)
 
   nte.setFibEntry(make_unique<Entry>(prefix));
   ++m_nItems;
+  m_version = name_tree::makeLookupCacheVersion();
   return {nte.getFibEntry(), true};
 }
 
@@ -110,6 +138,7 @@ Fib::erase(name_tree::Entry* nte, bool canDeleteNte)
     m_nameTree.eraseIfEmpty(nte);
   }
   --m_nItems;
+  m_version = name_tree::makeLookupCacheVersion();
 }
 
 void
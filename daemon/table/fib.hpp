@@ -157,6 +157,11 @@ private:
   const Entry&
   findLongestPrefixMatchImpl(const K& key) const;
 
+  /** \brief Longest prefix match of \p nte's name, served from the lookup cache of \p nte
+   */
+  const Entry&
+  findLongestPrefixMatchCached(name_tree::Entry& nte) const;
+
   void
   erase(name_tree::Entry* nte, bool canDeleteNte = true);
 
@@ -166,6 +171,8 @@ private:
 private:
   NameTree& m_nameTree;
   size_t m_nItems = 0;
+  /// changes whenever an entry is inserted or erased, invalidating cached lookups
+  uint64_t m_version;
 
   /** \brief The empty FIB entry.
    *
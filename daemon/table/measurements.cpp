@@ -113,7 +113,7 @@ Measurements::findLongestPrefixMatch(const Name& name, const EntryPredicate& pre
 Entry*
 Measurements::findLongestPrefixMatch(const pit::Entry& pitEntry, const EntryPredicate& pred) const
 {
-  return this->findLongestPrefixMatch(pitEntry.getName(), pred);
+  return this->findLongestPrefixMatchImpl(pitEntry, pred);
 }
 
 Entry*
@@ -26,9 +26,18 @@
 #include "name-tree-entry.hpp"
 #include "name-tree.hpp"
 
+#include <atomic>
+
 namespace nfd {
 namespace name_tree {
 
+uint64_t
+makeLookupCacheVersion()
+{
+  static std::atomic<uint64_t> lastVersion{0};
+  return ++lastVersion;
+}
+
 Entry::Entry(const Name& name, Node* node)
   : m_name(name)
   , m_node(node)
@@ -36,6 +36,27 @@ namespace name_tree {
 
 class Node;
 
+/** \brief The result of a longest prefix match, cached on the name tree entry it was computed for
+ *
+ *  A table that caches its lookups has a version number, which changes whenever one of its
+ *  entries is inserted or erased. A cached result is valid while its version equals the current
+ *  version of the table.
+ */
+template<typename ENTRY>
+struct LookupCache
+{
+  ENTRY* entry = nullptr;
+  uint64_t version = 0;
+};
+
+/** \brief Returns a new version number for a table that caches lookups in LookupCache
+ *
+ *  Version numbers are unique within the process and never zero, so that a result cached by
+ *  one table is not taken as valid by another table of the same type.
+ */
+uint64_t
+makeLookupCacheVersion();
+
 /** \brief An entry in the name tree
  */
 class Entry : noncopyable
@@ -151,6 +172,24 @@ public: // attached table entries
   void
   setStrategyChoiceEntry(unique_ptr<strategy_choice::Entry> strategyChoiceEntry);
 
+public: // cached lookups
+  /** \brief Longest prefix match of this entry's name in the FIB, managed by Fib
+   */
+  LookupCache<fib::Entry>&
+  getFibLookupCache()
+  {
+    return m_fibLookupCache;
+  }
+
+  /** \brief Longest prefix match of this entry's name in the StrategyChoice table,
+   *         managed by StrategyChoice
+   */
+  LookupCache<strategy_choice::Entry>&
+  getStrategyChoiceLookupCache()
+  {
+    return m_strategyChoiceLookupCache;
+  }
+
   /** \return name tree entry on which a table entry is attached,
    *          or nullptr if the table entry is detached
    *  \note This function is for NameTree internal use. Other components
@@ -174,6 +213,9 @@ private:
   unique_ptr<measurements::Entry> m_measurementsEntry;
   unique_ptr<strategy_choice::Entry> m_strategyChoiceEntry;
 
+  LookupCache<fib::Entry> m_fibLookupCache;
+  LookupCache<strategy_choice::Entry> m_strategyChoiceLookupCache;
+
   friend Node* getNode(const Entry& entry);
 };
 
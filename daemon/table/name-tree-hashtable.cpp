@@ -27,9 +27,17 @@
 #include "common/city-hash.hpp"
 #include "common/logger.hpp"
 
+#include <ndn-cxx/lp/tags.hpp>
+
 namespace nfd {
 namespace name_tree {
 
+constexpr int HashSequenceTag::TYPE_ID;
+
+static_assert(HashSequenceTag::TYPE_ID > lp::PrefixAnnouncementTag::getTypeId() &&
+              HashSequenceTag::TYPE_ID != lp::HopCountTag::getTypeId(),
+              "HashSequenceTag type ID collides with an ndn-cxx or ndnSIM packet tag");
+
 NFD_LOG_INIT(NameTreeHashtable);
 
 class Hash32
@@ -89,6 +97,32 @@ computeHashes(const Name& name, size_t prefixLen)
   return seq;
 }
 
+template<typename Packet>
+static const HashSequence&
+getHashesImpl(const Packet& packet)
+{
+  const Block& nameWire = packet.getName().wireEncode();
+  auto tag = packet.template getTag<HashSequenceTag>();
+  if (tag == nullptr || !tag->isValidFor(nameWire)) {
+    tag = make_shared<HashSequenceTag>(nameWire, computeHashes(packet.getName()));
+    packet.setTag(tag);
+  }
+  // the packet keeps the tag alive
+  return tag->hashes;
+}
+
+const HashSequence&
+getHashes(const Interest& interest)
+{
+  return getHashesImpl(interest);
+}
+
+const HashSequence&
+getHashes(const Data& data)
+{
+  return getHashesImpl(data);
+}
+
 Node::Node(HashValue h, const Name& name)
   : hash(h)
   , prev(nullptr)
@@ -109,12 +143,72 @@ getNode(const Entry& entry)
   return entry.m_node;
 }
 
+std::ostream&
+operator<<(std::ostream& os, HashtableMode mode)
+{
+  switch (mode) {
+    case HashtableMode::CHAINING:
+      return os << "chaining";
+    case HashtableMode::OPEN_ADDRESSING:
+      return os << "open-addressing";
+  }
+  return os << static_cast<int>(mode);
+}
+
 HashtableOptions::HashtableOptions(size_t size)
   : initialSize(size)
   , minSize(size)
 {
 }
 
+constexpr size_t NodeSlab::NODES_PER_SLAB;
+
+NodeSlab::~NodeSlab()
+{
+  for (Storage* slab : m_slabs) {
+    delete[] slab;
+  }
+}
+
+void*
+NodeSlab::allocate()
+{
+  if (m_freeList != nullptr) {
+    Storage* storage = m_freeList;
+    m_freeList = storage->nextFree;
+    return storage;
+  }
+
+  if (m_nUsedInLastSlab == NODES_PER_SLAB) {
+    // the slab is owned before push_back, which may throw when the vector grows
+    unique_ptr<Storage[]> slab(new Storage[NODES_PER_SLAB]);
+    m_slabs.push_back(slab.get());
+    slab.release();
+    m_nUsedInLastSlab = 0;
+  }
+  return &m_slabs.back()[m_nUsedInLastSlab++];
+}
+
+void
+NodeSlab::deallocate(void* p) noexcept
+{
+  auto storage = static_cast<Storage*>(p);
+  storage->nextFree = m_freeList;
+  m_freeList = storage;
+}
+
+/** \return smallest power of two that is not less than n
+ */
+static size_t
+roundUpToPowerOfTwo(size_t n)
+{
+  size_t p = 1;
+  while (p < n) {
+    p <<= 1;
+  }
+  return p;
+}
+
 Hashtable::Hashtable(const Options& options)
   : m_options(options)
   , m_size(0)
@@ -129,7 +223,15 @@ Hashtable::Hashtable(const Options& options)
   BOOST_ASSERT(m_options.shrinkFactor > 0.0);
   BOOST_ASSERT(m_options.shrinkFactor < 1.0);
 
-  m_buckets.resize(options.initialSize);
+  switch (m_options.mode) {
+    case HashtableMode::CHAINING:
+      m_buckets.resize(options.initialSize);
+      break;
+    case HashtableMode::OPEN_ADDRESSING:
+      m_options.minSize = roundUpToPowerOfTwo(m_options.minSize);
+      m_slots.resize(roundUpToPowerOfTwo(options.initialSize), Slot{0, nullptr});
+      break;
+  }
   this->computeThresholds();
 }
 
@@ -141,6 +243,43 @@ Hashtable::~Hashtable()
       delete node;
     });
   }
+
+  foreachNode(m_head, [this] (Node* node) {
+    node->prev = node->next = nullptr;
+    node->~Node();
+    m_slab.deallocate(node);
+  });
+}
+
+const Node*
+Hashtable::getFirst() const
+{
+  if (m_options.mode == HashtableMode::OPEN_ADDRESSING) {
+    return m_head;
+  }
+
+  for (const Node* head : m_buckets) {
+    if (head != nullptr) {
+      return head;
+    }
+  }
+  return nullptr;
+}
+
+const Node*
+Hashtable::getNext(const Node* node) const
+{
+  BOOST_ASSERT(node != nullptr);
+  if (node->next != nullptr || m_options.mode == HashtableMode::OPEN_ADDRESSING) {
+    return node->next;
+  }
+
+  for (size_t bucket = this->computeBucketIndex(node->hash) + 1; bucket < m_buckets.size(); ++bucket) {
+    if (m_buckets[bucket] != nullptr) {
+      return m_buckets[bucket];
+    }
+  }
+  return nullptr;
 }
 
 void
@@ -180,6 +319,10 @@ Hashtable::detach(size_t bucket, Node* node)
 std::pair<const Node*, bool>
 Hashtable::findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool allowInsert)
 {
+  if (m_options.mode == HashtableMode::OPEN_ADDRESSING) {
+    return this->findOrInsertOpen(name, prefixLen, h, allowInsert);
+  }
+
   size_t bucket = this->computeBucketIndex(h);
 
   for (const Node* node = m_buckets[bucket]; node != nullptr; node = node->next) {
@@ -206,6 +349,100 @@ Hashtable::findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool al
   return {node, true};
 }
 
+std::pair<const Node*, bool>
+Hashtable::findOrInsertOpen(const Name& name, size_t prefixLen, HashValue h, bool allowInsert)
+{
+  const size_t mask = m_slots.size() - 1;
+  size_t slot = this->computeBucketIndex(h);
+
+  // Robin Hood invariant: along a probe sequence, probe distances never decrease by more than one,
+  // so the search stops at the first slot whose node is closer to its home than the sought node
+  for (size_t dist = 0; m_slots[slot].node != nullptr; ++dist, slot = (slot + 1) & mask) {
+    const Slot& s = m_slots[slot];
+    if (s.hash == h && name.compare(0, prefixLen, s.node->entry.getName()) == 0) {
+      NFD_LOG_TRACE("found " << name.getPrefix(prefixLen) << " hash=" << h << " slot=" << slot);
+      return {s.node, false};
+    }
+    if (this->getProbeDistance(s.hash, slot) < dist) {
+      break;
+    }
+  }
+
+  if (!allowInsert) {
+    NFD_LOG_TRACE("not-found " << name.getPrefix(prefixLen) << " hash=" << h << " slot=" << slot);
+    return {nullptr, false};
+  }
+
+  // expand before placing the node, so that the slot array never becomes full
+  if (m_size + 1 > m_expandThreshold) {
+    this->resize(static_cast<size_t>(m_options.expandFactor * this->getNBuckets()));
+  }
+
+  Node* node = new (m_slab.allocate()) Node(h, name.getPrefix(prefixLen));
+  node->next = m_head;
+  if (m_head != nullptr) {
+    m_head->prev = node;
+  }
+  m_head = node;
+
+  this->placeOpen(node);
+  NFD_LOG_TRACE("insert " << node->entry.getName() << " hash=" << h);
+  ++m_size;
+
+  return {node, true};
+}
+
+void
+Hashtable::placeOpen(Node* node)
+{
+  const size_t mask = m_slots.size() - 1;
+  Slot incoming{node->hash, node};
+  size_t slot = this->computeBucketIndex(incoming.hash);
+
+  for (size_t dist = 0; m_slots[slot].node != nullptr; ++dist, slot = (slot + 1) & mask) {
+    size_t existingDist = this->getProbeDistance(m_slots[slot].hash, slot);
+    if (existingDist < dist) {
+      std::swap(incoming, m_slots[slot]);
+      dist = existingDist;
+    }
+  }
+  m_slots[slot] = incoming;
+}
+
+void
+Hashtable::eraseOpen(Node* node)
+{
+  const size_t mask = m_slots.size() - 1;
+  size_t slot = this->computeBucketIndex(node->hash);
+  while (m_slots[slot].node != node) {
+    BOOST_ASSERT(m_slots[slot].node != nullptr);
+    slot = (slot + 1) & mask;
+  }
+
+  // backward shift deletion: move the following nodes one slot closer to their homes
+  for (size_t next = (slot + 1) & mask;
+       m_slots[next].node != nullptr && this->getProbeDistance(m_slots[next].hash, next) > 0;
+       slot = next, next = (next + 1) & mask) {
+    m_slots[slot] = m_slots[next];
+  }
+  m_slots[slot] = Slot{0, nullptr};
+
+  if (node->prev != nullptr) {
+    node->prev->next = node->next;
+  }
+  else {
+    BOOST_ASSERT(m_head == node);
+    m_head = node->next;
+  }
+  if (node->next != nullptr) {
+    node->next->prev = node->prev;
+  }
+  node->prev = node->next = nullptr;
+
+  node->~Node();
+  m_slab.deallocate(node);
+}
+
 const Node*
 Hashtable::find(const Name& name, size_t prefixLen) const
 {
@@ -236,8 +473,13 @@ Hashtable::erase(Node* node)
   size_t bucket = this->computeBucketIndex(node->hash);
   NFD_LOG_TRACE("erase " << node->entry.getName() << " hash=" << node->hash << " bucket=" << bucket);
 
-  this->detach(bucket, node);
-  delete node;
+  if (m_options.mode == HashtableMode::OPEN_ADDRESSING) {
+    this->eraseOpen(node);
+  }
+  else {
+    this->detach(bucket, node);
+    delete node;
+  }
   --m_size;
 
   if (m_size < m_shrinkThreshold) {
@@ -252,17 +494,32 @@ Hashtable::computeThresholds()
 {
   m_expandThreshold = static_cast<size_t>(m_options.expandLoadFactor * this->getNBuckets());
   m_shrinkThreshold = static_cast<size_t>(m_options.shrinkLoadFactor * this->getNBuckets());
+  if (m_options.mode == HashtableMode::OPEN_ADDRESSING) {
+    // at least one slot must remain empty to terminate probing
+    m_expandThreshold = std::min(m_expandThreshold, this->getNBuckets() - 1);
+  }
   NFD_LOG_TRACE("thresholds expand=" << m_expandThreshold << " shrink=" << m_shrinkThreshold);
 }
 
 void
 Hashtable::resize(size_t newNBuckets)
 {
+  if (m_options.mode == HashtableMode::OPEN_ADDRESSING) {
+    newNBuckets = roundUpToPowerOfTwo(std::max(newNBuckets, m_size + 2));
+  }
   if (this->getNBuckets() == newNBuckets) {
     return;
   }
   NFD_LOG_DEBUG("resize from=" << this->getNBuckets() << " to=" << newNBuckets);
 
+  if (m_options.mode == HashtableMode::OPEN_ADDRESSING) {
+    // nodes stay in place, only the slots are rebuilt
+    m_slots.assign(newNBuckets, Slot{0, nullptr});
+    foreachNode(m_head, [this] (Node* node) { this->placeOpen(node); });
+    this->computeThresholds();
+    return;
+  }
+
   std::vector<Node*> oldBuckets;
   oldBuckets.swap(m_buckets);
   m_buckets.resize(newNBuckets);
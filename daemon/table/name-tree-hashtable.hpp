@@ -53,10 +53,75 @@ computeHash(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::ma
 HashSequence
 computeHashes(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::max());
 
+/** \brief a packet tag that caches the hash sequence of the packet name
+ *  \sa getHashes
+ */
+class HashSequenceTag : public ndn::Tag
+{
+public:
+  /** \brief packet tag type ID of HashSequenceTag
+   *
+   *  ndn-cxx numbers its link-protocol tags from 10 upward (IncomingFaceIdTag and onward in
+   *  ndn-cxx/lp/tags.hpp), and ndnSIM numbers its tags from 0x60000000 upward (HopCountTag,
+   *  GeoTag). This ID is taken from the 0x70000000 range, which neither of them uses, and is
+   *  reserved here for packet tags that are private to NFD.
+   */
+  static constexpr int TYPE_ID = 0x70000001;
+
+  static constexpr int
+  getTypeId()
+  {
+    return TYPE_ID;
+  }
+
+  HashSequenceTag(const Block& nameWire, HashSequence hashes)
+    : buffer(nameWire.getBuffer())
+    , wire(nameWire.wire())
+    , wireSize(nameWire.size())
+    , hashes(std::move(hashes))
+  {
+  }
+
+  /** \return whether the hash sequence was computed from \p nameWire
+   */
+  bool
+  isValidFor(const Block& nameWire) const
+  {
+    return nameWire.wire() == wire && nameWire.size() == wireSize;
+  }
+
+public:
+  /** \brief keeps the encoding of the name alive, so that its address identifies the name
+   */
+  ndn::ConstBufferPtr buffer;
+  const uint8_t* wire;
+  size_t wireSize;
+  HashSequence hashes;
+};
+
+/** \brief returns hash values for each prefix of the name of \p interest
+ *  \return a hash sequence, where the i-th hash value equals computeHash(interest.getName(), i)
+ *
+ *  The hash sequence is computed on first use, and cached in a HashSequenceTag on the packet,
+ *  so that all tables looking up the same packet during one pipeline pass share it.
+ *  It is recomputed if the name of the packet has changed.
+ */
+const HashSequence&
+getHashes(const Interest& interest);
+
+/** \brief returns hash values for each prefix of the name of \p data
+ *  \return a hash sequence, where the i-th hash value equals computeHash(data.getName(), i)
+ *  \sa getHashes(const Interest&)
+ */
+const HashSequence&
+getHashes(const Data& data);
+
 /** \brief a hashtable node
  *
- *  Zero or more nodes can be added to a hashtable bucket. They are organized as
- *  a doubly linked list through prev and next pointers.
+ *  In a chaining Hashtable, zero or more nodes can be added to a hashtable bucket.
+ *  They are organized as a doubly linked list through prev and next pointers.
+ *  In an open addressing Hashtable, all nodes are organized as one doubly linked list
+ *  for enumeration.
  */
 class Node : noncopyable
 {
@@ -101,6 +166,22 @@ foreachNode(N* head, const F& func)
   }
 }
 
+/** \brief collision resolution scheme of Hashtable
+ */
+enum class HashtableMode {
+  /** \brief each bucket is a doubly linked list of heap-allocated nodes
+   */
+  CHAINING,
+
+  /** \brief buckets are slots of an open addressing table with Robin Hood probing;
+   *         each slot holds the hash value and a pointer to a node allocated from a slab
+   */
+  OPEN_ADDRESSING,
+};
+
+std::ostream&
+operator<<(std::ostream& os, HashtableMode mode);
+
 /** \brief provides options for Hashtable
  */
 class HashtableOptions
@@ -137,13 +218,58 @@ public:
   /** \brief when hashtable is shrunk, its new size is max(nBuckets*shrinkFactor, minSize)
    */
   float shrinkFactor = 0.5;
+
+  /** \brief collision resolution scheme
+   *
+   *  With OPEN_ADDRESSING, the number of buckets is rounded up to a power of two,
+   *  and the load factor is kept below 1 regardless of expandLoadFactor.
+   */
+  HashtableMode mode = HashtableMode::CHAINING;
+};
+
+/** \brief allocates Nodes in fixed-size slabs
+ *
+ *  Freed nodes are kept in a free list and reused before a new slab is allocated,
+ *  so that nodes are packed densely and allocation does not go through the global heap.
+ */
+class NodeSlab : noncopyable
+{
+public:
+  ~NodeSlab();
+
+  /** \return storage for one Node
+   */
+  void*
+  allocate();
+
+  /** \brief returns storage of a destroyed Node
+   */
+  void
+  deallocate(void* p) noexcept;
+
+public:
+  static constexpr size_t NODES_PER_SLAB = 256;
+
+private:
+  union Storage
+  {
+    Storage* nextFree;
+    std::aligned_storage_t<sizeof(Node), alignof(Node)> node;
+  };
+
+  std::vector<Storage*> m_slabs;
+  Storage* m_freeList = nullptr;
+  size_t m_nUsedInLastSlab = NODES_PER_SLAB;
 };
 
 /** \brief a hashtable for fast exact name lookup
  *
  *  The Hashtable contains a number of buckets.
  *  Each node is placed into a bucket determined by a hash value computed from its name.
- *  Hash collision is resolved through a doubly linked list in each bucket.
+ *  Hash collision is resolved according to HashtableOptions::mode: either through a doubly
+ *  linked list in each bucket, or by open addressing with Robin Hood probing. In the latter,
+ *  a bucket holds at most one node, and hash values are stored inline, so that a lookup only
+ *  dereferences a node whose hash value matches.
  *  The number of buckets is adjusted according to how many nodes are stored.
  */
 class Hashtable
@@ -166,20 +292,26 @@ public:
     return m_size;
   }
 
+  HashtableMode
+  getMode() const
+  {
+    return m_options.mode;
+  }
+
   /** \return number of buckets
    */
   size_t
   getNBuckets() const
   {
-    return m_buckets.size();
+    return m_options.mode == HashtableMode::CHAINING ? m_buckets.size() : m_slots.size();
   }
 
-  /** \return bucket index for hash value h
+  /** \return home bucket index for hash value h
    */
   size_t
   computeBucketIndex(HashValue h) const
   {
-    return h % this->getNBuckets();
+    return m_options.mode == HashtableMode::CHAINING ? h % m_buckets.size() : h & (m_slots.size() - 1);
   }
 
   /** \return i-th bucket
@@ -189,9 +321,23 @@ public:
   getBucket(size_t bucket) const
   {
     BOOST_ASSERT(bucket < this->getNBuckets());
-    return m_buckets[bucket]; // don't use m_bucket.at() for better performance
+    // don't use .at() for better performance
+    return m_options.mode == HashtableMode::CHAINING ? m_buckets[bucket] : m_slots[bucket].node;
   }
 
+  /** \return first node in enumeration order, or nullptr if the hashtable is empty
+   */
+  const Node*
+  getFirst() const;
+
+  /** \return node after \p node in enumeration order, or nullptr if \p node is the last
+   *
+   *  Nodes inserted during an enumeration may or may not be visited.
+   *  Erasing a node other than \p node does not affect the enumeration.
+   */
+  const Node*
+  getNext(const Node* node) const;
+
   /** \brief find node for name.getPrefix(prefixLen)
    *  \pre name.size() > prefixLen
    */
@@ -232,6 +378,23 @@ private:
   std::pair<const Node*, bool>
   findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool allowInsert);
 
+  std::pair<const Node*, bool>
+  findOrInsertOpen(const Name& name, size_t prefixLen, HashValue h, bool allowInsert);
+
+  void
+  eraseOpen(Node* node);
+
+  /** \brief places \p node into the open addressing table, displacing nodes closer to home
+   */
+  void
+  placeOpen(Node* node);
+
+  size_t
+  getProbeDistance(HashValue h, size_t slot) const
+  {
+    return (slot - computeBucketIndex(h)) & (m_slots.size() - 1);
+  }
+
   void
   computeThresholds();
 
@@ -239,7 +402,18 @@ private:
   resize(size_t newNBuckets);
 
 private:
-  std::vector<Node*> m_buckets;
+  /** \brief a bucket of the open addressing table
+   */
+  struct Slot
+  {
+    HashValue hash;
+    Node* node; ///< nullptr if the slot is empty
+  };
+
+  std::vector<Node*> m_buckets; ///< used with CHAINING
+  std::vector<Slot> m_slots;    ///< used with OPEN_ADDRESSING
+  Node* m_head = nullptr;       ///< list of all nodes, used with OPEN_ADDRESSING
+  NodeSlab m_slab;              ///< node storage, used with OPEN_ADDRESSING
   Options m_options;
   size_t m_size;
   size_t m_expandThreshold;
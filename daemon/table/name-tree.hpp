@@ -39,6 +39,11 @@ public:
   explicit
   NameTree(size_t nBuckets = 1024);
 
+  /** \brief constructs a NameTree whose hashtable is configured by \p options
+   */
+  explicit
+  NameTree(const HashtableOptions& options);
+
 public: // information
   /** \brief Maximum depth of the name tree
    *
@@ -92,6 +97,13 @@ public: // mutation
   Entry&
   lookup(const Name& name, size_t prefixLen);
 
+  /** \brief Equivalent to `lookup(name, prefixLen)`, with precomputed hash values
+   *  \pre hashes[i] == computeHash(name, i) for every i <= prefixLen,
+   *       e.g. \p hashes is computeHashes(name) or getHashes(packet)
+   */
+  Entry&
+  lookup(const Name& name, size_t prefixLen, const HashSequence& hashes);
+
   /** \brief Equivalent to `lookup(name, name.size())`
    */
   Entry&
@@ -148,6 +160,12 @@ public: // matching
   Entry*
   findExactMatch(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::max()) const;
 
+  /** \brief Equivalent to `findExactMatch(name, prefixLen)`, with precomputed hash values
+   *  \pre hashes[i] == computeHash(name, i) for every i <= min(prefixLen, name.size())
+   */
+  Entry*
+  findExactMatch(const Name& name, size_t prefixLen, const HashSequence& hashes) const;
+
   /** \brief Longest prefix matching
    *  \return entry whose name is a prefix of \p name and passes \p entrySelector,
    *          where no other entry with a longer name satisfies those requirements;
@@ -157,6 +175,13 @@ public: // matching
   findLongestPrefixMatch(const Name& name,
                          const EntrySelector& entrySelector = AnyEntry()) const;
 
+  /** \brief Equivalent to `findLongestPrefixMatch(name, entrySelector)`, with precomputed hash values
+   *  \pre hashes[i] == computeHash(name, i) for every i <= min(name.size(), getMaxDepth())
+   */
+  Entry*
+  findLongestPrefixMatch(const Name& name, const HashSequence& hashes,
+                         const EntrySelector& entrySelector = AnyEntry()) const;
+
   /** \brief Equivalent to `findLongestPrefixMatch(entry.getName(), entrySelector)`
    *  \note This overload is more efficient than
    *        `findLongestPrefixMatch(const Name&, const EntrySelector&)` in common cases.
@@ -213,6 +238,13 @@ public: // matching
   findAllMatches(const Name& name,
                  const EntrySelector& entrySelector = AnyEntry()) const;
 
+  /** \brief Equivalent to `findAllMatches(name, entrySelector)`, with precomputed hash values
+   *  \pre hashes[i] == computeHash(name, i) for every i <= min(name.size(), getMaxDepth())
+   */
+  Range
+  findAllMatches(const Name& name, const HashSequence& hashes,
+                 const EntrySelector& entrySelector = AnyEntry()) const;
+
 public: // enumeration
   using const_iterator = Iterator;
 
@@ -63,11 +63,21 @@ Entry::insertOrUpdateInRecord(Face& face, const Interest& interest)
   auto it = std::find_if(m_inRecords.begin(), m_inRecords.end(),
     [&face] (const InRecord& inRecord) { return &inRecord.getFace() == &face; });
   if (it == m_inRecords.end()) {
-    m_inRecords.emplace_front(face);
-    it = m_inRecords.begin();
+    it = m_inRecords.emplace_back(face);
   }
 
+  auto oldExpiry = it->getExpiry();
   it->update(interest);
+
+  if (!m_isLastInRecordExpiryStale) {
+    if (it->getExpiry() >= m_lastInRecordExpiry) {
+      m_lastInRecordExpiry = it->getExpiry();
+    }
+    else if (oldExpiry == m_lastInRecordExpiry) {
+      // the last expiring in-record was shortened
+      m_isLastInRecordExpiryStale = true;
+    }
+  }
   return it;
 }
 
@@ -77,6 +87,9 @@ Entry::deleteInRecord(const Face& face)
   auto it = std::find_if(m_inRecords.begin(), m_inRecords.end(),
     [&face] (const InRecord& inRecord) { return &inRecord.getFace() == &face; });
   if (it != m_inRecords.end()) {
+    if (it->getExpiry() == m_lastInRecordExpiry) {
+      m_isLastInRecordExpiryStale = true;
+    }
     m_inRecords.erase(it);
   }
 }
@@ -85,6 +98,21 @@ void
 Entry::clearInRecords()
 {
   m_inRecords.clear();
+  m_lastInRecordExpiry = time::steady_clock::TimePoint::min();
+  m_isLastInRecordExpiryStale = false;
+}
+
+time::steady_clock::TimePoint
+Entry::getLastInRecordExpiry() const
+{
+  if (m_isLastInRecordExpiryStale) {
+    m_lastInRecordExpiry = time::steady_clock::TimePoint::min();
+    for (const auto& inRecord : m_inRecords) {
+      m_lastInRecordExpiry = std::max(m_lastInRecordExpiry, inRecord.getExpiry());
+    }
+    m_isLastInRecordExpiryStale = false;
+  }
+  return m_lastInRecordExpiry;
 }
 
 OutRecordCollection::iterator
@@ -102,8 +130,7 @@ Entry::insertOrUpdateOutRecord(Face& face, const Interest& interest)
   auto it = std::find_if(m_outRecords.begin(), m_outRecords.end(),
     [&face] (const OutRecord& outRecord) { return &outRecord.getFace() == &face; });
   if (it == m_outRecords.end()) {
-    m_outRecords.emplace_front(face);
-    it = m_outRecords.begin();
+    it = m_outRecords.emplace_back(face);
   }
 
   it->update(interest);
@@ -28,8 +28,7 @@
 
 #include "pit-in-record.hpp"
 #include "pit-out-record.hpp"
-
-#include <list>
+#include "pit-record-collection.hpp"
 
 namespace nfd {
 
@@ -40,12 +39,16 @@ class Entry;
 namespace pit {
 
 /** \brief An unordered collection of in-records
+ *
+ *  Most Interests arrive from a single downstream, so one in-record is stored inline.
  */
-typedef std::list<InRecord> InRecordCollection;
+typedef RecordCollection<InRecord, 1> InRecordCollection;
 
 /** \brief An unordered collection of out-records
+ *
+ *  Two out-records are stored inline, to cover retries and probing on a second upstream.
  */
-typedef std::list<OutRecord> OutRecordCollection;
+typedef RecordCollection<OutRecord, 2> OutRecordCollection;
 
 /** \brief An Interest table entry
  *
@@ -54,6 +57,8 @@ typedef std::list<OutRecord> OutRecordCollection;
  *  and two timers used in forwarding pipelines.
  *  In addition, the entry, in-records, and out-records are subclasses of StrategyInfoHost,
  *  which allows forwarding strategy to store arbitrary information on them.
+ *  \warning Inserting or deleting an in-record (out-record) invalidates iterators, pointers,
+ *           and references to all in-records (out-records) of the entry.
  */
 class Entry : public StrategyInfoHost, noncopyable
 {
@@ -153,6 +158,14 @@ public: // in-record
   void
   clearInRecords();
 
+  /** \return the time point at which the last in-record expires,
+   *          or TimePoint::min() if there is no in-record
+   *
+   *  This is maintained incrementally as in-records are inserted, updated, and deleted.
+   */
+  time::steady_clock::TimePoint
+  getLastInRecordExpiry() const;
+
 public: // out-record
   /** \return collection of in-records
    */
@@ -216,12 +229,6 @@ public: // out-record
   deleteOutRecord(const Face& face);
 
 public:
-  /** \brief Expiry timer
-   *
-   *  This timer is used in forwarding pipelines to delete the entry
-   */
-  scheduler::EventId expiryTimer;
-
   /** \brief Indicates whether this PIT entry is satisfied
    */
   bool isSatisfied = false;
@@ -235,10 +242,19 @@ private:
   shared_ptr<const Interest> m_interest;
   InRecordCollection m_inRecords;
   OutRecordCollection m_outRecords;
+  mutable time::steady_clock::TimePoint m_lastInRecordExpiry = time::steady_clock::TimePoint::min();
+  mutable bool m_isLastInRecordExpiryStale = false;
 
   name_tree::Entry* m_nameTreeEntry = nullptr;
 
+  // expiry timer, managed by ExpiryWheel
+  Entry* m_expiryPrev = nullptr;
+  Entry* m_expiryNext = nullptr;
+  uint64_t m_expiryTick = 0;
+  int16_t m_expiryList = -1;
+
   friend class name_tree::Entry;
+  friend class ExpiryWheel;
 };
 
 } // namespace pit
@@ -0,0 +1,276 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pit-expiry-wheel.hpp"
+#include "pit-entry.hpp"
+#include "common/global.hpp"
+
+namespace nfd {
+namespace pit {
+
+constexpr time::milliseconds ExpiryWheel::TICK;
+constexpr size_t ExpiryWheel::N_SLOTS;
+constexpr size_t ExpiryWheel::N_LEVELS;
+constexpr size_t ExpiryWheel::OVERFLOW_LIST;
+constexpr size_t ExpiryWheel::DUE_LIST;
+
+/** \return index of the first set bit at or after \p from, or N_SLOTS if there is none
+ */
+template<size_t N>
+static size_t
+findNextSet(const std::array<uint64_t, N>& bitmap, size_t from)
+{
+  for (size_t word = from / 64; word < N; ++word) {
+    uint64_t bits = bitmap[word];
+    if (word == from / 64) {
+      bits &= ~uint64_t(0) << (from % 64);
+    }
+    if (bits != 0) {
+      return word * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+    }
+  }
+  return N * 64;
+}
+
+ExpiryWheel::ExpiryWheel(ExpiryCallback expire)
+  : m_expire(std::move(expire))
+  , m_origin(time::steady_clock::now())
+{
+}
+
+ExpiryWheel::~ExpiryWheel()
+{
+  for (size_t list = 0; list < N_LISTS; ++list) {
+    while (m_lists[list] != nullptr) {
+      unlink(*m_lists[list]);
+    }
+  }
+}
+
+bool
+ExpiryWheel::isScheduled(const Entry& entry)
+{
+  return entry.m_expiryList != NOT_SCHEDULED;
+}
+
+void
+ExpiryWheel::schedule(Entry& entry, time::milliseconds duration)
+{
+  // rounding up the current time ensures that the entry does not expire early
+  auto elapsed = time::steady_clock::now() - m_origin;
+  Tick now = static_cast<Tick>(elapsed / TICK);
+  Tick nowRoundedUp = now + (elapsed % TICK != elapsed.zero());
+  advance(now);
+
+  if (isScheduled(entry)) {
+    unlink(entry);
+  }
+
+  if (duration <= time::milliseconds::zero()) {
+    entry.m_expiryTick = m_now; // expire on the next poll
+  }
+  else {
+    entry.m_expiryTick = nowRoundedUp + static_cast<Tick>(duration / TICK);
+  }
+  place(entry);
+  arm();
+}
+
+void
+ExpiryWheel::cancel(Entry& entry)
+{
+  if (isScheduled(entry)) {
+    unlink(entry);
+  }
+}
+
+ExpiryWheel::Tick
+ExpiryWheel::getCurrentTick() const
+{
+  return static_cast<Tick>((time::steady_clock::now() - m_origin) / TICK);
+}
+
+void
+ExpiryWheel::place(Entry& entry)
+{
+  Tick due = entry.m_expiryTick;
+  if (due <= m_now) {
+    link(entry, DUE_LIST);
+    return;
+  }
+
+  // the level is given by the most significant slot index that differs from the current tick
+  Tick diff = due ^ m_now;
+  for (size_t level = 0; level < N_LEVELS; ++level) {
+    if ((diff >> (SLOT_BITS * (level + 1))) == 0) {
+      size_t slot = (due >> (SLOT_BITS * level)) & (N_SLOTS - 1);
+      link(entry, level * N_SLOTS + slot);
+      return;
+    }
+  }
+  link(entry, OVERFLOW_LIST);
+}
+
+void
+ExpiryWheel::link(Entry& entry, size_t list)
+{
+  BOOST_ASSERT(!isScheduled(entry));
+  entry.m_expiryList = static_cast<int16_t>(list);
+  entry.m_expiryPrev = nullptr;
+  entry.m_expiryNext = m_lists[list];
+  if (m_lists[list] != nullptr) {
+    m_lists[list]->m_expiryPrev = &entry;
+  }
+  else if (list < OVERFLOW_LIST) {
+    m_occupied[list / N_SLOTS][(list % N_SLOTS) / 64] |= uint64_t(1) << (list % 64);
+  }
+  m_lists[list] = &entry;
+  ++m_size;
+}
+
+void
+ExpiryWheel::unlink(Entry& entry)
+{
+  BOOST_ASSERT(isScheduled(entry));
+  size_t list = static_cast<size_t>(entry.m_expiryList);
+  if (entry.m_expiryPrev != nullptr) {
+    entry.m_expiryPrev->m_expiryNext = entry.m_expiryNext;
+  }
+  else {
+    BOOST_ASSERT(m_lists[list] == &entry);
+    m_lists[list] = entry.m_expiryNext;
+    if (m_lists[list] == nullptr && list < OVERFLOW_LIST) {
+      m_occupied[list / N_SLOTS][(list % N_SLOTS) / 64] &= ~(uint64_t(1) << (list % 64));
+    }
+  }
+  if (entry.m_expiryNext != nullptr) {
+    entry.m_expiryNext->m_expiryPrev = entry.m_expiryPrev;
+  }
+  entry.m_expiryPrev = entry.m_expiryNext = nullptr;
+  entry.m_expiryList = NOT_SCHEDULED;
+  --m_size;
+}
+
+void
+ExpiryWheel::replaceList(size_t list)
+{
+  Entry* entry = m_lists[list];
+  while (entry != nullptr) {
+    Entry* next = entry->m_expiryNext;
+    unlink(*entry);
+    place(*entry);
+    entry = next;
+  }
+}
+
+optional<ExpiryWheel::Tick>
+ExpiryWheel::findNextTick() const
+{
+  // entries on a lower level are always due before those on a higher level
+  for (size_t level = 0; level < N_LEVELS; ++level) {
+    size_t shift = SLOT_BITS * level;
+    size_t current = (m_now >> shift) & (N_SLOTS - 1);
+    size_t slot = findNextSet(m_occupied[level], current + 1);
+    if (slot < N_SLOTS) {
+      Tick base = (m_now >> (shift + SLOT_BITS)) << (shift + SLOT_BITS);
+      return base + (static_cast<Tick>(slot) << shift);
+    }
+  }
+
+  if (m_lists[OVERFLOW_LIST] != nullptr) {
+    constexpr size_t shift = SLOT_BITS * N_LEVELS;
+    return ((m_now >> shift) + 1) << shift;
+  }
+  return nullopt;
+}
+
+void
+ExpiryWheel::advance(Tick target)
+{
+  while (m_now < target) {
+    auto next = findNextTick();
+    if (!next || *next > target) {
+      m_now = target;
+      return;
+    }
+    m_now = *next;
+
+    // cascade from the highest level whose slot boundary has been reached
+    if ((m_now & ((Tick(1) << (SLOT_BITS * N_LEVELS)) - 1)) == 0) {
+      replaceList(OVERFLOW_LIST);
+    }
+    for (size_t level = N_LEVELS - 1; level > 0; --level) {
+      size_t shift = SLOT_BITS * level;
+      if ((m_now & ((Tick(1) << shift) - 1)) == 0) {
+        replaceList(level * N_SLOTS + ((m_now >> shift) & (N_SLOTS - 1)));
+      }
+    }
+    replaceList(m_now & (N_SLOTS - 1));
+  }
+}
+
+void
+ExpiryWheel::arm()
+{
+  optional<Tick> tick;
+  if (m_lists[DUE_LIST] != nullptr) {
+    tick = m_now;
+  }
+  else {
+    tick = findNextTick();
+  }
+
+  if (!tick) {
+    m_timer.cancel();
+    m_timerTick = nullopt;
+    return;
+  }
+  if (m_timerTick && *m_timerTick <= *tick) {
+    return;
+  }
+
+  auto delay = m_origin + static_cast<time::milliseconds::rep>(*tick) * TICK - time::steady_clock::now();
+  m_timerTick = tick;
+  m_timer = getScheduler().schedule(std::max(delay, time::nanoseconds::zero()), [this] { onTimer(); });
+}
+
+void
+ExpiryWheel::onTimer()
+{
+  m_timerTick = nullopt;
+  advance(getCurrentTick());
+
+  // the callback may schedule or cancel other entries, including those in the due list
+  while (m_lists[DUE_LIST] != nullptr) {
+    Entry& entry = *m_lists[DUE_LIST];
+    unlink(entry);
+    m_expire(entry);
+  }
+
+  arm();
+}
+
+} // namespace pit
+} // namespace nfd
@@ -0,0 +1,154 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_PIT_EXPIRY_WHEEL_HPP
+#define NFD_DAEMON_TABLE_PIT_EXPIRY_WHEEL_HPP
+
+#include "core/common.hpp"
+
+#include <array>
+
+namespace nfd {
+namespace pit {
+
+class Entry;
+
+/** \brief A hierarchical timing wheel that tracks expiry timers of PIT entries
+ *
+ *  The wheel has four levels of 256 slots each. A slot on level L covers 256^L ticks of TICK.
+ *  Each slot is an intrusive doubly linked list threaded through the PIT entries, so that
+ *  setting, cancelling, and resetting a timer take constant time and no allocation.
+ *  When the current time reaches a slot on a higher level, its entries are cascaded into
+ *  lower levels. Timers farther than 256^4 ticks away are kept in an overflow list.
+ *
+ *  A single scheduler event is kept at the earliest tick that needs processing. When it fires,
+ *  all entries due by the current tick are expired in one batch.
+ */
+class ExpiryWheel : noncopyable
+{
+public:
+  using ExpiryCallback = std::function<void(Entry&)>;
+
+  /** \param expire invoked when the timer of an entry expires; the entry is no longer scheduled
+   */
+  explicit
+  ExpiryWheel(ExpiryCallback expire);
+
+  /** \brief cancels all timers
+   */
+  ~ExpiryWheel();
+
+  /** \brief sets the timer of \p entry to expire after \p duration, replacing any existing timer
+   *
+   *  Expiry is rounded up to a whole TICK, so a timer never fires early.
+   */
+  void
+  schedule(Entry& entry, time::milliseconds duration);
+
+  /** \brief cancels the timer of \p entry, if any
+   */
+  void
+  cancel(Entry& entry);
+
+  /** \return whether \p entry has a timer in this wheel
+   */
+  static bool
+  isScheduled(const Entry& entry);
+
+  /** \return number of scheduled entries
+   */
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+public:
+  static constexpr time::milliseconds TICK = time::milliseconds(1);
+
+private:
+  using Tick = uint64_t;
+
+  static constexpr size_t SLOT_BITS = 8;
+  static constexpr size_t N_SLOTS = size_t(1) << SLOT_BITS;
+  static constexpr size_t N_LEVELS = 4;
+  static constexpr size_t OVERFLOW_LIST = N_LEVELS * N_SLOTS;
+  static constexpr size_t DUE_LIST = OVERFLOW_LIST + 1;
+  static constexpr size_t N_LISTS = DUE_LIST + 1;
+  static constexpr int16_t NOT_SCHEDULED = -1;
+
+  Tick
+  getCurrentTick() const;
+
+  /** \brief inserts \p entry into the list determined by its expiry tick and m_now
+   */
+  void
+  place(Entry& entry);
+
+  void
+  link(Entry& entry, size_t list);
+
+  void
+  unlink(Entry& entry);
+
+  /** \brief moves all entries of \p list to the lists determined by m_now
+   */
+  void
+  replaceList(size_t list);
+
+  /** \return the earliest tick after m_now at which a non-empty list must be processed,
+   *          or nullopt if the wheel holds no entries other than those in the due list
+   */
+  optional<Tick>
+  findNextTick() const;
+
+  /** \brief advances m_now to \p target, moving entries due by then into the due list
+   */
+  void
+  advance(Tick target);
+
+  /** \brief ensures the scheduler event fires no later than needed
+   */
+  void
+  arm();
+
+  void
+  onTimer();
+
+private:
+  ExpiryCallback m_expire;
+  time::steady_clock::TimePoint m_origin;
+  Tick m_now = 0;
+  size_t m_size = 0;
+  std::array<Entry*, N_LISTS> m_lists{};
+  std::array<std::array<uint64_t, N_SLOTS / 64>, N_LEVELS> m_occupied{};
+  scheduler::ScopedEventId m_timer;
+  optional<Tick> m_timerTick;
+};
+
+} // namespace pit
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_PIT_EXPIRY_WHEEL_HPP
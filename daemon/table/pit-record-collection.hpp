@@ -0,0 +1,198 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_PIT_RECORD_COLLECTION_HPP
+#define NFD_DAEMON_TABLE_PIT_RECORD_COLLECTION_HPP
+
+#include "core/common.hpp"
+
+namespace nfd {
+namespace pit {
+
+/** \brief An unordered collection of in-records or out-records
+ *  \tparam T record type, either InRecord or OutRecord
+ *  \tparam N number of records stored inline
+ *
+ *  Up to \p N records are stored inside the collection itself, so that a PIT entry with few
+ *  faces needs no allocation for its records. Additional records move the collection into one
+ *  contiguous heap array. Either way, looking up a record by face is a linear scan over
+ *  contiguous memory.
+ *
+ *  \warning Inserting or erasing a record invalidates all iterators, pointers, and references
+ *           to records in the same collection.
+ */
+template<typename T, size_t N>
+class RecordCollection : noncopyable
+{
+  static_assert(N > 0, "inline capacity must be positive");
+
+public:
+  using value_type = T;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  RecordCollection() noexcept
+    : m_records(reinterpret_cast<T*>(&m_inline))
+  {
+  }
+
+  ~RecordCollection()
+  {
+    clear();
+    if (!isInline()) {
+      ::operator delete(m_records);
+    }
+  }
+
+  iterator
+  begin() noexcept
+  {
+    return m_records;
+  }
+
+  const_iterator
+  begin() const noexcept
+  {
+    return m_records;
+  }
+
+  iterator
+  end() noexcept
+  {
+    return m_records + m_size;
+  }
+
+  const_iterator
+  end() const noexcept
+  {
+    return m_records + m_size;
+  }
+
+  bool
+  empty() const noexcept
+  {
+    return m_size == 0;
+  }
+
+  size_t
+  size() const noexcept
+  {
+    return m_size;
+  }
+
+  size_t
+  capacity() const noexcept
+  {
+    return m_capacity;
+  }
+
+  T&
+  front()
+  {
+    BOOST_ASSERT(!empty());
+    return m_records[0];
+  }
+
+  const T&
+  front() const
+  {
+    BOOST_ASSERT(!empty());
+    return m_records[0];
+  }
+
+  /** \brief constructs a record at the end of the collection
+   *  \return an iterator to the new record
+   */
+  template<typename... Args>
+  iterator
+  emplace_back(Args&&... args)
+  {
+    if (m_size == m_capacity) {
+      grow();
+    }
+    new (m_records + m_size) T(std::forward<Args>(args)...);
+    return m_records + m_size++;
+  }
+
+  /** \brief erases the record at \p pos
+   *
+   *  The last record is moved into the vacated position.
+   */
+  void
+  erase(iterator pos)
+  {
+    BOOST_ASSERT(begin() <= pos && pos < end());
+    pos->~T();
+    iterator last = end() - 1;
+    if (pos != last) {
+      new (pos) T(std::move(*last));
+      last->~T();
+    }
+    --m_size;
+  }
+
+  void
+  clear() noexcept
+  {
+    for (iterator it = begin(); it != end(); ++it) {
+      it->~T();
+    }
+    m_size = 0;
+  }
+
+private:
+  bool
+  isInline() const noexcept
+  {
+    return m_records == reinterpret_cast<const T*>(&m_inline);
+  }
+
+  void
+  grow()
+  {
+    size_t newCapacity = 2 * m_capacity;
+    T* newRecords = static_cast<T*>(::operator new(newCapacity * sizeof(T)));
+    for (size_t i = 0; i < m_size; ++i) {
+      new (newRecords + i) T(std::move(m_records[i]));
+      m_records[i].~T();
+    }
+    if (!isInline()) {
+      ::operator delete(m_records);
+    }
+    m_records = newRecords;
+    m_capacity = newCapacity;
+  }
+
+private:
+  T* m_records;
+  uint32_t m_size = 0;
+  uint32_t m_capacity = N;
+  std::aligned_storage_t<sizeof(T) * N, alignof(T)> m_inline;
+};
+
+} // namespace pit
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_PIT_RECORD_COLLECTION_HPP
@@ -36,6 +36,7 @@ nteHasPitEntries(const name_tree::Entry& nte)
 
 Pit::Pit(NameTree& nameTree)
   : m_nameTree(nameTree)
+  , m_expiryWheel([this] (Entry& entry) { onExpire(entry); })
 {
 }
 
@@ -49,12 +50,13 @@ Pit::findOrInsert(const Interest& interest, bool allowInsert)
   nteDepth = std::min(nteDepth, NameTree::getMaxDepth());
 
   // ensure NameTree entry exists
+  const name_tree::HashSequence& hashes = name_tree::getHashes(interest);
   name_tree::Entry* nte = nullptr;
   if (allowInsert) {
-    nte = &m_nameTree.lookup(name, nteDepth);
+    nte = &m_nameTree.lookup(name, nteDepth, hashes);
   }
   else {
-    nte = m_nameTree.findExactMatch(name, nteDepth);
+    nte = m_nameTree.findExactMatch(name, nteDepth, hashes);
     if (nte == nullptr) {
       return {nullptr, true};
     }
@@ -76,7 +78,7 @@ Pit::findOrInsert(const Interest& interest, bool allowInsert)
     return {nullptr, true};
   }
 
-  auto entry = make_shared<Entry>(interest);
+  auto entry = std::allocate_shared<Entry>(PoolAllocator<Entry>(m_entryPool), interest);
   nte->insertPitEntry(entry);
   ++m_nItems;
   return {entry, true};
@@ -85,7 +87,8 @@ Pit::findOrInsert(const Interest& interest, bool allowInsert)
 DataMatchResult
 Pit::findAllDataMatches(const Data& data) const
 {
-  auto&& ntMatches = m_nameTree.findAllMatches(data.getName(), &nteHasPitEntries);
+  auto&& ntMatches = m_nameTree.findAllMatches(data.getName(), name_tree::getHashes(data),
+                                               &nteHasPitEntries);
 
   DataMatchResult matches;
   for (const auto& nte : ntMatches) {
@@ -104,6 +107,7 @@ Pit::erase(Entry* entry, bool canDeleteNte)
   name_tree::Entry* nte = m_nameTree.getEntry(*entry);
   BOOST_ASSERT(nte != nullptr);
 
+  m_expiryWheel.cancel(*entry);
   nte->erasePitEntry(entry);
   if (canDeleteNte) {
     m_nameTree.eraseIfEmpty(nte);
@@ -111,6 +115,32 @@ Pit::erase(Entry* entry, bool canDeleteNte)
   --m_nItems;
 }
 
+void
+Pit::setExpiryTimer(Entry& entry, time::milliseconds duration)
+{
+  // the wheel does not own the entry, so only entries kept alive by NameTree may be scheduled
+  if (m_nameTree.getEntry(entry) == nullptr) {
+    return;
+  }
+  m_expiryWheel.schedule(entry, duration);
+}
+
+void
+Pit::onExpire(Entry& entry)
+{
+  name_tree::Entry* nte = m_nameTree.getEntry(entry);
+  BOOST_ASSERT(nte != nullptr);
+
+  const auto& pitEntries = nte->getPitEntries();
+  auto it = std::find_if(pitEntries.begin(), pitEntries.end(),
+                         [&entry] (const auto& pitEntry) { return pitEntry.get() == &entry; });
+  BOOST_ASSERT(it != pitEntries.end());
+
+  // copy, because the handler may erase the entry
+  shared_ptr<Entry> pitEntry = *it;
+  afterExpire(pitEntry);
+}
+
 void
 Pit::deleteInOutRecords(Entry* entry, const Face& face)
 {
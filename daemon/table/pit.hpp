@@ -27,7 +27,9 @@
 #define NFD_DAEMON_TABLE_PIT_HPP
 
 #include "pit-entry.hpp"
+#include "pit-expiry-wheel.hpp"
 #include "pit-iterator.hpp"
+#include "common/pool-allocator.hpp"
 
 namespace nfd {
 namespace pit {
@@ -86,6 +88,8 @@ public:
   findAllDataMatches(const Data& data) const;
 
   /** \brief Deletes an entry
+   *
+   *  The expiry timer of the entry, if any, is cancelled.
    */
   void
   erase(Entry* entry)
@@ -93,6 +97,35 @@ public:
     this->erase(entry, true);
   }
 
+public: // expiry timer
+  /** \brief Sets the expiry timer of \p entry, replacing any existing timer
+   *
+   *  When the timer expires, afterExpire is emitted.
+   *  This has no effect if \p entry has been erased from the PIT.
+   */
+  void
+  setExpiryTimer(Entry& entry, time::milliseconds duration);
+
+  /** \brief Cancels the expiry timer of \p entry, if any
+   */
+  void
+  cancelExpiryTimer(Entry& entry)
+  {
+    m_expiryWheel.cancel(entry);
+  }
+
+  /** \return whether \p entry has an expiry timer
+   */
+  static bool
+  hasExpiryTimer(const Entry& entry)
+  {
+    return ExpiryWheel::isScheduled(entry);
+  }
+
+  /** \brief Signals that the expiry timer of a PIT entry has expired
+   */
+  signal::Signal<Pit, shared_ptr<Entry>> afterExpire;
+
   /** \brief Deletes in-records and out-records for \p face
    */
   void
@@ -122,6 +155,9 @@ private:
   void
   erase(Entry* pitEntry, bool canDeleteNte);
 
+  void
+  onExpire(Entry& entry);
+
   /** \brief Finds or inserts a PIT entry for \p interest
    *  \param interest the Interest; must be created with make_shared if allowInsert
    *  \param allowInsert whether inserting a new entry is allowed
@@ -136,6 +172,9 @@ private:
 private:
   NameTree& m_nameTree;
   size_t m_nItems = 0;
+  /// storage for entries together with their shared_ptr control blocks
+  shared_ptr<FixedSizePool> m_entryPool = make_shared<FixedSizePool>();
+  ExpiryWheel m_expiryWheel;
 };
 
 } // namespace pit
@@ -50,6 +50,7 @@ nteHasStrategyChoiceEntry(const name_tree::Entry& nte)
 StrategyChoice::StrategyChoice(Forwarder& forwarder)
   : m_forwarder(forwarder)
   , m_nameTree(m_forwarder.getNameTree())
+  , m_version(name_tree::makeLookupCacheVersion())
 {
 }
 
@@ -65,6 +66,7 @@ StrategyChoice::setDefaultStrategy(const Name& strategyName)
   name_tree::Entry& nte = m_nameTree.lookup(Name());
   nte.setStrategyChoiceEntry(std::move(entry));
   ++m_nItems;
+  m_version = name_tree::makeLookupCacheVersion();
 }
 
 StrategyChoice::InsertResult
@@ -106,6 +108,7 @@ StrategyChoice::insert(const Name& prefix, const Name& strategyName)
     entry = newEntry.get();
     nte.setStrategyChoiceEntry(std::move(newEntry));
     ++m_nItems;
+    m_version = name_tree::makeLookupCacheVersion();
     NFD_LOG_TRACE("insert(" << prefix << ") new entry " << strategy->getInstanceName());
   }
 
@@ -160,6 +163,7 @@ StrategyChoice::erase(const Name& prefix)
   nte->setStrategyChoiceEntry(nullptr);
   m_nameTree.eraseIfEmpty(nte);
   --m_nItems;
+  m_version = name_tree::makeLookupCacheVersion();
 }
 
 std::pair<bool, Name>
@@ -187,6 +191,20 @@ StrategyChoice::findEffectiveStrategyImpl(const K& key) const
   return nte->getStrategyChoiceEntry()->getStrategy();
 }
 
+Strategy&
+StrategyChoice::findEffectiveStrategyCached(name_tree::Entry& nte) const
+{
+  auto& cache = nte.getStrategyChoiceLookupCache();
+  if (cache.version != m_version) {
+    const name_tree::Entry* match = m_nameTree.findLongestPrefixMatch(nte,
+                                                                      &nteHasStrategyChoiceEntry);
+    BOOST_ASSERT(match != nullptr);
+    cache.entry = match->getStrategyChoiceEntry();
+    cache.version = m_version;
+  }
+  return cache.entry->getStrategy();
+}
+
 Strategy&
 StrategyChoice::findEffectiveStrategy(const Name& prefix) const
 {
@@ -196,13 +214,22 @@ StrategyChoice::findEffectiveStrategy(const Name& prefix) const
 Strategy&
 StrategyChoice::findEffectiveStrategy(const pit::Entry& pitEntry) const
 {
-  return this->findEffectiveStrategyImpl(pitEntry);
+  name_tree::Entry* nte = m_nameTree.getEntry(pitEntry);
+  BOOST_ASSERT(nte != nullptr);
+
+  // see Fib::findLongestPrefixMatch(const pit::Entry&)
+  if (nte->getName().size() != pitEntry.getName().size()) {
+    return this->findEffectiveStrategyImpl(pitEntry);
+  }
+  return this->findEffectiveStrategyCached(*nte);
 }
 
 Strategy&
 StrategyChoice::findEffectiveStrategy(const measurements::Entry& measurementsEntry) const
 {
-  return this->findEffectiveStrategyImpl(measurementsEntry);
+  name_tree::Entry* nte = m_nameTree.getEntry(measurementsEntry);
+  BOOST_ASSERT(nte != nullptr);
+  return this->findEffectiveStrategyCached(*nte);
 }
 
 static inline void
@@ -187,6 +187,11 @@ private:
   fw::Strategy&
   findEffectiveStrategyImpl(const K& key) const;
 
+  /** \brief Effective strategy of \p nte's name, served from the lookup cache of \p nte
+   */
+  fw::Strategy&
+  findEffectiveStrategyCached(name_tree::Entry& nte) const;
+
   Range
   getRange() const;
 
@@ -194,6 +199,8 @@ private:
   Forwarder& m_forwarder;
   NameTree& m_nameTree;
   size_t m_nItems = 0;
+  /// changes whenever an entry is inserted or erased, invalidating cached lookups
+  uint64_t m_version;
 };
 
 std::ostream&
@@ -28,9 +28,14 @@
 
 #include "fw/strategy-info.hpp"
 
+#include <array>
+
 namespace nfd {
 
 /** \brief Base class for an entity onto which StrategyInfo items may be placed
+ *
+ *  The first few items are kept in inline slots, and any further items in an overflow vector.
+ *  A host rarely carries more than one or two items, so a lookup is a short linear scan.
  */
 class StrategyInfoHost
 {
@@ -46,11 +51,11 @@ public:
     static_assert(std::is_base_of<fw::StrategyInfo, T>::value,
                   "T must inherit from StrategyInfo");
 
-    auto it = m_items.find(T::getTypeId());
-    if (it == m_items.end()) {
+    const Item* item = this->findItem(T::getTypeId());
+    if (item == nullptr) {
       return nullptr;
     }
-    return static_cast<T*>(it->second.get());
+    return static_cast<T*>(item->info.get());
   }
 
   /** \brief Insert a StrategyInfo item
@@ -65,12 +70,15 @@ public:
     static_assert(std::is_base_of<fw::StrategyInfo, T>::value,
                   "T must inherit from StrategyInfo");
 
-    auto& item = m_items[T::getTypeId()];
-    bool isNew = item == nullptr;
-    if (isNew) {
-      item = make_unique<T>(std::forward<A>(args)...);
+    const Item* existing = this->findItem(T::getTypeId());
+    if (existing != nullptr) {
+      return {static_cast<T*>(existing->info.get()), false};
     }
-    return {static_cast<T*>(item.get()), isNew};
+
+    auto info = make_unique<T>(std::forward<A>(args)...);
+    T* ptr = info.get();
+    this->emplaceItem(T::getTypeId(), std::move(info));
+    return {ptr, true};
   }
 
   /** \brief Erase a StrategyInfo item
@@ -84,7 +92,7 @@ public:
     static_assert(std::is_base_of<fw::StrategyInfo, T>::value,
                   "T must inherit from StrategyInfo");
 
-    return m_items.erase(T::getTypeId());
+    return this->eraseItem(T::getTypeId());
   }
 
   /** \brief Clear all StrategyInfo items
@@ -92,11 +100,71 @@ public:
   void
   clearStrategyInfo()
   {
-    m_items.clear();
+    for (auto& item : m_items) {
+      item.info.reset();
+    }
+    m_overflow.clear();
   }
 
 private:
-  std::unordered_map<int, unique_ptr<fw::StrategyInfo>> m_items;
+  struct Item
+  {
+    int typeId = 0;
+    unique_ptr<fw::StrategyInfo> info; ///< nullptr for an unused slot
+  };
+
+  const Item*
+  findItem(int typeId) const
+  {
+    for (const auto& item : m_items) {
+      if (item.typeId == typeId && item.info != nullptr) {
+        return &item;
+      }
+    }
+    for (const auto& item : m_overflow) {
+      if (item.typeId == typeId) {
+        return &item;
+      }
+    }
+    return nullptr;
+  }
+
+  void
+  emplaceItem(int typeId, unique_ptr<fw::StrategyInfo> info)
+  {
+    for (auto& item : m_items) {
+      if (item.info == nullptr) {
+        item.typeId = typeId;
+        item.info = std::move(info);
+        return;
+      }
+    }
+    m_overflow.push_back({typeId, std::move(info)});
+  }
+
+  size_t
+  eraseItem(int typeId)
+  {
+    for (auto& item : m_items) {
+      if (item.typeId == typeId && item.info != nullptr) {
+        item.info.reset();
+        return 1;
+      }
+    }
+    for (auto it = m_overflow.begin(); it != m_overflow.end(); ++it) {
+      if (it->typeId == typeId) {
+        m_overflow.erase(it);
+        return 1;
+      }
+    }
+    return 0;
+  }
+
+  /// number of items that can be stored without allocating the overflow vector
+  static constexpr size_t N_INLINE_ITEMS = 2;
+
+  std::array<Item, N_INLINE_ITEMS> m_items;
+  std::vector<Item> m_overflow;
 };
 
 } // namespace nfd
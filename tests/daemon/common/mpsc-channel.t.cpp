@@ -0,0 +1,165 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/mpsc-channel.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace nfd {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(TestMpscChannel)
+
+class MpscChannelFixture
+{
+protected:
+  void
+  post(const std::function<void()>& f)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_posted.push_back(f);
+    ++nPosts;
+  }
+
+  /** \return whether a posted callback was run
+   */
+  bool
+  runOne()
+  {
+    std::function<void()> f;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_posted.empty()) {
+        return false;
+      }
+      f = std::move(m_posted.front());
+      m_posted.pop_front();
+    }
+    f();
+    return true;
+  }
+
+  MpscChannel<std::string>::PostFunc
+  makePost()
+  {
+    return [this] (const std::function<void()>& f) { post(f); };
+  }
+
+protected:
+  size_t nPosts = 0;
+
+private:
+  std::mutex m_mutex;
+  std::deque<std::function<void()>> m_posted;
+};
+
+BOOST_FIXTURE_TEST_CASE(Batches, MpscChannelFixture)
+{
+  std::vector<std::string> received;
+  MpscChannel<std::string> channel(3, makePost(),
+                                   [&] (std::string& msg) { received.push_back(msg); }, 2);
+  BOOST_CHECK_EQUAL(channel.capacity(), 4);
+
+  for (int i = 0; i < 5; ++i) {
+    channel.send([i] (std::string& msg) { msg = to_string(i); });
+  }
+  BOOST_CHECK_EQUAL(channel.getNSent(), 4);
+  BOOST_CHECK_EQUAL(channel.getNDropped(), 1);
+  BOOST_CHECK_EQUAL(nPosts, 1); // one drain for the whole burst
+  BOOST_CHECK(received.empty());
+
+  while (runOne()) {
+  }
+  std::vector<std::string> expected{"0", "1", "2", "3"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(received.begin(), received.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(channel.getNReceived(), 4);
+  BOOST_CHECK_EQUAL(channel.getNBatches(), 2); // limited by maxBatchSize
+
+  BOOST_CHECK_EQUAL(channel.send([] (std::string& msg) { msg = "4"; }), true);
+  BOOST_CHECK_EQUAL(nPosts, 4);
+  BOOST_CHECK(runOne());
+  BOOST_CHECK_EQUAL(received.back(), "4");
+}
+
+BOOST_FIXTURE_TEST_CASE(DrainAfterDestruction, MpscChannelFixture)
+{
+  size_t nReceived = 0;
+  {
+    MpscChannel<std::string> channel(4, makePost(), [&] (std::string&) { ++nReceived; });
+    channel.send([] (std::string& msg) { msg = "x"; });
+  }
+  BOOST_CHECK(runOne());
+  BOOST_CHECK_EQUAL(nReceived, 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(Concurrent, MpscChannelFixture)
+{
+  const size_t nProducers = 4;
+  const uint64_t nMessages = 100000;
+
+  std::vector<uint64_t> lastSeq(nProducers);
+  size_t nOutOfOrder = 0;
+  MpscChannel<std::pair<size_t, uint64_t>> channel(256,
+    [this] (const std::function<void()>& f) { post(f); },
+    [&] (std::pair<size_t, uint64_t>& msg) {
+      nOutOfOrder += msg.second != lastSeq[msg.first] + 1;
+      lastSeq[msg.first] = msg.second;
+    });
+
+  std::vector<std::thread> producers;
+  for (size_t p = 0; p < nProducers; ++p) {
+    producers.emplace_back([&channel, p, nMessages] {
+      for (uint64_t i = 1; i <= nMessages; ++i) {
+        while (!channel.send([=] (std::pair<size_t, uint64_t>& msg) { msg = {p, i}; })) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  while (channel.getNReceived() < nProducers * nMessages) {
+    if (!runOne()) {
+      std::this_thread::yield();
+    }
+  }
+  for (auto& t : producers) {
+    t.join();
+  }
+
+  BOOST_CHECK_EQUAL(nOutOfOrder, 0);
+  BOOST_CHECK_EQUAL(channel.getNSent(), nProducers * nMessages);
+  for (uint64_t seq : lastSeq) {
+    BOOST_CHECK_EQUAL(seq, nMessages);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestMpscChannel
+
+} // namespace tests
+} // namespace nfd
@@ -0,0 +1,93 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/pool-allocator.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(TestPoolAllocator)
+
+BOOST_AUTO_TEST_CASE(FixedSize)
+{
+  FixedSizePool pool(4);
+  BOOST_CHECK_EQUAL(pool.canAllocate(24), true);
+  BOOST_CHECK_EQUAL(pool.canAllocate(FixedSizePool::MAX_BLOCK_SIZE + 1), false);
+
+  std::vector<void*> blocks;
+  for (int i = 0; i < 10; ++i) {
+    blocks.push_back(pool.allocate(24));
+    BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(blocks.back()) % alignof(std::max_align_t), 0);
+  }
+  BOOST_CHECK_EQUAL(pool.size(), 10);
+  BOOST_CHECK_EQUAL(pool.getNChunks(), 3);
+  BOOST_CHECK_EQUAL(pool.canAllocate(24), true);
+  BOOST_CHECK_EQUAL(pool.canAllocate(16), false);
+
+  std::sort(blocks.begin(), blocks.end());
+  BOOST_CHECK(std::adjacent_find(blocks.begin(), blocks.end()) == blocks.end());
+
+  // freed blocks are reused before a new chunk is allocated
+  pool.deallocate(blocks[3]);
+  pool.deallocate(blocks[7]);
+  BOOST_CHECK_EQUAL(pool.size(), 8);
+  void* p1 = pool.allocate(24);
+  void* p2 = pool.allocate(24);
+  BOOST_CHECK((p1 == blocks[3] && p2 == blocks[7]) || (p1 == blocks[7] && p2 == blocks[3]));
+  BOOST_CHECK_EQUAL(pool.getNChunks(), 3);
+
+  blocks[3] = p1;
+  blocks[7] = p2;
+  for (void* p : blocks) {
+    pool.deallocate(p);
+  }
+  BOOST_CHECK_EQUAL(pool.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(AllocateShared)
+{
+  auto pool = make_shared<FixedSizePool>();
+  auto obj1 = std::allocate_shared<std::string>(PoolAllocator<std::string>(pool), "obj1");
+  auto obj2 = std::allocate_shared<std::string>(PoolAllocator<std::string>(pool), "obj2");
+  BOOST_CHECK_EQUAL(pool->size(), 2);
+  BOOST_CHECK_EQUAL(pool->getNChunks(), 1);
+
+  // the pool is kept alive by the objects allocated from it
+  weak_ptr<FixedSizePool> weakPool = pool;
+  pool.reset();
+  BOOST_CHECK_EQUAL(weakPool.expired(), false);
+  obj1.reset();
+  BOOST_CHECK_EQUAL(weakPool.lock()->size(), 1);
+  BOOST_CHECK_EQUAL(*obj2, "obj2");
+  obj2.reset();
+  BOOST_CHECK_EQUAL(weakPool.expired(), true);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestPoolAllocator
+
+} // namespace tests
+} // namespace nfd
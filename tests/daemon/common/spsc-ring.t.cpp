@@ -0,0 +1,113 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/spsc-ring.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <thread>
+
+namespace nfd {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(TestSpscRing)
+
+BOOST_AUTO_TEST_CASE(PushPop)
+{
+  SpscRing<int> ring(3);
+  BOOST_CHECK_EQUAL(ring.capacity(), 4);
+  BOOST_CHECK(ring.empty());
+
+  int item = 0;
+  BOOST_CHECK_EQUAL(ring.tryPop(item), false);
+
+  for (int i = 1; i <= 4; ++i) {
+    BOOST_CHECK_EQUAL(ring.tryPush(i), true);
+  }
+  BOOST_CHECK_EQUAL(ring.tryPush(5), false);
+  BOOST_CHECK_EQUAL(ring.size(), 4);
+
+  BOOST_CHECK_EQUAL(ring.tryPop(item), true);
+  BOOST_CHECK_EQUAL(item, 1);
+  BOOST_CHECK_EQUAL(ring.tryPush(5), true);
+
+  std::vector<int> items;
+  BOOST_CHECK_EQUAL(ring.consume([&] (int i) { items.push_back(i); }, 3), 3);
+  BOOST_CHECK_EQUAL(ring.consume([&] (int i) { items.push_back(i); }), 1);
+  std::vector<int> expected{2, 3, 4, 5};
+  BOOST_CHECK_EQUAL_COLLECTIONS(items.begin(), items.end(), expected.begin(), expected.end());
+  BOOST_CHECK(ring.empty());
+}
+
+BOOST_AUTO_TEST_CASE(MoveOnly)
+{
+  SpscRing<unique_ptr<int>> ring(2);
+  auto p = make_unique<int>(42);
+  BOOST_CHECK_EQUAL(ring.tryPush(std::move(p)), true);
+  BOOST_CHECK(p == nullptr);
+
+  auto q = make_unique<int>(43);
+  BOOST_CHECK_EQUAL(ring.tryPush(std::move(q)), true);
+  auto r = make_unique<int>(44);
+  BOOST_CHECK_EQUAL(ring.tryPush(std::move(r)), false);
+  BOOST_REQUIRE(r != nullptr); // not consumed when the ring is full
+
+  unique_ptr<int> out;
+  BOOST_CHECK_EQUAL(ring.tryPop(out), true);
+  BOOST_REQUIRE(out != nullptr);
+  BOOST_CHECK_EQUAL(*out, 42);
+}
+
+BOOST_AUTO_TEST_CASE(Concurrent)
+{
+  const uint64_t nItems = 1000000;
+  SpscRing<uint64_t> ring(64);
+
+  std::thread producer([&] {
+    for (uint64_t i = 1; i <= nItems; ++i) {
+      while (!ring.tryPush(i)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  uint64_t nReceived = 0;
+  uint64_t nOutOfOrder = 0;
+  while (nReceived < nItems) {
+    if (ring.consume([&] (uint64_t i) { nOutOfOrder += i != ++nReceived; }) == 0) {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+
+  BOOST_CHECK_EQUAL(nReceived, nItems);
+  BOOST_CHECK_EQUAL(nOutOfOrder, 0);
+  BOOST_CHECK(ring.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestSpscRing
+
+} // namespace tests
+} // namespace nfd
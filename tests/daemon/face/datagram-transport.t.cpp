@@ -144,6 +144,58 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceiveTooLarge, T, DatagramTransportFixtures,
   BOOST_CHECK_EQUAL(this->transport->getState(), TransportState::UP);
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceiveZeroCopy, T, DatagramTransportFixtures, T)
+{
+  TRANSPORT_TEST_INIT();
+
+  // no buffer is allocated until a datagram is readable
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInBufferAllocations, 0);
+
+  // a packet of typical size is received into a buffer of the smallest size class that fits it,
+  // and shares that buffer
+  const std::vector<uint8_t> typicalBytes(1200, 0xAA);
+  auto pkt1 = ndn::encoding::makeBinaryBlock(300, typicalBytes);
+  this->remoteWrite(ndn::Buffer(pkt1.begin(), pkt1.end()));
+
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInPackets, 1);
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInPacketCopies, 0);
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInBufferAllocations, 1);
+  BOOST_REQUIRE_EQUAL(this->receivedPackets->size(), 1);
+  const Block& received1 = this->receivedPackets->at(0).packet;
+  BOOST_CHECK(received1 == pkt1);
+  BOOST_REQUIRE(received1.getBuffer() != nullptr);
+  BOOST_CHECK_EQUAL(received1.getBuffer()->size(), ndn::MAX_NDN_PACKET_SIZE / 4);
+  BOOST_CHECK_EQUAL(received1.wire(), received1.getBuffer()->data());
+
+  // so do a small and a large packet, each in a buffer of its own size class
+  auto pkt2 = ndn::encoding::makeStringBlock(301, "hello");
+  this->remoteWrite(ndn::Buffer(pkt2.begin(), pkt2.end()));
+  const std::vector<uint8_t> largeBytes(8000, 0xBB);
+  auto pkt3 = ndn::encoding::makeBinaryBlock(302, largeBytes);
+  this->remoteWrite(ndn::Buffer(pkt3.begin(), pkt3.end()));
+
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInPackets, 3);
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInPacketCopies, 0);
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInBufferAllocations, 3);
+  BOOST_REQUIRE_EQUAL(this->receivedPackets->size(), 3);
+  BOOST_CHECK(this->receivedPackets->at(1).packet == pkt2);
+  BOOST_CHECK_LT(this->receivedPackets->at(1).packet.getBuffer()->size(),
+                 2 * ReceiveBufferPool::MIN_BUFFER_SIZE);
+  BOOST_CHECK(this->receivedPackets->at(2).packet == pkt3);
+  BOOST_CHECK_EQUAL(this->receivedPackets->at(2).packet.getBuffer()->size(),
+                    ndn::MAX_NDN_PACKET_SIZE);
+
+  // once the packets are released, their buffers are recycled
+  this->receivedPackets->clear();
+  this->remoteWrite(ndn::Buffer(pkt1.begin(), pkt1.end()));
+  this->remoteWrite(ndn::Buffer(pkt3.begin(), pkt3.end()));
+
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInPackets, 5);
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInPacketCopies, 0);
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInBufferAllocations, 3);
+  BOOST_CHECK_EQUAL(this->transport->getState(), TransportState::UP);
+}
+
 BOOST_FIXTURE_TEST_CASE_TEMPLATE(Close, T, DatagramTransportFixtures, T)
 {
   TRANSPORT_TEST_INIT();
@@ -164,6 +216,45 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(Close, T, DatagramTransportFixtures, T)
   BOOST_REQUIRE_EQUAL(this->limitedIo.run(1, 1_s), LimitedIo::EXCEED_OPS);
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(BatchedIo, T, DatagramTransportFixtures, T)
+{
+  TRANSPORT_TEST_INIT();
+
+  this->transport->setIoBatchSize(8);
+  BOOST_CHECK_EQUAL(this->transport->getIoBatchSize(), 8);
+
+  // datagrams are received in batches from the next time the socket is readable
+  std::vector<Block> pkts;
+  for (uint32_t i = 0; i < 3; ++i) {
+    pkts.push_back(ndn::encoding::makeStringBlock(300 + i, "hello"));
+    this->remoteWrite(ndn::Buffer(pkts.back().begin(), pkts.back().end()));
+  }
+
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInPackets, 3);
+  BOOST_REQUIRE_EQUAL(this->receivedPackets->size(), 3);
+  for (size_t i = 0; i < pkts.size(); ++i) {
+    BOOST_CHECK(this->receivedPackets->at(i).packet == pkts[i]);
+  }
+
+  // packets sent in the same event loop iteration are queued, then sent together
+  pkts.clear();
+  size_t nQueuedBytes = 0;
+  for (uint32_t i = 0; i < 5; ++i) {
+    pkts.push_back(ndn::encoding::makeStringBlock(400 + i, "world"));
+    this->transport->send(pkts.back());
+    nQueuedBytes += pkts.back().size();
+  }
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nOutPackets, 5);
+  BOOST_CHECK_GE(this->transport->getSendQueueLength(), static_cast<ssize_t>(nQueuedBytes));
+
+  for (const auto& pkt : pkts) {
+    std::vector<uint8_t> readBuf(pkt.size());
+    this->remoteRead(readBuf);
+    BOOST_CHECK_EQUAL_COLLECTIONS(readBuf.begin(), readBuf.end(), pkt.begin(), pkt.end());
+  }
+  BOOST_CHECK_EQUAL(this->transport->getState(), TransportState::UP);
+}
+
 BOOST_FIXTURE_TEST_CASE_TEMPLATE(SendQueueLength, T, DatagramTransportFixtures, T)
 {
   TRANSPORT_TEST_INIT();
@@ -323,6 +323,63 @@ BOOST_AUTO_TEST_CASE(Omitted)
   BOOST_CHECK_EQUAL(this->countEtherMcastFaces(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(Backend)
+{
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      ether
+      {
+        backend pcap
+        mcast no
+      }
+    }
+  )CONFIG";
+
+  parseConfig(CONFIG, true);
+  parseConfig(CONFIG, false);
+  for (const auto& ch : factory.getChannels()) {
+    BOOST_CHECK(static_cast<const EthernetChannel&>(*ch).getTransportBackend() ==
+                EthernetTransport::Backend::PCAP);
+  }
+
+#if defined(__linux__)
+  const std::string CONFIG_TPACKET = R"CONFIG(
+    face_system
+    {
+      ether
+      {
+        backend tpacket
+        mcast no
+      }
+    }
+  )CONFIG";
+
+  parseConfig(CONFIG_TPACKET, true);
+  parseConfig(CONFIG_TPACKET, false);
+  for (const auto& ch : factory.getChannels()) {
+    BOOST_CHECK(static_cast<const EthernetChannel&>(*ch).getTransportBackend() ==
+                EthernetTransport::Backend::TPACKET);
+  }
+#endif // __linux__
+}
+
+BOOST_AUTO_TEST_CASE(BadBackend)
+{
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      ether
+      {
+        backend hello
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(parseConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(parseConfig(CONFIG, false), ConfigFile::Error);
+}
+
 BOOST_AUTO_TEST_CASE(BadListen)
 {
   const std::string CONFIG = R"CONFIG(
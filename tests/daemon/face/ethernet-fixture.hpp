@@ -81,7 +81,8 @@ protected:
   void
   initializeUnicast(shared_ptr<ndn::net::NetworkInterface> netif = nullptr,
                     ndn::nfd::FacePersistency persistency = ndn::nfd::FACE_PERSISTENCY_PERSISTENT,
-                    ethernet::Address remoteAddr = {0x00, 0x00, 0x5e, 0x00, 0x53, 0x5e})
+                    ethernet::Address remoteAddr = {0x00, 0x00, 0x5e, 0x00, 0x53, 0x5e},
+                    EthernetTransport::Backend backend = EthernetTransport::Backend::PCAP)
   {
     if (!netif) {
       netif = defaultNetif;
@@ -89,7 +90,7 @@ protected:
 
     localEp = netif->getName();
     remoteEp = remoteAddr;
-    transport = make_unique<UnicastEthernetTransport>(*netif, remoteEp, persistency, 2_s);
+    transport = make_unique<UnicastEthernetTransport>(*netif, remoteEp, persistency, 2_s, backend);
   }
 
   /** \brief create a MulticastEthernetTransport
@@ -97,7 +98,8 @@ protected:
   void
   initializeMulticast(shared_ptr<ndn::net::NetworkInterface> netif = nullptr,
                       ndn::nfd::LinkType linkType = ndn::nfd::LINK_TYPE_MULTI_ACCESS,
-                      ethernet::Address mcastGroup = {0x01, 0x00, 0x5e, 0x90, 0x10, 0x5e})
+                      ethernet::Address mcastGroup = {0x01, 0x00, 0x5e, 0x90, 0x10, 0x5e},
+                      EthernetTransport::Backend backend = EthernetTransport::Backend::PCAP)
   {
     if (!netif) {
       netif = defaultNetif;
@@ -105,7 +107,7 @@ protected:
 
     localEp = netif->getName();
     remoteEp = mcastGroup;
-    transport = make_unique<MulticastEthernetTransport>(*netif, remoteEp, linkType);
+    transport = make_unique<MulticastEthernetTransport>(*netif, remoteEp, linkType, backend);
   }
 
 protected:
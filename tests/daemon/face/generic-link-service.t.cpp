@@ -253,6 +253,8 @@ BOOST_AUTO_TEST_CASE(ReceiveBareData)
   BOOST_CHECK_EQUAL(service->getCounters().nInData, 1);
   BOOST_REQUIRE_EQUAL(receivedData.size(), 1);
   BOOST_CHECK_EQUAL(receivedData.back().wireEncode(), data1->wireEncode());
+  // decoded without copying
+  BOOST_CHECK(receivedData.back().wireEncode().getBuffer() == data1->wireEncode().getBuffer());
 }
 
 BOOST_AUTO_TEST_CASE(ReceiveData)
@@ -267,12 +269,15 @@ BOOST_AUTO_TEST_CASE(ReceiveData)
   lpPacket.set<lp::FragmentField>(std::make_pair(
     data1->wireEncode().begin(), data1->wireEncode().end()));
   lpPacket.set<lp::SequenceField>(0); // force LpPacket encoding
+  Block lpWire = lpPacket.wireEncode();
 
-  transport->receivePacket(lpPacket.wireEncode());
+  transport->receivePacket(lpWire);
 
   BOOST_CHECK_EQUAL(service->getCounters().nInData, 1);
   BOOST_REQUIRE_EQUAL(receivedData.size(), 1);
   BOOST_CHECK_EQUAL(receivedData.back().wireEncode(), data1->wireEncode());
+  // the Data shares the buffer of the LpPacket
+  BOOST_CHECK(receivedData.back().wireEncode().getBuffer() == lpWire.getBuffer());
 }
 
 BOOST_AUTO_TEST_CASE(ReceiveNack)
@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2014-2020,  Regents of the University of California,
+ * Copyright (c) 2014-2022,  Regents of the University of California,
  *                           Arizona Board of Regents,
  *                           Colorado State University,
  *                           University Pierre & Marie Curie, Sorbonne University,
@@ -146,6 +146,52 @@ BOOST_AUTO_TEST_CASE(MultipleFragments)
                                 reassembledPayload.begin(), reassembledPayload.end());
 }
 
+BOOST_AUTO_TEST_CASE(AssignSequences)
+{
+  const size_t mtu = MIN_MTU;
+
+  lp::Packet packet;
+  packet.add<lp::IncomingFaceIdField>(123);
+
+  auto data = makeData("/test/data123/123456789/987654321/123456789");
+  const Block& dataWire = data->wireEncode();
+  packet.add<lp::FragmentField>({dataWire.begin(), dataWire.end()});
+
+  bool isOk = false;
+  std::vector<lp::Packet> frags;
+  std::tie(isOk, frags) = fragmenter.fragmentPacket(packet, mtu, 1000);
+  BOOST_REQUIRE(isOk);
+  BOOST_REQUIRE_EQUAL(frags.size(), 5);
+
+  auto fragBegin = dataWire.begin();
+  for (size_t fragIndex = 0; fragIndex < frags.size(); ++fragIndex) {
+    BOOST_CHECK_EQUAL(frags[fragIndex].get<lp::SequenceField>(), 1000 + fragIndex);
+    BOOST_CHECK_LE(frags[fragIndex].wireEncode().size(), mtu);
+
+    // the encoding is the same as that of a packet built field by field
+    ndn::Buffer::const_iterator payloadBegin, payloadEnd;
+    std::tie(payloadBegin, payloadEnd) = frags[fragIndex].get<lp::FragmentField>();
+    auto fragEnd = fragBegin + std::distance(payloadBegin, payloadEnd);
+    lp::Packet expected;
+    if (fragIndex == 0) {
+      expected.add<lp::IncomingFaceIdField>(123);
+    }
+    expected.add<lp::FragmentField>({fragBegin, fragEnd});
+    expected.add<lp::FragIndexField>(fragIndex);
+    expected.add<lp::FragCountField>(frags.size());
+    expected.add<lp::SequenceField>(1000 + fragIndex);
+    BOOST_CHECK_EQUAL(frags[fragIndex].wireEncode(), expected.wireEncode());
+    fragBegin = fragEnd;
+  }
+  BOOST_CHECK(fragBegin == dataWire.end());
+
+  // a packet that is not fragmented is not assigned a sequence number
+  std::tie(isOk, frags) = fragmenter.fragmentPacket(packet, 256, 2000);
+  BOOST_REQUIRE(isOk);
+  BOOST_REQUIRE_EQUAL(frags.size(), 1);
+  BOOST_CHECK(!frags[0].has<lp::SequenceField>());
+}
+
 BOOST_AUTO_TEST_CASE(MtuTooSmall)
 {
   const size_t mtu = 20;
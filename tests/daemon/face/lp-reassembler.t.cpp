@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2014-2019,  Regents of the University of California,
+ * Copyright (c) 2014-2022,  Regents of the University of California,
  *                           Arizona Board of Regents,
  *                           Colorado State University,
  *                           University Pierre & Marie Curie, Sorbonne University,
@@ -257,6 +257,8 @@ BOOST_AUTO_TEST_CASE(OutOfOrder)
   frag2.add<lp::SequenceField>(1002);
 
   bool isComplete = false;
+  Block netPacket;
+  lp::Packet packet;
 
   std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment(0, frag2);
   BOOST_REQUIRE(!isComplete);
@@ -264,8 +266,11 @@ BOOST_AUTO_TEST_CASE(OutOfOrder)
   std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment(0, frag0);
   BOOST_REQUIRE(!isComplete);
 
-  std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment(0, frag1);
+  std::tie(isComplete, netPacket, packet) = reassembler.receiveFragment(0, frag1);
   BOOST_REQUIRE(isComplete);
+  BOOST_CHECK(packet.has<lp::NextHopFaceIdField>());
+  BOOST_CHECK_EQUAL_COLLECTIONS(data, data + sizeof(data), netPacket.begin(), netPacket.end());
+  BOOST_CHECK_EQUAL(reassembler.size(), 0);
 }
 
 BOOST_AUTO_TEST_CASE(Duplicate)
@@ -322,6 +327,50 @@ BOOST_AUTO_TEST_CASE(Timeout)
   BOOST_REQUIRE(!isComplete);
 }
 
+BOOST_AUTO_TEST_CASE(TimeoutRestartedByNewFragment)
+{
+  ndn::Buffer data0Buffer(data, 4);
+  ndn::Buffer data1Buffer(data + 4, 4);
+  ndn::Buffer data2Buffer(data + 8, 2);
+
+  lp::Packet frag0;
+  frag0.add<lp::FragmentField>(std::make_pair(data0Buffer.begin(), data0Buffer.end()));
+  frag0.add<lp::FragIndexField>(0);
+  frag0.add<lp::FragCountField>(3);
+  frag0.add<lp::SequenceField>(1000);
+
+  lp::Packet frag1;
+  frag1.add<lp::FragmentField>(std::make_pair(data1Buffer.begin(), data1Buffer.end()));
+  frag1.add<lp::FragIndexField>(1);
+  frag1.add<lp::FragCountField>(3);
+  frag1.add<lp::SequenceField>(1001);
+
+  lp::Packet frag2;
+  frag2.add<lp::FragmentField>(std::make_pair(data2Buffer.begin(), data2Buffer.end()));
+  frag2.add<lp::FragIndexField>(2);
+  frag2.add<lp::FragCountField>(3);
+  frag2.add<lp::SequenceField>(1002);
+
+  bool isComplete = false;
+  std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment(0, frag0);
+  BOOST_REQUIRE(!isComplete);
+
+  advanceClocks(1_ms, 400);
+  std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment(0, frag1);
+  BOOST_REQUIRE(!isComplete);
+
+  advanceClocks(1_ms, 400); // 800ms after the first fragment, 400ms after the last one
+  BOOST_CHECK_EQUAL(reassembler.size(), 1);
+  BOOST_CHECK(timeoutHistory.empty());
+
+  std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment(0, frag2);
+  BOOST_REQUIRE(isComplete);
+  BOOST_CHECK_EQUAL(reassembler.size(), 0);
+
+  advanceClocks(1_ms, 600);
+  BOOST_CHECK(timeoutHistory.empty());
+}
+
 BOOST_AUTO_TEST_CASE(MissingSequence)
 {
   ndn::Buffer data1Buffer(data, 4);
@@ -458,6 +507,65 @@ BOOST_AUTO_TEST_CASE(OverFragCount)
   BOOST_REQUIRE(!isComplete);
 }
 
+BOOST_AUTO_TEST_CASE(PartialPacketLimit)
+{
+  LpReassembler::Options options;
+  options.nMaxPartialPackets = 2;
+  reassembler.setOptions(options);
+
+  ndn::Buffer data1Buffer(data, 5);
+  ndn::Buffer data2Buffer(data + 5, 5);
+
+  lp::Packet frag1;
+  frag1.add<lp::FragmentField>(std::make_pair(data1Buffer.begin(), data1Buffer.end()));
+  frag1.add<lp::FragIndexField>(0);
+  frag1.add<lp::FragCountField>(2);
+  frag1.add<lp::SequenceField>(1000);
+
+  lp::Packet frag2;
+  frag2.add<lp::FragmentField>(std::make_pair(data2Buffer.begin(), data2Buffer.end()));
+  frag2.add<lp::FragIndexField>(1);
+  frag2.add<lp::FragCountField>(2);
+  frag2.add<lp::SequenceField>(1001);
+
+  bool isComplete = false;
+  Block netPacket;
+
+  std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment(1, frag1);
+  BOOST_REQUIRE(!isComplete);
+  advanceClocks(1_ms, 10);
+  std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment(2, frag1);
+  BOOST_REQUIRE(!isComplete);
+  advanceClocks(1_ms, 10);
+  BOOST_CHECK_EQUAL(reassembler.size(), 2);
+  BOOST_CHECK(timeoutHistory.empty());
+
+  // the partial packet from endpoint 1 is closest to its timeout, and is dropped
+  std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment(3, frag2);
+  BOOST_REQUIRE(!isComplete);
+  BOOST_CHECK_EQUAL(reassembler.size(), 2);
+  BOOST_REQUIRE_EQUAL(timeoutHistory.size(), 1);
+  BOOST_CHECK_EQUAL(std::get<0>(timeoutHistory.back()), 1);
+  BOOST_CHECK_EQUAL(std::get<1>(timeoutHistory.back()), 1);
+
+  std::tie(isComplete, netPacket, std::ignore) = reassembler.receiveFragment(2, frag2);
+  BOOST_REQUIRE(isComplete);
+  BOOST_CHECK_EQUAL_COLLECTIONS(data, data + sizeof(data), netPacket.begin(), netPacket.end());
+  std::tie(isComplete, netPacket, std::ignore) = reassembler.receiveFragment(3, frag1);
+  BOOST_REQUIRE(isComplete);
+  BOOST_CHECK_EQUAL_COLLECTIONS(data, data + sizeof(data), netPacket.begin(), netPacket.end());
+  BOOST_CHECK_EQUAL(reassembler.size(), 0);
+
+  // the remaining fragment from endpoint 1 starts a new partial packet
+  std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment(1, frag2);
+  BOOST_REQUIRE(!isComplete);
+  BOOST_CHECK_EQUAL(reassembler.size(), 1);
+
+  advanceClocks(1_ms, 600);
+  BOOST_CHECK_EQUAL(reassembler.size(), 0);
+  BOOST_CHECK_EQUAL(timeoutHistory.size(), 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // MultiFragment
 
 BOOST_AUTO_TEST_SUITE(MultipleRemoteEndpoints)
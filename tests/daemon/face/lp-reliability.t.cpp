@@ -114,8 +114,8 @@ public:
   static bool
   netPktHasUnackedFrag(const shared_ptr<LpReliability::NetPkt>& netPkt, lp::Sequence txSeq)
   {
-    return std::any_of(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(),
-                       [txSeq] (auto fragIt) { return fragIt->first == txSeq; });
+    return std::find(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(), txSeq) !=
+           netPkt->unackedFrags.end();
   }
 
   /** \brief make an LpPacket with fragment of specified size
@@ -207,7 +207,7 @@ BOOST_AUTO_TEST_CASE(SendUnfragmentedRetx)
                  reliability->m_unackedFrags.at(firstTxSeq + 1).netPkt);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq).retxCount, 0);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 1).retxCount, 0);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, firstTxSeq);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), firstTxSeq);
   BOOST_CHECK_EQUAL(reliability->m_ackQueue.size(), 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -225,7 +225,7 @@ BOOST_AUTO_TEST_CASE(SendUnfragmentedRetx)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 2).retxCount, 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + 1), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 1).retxCount, 0);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, firstTxSeq + 1);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), firstTxSeq + 1);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 3);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -244,7 +244,7 @@ BOOST_AUTO_TEST_CASE(SendUnfragmentedRetx)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 4).retxCount, 2);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + 3), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 3).retxCount, 1);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, firstTxSeq + 3);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), firstTxSeq + 3);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 5);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -263,7 +263,7 @@ BOOST_AUTO_TEST_CASE(SendUnfragmentedRetx)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 6).retxCount, 3);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + 5), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 5).retxCount, 2);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, firstTxSeq + 5);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), firstTxSeq + 5);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 7);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -280,7 +280,7 @@ BOOST_AUTO_TEST_CASE(SendUnfragmentedRetx)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + 6), 0);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + 7), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 7).retxCount, 3);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, firstTxSeq + 7);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), firstTxSeq + 7);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 8);
 
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
@@ -354,7 +354,7 @@ BOOST_AUTO_TEST_CASE(SendFragmentedRetx)
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 2));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 3));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 4));
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 2);
   BOOST_CHECK_EQUAL(reliability->m_ackQueue.size(), 0);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 3);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
@@ -389,7 +389,7 @@ BOOST_AUTO_TEST_CASE(SendFragmentedRetx)
   BOOST_CHECK(!netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 3));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 5));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 4));
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 2);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 4);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -423,7 +423,7 @@ BOOST_AUTO_TEST_CASE(SendFragmentedRetx)
   BOOST_CHECK(!netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 5));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 6));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 4));
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 2);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 5);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -457,7 +457,7 @@ BOOST_AUTO_TEST_CASE(SendFragmentedRetx)
   BOOST_CHECK(!netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 6));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 7));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 4));
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 2);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 6);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -486,7 +486,7 @@ BOOST_AUTO_TEST_CASE(AckUnknownTxSeq)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(2), 1);
   BOOST_CHECK(reliability->m_unackedFrags.at(2).netPkt);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 2);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 1);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -500,7 +500,7 @@ BOOST_AUTO_TEST_CASE(AckUnknownTxSeq)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(2), 1);
   BOOST_CHECK(reliability->m_unackedFrags.at(2).netPkt);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 2);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 1);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -533,7 +533,7 @@ BOOST_AUTO_TEST_CASE(LossByGreaterAcks)
   BOOST_CHECK(reliability->m_unackedFrags.at(2).netPkt);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(3), 1); // pkt5
   BOOST_CHECK(reliability->m_unackedFrags.at(3).netPkt);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 0xFFFFFFFFFFFFFFFF);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 0xFFFFFFFFFFFFFFFF);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetxExhausted, 0);
@@ -560,7 +560,7 @@ BOOST_AUTO_TEST_CASE(LossByGreaterAcks)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(3), 1); // pkt5
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(3).retxCount, 0);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(3).nGreaterSeqAcks, 0);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 0xFFFFFFFFFFFFFFFF);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 0xFFFFFFFFFFFFFFFF);
   BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 5);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 1);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -588,7 +588,7 @@ BOOST_AUTO_TEST_CASE(LossByGreaterAcks)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(3).retxCount, 0);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(3).nGreaterSeqAcks, 0);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(101010), 0);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 0xFFFFFFFFFFFFFFFF);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 0xFFFFFFFFFFFFFFFF);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 5);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 2);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -613,7 +613,7 @@ BOOST_AUTO_TEST_CASE(LossByGreaterAcks)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(4), 1); // pkt1 new TxSeq
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(4).retxCount, 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(4).nGreaterSeqAcks, 0);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 3);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 3);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 6);
   lp::Packet sentRetxPkt(transport->sentPackets.back());
   BOOST_REQUIRE(sentRetxPkt.has<lp::TxSequenceField>());
@@ -640,7 +640,7 @@ BOOST_AUTO_TEST_CASE(LossByGreaterAcks)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(3).retxCount, 0);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(3).nGreaterSeqAcks, 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(4), 0); // pkt1 new TxSeq
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 3);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 3);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 6);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 3);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 1);
@@ -665,7 +665,7 @@ BOOST_AUTO_TEST_CASE(SkipFragmentsRemovedInRtt)
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 5);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 5);
 
-  lp::Sequence firstTxSeq = reliability->m_firstUnackedFrag->first;
+  lp::Sequence firstTxSeq = reliability->m_unackedFrags.getFirstTxSeq();
 
   // Ack the last 2 packets
   lp::Packet ackPkt1;
@@ -710,6 +710,91 @@ BOOST_AUTO_TEST_CASE(CancelLossNotificationOnAck)
   BOOST_CHECK_EQUAL(linkService->getCounters().nInterestsExceededRetx, 0);
 }
 
+BOOST_AUTO_TEST_CASE(RtoShrinksBetweenSends)
+{
+  linkService->sendLpPackets({makeFrag(1024, 50)});
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 1);
+  lp::Sequence firstTxSeq = reliability->m_unackedFrags.getFirstTxSeq();
+  BOOST_CHECK_EQUAL(reliability->m_rttEst.getEstimatedRto(), 1_s);
+
+  // a small RTT sample brings the RTO down to its minimum
+  reliability->m_rttEst.addMeasurement(10_ms);
+  BOOST_REQUIRE_EQUAL(reliability->m_rttEst.getEstimatedRto(), 200_ms);
+  linkService->sendLpPackets({makeFrag(3000, 30)});
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 2);
+
+  // T+300ms: the second fragment is retransmitted although the first one has not expired
+  advanceClocks(1_ms, 300);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 3);
+  BOOST_CHECK_EQUAL(getPktNum(lp::Packet(transport->sentPackets.back())), 3000);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq), 1);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq).retxCount, 0);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + 1), 0);
+  BOOST_REQUIRE_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + 2), 1);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 2).retxCount, 1);
+
+  // T+1050ms: the first fragment is retransmitted when its own RTO expires
+  advanceClocks(1_ms, 750);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq), 0);
+  lp::Sequence retxTxSeq = reliability->m_lastTxSeqNo;
+  BOOST_REQUIRE_EQUAL(reliability->m_unackedFrags.count(retxTxSeq), 1);
+  BOOST_CHECK_EQUAL(getPktNum(reliability->m_unackedFrags.at(retxTxSeq).pkt), 1024);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(retxTxSeq).retxCount, 1);
+  BOOST_CHECK_EQUAL(getPktNum(lp::Packet(transport->sentPackets.back())), 1024);
+}
+
+BOOST_AUTO_TEST_CASE(WindowGrowth)
+{
+  const size_t nFrags = 3 * LpReliability::UnackedFrags::INITIAL_CAPACITY;
+  auto opts = linkService->getOptions();
+  opts.reliabilityOptions.seqNumLossThreshold = nFrags; // no loss detection by greater Acks
+  linkService->setOptions(opts);
+  reliability->m_lastTxSeqNo = 0xFFFFFFFFFFFFFFF0;
+  lp::Sequence firstTxSeq = reliability->m_lastTxSeqNo + 1;
+
+  for (size_t i = 0; i < nFrags; ++i) {
+    linkService->sendLpPackets({makeFrag(static_cast<uint32_t>(i), 50)});
+  }
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), nFrags);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), firstTxSeq);
+
+  // acknowledge every other fragment, except the first
+  lp::Packet ackPkt;
+  for (size_t i = 1; i < nFrags; i += 2) {
+    ackPkt.add<lp::AckField>(firstTxSeq + i);
+  }
+  BOOST_CHECK(reliability->processIncomingPacket(ackPkt));
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), nFrags / 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), firstTxSeq);
+  for (size_t i = 0; i < nFrags; ++i) {
+    BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + i), i % 2 == 0 ? 1 : 0);
+  }
+  BOOST_CHECK_EQUAL(getPktNum(reliability->m_unackedFrags.at(firstTxSeq + 10).pkt), 10);
+  BOOST_CHECK_THROW(reliability->m_unackedFrags.at(firstTxSeq + 11), std::out_of_range);
+  BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, nFrags / 2);
+
+  // the first two remaining fragments are acknowledged, the window moves past the gaps
+  lp::Packet ackPkt2;
+  ackPkt2.add<lp::AckField>(firstTxSeq);
+  ackPkt2.add<lp::AckField>(firstTxSeq + 2);
+  BOOST_CHECK(reliability->processIncomingPacket(ackPkt2));
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), nFrags / 2 - 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), firstTxSeq + 4);
+
+  // the remaining fragments time out together, and are retransmitted in TxSequence order
+  size_t nSentBefore = transport->sentPackets.size();
+  advanceClocks(1_ms, 1000);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), nSentBefore + nFrags / 2 - 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), nFrags / 2 - 2);
+  lp::Sequence retxTxSeq = firstTxSeq + nFrags;
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), retxTxSeq);
+  for (size_t i = 4; i < nFrags; i += 2, ++retxTxSeq) {
+    BOOST_REQUIRE_EQUAL(reliability->m_unackedFrags.count(retxTxSeq), 1);
+    BOOST_CHECK_EQUAL(getPktNum(reliability->m_unackedFrags.at(retxTxSeq).pkt), i);
+    BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(retxTxSeq).retxCount, 1);
+  }
+}
+
 BOOST_AUTO_TEST_CASE(ProcessIncomingPacket)
 {
   BOOST_CHECK(!reliability->m_idleAckTimer);
@@ -724,8 +809,7 @@ BOOST_AUTO_TEST_CASE(ProcessIncomingPacket)
   BOOST_CHECK(reliability->m_idleAckTimer);
   BOOST_REQUIRE_EQUAL(reliability->m_ackQueue.size(), 1);
   BOOST_CHECK_EQUAL(reliability->m_ackQueue.front(), 765432);
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.size(), 1);
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.count(123456), 1);
+  BOOST_CHECK(reliability->m_recentRecvSeqs.contains(123456));
 
   lp::Packet pkt2 = makeFrag(276, 40);
   pkt2.add<lp::SequenceField>(654321);
@@ -737,9 +821,8 @@ BOOST_AUTO_TEST_CASE(ProcessIncomingPacket)
   BOOST_REQUIRE_EQUAL(reliability->m_ackQueue.size(), 2);
   BOOST_CHECK_EQUAL(reliability->m_ackQueue.front(), 765432);
   BOOST_CHECK_EQUAL(reliability->m_ackQueue.back(), 234567);
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.size(), 2);
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.count(123456), 1);
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.count(654321), 1);
+  BOOST_CHECK(reliability->m_recentRecvSeqs.contains(123456));
+  BOOST_CHECK(reliability->m_recentRecvSeqs.contains(654321));
 
   // T+5ms
   advanceClocks(1_ms, 5);
@@ -939,56 +1022,94 @@ BOOST_AUTO_TEST_CASE(IdleAckTimerMtu)
 
 BOOST_AUTO_TEST_CASE(TrackRecentReceivedLpPackets)
 {
-  lp::Packet pkt1 = makeFrag(1, 100);
-  pkt1.add<lp::SequenceField>(7);
-  pkt1.add<lp::TxSequenceField>(12);
-  BOOST_CHECK(reliability->processIncomingPacket({pkt1}));
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqsQueue.size(), 1);
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqsQueue.front(), 7);
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.size(), 1);
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.count(7), 1);
+  const lp::Sequence windowSize = LpReliability::RecvSeqWindow::WINDOW_SIZE;
+  lp::Sequence txSeq = 12;
+  auto receive = [&] (lp::Sequence seq) {
+    lp::Packet pkt = makeFrag(1, 100);
+    pkt.add<lp::SequenceField>(seq);
+    pkt.add<lp::TxSequenceField>(txSeq++);
+    return reliability->processIncomingPacket({pkt});
+  };
+
+  BOOST_CHECK(receive(7));
+  BOOST_CHECK(reliability->m_recentRecvSeqs.contains(7));
+  BOOST_CHECK(!reliability->m_recentRecvSeqs.contains(8));
+
+  // out of order, within the window
+  BOOST_CHECK(receive(23));
+  BOOST_CHECK(receive(9));
+  BOOST_CHECK(reliability->m_recentRecvSeqs.contains(7));
+  BOOST_CHECK(!reliability->m_recentRecvSeqs.contains(8));
+  BOOST_CHECK(reliability->m_recentRecvSeqs.contains(9));
+  BOOST_CHECK(reliability->m_recentRecvSeqs.contains(23));
+  BOOST_CHECK(!receive(9));
+
+  // Sequence 7 falls out of the window, but 9 and 23 remain
+  BOOST_CHECK(receive(7 + windowSize));
+  BOOST_CHECK(!reliability->m_recentRecvSeqs.contains(7));
+  BOOST_CHECK(reliability->m_recentRecvSeqs.contains(9));
+  BOOST_CHECK(reliability->m_recentRecvSeqs.contains(23));
+  BOOST_CHECK(reliability->m_recentRecvSeqs.contains(7 + windowSize));
+  BOOST_CHECK(!receive(23));
+
+  // a Sequence far ahead resets the window
+  BOOST_CHECK(receive(7 + 3 * windowSize));
+  BOOST_CHECK(!reliability->m_recentRecvSeqs.contains(23));
+  BOOST_CHECK(!reliability->m_recentRecvSeqs.contains(7 + windowSize));
+  BOOST_CHECK(reliability->m_recentRecvSeqs.contains(7 + 3 * windowSize));
+
+  // so does a Sequence far behind, e.g. after the peer restarts
+  BOOST_CHECK(receive(5));
+  BOOST_CHECK(!reliability->m_recentRecvSeqs.contains(7 + 3 * windowSize));
+  BOOST_CHECK(reliability->m_recentRecvSeqs.contains(5));
+  BOOST_CHECK(!receive(5));
+}
 
-  // T+500ms
-  // Estimated RTO starts at 1000ms and we are not adding any measurements, so it should remain
-  // this value throughout the test case
-  advanceClocks(500_ms, 1);
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.size(), 1);
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.count(7), 1);
-  lp::Packet pkt2 = makeFrag(1, 100);
-  pkt2.add<lp::SequenceField>(23);
-  pkt2.add<lp::TxSequenceField>(13);
-  BOOST_CHECK(reliability->processIncomingPacket({pkt2}));
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqsQueue.size(), 2);
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqsQueue.front(), 7);
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.size(), 2);
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.count(7), 1);
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.count(23), 1);
+BOOST_AUTO_TEST_CASE(TrackRecentReceivedLpPacketsExpire)
+{
+  lp::Sequence txSeq = 12;
+  auto receive = [&] (lp::Sequence seq) {
+    lp::Packet pkt = makeFrag(1, 100);
+    pkt.add<lp::SequenceField>(seq);
+    pkt.add<lp::TxSequenceField>(txSeq++);
+    return reliability->processIncomingPacket({pkt});
+  };
+
+  for (lp::Sequence seq = 0; seq < 200; ++seq) {
+    BOOST_CHECK(receive(seq));
+  }
 
-  // T+1250ms
-  // First received sequence should be removed after next received packet, but second should remain
-  advanceClocks(750_ms, 1);
-  lp::Packet pkt3 = makeFrag(1, 100);
-  pkt3.add<lp::SequenceField>(24);
-  pkt3.add<lp::TxSequenceField>(14);
-  BOOST_CHECK(reliability->processIncomingPacket({pkt3}));
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqsQueue.size(), 2);
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqsQueue.front(), 23);
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.size(), 2);
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.count(23), 1);
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.count(24), 1);
-
-  // T+1750ms
-  // Second received sequence should be removed
-  advanceClocks(500_ms, 1);
-  lp::Packet pkt4 = makeFrag(1, 100);
-  pkt4.add<lp::SequenceField>(25);
-  pkt4.add<lp::TxSequenceField>(15);
-  BOOST_CHECK(reliability->processIncomingPacket({pkt4}));
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqsQueue.size(), 2);
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqsQueue.front(), 24);
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.size(), 2);
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.count(24), 1);
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.count(25), 1);
+  // within one RTO, a Sequence is a duplicate
+  advanceClocks(reliability->m_rttEst.getEstimatedRto() / 2);
+  BOOST_CHECK(!receive(50));
+
+  // the peer restarts: its Sequences start again at 0, behind the greatest Sequence received,
+  // but they are no longer duplicates after one RTO
+  advanceClocks(reliability->m_rttEst.getEstimatedRto() + 1_ms);
+  for (lp::Sequence seq = 0; seq < 100; ++seq) {
+    BOOST_CHECK(receive(seq));
+  }
+  BOOST_CHECK(!receive(50));
+}
+
+BOOST_AUTO_TEST_CASE(TrackRecentReceivedLpPacketsWraparound)
+{
+  lp::Sequence txSeq = 12;
+  auto receive = [&] (lp::Sequence seq) {
+    lp::Packet pkt = makeFrag(1, 100);
+    pkt.add<lp::SequenceField>(seq);
+    pkt.add<lp::TxSequenceField>(txSeq++);
+    return reliability->processIncomingPacket({pkt});
+  };
+
+  BOOST_CHECK(receive(0xFFFFFFFFFFFFFFFE));
+  BOOST_CHECK(receive(1));
+  BOOST_CHECK(receive(0xFFFFFFFFFFFFFFFF));
+  BOOST_CHECK(!reliability->m_recentRecvSeqs.contains(0));
+  BOOST_CHECK(!receive(0xFFFFFFFFFFFFFFFE));
+  BOOST_CHECK(!receive(0xFFFFFFFFFFFFFFFF));
+  BOOST_CHECK(!receive(1));
+  BOOST_CHECK(receive(0));
 }
 
 BOOST_AUTO_TEST_CASE(DropDuplicateReceivedSequence)
@@ -1000,16 +1121,14 @@ BOOST_AUTO_TEST_CASE(DropDuplicateReceivedSequence)
   pkt1.add<lp::SequenceField>(7);
   pkt1.add<lp::TxSequenceField>(12);
   BOOST_CHECK(reliability->processIncomingPacket({pkt1}));
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.size(), 1);
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.count(7), 1);
+  BOOST_CHECK(reliability->m_recentRecvSeqs.contains(7));
 
   lp::Packet pkt2;
   pkt2.add<lp::FragmentField>({interest.wireEncode().begin(), interest.wireEncode().end()});
   pkt2.add<lp::SequenceField>(7);
   pkt2.add<lp::TxSequenceField>(13);
   BOOST_CHECK(!reliability->processIncomingPacket({pkt2}));
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.size(), 1);
-  BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.count(7), 1);
+  BOOST_CHECK(reliability->m_recentRecvSeqs.contains(7));
 }
 
 BOOST_AUTO_TEST_CASE(DropDuplicateAckForRetx)
@@ -1020,7 +1139,7 @@ BOOST_AUTO_TEST_CASE(DropDuplicateAckForRetx)
   // Will send out a single fragment
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 1);
-  lp::Sequence firstTxSeq = reliability->m_firstUnackedFrag->first;
+  lp::Sequence firstTxSeq = reliability->m_unackedFrags.getFirstTxSeq();
 
   // RTO is initially 1 second, so will time out and retx
   advanceClocks(1250_ms, 1);
@@ -1037,7 +1156,7 @@ BOOST_AUTO_TEST_CASE(DropDuplicateAckForRetx)
   // Acknowledge second transmission
   // Ack will acknowledge retx and remove unacked frag
   lp::Packet ackPkt2;
-  ackPkt2.add<lp::AckField>(reliability->m_firstUnackedFrag->first);
+  ackPkt2.add<lp::AckField>(reliability->m_unackedFrags.getFirstTxSeq());
   reliability->processIncomingPacket(ackPkt2);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 0);
 }
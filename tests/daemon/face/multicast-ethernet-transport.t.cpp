@@ -129,6 +129,36 @@ BOOST_AUTO_TEST_CASE(Close)
   BOOST_REQUIRE_EQUAL(limitedIo.run(1, 1_s), LimitedIo::EXCEED_OPS);
 }
 
+#if defined(__linux__)
+BOOST_AUTO_TEST_CASE(TpacketBackend)
+{
+  SKIP_IF_NO_RUNNING_ETHERNET_NETIF();
+  try {
+    initializeMulticast(getRunningNetif(), ndn::nfd::LINK_TYPE_MULTI_ACCESS,
+                        {0x01, 0x00, 0x5e, 0x90, 0x10, 0x5e}, EthernetTransport::Backend::TPACKET);
+  }
+  catch (const EthernetTransport::Error& e) {
+    BOOST_WARN_MESSAGE(false, "skipping assertions that require TPACKET_V3 support: "s + e.what());
+    return;
+  }
+  BOOST_CHECK_EQUAL(transport->getState(), TransportState::UP);
+
+  // frames queued in the same event loop iteration are flushed together
+  transport->send(ndn::encoding::makeStringBlock(300, "hello"));
+  transport->send(ndn::encoding::makeStringBlock(301, "world"));
+  limitedIo.defer(10_ms);
+  BOOST_CHECK_EQUAL(transport->getCounters().nOutPackets, 2);
+  BOOST_CHECK_EQUAL(transport->getState(), TransportState::UP);
+
+  transport->close();
+  transport->afterStateChange.connectSingleShot([this] (auto, auto newState) {
+    BOOST_CHECK_EQUAL(newState, TransportState::CLOSED);
+    this->limitedIo.afterOp();
+  });
+  BOOST_REQUIRE_EQUAL(limitedIo.run(1, 1_s), LimitedIo::EXCEED_OPS);
+}
+#endif // __linux__
+
 BOOST_AUTO_TEST_CASE(SendQueueLength)
 {
   SKIP_IF_ETHERNET_NETIF_COUNT_LT(1);
@@ -0,0 +1,122 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face/receive-buffer-pool.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace face {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Face)
+BOOST_AUTO_TEST_SUITE(TestReceiveBufferPool)
+
+BOOST_AUTO_TEST_CASE(Recycle)
+{
+  ReceiveBufferPool pool(1000, 2);
+  BOOST_CHECK_EQUAL(pool.getBufferSize(), 1000);
+
+  auto b1 = pool.acquire();
+  BOOST_CHECK_EQUAL(b1->size(), 1000);
+  auto b2 = pool.acquire();
+  auto b3 = pool.acquire();
+  BOOST_CHECK_EQUAL(pool.getNAllocations(), 3);
+  BOOST_CHECK_EQUAL(pool.getNIdle(), 0);
+
+  // a buffer returns to the pool when its last reference is released
+  const ndn::Buffer* p1 = b1.get();
+  ndn::ConstBufferPtr ref1 = b1;
+  b1.reset();
+  BOOST_CHECK_EQUAL(pool.getNIdle(), 0);
+  ref1.reset();
+  BOOST_CHECK_EQUAL(pool.getNIdle(), 1);
+
+  b1 = pool.acquire();
+  BOOST_CHECK_EQUAL(b1.get(), p1);
+  BOOST_CHECK_EQUAL(b1->size(), 1000);
+  BOOST_CHECK_EQUAL(pool.getNAllocations(), 3);
+
+  // no more than maxIdle buffers are kept
+  b1.reset();
+  b2.reset();
+  b3.reset();
+  BOOST_CHECK_EQUAL(pool.getNIdle(), 2);
+
+  pool.setMaxIdle(1);
+  BOOST_CHECK_EQUAL(pool.getNIdle(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(OutlivePool)
+{
+  shared_ptr<ndn::Buffer> buffer;
+  {
+    ReceiveBufferPool pool;
+    buffer = pool.acquire();
+    BOOST_CHECK_EQUAL(buffer->size(), ndn::MAX_NDN_PACKET_SIZE);
+  }
+  // the buffer is freed when released after the pool is destroyed
+  buffer->front() = 0xFF;
+  buffer.reset();
+}
+
+BOOST_AUTO_TEST_CASE(SizeClasses)
+{
+  ReceiveBufferPool pool(8800, 2);
+  BOOST_CHECK_EQUAL(pool.acquire(8800)->size(), 8800);
+  BOOST_CHECK_EQUAL(pool.acquire(9000)->size(), 8800);
+  BOOST_CHECK_EQUAL(pool.acquire(4401)->size(), 8800);
+  BOOST_CHECK_EQUAL(pool.acquire(4400)->size(), 4400);
+  BOOST_CHECK_EQUAL(pool.acquire(1500)->size(), 2200);
+  BOOST_CHECK_EQUAL(pool.acquire(100)->size(), 275);
+  BOOST_CHECK_EQUAL(pool.acquire(0)->size(), 275);
+
+  // each buffer was released before the next acquire, and recycled within its size class
+  BOOST_CHECK_EQUAL(pool.getNAllocations(), 4);
+  BOOST_CHECK_EQUAL(pool.getNIdle(), 4);
+
+  auto b1 = pool.acquire(1500);
+  auto b2 = pool.acquire(1500);
+  BOOST_CHECK_EQUAL(pool.getNAllocations(), 5);
+  BOOST_CHECK_EQUAL(pool.getNIdle(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(CanShare)
+{
+  BOOST_CHECK_EQUAL(canShareReceiveBuffer(8800, 8800), true);
+  BOOST_CHECK_EQUAL(canShareReceiveBuffer(4400, 8800), true);
+  BOOST_CHECK_EQUAL(canShareReceiveBuffer(4399, 8800), false);
+  BOOST_CHECK_EQUAL(canShareReceiveBuffer(1101, 2200), true);
+  BOOST_CHECK_EQUAL(canShareReceiveBuffer(100, 2200), false);
+  // buffers of the smallest size class are always shared
+  BOOST_CHECK_EQUAL(canShareReceiveBuffer(10, 275), true);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestReceiveBufferPool
+BOOST_AUTO_TEST_SUITE_END() // Face
+
+} // namespace tests
+} // namespace face
+} // namespace nfd
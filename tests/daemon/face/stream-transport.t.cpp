@@ -70,6 +70,83 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(Send, T, StreamTransportFixtures, T)
   BOOST_CHECK_EQUAL(this->transport->getState(), TransportState::UP);
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(SendCoalesced, T, StreamTransportFixtures, T)
+{
+  TRANSPORT_TEST_INIT();
+
+  StreamTransportOptions options;
+  options.maxWriteDelay = 50_ms;
+  this->transport->setOptions(options);
+
+  std::vector<Block> blocks{ndn::encoding::makeStringBlock(300, "hello"),
+                            ndn::encoding::makeStringBlock(301, "world"),
+                            ndn::encoding::makeStringBlock(302, "again")};
+  size_t totalBytes = 0;
+  for (const auto& block : blocks) {
+    this->transport->send(block);
+    totalBytes += block.size();
+  }
+
+  const auto& counters = this->transport->getCounters();
+  BOOST_CHECK_EQUAL(counters.nOutPackets, 3);
+  BOOST_CHECK_EQUAL(counters.nWriteCalls, 0);
+  BOOST_CHECK_GE(this->transport->getSendQueueLength(), static_cast<ssize_t>(totalBytes));
+
+  std::vector<uint8_t> readBuf(totalBytes);
+  boost::asio::async_read(this->remoteSocket, boost::asio::buffer(readBuf),
+    [this] (const boost::system::error_code& error, size_t) {
+      BOOST_REQUIRE_EQUAL(error, boost::system::errc::success);
+      this->limitedIo.afterOp();
+    });
+
+  BOOST_REQUIRE_EQUAL(this->limitedIo.run(1, 1_s), LimitedIo::EXCEED_OPS);
+  this->limitedIo.defer(10_ms);
+
+  auto it = readBuf.begin();
+  for (const auto& block : blocks) {
+    BOOST_CHECK_EQUAL_COLLECTIONS(it, it + block.size(), block.begin(), block.end());
+    it += block.size();
+  }
+  BOOST_CHECK_EQUAL(counters.nWriteCalls, 1);
+  BOOST_CHECK_EQUAL(counters.nWritePackets, 3);
+  BOOST_CHECK_EQUAL(counters.nWrittenBytes, totalBytes);
+  BOOST_CHECK_EQUAL(this->transport->getState(), TransportState::UP);
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(SendMaxWriteBytes, T, StreamTransportFixtures, T)
+{
+  TRANSPORT_TEST_INIT();
+
+  auto block1 = ndn::encoding::makeStringBlock(300, "hello");
+  auto block2 = ndn::encoding::makeStringBlock(301, "world");
+
+  StreamTransportOptions options;
+  options.maxWriteBytes = block1.size();
+  options.maxWriteDelay = 50_ms;
+  this->transport->setOptions(options);
+
+  // reaching maxWriteBytes starts the write without waiting for maxWriteDelay
+  this->transport->send(block1);
+  this->transport->send(block2);
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nWriteCalls, 1);
+
+  std::vector<uint8_t> readBuf(block1.size() + block2.size());
+  boost::asio::async_read(this->remoteSocket, boost::asio::buffer(readBuf),
+    [this] (const boost::system::error_code& error, size_t) {
+      BOOST_REQUIRE_EQUAL(error, boost::system::errc::success);
+      this->limitedIo.afterOp();
+    });
+
+  BOOST_REQUIRE_EQUAL(this->limitedIo.run(1, 1_s), LimitedIo::EXCEED_OPS);
+  this->limitedIo.defer(10_ms);
+
+  BOOST_CHECK_EQUAL_COLLECTIONS(readBuf.begin(), readBuf.begin() + block1.size(), block1.begin(), block1.end());
+  BOOST_CHECK_EQUAL_COLLECTIONS(readBuf.begin() + block1.size(), readBuf.end(),   block2.begin(), block2.end());
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nWriteCalls, 2);
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nWritePackets, 2);
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nWrittenBytes, readBuf.size());
+}
+
 BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceiveNormal, T, StreamTransportFixtures, T)
 {
   TRANSPORT_TEST_INIT();
@@ -134,6 +211,8 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceiveMultipleBlocks, T, StreamTransportFixtur
   BOOST_CHECK_EQUAL(this->transport->getCounters().nInPackets, 2);
   BOOST_CHECK_EQUAL(this->transport->getCounters().nInBytes, buf.size());
   BOOST_CHECK_EQUAL(this->receivedPackets->size(), 2);
+  BOOST_CHECK_GE(this->transport->getCounters().nReadCalls, 1);
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nReadBytes, buf.size());
   BOOST_CHECK_EQUAL(this->transport->getState(), TransportState::UP);
 }
 
@@ -63,6 +63,42 @@ BOOST_AUTO_TEST_CASE(Normal)
   BOOST_CHECK_NE(uri.getPath().find("nfd-test.sock"), std::string::npos);
 }
 
+BOOST_AUTO_TEST_CASE(WriteCoalescing)
+{
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      unix
+      {
+        path /tmp/nfd-test.sock
+        max_write_bytes 131072
+        max_write_delay 200
+      }
+    }
+  )CONFIG";
+
+  parseConfig(CONFIG, true);
+  parseConfig(CONFIG, false);
+
+  BOOST_REQUIRE_EQUAL(factory.getChannels().size(), 1);
+  const auto& options = static_cast<const UnixStreamChannel&>(*factory.getChannels().front())
+                          .getTransportOptions();
+  BOOST_CHECK_EQUAL(options.maxWriteBytes, 131072);
+  BOOST_CHECK_EQUAL(options.maxWriteDelay, 200_us);
+
+  const std::string BAD_CONFIG = R"CONFIG(
+    face_system
+    {
+      unix
+      {
+        max_write_bytes 1048577
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(parseConfig(BAD_CONFIG, true), ConfigFile::Error);
+}
+
 BOOST_AUTO_TEST_CASE(Omitted)
 {
   const std::string CONFIG = R"CONFIG(
@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/amif-measurements.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace fw {
+namespace amif {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_AUTO_TEST_SUITE(TestAmifMeasurements)
+
+BOOST_AUTO_TEST_CASE(InsertErase)
+{
+  PathTable table;
+  BOOST_CHECK_EQUAL(table.size(), 0);
+  BOOST_CHECK(table.getBestCandidate() == nullptr);
+  BOOST_CHECK(table.getBestSelected() == nullptr);
+
+  PathStats* p1 = table.insertPath(101);
+  BOOST_REQUIRE(p1 != nullptr);
+  BOOST_CHECK_EQUAL(p1->outFace, 101);
+  BOOST_CHECK_EQUAL(table.insertPath(101), p1);
+  BOOST_CHECK_EQUAL(table.size(), 1);
+
+  for (FaceId faceId = 102; table.size() < PathTable::MAX_PATHS; ++faceId) {
+    BOOST_CHECK(table.insertPath(faceId) != nullptr);
+  }
+  BOOST_CHECK(table.insertPath(999) == nullptr);
+
+  BOOST_CHECK_EQUAL(table.erasePath(101), true);
+  BOOST_CHECK_EQUAL(table.erasePath(101), false);
+  BOOST_CHECK(table.findPath(101) == nullptr);
+  BOOST_CHECK_EQUAL(table.size(), PathTable::MAX_PATHS - 1);
+  BOOST_CHECK_EQUAL(table.getCandidateCount(), PathTable::MAX_PATHS - 1);
+}
+
+BOOST_AUTO_TEST_CASE(OrderByDegreeAndQuota)
+{
+  PathTable table;
+  const double degrees[] = {3.0, 9.0, 1.0, 7.0, 5.0};
+  FaceId faceId = 201;
+  for (double degree : degrees) {
+    table.setDegree(*table.insertPath(faceId++), degree);
+  }
+
+  // candidates come out by descending degree
+  PathStats* best = table.getBestCandidate();
+  BOOST_CHECK_EQUAL(best->outFace, 202);
+  table.selectPath(*best);
+  table.setQuota(*best, 2.0);
+  best = table.getBestCandidate();
+  BOOST_CHECK_EQUAL(best->outFace, 204);
+  table.selectPath(*best);
+  table.setQuota(*best, 4.0);
+  BOOST_CHECK_EQUAL(table.getCandidateCount(), 3);
+  BOOST_CHECK_EQUAL(table.getSelectedCount(), 2);
+
+  // lowering a degree reorders the candidates
+  table.setDegree(*table.findPath(205), 0.5);
+  BOOST_CHECK_EQUAL(table.getBestCandidate()->outFace, 201);
+
+  // selected paths come out by descending quota
+  BOOST_CHECK_EQUAL(table.getBestSelected()->outFace, 204);
+  table.setQuota(*table.findPath(204), 1.0);
+  BOOST_CHECK_EQUAL(table.getBestSelected()->outFace, 202);
+
+  // erasing a selected path keeps both heaps consistent
+  BOOST_CHECK_EQUAL(table.erasePath(202), true);
+  BOOST_CHECK_EQUAL(table.getBestSelected()->outFace, 204);
+  BOOST_CHECK_EQUAL(table.getBestCandidate()->outFace, 201);
+
+  table.unselectAll();
+  BOOST_CHECK_EQUAL(table.getSelectedCount(), 0);
+  BOOST_CHECK_EQUAL(table.getCandidateCount(), 4);
+  BOOST_CHECK_EQUAL(table.getBestCandidate()->outFace, 204);
+}
+
+BOOST_AUTO_TEST_CASE(QuotaPeriodPerPrefix)
+{
+  PathTable a;
+  PathTable b;
+  BOOST_CHECK_EQUAL(a.advanceQuotaPeriod(3), false);
+  BOOST_CHECK_EQUAL(a.advanceQuotaPeriod(3), false);
+
+  // refreshes on another prefix do not advance this prefix's period
+  BOOST_CHECK_EQUAL(b.advanceQuotaPeriod(3), false);
+  BOOST_CHECK_EQUAL(b.advanceQuotaPeriod(3), false);
+  BOOST_CHECK_EQUAL(a.advanceQuotaPeriod(3), true);
+  BOOST_CHECK_EQUAL(b.advanceQuotaPeriod(3), true);
+
+  // the period restarts after it elapses
+  BOOST_CHECK_EQUAL(a.advanceQuotaPeriod(3), false);
+  BOOST_CHECK_EQUAL(a.advanceQuotaPeriod(3), false);
+  BOOST_CHECK_EQUAL(a.advanceQuotaPeriod(3), true);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestAmifMeasurements
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace amif
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,144 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/lamdp-measurements.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+namespace nfd {
+namespace fw {
+namespace lamdp {
+namespace tests {
+
+using namespace nfd::tests;
+
+class AutomatonFixture : public GlobalIoFixture
+{
+protected:
+  AutomatonFixture()
+  {
+    for (FaceId faceId = 301; faceId <= 304; ++faceId) {
+      auto face = make_shared<DummyFace>();
+      face->setId(faceId);
+      faces.push_back(face);
+      nexthops.emplace_back(*face);
+    }
+  }
+
+  double
+  sumProbabilities() const
+  {
+    double sum = 0.0;
+    for (size_t i = 0; i < automaton.size(); ++i) {
+      sum += automaton[i].probability;
+    }
+    return sum;
+  }
+
+protected:
+  std::vector<shared_ptr<Face>> faces;
+  fib::NextHopList nexthops;
+  Automaton automaton;
+};
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_FIXTURE_TEST_SUITE(TestLamdpMeasurements, AutomatonFixture)
+
+BOOST_AUTO_TEST_CASE(SyncActions)
+{
+  BOOST_CHECK_EQUAL(automaton.choose(0.5), Automaton::MAX_ACTIONS);
+
+  automaton.syncActions(nexthops);
+  BOOST_REQUIRE_EQUAL(automaton.size(), 4);
+  for (size_t i = 0; i < automaton.size(); ++i) {
+    BOOST_CHECK_EQUAL(automaton[i].face, nexthops[i].getFace().getId());
+    BOOST_CHECK_CLOSE(automaton[i].probability, 0.25, 0.001);
+  }
+
+  // learned probabilities survive a change of nexthops
+  automaton.afterData(automaton.find(302), 10_ms);
+  double p302 = automaton[automaton.find(302)].probability;
+  nexthops.erase(nexthops.begin());
+  automaton.syncActions(nexthops);
+  BOOST_CHECK_EQUAL(automaton.size(), 3);
+  BOOST_CHECK_EQUAL(automaton.find(301), Automaton::MAX_ACTIONS);
+  BOOST_CHECK_GT(automaton[automaton.find(302)].probability, p302);
+  BOOST_CHECK_CLOSE(sumProbabilities(), 1.0, 0.001);
+}
+
+BOOST_AUTO_TEST_CASE(Choose)
+{
+  automaton.syncActions(nexthops);
+
+  // uniform probabilities and no measurements yield a uniform distribution
+  BOOST_CHECK_EQUAL(automaton.choose(0.0), 0);
+  BOOST_CHECK_EQUAL(automaton.choose(0.3), 1);
+  BOOST_CHECK_EQUAL(automaton.choose(0.6), 2);
+  BOOST_CHECK_EQUAL(automaton.choose(0.99), 3);
+
+  // pending Interests lower the weighted probability of an action
+  automaton.beforeSend(0);
+  automaton.beforeSend(0);
+  BOOST_CHECK_LT(automaton.getWeightedProbability(0), automaton.getWeightedProbability(1));
+  BOOST_CHECK_EQUAL(automaton[0].nPending, 2);
+  automaton.afterFailure(0);
+  BOOST_CHECK_EQUAL(automaton[0].nPending, 2);
+  automaton.endPending(0);
+  automaton.endPending(0);
+  automaton.endPending(0);
+  BOOST_CHECK_EQUAL(automaton[0].nPending, 0);
+}
+
+BOOST_AUTO_TEST_CASE(Convergence)
+{
+  automaton.syncActions(nexthops);
+
+  // face 303 always brings Data back, the other faces fail in turn
+  size_t best = automaton.find(303);
+  const size_t others[] = {automaton.find(301), automaton.find(302), automaton.find(304)};
+  for (int n = 0; n < 100; ++n) {
+    automaton.beforeSend(best);
+    automaton.endPending(best);
+    automaton.afterData(best, 20_ms);
+    size_t i = others[n % 3];
+    automaton.beforeSend(i);
+    automaton.endPending(i);
+    automaton.afterFailure(i);
+    BOOST_CHECK_CLOSE(sumProbabilities(), 1.0, 0.001);
+  }
+
+  BOOST_CHECK_GT(automaton.getWeightedProbability(best), 0.7);
+  BOOST_CHECK_EQUAL(automaton.choose(0.5), best);
+  BOOST_CHECK_EQUAL(automaton[best].srtt, 20_ms);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestLamdpMeasurements
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace lamdp
+} // namespace fw
+} // namespace nfd
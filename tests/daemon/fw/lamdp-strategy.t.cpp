@@ -0,0 +1,107 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/lamdp-strategy.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+#include "choose-strategy.hpp"
+
+namespace nfd {
+namespace fw {
+namespace tests {
+
+using namespace nfd::tests;
+
+class LamdpStrategyFixture : public GlobalIoTimeFixture
+{
+protected:
+  LamdpStrategyFixture()
+  {
+    faceTable.add(face1);
+    faceTable.add(face2);
+
+    fib::Entry& fibEntry = *forwarder.getFib().insert("/").first;
+    forwarder.getFib().addOrUpdateNextHop(fibEntry, *face2, 10);
+  }
+
+  size_t
+  getPending(const Name& name)
+  {
+    lamdp::Automaton* automaton = strategy.m_measurements.getAutomaton(name);
+    BOOST_REQUIRE(automaton != nullptr);
+    size_t i = automaton->find(face2->getId());
+    BOOST_REQUIRE_NE(i, lamdp::Automaton::MAX_ACTIONS);
+    return (*automaton)[i].nPending;
+  }
+
+protected:
+  FaceTable faceTable;
+  Forwarder forwarder{faceTable};
+  LAMDPStrategy& strategy{choose<LAMDPStrategy>(forwarder)};
+
+  shared_ptr<DummyFace> face1 = make_shared<DummyFace>();
+  shared_ptr<DummyFace> face2 = make_shared<DummyFace>();
+};
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_FIXTURE_TEST_SUITE(TestLamdpStrategy, LamdpStrategyFixture)
+
+BOOST_AUTO_TEST_CASE(PendingUntilData)
+{
+  auto interest = makeInterest("/A/1");
+  face1->receiveInterest(*interest, 0);
+  advanceClocks(1_ms);
+  BOOST_REQUIRE_EQUAL(face2->sentInterests.size(), 1);
+  BOOST_CHECK_EQUAL(getPending("/A/1"), 1);
+
+  face2->receiveData(*makeData("/A/1"), 0);
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(getPending("/A/1"), 0);
+}
+
+BOOST_AUTO_TEST_CASE(PendingUntilExpiry)
+{
+  for (int i = 0; i < 3; ++i) {
+    auto interest = makeInterest("/B/" + to_string(i));
+    interest->setInterestLifetime(100_ms);
+    face1->receiveInterest(*interest, 0);
+  }
+  advanceClocks(1_ms);
+  BOOST_REQUIRE_EQUAL(face2->sentInterests.size(), 3);
+  BOOST_CHECK_EQUAL(getPending("/B"), 3);
+
+  advanceClocks(10_ms, 200_ms);
+  BOOST_CHECK_EQUAL(forwarder.getPit().size(), 0);
+  BOOST_CHECK_EQUAL(getPending("/B"), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestLamdpStrategy
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace fw
+} // namespace nfd
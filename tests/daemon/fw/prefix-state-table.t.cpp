@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/prefix-state-table.hpp"
+#include "fw/pending-interest-count.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace fw {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_AUTO_TEST_SUITE(TestPrefixStateTable)
+
+BOOST_AUTO_TEST_CASE(TruncatedPrefix)
+{
+  PrefixStateTable<int> table(2);
+  BOOST_CHECK_EQUAL(table.getPrefixLength(), 2);
+  BOOST_CHECK(table.find("/A/B/C") == nullptr);
+
+  int* state = nullptr;
+  bool isNew = false;
+  std::tie(state, isNew) = table.insert("/A/B/C");
+  BOOST_REQUIRE(state != nullptr);
+  BOOST_CHECK_EQUAL(isNew, true);
+  *state = 42;
+
+  // names sharing the first two components share the state
+  std::tie(state, isNew) = table.insert("/A/B/D/E");
+  BOOST_CHECK_EQUAL(isNew, false);
+  BOOST_CHECK_EQUAL(*state, 42);
+  BOOST_REQUIRE(table.find("/A/B") != nullptr);
+  BOOST_CHECK_EQUAL(*table.find("/A/B"), 42);
+
+  // shorter names and other prefixes are distinct keys
+  BOOST_CHECK(table.find("/A") == nullptr);
+  BOOST_CHECK(table.find("/A/C/B") == nullptr);
+  BOOST_CHECK_EQUAL(table.insert("/A").second, true);
+  BOOST_CHECK_EQUAL(table.size(), 2);
+
+  BOOST_CHECK_EQUAL(table.erase("/A/B/X"), 1);
+  BOOST_CHECK_EQUAL(table.erase("/A/B/X"), 0);
+  BOOST_CHECK(table.find("/A/B/C") == nullptr);
+  BOOST_CHECK_EQUAL(table.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(KnownInFaces)
+{
+  KnownInFaceTable table;
+  BOOST_CHECK_EQUAL(table.contains("/A/1", 256), false);
+
+  table.add("/A/1", 256);
+  table.add("/A/1", 256);
+  table.add("/A/1", 257);
+  BOOST_CHECK_EQUAL(table.contains("/A/1", 256), true);
+  BOOST_CHECK_EQUAL(table.contains("/A/1", 257), true);
+  BOOST_CHECK_EQUAL(table.contains("/A/2", 256), false);
+  BOOST_CHECK_EQUAL(table.contains("/A", 256), false);
+  BOOST_CHECK_EQUAL(table.size(), 1);
+
+  table.clear("/A/1");
+  BOOST_CHECK_EQUAL(table.contains("/A/1", 256), false);
+  BOOST_CHECK_EQUAL(table.size(), 0);
+
+  table.add("/B/1", 256);
+  table.add("/B/1", 257);
+  table.add("/B/2", 256);
+  table.removeFace(256);
+  BOOST_CHECK_EQUAL(table.contains("/B/1", 256), false);
+  BOOST_CHECK_EQUAL(table.contains("/B/1", 257), true);
+  BOOST_CHECK_EQUAL(table.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(FacePics)
+{
+  FacePicTable pics;
+  BOOST_CHECK(pics.find(256) == nullptr);
+
+  PendingInterestCount& pic = pics.insert(256);
+  BOOST_CHECK_EQUAL(&pics.insert(256), &pic);
+  pics.insert(257);
+  BOOST_CHECK_EQUAL(pics.size(), 2);
+
+  double initialWeight = pic.getWeight();
+  pic.increase();
+  pic.increase();
+  BOOST_CHECK_EQUAL(pic.getCount(), 2);
+  BOOST_CHECK_LT(pic.getWeight(), initialWeight);
+  BOOST_CHECK_LT(pic.getWeight(), pics.find(257)->getWeight());
+
+  pic.decrease();
+  pic.decrease();
+  pic.decrease();
+  BOOST_CHECK_EQUAL(pic.getCount(), 0);
+
+  pics.erase(256);
+  BOOST_CHECK(pics.find(256) == nullptr);
+  BOOST_CHECK(pics.find(257) != nullptr);
+  BOOST_CHECK_EQUAL(pics.size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestPrefixStateTable
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace fw
+} // namespace nfd
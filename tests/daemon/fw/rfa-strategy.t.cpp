@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/rfa-strategy.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+#include "choose-strategy.hpp"
+
+namespace nfd {
+namespace fw {
+namespace tests {
+
+using namespace nfd::tests;
+
+class RfaStrategyFixture : public GlobalIoTimeFixture
+{
+protected:
+  RfaStrategyFixture()
+  {
+    faceTable.add(face1);
+    faceTable.add(face2);
+    faceTable.add(face3);
+
+    fib::Entry& fibEntry = *forwarder.getFib().insert("/").first;
+    forwarder.getFib().addOrUpdateNextHop(fibEntry, *face2, 10);
+    forwarder.getFib().addOrUpdateNextHop(fibEntry, *face3, 10);
+  }
+
+protected:
+  FaceTable faceTable;
+  Forwarder forwarder{faceTable};
+  RFAStrategy& strategy{choose<RFAStrategy>(forwarder)};
+
+  shared_ptr<DummyFace> face1 = make_shared<DummyFace>();
+  shared_ptr<DummyFace> face2 = make_shared<DummyFace>();
+  shared_ptr<DummyFace> face3 = make_shared<DummyFace>();
+};
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_FIXTURE_TEST_SUITE(TestRfaStrategy, RfaStrategyFixture)
+
+BOOST_AUTO_TEST_CASE(PicsPerContentPrefix)
+{
+  face1->receiveInterest(*makeInterest("/A/B/1"), 0);
+  face1->receiveInterest(*makeInterest("/A/B/2"), 0);
+  face1->receiveInterest(*makeInterest("/A/C/1"), 0);
+  face1->receiveInterest(*makeInterest("/A"), 0);
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(face2->sentInterests.size() + face3->sentInterests.size(), 4);
+  BOOST_CHECK_EQUAL(strategy.m_picTables->size(), 3);
+
+  auto pitEntry = forwarder.getPit().find(*makeInterest("/A/B/1"));
+  BOOST_REQUIRE(pitEntry != nullptr);
+  auto pics = strategy.getPics(*pitEntry, *forwarder.getFib().findExactMatch("/"));
+  BOOST_REQUIRE(pics != nullptr);
+  BOOST_CHECK_EQUAL(pics->size(), 2);
+  size_t nPending = 0;
+  for (const auto& item : *pics) {
+    nPending += item.second.getCount();
+  }
+  BOOST_CHECK_EQUAL(nPending, 2);
+}
+
+BOOST_AUTO_TEST_CASE(DeepNamespace)
+{
+  // PICs of a namespace longer than PREFIX_LENGTH are kept at the depth of that namespace
+  RFAStrategy& deepStrategy = choose<RFAStrategy>(forwarder, "/A/B/C");
+  face1->receiveInterest(*makeInterest("/A/B/C/1"), 0);
+  face1->receiveInterest(*makeInterest("/A/B/C/2/x"), 0);
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(face2->sentInterests.size() + face3->sentInterests.size(), 2);
+  BOOST_CHECK_EQUAL(deepStrategy.m_picTables->size(), 1);
+  BOOST_CHECK_EQUAL(strategy.m_picTables->size(), 0);
+
+  measurements::Entry* me = forwarder.getMeasurements().findExactMatch("/A/B/C");
+  BOOST_REQUIRE(me != nullptr);
+  BOOST_CHECK(me->getStrategyInfo<RFAStrategy::PrefixInfo>() != nullptr);
+
+  auto pitEntry = forwarder.getPit().find(*makeInterest("/A/B/C/2/x"));
+  BOOST_REQUIRE(pitEntry != nullptr);
+  auto pics = deepStrategy.getPics(*pitEntry, *forwarder.getFib().findExactMatch("/"));
+  BOOST_REQUIRE(pics != nullptr);
+  size_t nPending = 0;
+  for (const auto& item : *pics) {
+    nPending += item.second.getCount();
+  }
+  BOOST_CHECK_EQUAL(nPending, 2);
+}
+
+BOOST_AUTO_TEST_CASE(RemoveFace)
+{
+  face1->receiveInterest(*makeInterest("/A/B/1"), 0);
+  face1->receiveInterest(*makeInterest("/A/C/1"), 0);
+  advanceClocks(1_ms);
+  BOOST_REQUIRE_EQUAL(strategy.m_picTables->size(), 2);
+
+  FaceId id2 = face2->getId();
+  face2->close();
+  for (FacePicTable* pics : *strategy.m_picTables) {
+    BOOST_CHECK_EQUAL(pics->size(), 1);
+    BOOST_CHECK(pics->find(id2) == nullptr);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ExpireWithMeasurements)
+{
+  face1->receiveInterest(*makeInterest("/A/B/1"), 0);
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(strategy.m_picTables->size(), 1);
+
+  // the PIT entry expires first, then the Measurements entry
+  advanceClocks(1_s, RFAStrategy::MEASUREMENTS_LIFETIME + 10_s);
+  BOOST_CHECK_EQUAL(forwarder.getPit().size(), 0);
+  BOOST_CHECK_EQUAL(strategy.m_picTables->size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestRfaStrategy
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace fw
+} // namespace nfd
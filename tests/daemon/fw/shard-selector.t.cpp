@@ -0,0 +1,88 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/shard-selector.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace fw {
+namespace tests {
+
+using namespace nfd::tests;
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_AUTO_TEST_SUITE(TestShardSelector)
+
+BOOST_AUTO_TEST_CASE(SamePrefix)
+{
+  ShardSelector selector(8, 2);
+  BOOST_CHECK_EQUAL(selector.getNShards(), 8);
+  BOOST_CHECK_EQUAL(selector.getPrefixLength(), 2);
+
+  for (int i = 0; i < 100; ++i) {
+    Name prefix("/A");
+    prefix.append(to_string(i));
+    size_t shard = selector(prefix);
+    BOOST_CHECK_LT(shard, 8);
+
+    auto interest = makeInterest(Name(prefix).append("B"));
+    auto data = makeData(Name(prefix).append("B").appendVersion(1));
+    BOOST_CHECK_EQUAL(selector(*interest), shard);
+    BOOST_CHECK_EQUAL(selector(*data), shard);
+    BOOST_CHECK_EQUAL(selector(data->getName()), shard);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ShortName)
+{
+  ShardSelector selector(4, 3);
+  auto interest = makeInterest("/A");
+  BOOST_CHECK_EQUAL(selector(*interest), selector(Name("/A")));
+  BOOST_CHECK_LT(selector(Name()), 4);
+}
+
+BOOST_AUTO_TEST_CASE(Balance)
+{
+  const size_t nShards = 4;
+  const size_t nNames = 4000;
+  ShardSelector selector(nShards, 1);
+
+  std::vector<size_t> load(nShards);
+  for (size_t i = 0; i < nNames; ++i) {
+    ++load[selector(Name("/P" + to_string(i)))];
+  }
+  for (size_t n : load) {
+    BOOST_CHECK_GT(n, nNames / nShards * 3 / 4);
+    BOOST_CHECK_LT(n, nNames / nShards * 5 / 4);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestShardSelector
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,131 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/sl-route-channel.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <deque>
+
+namespace nfd {
+namespace fw {
+namespace tests {
+
+using namespace nfd::tests;
+
+class SlRouteChannelFixture
+{
+protected:
+  MpscChannel<SlRouteRequest>::PostFunc
+  makePost()
+  {
+    return [this] (const std::function<void()>& f) { posted.push_back(f); };
+  }
+
+  MpscChannel<SlRouteRequest>::Handler
+  makeHandler()
+  {
+    return [this] (SlRouteRequest& request) { handled.push_back(request); };
+  }
+
+  void
+  runPosted()
+  {
+    while (!posted.empty()) {
+      auto f = std::move(posted.front());
+      posted.pop_front();
+      f();
+    }
+  }
+
+protected:
+  std::deque<std::function<void()>> posted;
+  std::vector<SlRouteRequest> handled;
+};
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_FIXTURE_TEST_SUITE(TestSlRouteChannel, SlRouteChannelFixture)
+
+BOOST_AUTO_TEST_CASE(AnnounceRenew)
+{
+  SlRouteChannel channel(4, makePost(), makeHandler());
+
+  ndn::PrefixAnnouncement pa;
+  pa.setAnnouncedName("/A");
+  pa.setExpiration(5_min);
+
+  // each round trip reuses the slots written by the previous one
+  for (int round = 0; round < 3; ++round) {
+    handled.clear();
+    BOOST_CHECK(channel.announce(pa, 5, 10_s));
+    BOOST_CHECK(channel.renew("/B", 6, 20_s));
+    BOOST_CHECK(handled.empty());
+    runPosted();
+
+    BOOST_REQUIRE_EQUAL(handled.size(), 2);
+    BOOST_CHECK(handled[0].action == SlRouteRequest::Action::ANNOUNCE);
+    BOOST_CHECK_EQUAL(handled[0].faceId, 5);
+    BOOST_CHECK_EQUAL(handled[0].maxLifetime, 10_s);
+    BOOST_REQUIRE(handled[0].announcement);
+    BOOST_CHECK_EQUAL(handled[0].announcement->getAnnouncedName(), "/A");
+    BOOST_CHECK(handled[1].action == SlRouteRequest::Action::RENEW);
+    BOOST_CHECK_EQUAL(handled[1].faceId, 6);
+    BOOST_CHECK_EQUAL(handled[1].maxLifetime, 20_s);
+    BOOST_CHECK_EQUAL(handled[1].name, "/B");
+  }
+  BOOST_CHECK_EQUAL(channel.getChannel().getNSent(), 6);
+  BOOST_CHECK_EQUAL(channel.getChannel().getNReceived(), 6);
+  BOOST_CHECK_EQUAL(channel.getChannel().getNDropped(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Full)
+{
+  SlRouteChannel channel(2, makePost(), makeHandler());
+  BOOST_CHECK_EQUAL(channel.getChannel().capacity(), 2);
+
+  BOOST_CHECK(channel.renew("/A", 5, 10_s));
+  BOOST_CHECK(channel.renew("/B", 5, 10_s));
+  BOOST_CHECK(!channel.renew("/C", 5, 10_s));
+  BOOST_CHECK_EQUAL(channel.getChannel().getNSent(), 2);
+  BOOST_CHECK_EQUAL(channel.getChannel().getNDropped(), 1);
+
+  runPosted();
+  BOOST_REQUIRE_EQUAL(handled.size(), 2);
+  BOOST_CHECK_EQUAL(handled[0].name, "/A");
+  BOOST_CHECK_EQUAL(handled[1].name, "/B");
+
+  // slots are available again once their requests have been handled
+  BOOST_CHECK(channel.renew("/C", 5, 10_s));
+  runPosted();
+  BOOST_REQUIRE_EQUAL(handled.size(), 3);
+  BOOST_CHECK_EQUAL(handled[2].name, "/C");
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestSlRouteChannel
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace fw
+} // namespace nfd
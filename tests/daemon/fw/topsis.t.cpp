@@ -0,0 +1,97 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/topsis.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace fw {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_AUTO_TEST_SUITE(TestTopsis)
+
+BOOST_AUTO_TEST_CASE(Empty)
+{
+  Topsis topsis;
+  topsis.setCriterion(0, 1.0f, Topsis::CriterionType::BENEFIT);
+  BOOST_CHECK_EQUAL(topsis.rank(), Topsis::MAX_ALTERNATIVES);
+}
+
+BOOST_AUTO_TEST_CASE(Rank)
+{
+  Topsis topsis;
+  topsis.setCriterion(0, 0.5f, Topsis::CriterionType::BENEFIT);
+  topsis.setCriterion(1, 0.3f, Topsis::CriterionType::COST);
+  topsis.setCriterion(2, 0.2f, Topsis::CriterionType::COST);
+
+  const float values[3][3] = {
+    {100.0f, 3.0f, 50.0f},
+    { 50.0f, 1.0f, 20.0f},
+    {100.0f, 1.0f, 10.0f}, // ideal solution: best in every criterion
+  };
+  for (const auto& row : values) {
+    size_t i = topsis.addAlternative();
+    for (size_t j = 0; j < 3; ++j) {
+      topsis.setValue(i, j, row[j]);
+    }
+  }
+  BOOST_CHECK_EQUAL(topsis.getAlternativeCount(), 3);
+
+  BOOST_CHECK_EQUAL(topsis.rank(), 2);
+  BOOST_CHECK_CLOSE(topsis.getCloseness(2), 1.0f, 0.001);
+  BOOST_CHECK_LT(topsis.getCloseness(0), topsis.getCloseness(1));
+
+  // engine is reusable after clearing alternatives
+  topsis.clearAlternatives();
+  BOOST_CHECK_EQUAL(topsis.getAlternativeCount(), 0);
+  size_t i0 = topsis.addAlternative();
+  size_t i1 = topsis.addAlternative();
+  topsis.setValue(i0, 0, 10.0f);
+  topsis.setValue(i1, 0, 20.0f);
+  BOOST_CHECK_EQUAL(topsis.rank(), i1);
+  BOOST_CHECK_CLOSE(topsis.getCloseness(i1), 1.0f, 0.001);
+  BOOST_CHECK_EQUAL(topsis.getCloseness(i0), 0.0f);
+}
+
+BOOST_AUTO_TEST_CASE(Capacity)
+{
+  Topsis topsis;
+  topsis.setCriterion(0, 1.0f, Topsis::CriterionType::COST);
+  for (size_t i = 0; i < Topsis::MAX_ALTERNATIVES; ++i) {
+    BOOST_CHECK_EQUAL(topsis.addAlternative(), i);
+    topsis.setValue(i, 0, static_cast<float>(i + 1));
+  }
+  BOOST_CHECK_EQUAL(topsis.addAlternative(), Topsis::MAX_ALTERNATIVES);
+  BOOST_CHECK_EQUAL(topsis.rank(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestTopsis
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace fw
+} // namespace nfd
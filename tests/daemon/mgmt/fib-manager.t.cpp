@@ -443,6 +443,69 @@ BOOST_AUTO_TEST_CASE(FibDataset)
 
 BOOST_AUTO_TEST_SUITE_END() // List
 
+BOOST_AUTO_TEST_CASE(ApplyFibUpdates)
+{
+  FaceId face1 = addFace();
+  FaceId face2 = addFace();
+  FaceId unknownFace = face2 + 100;
+
+  Name longName;
+  for (size_t i = 0; i < Fib::getMaxDepth() + 1; i++) {
+    longName.append("A");
+  }
+
+  std::list<rib::FibUpdate> updates{
+    rib::FibUpdate::createAddUpdate("/hello", face1, 101),
+    rib::FibUpdate::createAddUpdate("/hello", face2, 102),
+    rib::FibUpdate::createAddUpdate("/world", face1, 103),
+    rib::FibUpdate::createAddUpdate("/world", unknownFace, 104),
+    rib::FibUpdate::createAddUpdate(longName, face1, 105),
+    rib::FibUpdate::createRemoveUpdate("/hello", face2),
+    rib::FibUpdate::createRemoveUpdate("/none", face1),
+  };
+  auto codes = m_manager.applyFibUpdates(updates);
+
+  std::vector<uint32_t> expectedCodes{200, 200, 200, 410, 414, 200, 200};
+  BOOST_CHECK_EQUAL_COLLECTIONS(codes.begin(), codes.end(),
+                                expectedCodes.begin(), expectedCodes.end());
+  BOOST_CHECK_EQUAL(checkNextHop("/hello", 1, face1, 101), CheckNextHopResult::OK);
+  BOOST_CHECK_EQUAL(checkNextHop("/world", 1, face1, 103), CheckNextHopResult::OK);
+  BOOST_CHECK_EQUAL(checkNextHop(longName), CheckNextHopResult::NO_FIB_ENTRY);
+  BOOST_CHECK_EQUAL(checkNextHop("/none"), CheckNextHopResult::NO_FIB_ENTRY);
+  BOOST_CHECK(m_responses.empty()); // no command responses are produced
+}
+
+BOOST_AUTO_TEST_CASE(ApplyFibUpdatesBatchFace)
+{
+  FaceId face1 = addFace();
+  FaceId face2 = addFace();
+  FaceId unknownFace = face2 + 100;
+
+  std::list<rib::FibUpdate> otherUpdates{
+    rib::FibUpdate::createAddUpdate("/other", face1, 10),
+  };
+
+  auto codes = m_manager.applyFibUpdates({rib::FibUpdate::createAddUpdate("/batch", face2, 20)},
+                                         otherUpdates);
+  std::vector<uint32_t> expectedCodes{200};
+  BOOST_CHECK_EQUAL_COLLECTIONS(codes.first.begin(), codes.first.end(),
+                                expectedCodes.begin(), expectedCodes.end());
+  BOOST_CHECK_EQUAL_COLLECTIONS(codes.second.begin(), codes.second.end(),
+                                expectedCodes.begin(), expectedCodes.end());
+  BOOST_CHECK_EQUAL(checkNextHop("/batch", 1, face2, 20), CheckNextHopResult::OK);
+  BOOST_CHECK_EQUAL(checkNextHop("/other", 1, face1, 10), CheckNextHopResult::OK);
+
+  // other updates are not applied if an update for the batch face fails
+  otherUpdates = {rib::FibUpdate::createAddUpdate("/skipped", face1, 10)};
+  codes = m_manager.applyFibUpdates({rib::FibUpdate::createAddUpdate("/batch", unknownFace, 20)},
+                                    otherUpdates);
+  expectedCodes = {410};
+  BOOST_CHECK_EQUAL_COLLECTIONS(codes.first.begin(), codes.first.end(),
+                                expectedCodes.begin(), expectedCodes.end());
+  BOOST_CHECK(codes.second.empty());
+  BOOST_CHECK_EQUAL(checkNextHop("/skipped"), CheckNextHopResult::NO_FIB_ENTRY);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestFibManager
 BOOST_AUTO_TEST_SUITE_END() // Mgmt
 
@@ -152,6 +152,129 @@ BOOST_AUTO_TEST_CASE(InvalidValue)
 
 BOOST_AUTO_TEST_SUITE_END() // CsMaxPackets
 
+BOOST_AUTO_TEST_SUITE(CsExactIndex)
+
+BOOST_AUTO_TEST_CASE(Default)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+    }
+  )CONFIG";
+
+  cs.enableExactIndex(true);
+  runConfig(CONFIG, false);
+  BOOST_CHECK_EQUAL(cs.hasExactIndex(), false);
+}
+
+BOOST_AUTO_TEST_CASE(Enabled)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      cs_exact_index yes
+    }
+  )CONFIG";
+
+  runConfig(CONFIG, true);
+  BOOST_CHECK_EQUAL(cs.hasExactIndex(), false);
+
+  runConfig(CONFIG, false);
+  BOOST_CHECK_EQUAL(cs.hasExactIndex(), true);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidValue)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      cs_exact_index maybe
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG, false), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // CsExactIndex
+
+BOOST_AUTO_TEST_SUITE(DeadNonceListType)
+
+BOOST_AUTO_TEST_CASE(Default)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+    }
+  )CONFIG";
+
+  forwarder.getDeadNonceList().useFilter(DeadNonceFilter::Options{});
+  runConfig(CONFIG, false);
+  BOOST_CHECK(forwarder.getDeadNonceList().getFilter() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(Filter)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      dnl_type filter
+      dnl_filter_memory 65536
+      dnl_filter_fp_rate 0.001
+    }
+  )CONFIG";
+
+  runConfig(CONFIG, true);
+  BOOST_CHECK(forwarder.getDeadNonceList().getFilter() == nullptr);
+
+  runConfig(CONFIG, false);
+  const DeadNonceFilter* filter = forwarder.getDeadNonceList().getFilter();
+  BOOST_REQUIRE(filter != nullptr);
+  BOOST_CHECK_EQUAL(filter->getOptions().memoryBudget, 65536);
+  BOOST_CHECK_EQUAL(filter->getOptions().falsePositiveRate, 0.001);
+
+  // reloading the same configuration keeps the filter and its entries
+  runConfig(CONFIG, false);
+  BOOST_CHECK(forwarder.getDeadNonceList().getFilter() == filter);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidValue)
+{
+  const std::string CONFIG1 = R"CONFIG(
+    tables
+    {
+      dnl_type bloom
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG1, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG1, false), ConfigFile::Error);
+
+  const std::string CONFIG2 = R"CONFIG(
+    tables
+    {
+      dnl_type filter
+      dnl_filter_memory 64
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG2, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG2, false), ConfigFile::Error);
+
+  const std::string CONFIG3 = R"CONFIG(
+    tables
+    {
+      dnl_type filter
+      dnl_filter_fp_rate 1.5
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG3, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG3, false), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // DeadNonceListType
+
 BOOST_AUTO_TEST_SUITE(CsPolicy)
 
 BOOST_AUTO_TEST_CASE(Default)
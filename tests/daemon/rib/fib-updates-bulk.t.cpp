@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "rib/rib.hpp"
+
+#include "tests/test-common.hpp"
+#include "fib-updates-common.hpp"
+
+#include <algorithm>
+
+namespace nfd {
+namespace rib {
+namespace tests {
+
+class BulkFibUpdatesFixture : public FibUpdatesFixture
+{
+public:
+  BulkFibUpdatesFixture()
+  {
+    fibUpdater.setBulkFibUpdateFunc([this] (const FibUpdater::FibUpdateList& batchFaceUpdates,
+                                            const FibUpdater::FibUpdateList& otherUpdates,
+                                            const FibUpdater::BulkFibUpdateCallback& done) {
+      ++nBulkCalls;
+      auto batchFaceCodes = apply(batchFaceUpdates);
+      std::vector<uint32_t> otherCodes;
+      if (std::all_of(batchFaceCodes.begin(), batchFaceCodes.end(),
+                      [] (uint32_t code) { return code == 200; })) {
+        otherCodes = apply(otherUpdates);
+      }
+      getGlobalIoService().post([=] { done(batchFaceCodes, otherCodes); });
+    });
+  }
+
+private:
+  std::vector<uint32_t>
+  apply(const FibUpdater::FibUpdateList& updates)
+  {
+    std::vector<uint32_t> codes;
+    for (const auto& update : updates) {
+      bulkUpdates.push_back(update);
+      codes.push_back(update.faceId == missingFaceId ? 410 : 200);
+    }
+    return codes;
+  }
+
+public:
+  FibUpdater::FibUpdateList bulkUpdates;
+  size_t nBulkCalls = 0;
+  uint64_t missingFaceId = 0;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestFibUpdates, BulkFibUpdatesFixture)
+
+BOOST_AUTO_TEST_SUITE(Bulk)
+
+BOOST_AUTO_TEST_CASE(OneCallPerBatch)
+{
+  insertRoute("/", 1, 0, 50, ndn::nfd::ROUTE_FLAG_CHILD_INHERIT);
+  BOOST_CHECK_EQUAL(nBulkCalls, 1);
+  BOOST_CHECK_EQUAL(bulkUpdates.size(), 1);
+
+  // generates /a via face 2 (batch face) and /a via inherited face 1 (other face)
+  insertRoute("/a", 2, 0, 30, 0);
+  BOOST_CHECK_EQUAL(nBulkCalls, 2);
+  BOOST_CHECK_EQUAL(bulkUpdates.size(), 3);
+  BOOST_CHECK(rib.find("/a") != rib.end());
+
+  // no command is sent
+  BOOST_CHECK_EQUAL(getFibUpdates().size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(BatchFaceNotFound)
+{
+  insertRoute("/", 1, 0, 50, ndn::nfd::ROUTE_FLAG_CHILD_INHERIT);
+  bulkUpdates.clear();
+
+  // /b via inherited face 1 is not applied, because /b via face 3 fails
+  missingFaceId = 3;
+  insertRoute("/b", 3, 0, 10, 0);
+  BOOST_CHECK_EQUAL(nBulkCalls, 2);
+  BOOST_CHECK_EQUAL(bulkUpdates.size(), 1);
+  BOOST_CHECK(rib.find("/b") == rib.end());
+}
+
+BOOST_AUTO_TEST_CASE(OtherFaceNotFound)
+{
+  insertRoute("/", 1, 0, 50, ndn::nfd::ROUTE_FLAG_CHILD_INHERIT);
+  missingFaceId = 1;
+  insertRoute("/c", 2, 0, 10, 0);
+  BOOST_CHECK_EQUAL(nBulkCalls, 2);
+  BOOST_CHECK(rib.find("/c") != rib.end());
+}
+
+BOOST_AUTO_TEST_CASE(CommandPathRestored)
+{
+  fibUpdater.setBulkFibUpdateFunc(nullptr);
+  insertRoute("/d", 1, 0, 10, 0);
+  BOOST_CHECK_EQUAL(nBulkCalls, 0);
+  BOOST_CHECK_EQUAL(getFibUpdates().size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Bulk
+
+BOOST_AUTO_TEST_SUITE_END() // FibUpdates
+
+} // namespace tests
+} // namespace rib
+} // namespace nfd
@@ -100,6 +100,34 @@ BOOST_AUTO_TEST_CASE(Children)
   BOOST_CHECK_EQUAL((rib.find(name3)->second)->getParent()->getName(), name4);
 }
 
+BOOST_AUTO_TEST_CASE(ChildrenInDeepNamespace)
+{
+  rib::Rib rib;
+
+  rib.insert("/a", createRoute(1, 20));
+  rib.insert("/a/b/c", createRoute(2, 20));
+  rib.insert("/a/b/c/d", createRoute(3, 20));
+  rib.insert("/a/b/c/d/e", createRoute(4, 20));
+  rib.insert("/a/b/f", createRoute(5, 20));
+  rib.insert("/a/ba", createRoute(6, 20));
+  rib.insert("/b", createRoute(7, 20));
+
+  // entries under /a/b/c must not be taken as children of /a/b
+  rib.insert("/a/b", createRoute(8, 20));
+
+  const auto& children = rib.find("/a/b")->second->getChildren();
+  BOOST_REQUIRE_EQUAL(children.size(), 2);
+  BOOST_CHECK_EQUAL(children.front()->getName(), "/a/b/c");
+  BOOST_CHECK_EQUAL(children.back()->getName(), "/a/b/f");
+
+  BOOST_CHECK_EQUAL(rib.find("/a")->second->getChildren().size(), 2);
+  BOOST_CHECK_EQUAL(rib.find("/a/b/c")->second->getParent()->getName(), "/a/b");
+  BOOST_CHECK_EQUAL(rib.find("/a/b/c/d")->second->getParent()->getName(), "/a/b/c");
+  BOOST_CHECK_EQUAL(rib.find("/a/b/c/d/e")->second->getParent()->getName(), "/a/b/c/d");
+  BOOST_CHECK_EQUAL(rib.find("/a/ba")->second->getParent()->getName(), "/a");
+  BOOST_CHECK(rib.find("/b")->second->getParent() == nullptr);
+}
+
 BOOST_AUTO_TEST_CASE(EraseFace)
 {
   rib::Rib rib;
@@ -143,6 +143,48 @@ BOOST_AUTO_TEST_CASE(LocalhopAndPropagate)
   poll();
 }
 
+BOOST_AUTO_TEST_CASE(BulkFibUpdates)
+{
+  const std::string CONFIG = R"CONFIG(
+    rib
+    {
+      bulk_fib_updates yes
+    }
+  )CONFIG";
+
+  runOnRibIoService([&] {
+    {
+      Service ribService(makeSection(""), m_ribKeyChain);
+      BOOST_CHECK(ribService.m_fibUpdater.m_bulkFibUpdate == nullptr);
+    }
+    Service ribService(makeSection(CONFIG), m_ribKeyChain);
+    BOOST_CHECK(ribService.m_fibUpdater.m_bulkFibUpdate != nullptr);
+
+    // reloading a configuration without the option restores per-route updates
+    ribService.applyConfig(ConfigSection(), "reload-1");
+    BOOST_CHECK(ribService.m_fibUpdater.m_bulkFibUpdate == nullptr);
+
+    ribService.applyConfig(makeSection(CONFIG, false).get_child("rib"), "reload-2");
+    BOOST_CHECK(ribService.m_fibUpdater.m_bulkFibUpdate != nullptr);
+  });
+  poll();
+}
+
+BOOST_AUTO_TEST_CASE(InvalidBulkFibUpdates)
+{
+  const std::string CONFIG = R"CONFIG(
+    rib
+    {
+      bulk_fib_updates maybe
+    }
+  )CONFIG";
+
+  runOnRibIoService([&] {
+    BOOST_CHECK_THROW(Service(makeSection(CONFIG), m_ribKeyChain), ConfigFile::Error);
+  });
+  poll();
+}
+
 BOOST_AUTO_TEST_SUITE_END() // ProcessConfig
 
 BOOST_AUTO_TEST_SUITE_END() // TestService
@@ -0,0 +1,199 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/cs-policy-soltani.hpp"
+
+#include "tests/daemon/table/cs-fixture.hpp"
+
+#include <cmath>
+
+namespace nfd {
+namespace cs {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Table)
+BOOST_AUTO_TEST_SUITE(TestCsSoltani)
+
+BOOST_AUTO_TEST_CASE(Registration)
+{
+  std::set<std::string> policyNames = Policy::getPolicyNames();
+  BOOST_CHECK_EQUAL(policyNames.count("soltani"), 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(LrfuDi, CsFixture)
+{
+  auto policy = make_unique<SoltaniPolicy>();
+  SoltaniPolicy& soltani = *policy;
+  cs.setPolicy(std::move(policy));
+  cs.setLimit(3);
+
+  // Di := 1 + Di * 2^(-LAMBDA * (t - lastReferencedTime)) on every reference
+  insert(1, "/A");
+  BOOST_REQUIRE_EQUAL(cs.size(), 1);
+  const EntryInfo& info = soltani.getInfo(cs.begin());
+  BOOST_CHECK_CLOSE(info.di, 1.0, 1e-9);
+
+  advanceClocks(10_s);
+  startInterest("/A");
+  CHECK_CS_FIND(1);
+  BOOST_CHECK_CLOSE(info.di, 1.5, 1e-9);
+  BOOST_CHECK_CLOSE(info.priority, std::log2(1.5) + SoltaniPolicy::LAMBDA * info.lastReferencedTime,
+                    1e-9);
+
+  startInterest("/A");
+  CHECK_CS_FIND(1);
+  BOOST_CHECK_CLOSE(info.di, 2.5, 1e-9);
+
+  advanceClocks(20_s);
+  startInterest("/A");
+  CHECK_CS_FIND(1);
+  BOOST_CHECK_CLOSE(info.di, 1.625, 1e-9);
+}
+
+BOOST_FIXTURE_TEST_CASE(EvictLowestDi, CsFixture)
+{
+  cs.setPolicy(make_unique<SoltaniPolicy>());
+  cs.setLimit(3);
+
+  insert(1, "/A");
+  insert(2, "/B");
+  insert(3, "/C");
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+
+  // A is referenced twice, C once, B never
+  advanceClocks(1_s);
+  startInterest("/A");
+  CHECK_CS_FIND(1);
+  startInterest("/A");
+  CHECK_CS_FIND(1);
+  startInterest("/C");
+  CHECK_CS_FIND(3);
+
+  // evict B
+  insert(4, "/D");
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  startInterest("/B");
+  CHECK_CS_FIND(0);
+
+  // D has the lowest Di, evict D
+  advanceClocks(1_s);
+  insert(5, "/E");
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  startInterest("/D");
+  CHECK_CS_FIND(0);
+  startInterest("/A");
+  CHECK_CS_FIND(1);
+}
+
+BOOST_FIXTURE_TEST_CASE(Decay, CsFixture)
+{
+  cs.setPolicy(make_unique<SoltaniPolicy>());
+  cs.setLimit(2);
+
+  insert(1, "/A");
+  for (int i = 0; i < 3; ++i) {
+    startInterest("/A");
+    CHECK_CS_FIND(1);
+  }
+
+  // after a long idle period, frequent-but-old A ranks below recently-used B
+  advanceClocks(10_s, 100_s);
+  insert(2, "/B");
+  startInterest("/B");
+  CHECK_CS_FIND(2);
+
+  // evict A
+  insert(3, "/C");
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+  startInterest("/A");
+  CHECK_CS_FIND(0);
+  startInterest("/B");
+  CHECK_CS_FIND(2);
+}
+
+BOOST_FIXTURE_TEST_CASE(EvictUnsolicitedFirst, CsFixture)
+{
+  cs.setPolicy(make_unique<SoltaniPolicy>());
+  cs.setLimit(2);
+
+  insert(1, "/A");
+  insert(2, "/B", nullptr, true);
+  advanceClocks(1_s);
+
+  // evict unsolicited B, even though it is more recent
+  insert(3, "/C");
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+  startInterest("/B");
+  CHECK_CS_FIND(0);
+  startInterest("/A");
+  CHECK_CS_FIND(1);
+}
+
+BOOST_FIXTURE_TEST_CASE(EraseAndReinsert, CsFixture)
+{
+  cs.setPolicy(make_unique<SoltaniPolicy>());
+  cs.setLimit(4);
+
+  for (uint32_t i = 1; i <= 4; ++i) {
+    insert(i, Name("/P").appendNumber(i));
+  }
+  BOOST_CHECK_EQUAL(erase("/P", 2), 2);
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+
+  // released EntryInfo slots are reused
+  insert(5, "/Q/5");
+  insert(6, "/Q/6");
+  insert(7, "/Q/7");
+  BOOST_CHECK_EQUAL(cs.size(), 4);
+}
+
+BOOST_FIXTURE_TEST_CASE(ManyEntries, CsFixture)
+{
+  cs.setPolicy(make_unique<SoltaniPolicy>());
+  cs.setLimit(500);
+
+  // entries are inserted, evicted and erased often enough to grow the index and to
+  // exercise backward shifting on erase
+  for (uint32_t i = 1; i <= 2000; ++i) {
+    insert(i, Name("/M").appendNumber(i));
+    if (i % 3 == 0) {
+      erase(Name("/M").appendNumber(i - 1), 1);
+    }
+  }
+  BOOST_CHECK_EQUAL(cs.size(), 500);
+
+  // every remaining entry is still known to the policy
+  for (const auto& entry : cs) {
+    startInterest(entry.getName());
+    CHECK_CS_FIND(static_cast<uint32_t>(entry.getName().at(-1).toNumber()));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCsSoltani
+BOOST_AUTO_TEST_SUITE_END() // Table
+
+} // namespace tests
+} // namespace cs
+} // namespace nfd
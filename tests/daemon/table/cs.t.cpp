@@ -143,6 +143,54 @@ BOOST_AUTO_TEST_CASE(MustBeFresh)
   CHECK_CS_FIND(0);
 }
 
+BOOST_AUTO_TEST_CASE(ExactIndex)
+{
+  BOOST_CHECK_EQUAL(cs.hasExactIndex(), false);
+  cs.enableExactIndex(true);
+  cs.setLimit(1000);
+
+  // enough entries to grow the index several times
+  for (uint32_t i = 1; i <= 100; ++i) {
+    insert(i, Name("/E").appendNumber(i));
+  }
+  for (uint32_t i = 1; i <= 100; ++i) {
+    startInterest(Name("/E").appendNumber(i));
+    CHECK_CS_FIND(i);
+  }
+
+  BOOST_CHECK_EQUAL(erase("/E", 50), 50);
+  for (uint32_t i = 1; i <= 100; ++i) {
+    startInterest(Name("/E").appendNumber(i));
+    CHECK_CS_FIND(i > 50 ? i : 0);
+  }
+
+  // several entries with the same Data name
+  insert(101, "/F");
+  Name n102 = insert(102, "/F", [] (Data& data) { data.setFreshnessPeriod(1_h); });
+  advanceClocks(500_ms);
+
+  startInterest("/F")
+    .setMustBeFresh(true);
+  CHECK_CS_FIND(102);
+  startInterest(n102);
+  CHECK_CS_FIND(102);
+
+  uint32_t foundWithIndex = 0;
+  startInterest("/F");
+  find([&] (uint32_t found) { foundWithIndex = found; });
+
+  cs.enableExactIndex(false);
+  startInterest("/F");
+  CHECK_CS_FIND(foundWithIndex);
+
+  // the index is rebuilt when it is enabled again
+  cs.enableExactIndex(true);
+  startInterest("/F");
+  CHECK_CS_FIND(foundWithIndex);
+  startInterest(Name("/E").appendNumber(75));
+  CHECK_CS_FIND(75);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Find
 
 BOOST_AUTO_TEST_CASE(Erase)
@@ -193,6 +193,119 @@ BOOST_FIXTURE_TEST_CASE(CapacityUp, PeriodicalInsertionFixture)
   BOOST_CHECK_LT(std::abs(cap1 - RATE), std::abs(cap0 - RATE));
 }
 
+BOOST_AUTO_TEST_SUITE(Filter)
+
+BOOST_AUTO_TEST_CASE(Basic)
+{
+  Name nameA("ndn:/A");
+  Name nameB("ndn:/B");
+  const Interest::Nonce nonce1(0x53b4eaa8);
+  const Interest::Nonce nonce2(0x1f46372b);
+
+  DeadNonceList dnl;
+  dnl.add(nameA, nonce2);
+  dnl.useFilter(DeadNonceFilter::Options{});
+  BOOST_REQUIRE(dnl.getFilter() != nullptr);
+  BOOST_CHECK_EQUAL(dnl.size(), 0);
+  BOOST_CHECK_EQUAL(dnl.has(nameA, nonce2), false);
+
+  dnl.add(nameA, nonce1);
+  BOOST_CHECK_EQUAL(dnl.size(), 1);
+  BOOST_CHECK_EQUAL(dnl.has(nameA, nonce1), true);
+  BOOST_CHECK_EQUAL(dnl.has(nameA, nonce2), false);
+  BOOST_CHECK_EQUAL(dnl.has(nameB, nonce1), false);
+
+  dnl.add(nameA, nonce1);
+  BOOST_CHECK_EQUAL(dnl.size(), 1);
+
+  dnl.useFilter(nullopt);
+  BOOST_CHECK(dnl.getFilter() == nullptr);
+  BOOST_CHECK_EQUAL(dnl.size(), 0);
+  BOOST_CHECK_EQUAL(dnl.has(nameA, nonce1), false);
+  dnl.add(nameA, nonce1);
+  BOOST_CHECK_EQUAL(dnl.has(nameA, nonce1), true);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidOptions)
+{
+  DeadNonceList dnl;
+
+  DeadNonceFilter::Options options;
+  options.memoryBudget = DeadNonceFilter::MIN_MEMORY_BUDGET - 1;
+  BOOST_CHECK_THROW(dnl.useFilter(options), std::invalid_argument);
+
+  options = {};
+  options.falsePositiveRate = 0.0;
+  BOOST_CHECK_THROW(dnl.useFilter(options), std::invalid_argument);
+
+  BOOST_CHECK(dnl.getFilter() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(FalsePositiveRate)
+{
+  DeadNonceFilter::Options options;
+  options.memoryBudget = 64 * 1024;
+  options.falsePositiveRate = 0.01;
+  DeadNonceFilter filter(DeadNonceList::DEFAULT_LIFETIME, options);
+  BOOST_CHECK_LE(filter.getMemoryUsage(), options.memoryBudget);
+  BOOST_CHECK_GT(filter.getMemoryUsage(),
+                 options.memoryBudget - DeadNonceFilter::N_SLICES * DeadNonceFilter::BLOCK_SIZE);
+
+  // fill every slice, the active one rotates early when it is full
+  const size_t nEntries = filter.getSliceCapacity() * DeadNonceFilter::N_SLICES;
+  for (uint64_t i = 0; i < nEntries; ++i) {
+    filter.add(i * 0x9E3779B97F4A7C15);
+  }
+  // an entry that is a false positive in the active slice is not added again
+  BOOST_CHECK_LE(filter.size(), nEntries);
+  BOOST_CHECK_GT(filter.size(), nEntries * 0.99);
+
+  // the newest entries of the last N_SLICES - 1 slices are all present
+  const size_t nRecent = filter.getSliceCapacity() * (DeadNonceFilter::N_SLICES - 1);
+  size_t nMissing = 0;
+  for (uint64_t i = nEntries - nRecent; i < nEntries; ++i) {
+    nMissing += !filter.has(i * 0x9E3779B97F4A7C15);
+  }
+  BOOST_CHECK_EQUAL(nMissing, 0);
+
+  const size_t nQueries = 100000;
+  size_t nFalsePositives = 0;
+  for (uint64_t i = 0; i < nQueries; ++i) {
+    nFalsePositives += filter.has((nEntries + i) * 0x9E3779B97F4A7C15);
+  }
+  BOOST_CHECK_LT(nFalsePositives, nQueries * options.falsePositiveRate * 1.5);
+}
+
+class FilterInsertionFixture : public PeriodicalInsertionFixture
+{
+protected:
+  FilterInsertionFixture()
+  {
+    dnl.useFilter(DeadNonceFilter::Options{});
+  }
+};
+
+BOOST_FIXTURE_TEST_CASE(Lifetime, FilterInsertionFixture)
+{
+  const int RATE = DeadNonceList::INITIAL_CAPACITY / 2;
+  this->setRate(RATE);
+  this->advanceClocksByLifetime(10.0);
+
+  Name nameC("ndn:/C");
+  const Interest::Nonce nonceC(0x25390656);
+  BOOST_CHECK_EQUAL(dnl.has(nameC, nonceC), false);
+  dnl.add(nameC, nonceC);
+  BOOST_CHECK_EQUAL(dnl.has(nameC, nonceC), true);
+
+  this->advanceClocksByLifetime(0.5); // -50%, entry should exist
+  BOOST_CHECK_EQUAL(dnl.has(nameC, nonceC), true);
+
+  this->advanceClocksByLifetime(1.0); // +50%, entry should be gone
+  BOOST_CHECK_EQUAL(dnl.has(nameC, nonceC), false);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Filter
+
 BOOST_AUTO_TEST_SUITE_END() // TestDeadNonceList
 BOOST_AUTO_TEST_SUITE_END() // Table
 
@@ -242,6 +242,30 @@ BOOST_AUTO_TEST_CASE(LongestPrefixMatchWithMeasurementsEntry)
   BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(mABCD).getPrefix(), "/A/B/C");
 }
 
+BOOST_AUTO_TEST_CASE(LongestPrefixMatchCacheInvalidation)
+{
+  NameTree nameTree;
+  Fib fib(nameTree);
+  Pit pit(nameTree);
+
+  shared_ptr<pit::Entry> pitABCD = pit.insert(*makeInterest("/A/B/C/D")).first;
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(*pitABCD).getPrefix(), "/");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(*pitABCD).hasNextHops(), false);
+
+  fib.insert("/A");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(*pitABCD).getPrefix(), "/A");
+
+  fib.insert("/A/B/C");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(*pitABCD).getPrefix(), "/A/B/C");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(*pitABCD).getPrefix(), "/A/B/C");
+
+  fib.erase("/A/B/C");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(*pitABCD).getPrefix(), "/A");
+
+  fib.erase("/A");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(*pitABCD).getPrefix(), "/");
+}
+
 void
 validateFindExactMatch(Fib& fib, const Name& target)
 {
@@ -53,6 +53,39 @@ BOOST_AUTO_TEST_CASE(ComputeHash)
   BOOST_CHECK_EQUAL(hashes.size(), 3);
 }
 
+BOOST_AUTO_TEST_CASE(GetHashes)
+{
+  auto interest = makeInterest("/A/B/C");
+  const HashSequence& hashes1 = getHashes(*interest);
+  HashSequence expected = computeHashes(interest->getName());
+  BOOST_CHECK_EQUAL_COLLECTIONS(hashes1.begin(), hashes1.end(), expected.begin(), expected.end());
+  BOOST_CHECK(interest->getTag<HashSequenceTag>() != nullptr);
+
+  // cached hash sequence is reused
+  BOOST_CHECK_EQUAL(&getHashes(*interest), &hashes1);
+
+  // and recomputed after the name changes
+  interest->setName("/A/B/D/E");
+  const HashSequence& hashes2 = getHashes(*interest);
+  expected = computeHashes(interest->getName());
+  BOOST_CHECK_EQUAL_COLLECTIONS(hashes2.begin(), hashes2.end(), expected.begin(), expected.end());
+
+  auto data = makeData("/A/B/C");
+  const HashSequence& hashes3 = getHashes(*data);
+  expected = computeHashes(data->getName());
+  BOOST_CHECK_EQUAL_COLLECTIONS(hashes3.begin(), hashes3.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(&getHashes(*data), &hashes3);
+
+  // lookups with precomputed hash values agree with regular lookups
+  NameTree nt;
+  Entry& entry = nt.lookup(data->getName(), 2, hashes3);
+  BOOST_CHECK_EQUAL(entry.getName(), "/A/B");
+  BOOST_CHECK_EQUAL(&nt.lookup("/A/B"), &entry);
+  BOOST_CHECK_EQUAL(nt.findExactMatch(data->getName(), 2, hashes3), &entry);
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch(data->getName(), hashes3), &entry);
+  BOOST_CHECK(nt.findExactMatch(data->getName(), 3, hashes3) == nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE(Hashtable)
 using name_tree::Hashtable;
 
@@ -183,6 +216,68 @@ BOOST_AUTO_TEST_CASE(Resize)
   BOOST_CHECK_EQUAL(ht.getNBuckets(), 6);
 }
 
+BOOST_AUTO_TEST_CASE(OpenAddressing)
+{
+  HashtableOptions options(9);
+  options.mode = HashtableMode::OPEN_ADDRESSING;
+  Hashtable ht(options);
+  BOOST_CHECK_EQUAL(ht.getMode(), HashtableMode::OPEN_ADDRESSING);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 16);
+  BOOST_CHECK(ht.getFirst() == nullptr);
+
+  auto makeName = [] (int i) {
+    Name name;
+    name.appendNumber(i);
+    return name;
+  };
+
+  std::map<int, const Node*> nodes;
+  for (int i = 0; i < 1000; ++i) {
+    Name name = makeName(i);
+    const Node* node = nullptr;
+    bool isNew = false;
+    std::tie(node, isNew) = ht.insert(name, name.size(), computeHashes(name));
+    BOOST_CHECK_EQUAL(isNew, true);
+    nodes[i] = node;
+  }
+  BOOST_CHECK_EQUAL(ht.size(), 1000);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 2048);
+
+  // nodes are not moved by resizing
+  for (const auto& p : nodes) {
+    Name name = makeName(p.first);
+    BOOST_CHECK_EQUAL(ht.find(name, name.size()), p.second);
+  }
+
+  for (int i = 0; i < 1000; i += 2) {
+    ht.erase(const_cast<Node*>(nodes[i]));
+    nodes.erase(i);
+  }
+  BOOST_CHECK_EQUAL(ht.size(), 500);
+  for (int i = 0; i < 1000; ++i) {
+    Name name = makeName(i);
+    BOOST_CHECK_EQUAL(ht.find(name, name.size()), i % 2 == 0 ? nullptr : nodes[i]);
+  }
+
+  std::set<const Node*> enumerated;
+  for (const Node* node = ht.getFirst(); node != nullptr; node = ht.getNext(node)) {
+    BOOST_CHECK(enumerated.insert(node).second);
+  }
+  BOOST_CHECK_EQUAL(enumerated.size(), 500);
+
+  for (const auto& p : nodes) {
+    ht.erase(const_cast<Node*>(p.second));
+  }
+  BOOST_CHECK_EQUAL(ht.size(), 0);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 16);
+  BOOST_CHECK(ht.getFirst() == nullptr);
+
+  // freed nodes are reused
+  Name name = makeName(1);
+  const Node* node = ht.insert(name, name.size(), computeHashes(name)).first;
+  BOOST_CHECK_EQUAL(ht.find(name, name.size()), node);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Hashtable
 
 BOOST_AUTO_TEST_SUITE(TestEntry)
@@ -764,6 +859,44 @@ BOOST_AUTO_TEST_CASE(SurvivedIteratorAfterErase)
   BOOST_CHECK(seenNames.size() == 7);
 }
 
+BOOST_AUTO_TEST_CASE(OpenAddressing)
+{
+  HashtableOptions options(16);
+  options.mode = HashtableMode::OPEN_ADDRESSING;
+  NameTree nt(options);
+
+  nt.lookup("/A/B/C");
+  nt.lookup("/A/D/E");
+  nt.lookup("/A/F/G");
+  nt.lookup("/H");
+  BOOST_CHECK_EQUAL(nt.size(), 9);
+  BOOST_CHECK_EQUAL(nt.findExactMatch("/A/D")->getName(), "/A/D");
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch("/A/B/C/D")->getName(), "/A/B/C");
+
+  Name nameD("/A/D");
+  std::set<Name> seenNames;
+  for (NameTree::const_iterator it = nt.begin(); it != nt.end(); ++it) {
+    BOOST_CHECK(seenNames.insert(it->getName()).second);
+    if (it->getName() == nameD) {
+      nt.eraseIfEmpty(nt.findExactMatch("/A/F/G")); // /A/F/G and /A/F are erased
+      nt.lookup("/I");
+    }
+  }
+
+  seenNames.erase("/A/F"); // /A/F may or may not appear
+  seenNames.erase("/A/F/G"); // /A/F/G may or may not appear
+  seenNames.erase("/I"); // /I may or may not appear
+  BOOST_CHECK_EQUAL(seenNames.size(), 7);
+  BOOST_CHECK_EQUAL(nt.size(), 8);
+
+  nt.eraseIfEmpty(nt.findExactMatch("/A/B/C"));
+  nt.eraseIfEmpty(nt.findExactMatch("/A/D/E"));
+  nt.eraseIfEmpty(nt.findExactMatch("/H"));
+  nt.eraseIfEmpty(nt.findExactMatch("/I"));
+  BOOST_CHECK_EQUAL(nt.size(), 0);
+  BOOST_CHECK(nt.begin() == nt.end());
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestNameTree
 BOOST_AUTO_TEST_SUITE_END() // Table
 
@@ -236,6 +236,82 @@ BOOST_AUTO_TEST_CASE(OutRecordNack)
   BOOST_CHECK(outR.getIncomingNack() == nullptr);
 }
 
+class RecordStrategyInfo : public fw::StrategyInfo
+{
+public:
+  static constexpr int
+  getTypeId()
+  {
+    return 1;
+  }
+
+  explicit
+  RecordStrategyInfo(int value)
+    : value(value)
+  {
+  }
+
+public:
+  int value;
+};
+
+BOOST_AUTO_TEST_CASE(ManyRecords)
+{
+  Name name("/ZtbQoTsWx");
+  auto interest = makeInterest(name);
+  Entry entry(*interest);
+
+  // exceed the inline capacity of both collections
+  std::vector<shared_ptr<DummyFace>> faces;
+  for (int i = 0; i < 8; ++i) {
+    faces.push_back(make_shared<DummyFace>());
+    auto interest1 = makeInterest(name, false, nullopt, 1000 + i);
+    entry.insertOrUpdateInRecord(*faces.back(), *interest1)->insertStrategyInfo<RecordStrategyInfo>(i);
+    entry.insertOrUpdateOutRecord(*faces.back(), *interest1)->insertStrategyInfo<RecordStrategyInfo>(i);
+  }
+  BOOST_CHECK_EQUAL(entry.getInRecords().size(), 8);
+  BOOST_CHECK_EQUAL(entry.getOutRecords().size(), 8);
+
+  auto checkRecords = [&] (const std::set<int>& expected) {
+    BOOST_CHECK_EQUAL(entry.getInRecords().size(), expected.size());
+    BOOST_CHECK_EQUAL(entry.getOutRecords().size(), expected.size());
+    for (int i = 0; i < 8; ++i) {
+      auto inR = entry.getInRecord(*faces[i]);
+      auto outR = entry.getOutRecord(*faces[i]);
+      if (expected.count(i) == 0) {
+        BOOST_CHECK(inR == entry.in_end());
+        BOOST_CHECK(outR == entry.out_end());
+        continue;
+      }
+      BOOST_REQUIRE(inR != entry.in_end());
+      BOOST_REQUIRE(outR != entry.out_end());
+      BOOST_CHECK_EQUAL(inR->getLastNonce(), Interest::Nonce(1000 + i));
+      BOOST_CHECK_EQUAL(inR->getInterest().getNonce(), Interest::Nonce(1000 + i));
+      BOOST_CHECK_EQUAL(outR->getLastNonce(), Interest::Nonce(1000 + i));
+      BOOST_REQUIRE(inR->getStrategyInfo<RecordStrategyInfo>() != nullptr);
+      BOOST_CHECK_EQUAL(inR->getStrategyInfo<RecordStrategyInfo>()->value, i);
+      BOOST_REQUIRE(outR->getStrategyInfo<RecordStrategyInfo>() != nullptr);
+      BOOST_CHECK_EQUAL(outR->getStrategyInfo<RecordStrategyInfo>()->value, i);
+    }
+  };
+  checkRecords({0, 1, 2, 3, 4, 5, 6, 7});
+
+  // records keep their state when other records are deleted
+  entry.deleteInRecord(*faces[0]);
+  entry.deleteOutRecord(*faces[0]);
+  entry.deleteInRecord(*faces[5]);
+  entry.deleteOutRecord(*faces[5]);
+  checkRecords({1, 2, 3, 4, 6, 7});
+
+  entry.deleteInRecord(*faces[7]);
+  entry.deleteOutRecord(*faces[7]);
+  checkRecords({1, 2, 3, 4, 6});
+
+  entry.clearInRecords();
+  BOOST_CHECK_EQUAL(entry.hasInRecords(), false);
+  BOOST_CHECK_EQUAL(entry.getOutRecords().size(), 5);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestPitEntry
 BOOST_AUTO_TEST_SUITE_END() // Table
 
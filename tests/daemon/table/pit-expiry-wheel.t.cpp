@@ -0,0 +1,197 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/pit-expiry-wheel.hpp"
+#include "table/pit-entry.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+
+#include <boost/range/irange.hpp>
+
+#include <random>
+
+namespace nfd {
+namespace pit {
+namespace tests {
+
+using namespace nfd::tests;
+
+class ExpiryWheelFixture : public GlobalIoTimeFixture
+{
+protected:
+  ExpiryWheelFixture()
+  {
+    for (int i = 0; i < 1000; ++i) {
+      entries.push_back(make_unique<Entry>(*makeInterest(Name("/wheel").appendNumber(i))));
+    }
+  }
+
+  ~ExpiryWheelFixture()
+  {
+    wheel.reset(); // cancel all timers before entries are destroyed
+  }
+
+  /** \return time elapsed since the fixture was constructed
+   */
+  time::nanoseconds
+  elapsed() const
+  {
+    return time::steady_clock::now() - start;
+  }
+
+protected:
+  std::vector<unique_ptr<Entry>> entries;
+  std::map<Entry*, time::nanoseconds> expired;
+  const time::steady_clock::TimePoint start = time::steady_clock::now();
+  unique_ptr<ExpiryWheel> wheel = make_unique<ExpiryWheel>([this] (Entry& entry) {
+    BOOST_CHECK(expired.emplace(&entry, elapsed()).second);
+    BOOST_CHECK(!ExpiryWheel::isScheduled(entry));
+  });
+};
+
+BOOST_AUTO_TEST_SUITE(Table)
+BOOST_FIXTURE_TEST_SUITE(TestPitExpiryWheel, ExpiryWheelFixture)
+
+BOOST_AUTO_TEST_CASE(ScheduleCancel)
+{
+  Entry& e0 = *entries[0];
+  Entry& e1 = *entries[1];
+  Entry& e2 = *entries[2];
+  Entry& e3 = *entries[3];
+
+  wheel->schedule(e0, 0_ms);
+  wheel->schedule(e1, 255_ms);
+  wheel->schedule(e2, 256_ms);
+  wheel->schedule(e3, 70_s);
+  BOOST_CHECK_EQUAL(wheel->size(), 4);
+  BOOST_CHECK(ExpiryWheel::isScheduled(e2));
+
+  pollIo();
+  BOOST_REQUIRE_EQUAL(expired.count(&e0), 1);
+  BOOST_CHECK_EQUAL(expired[&e0], 0_ms);
+  BOOST_CHECK_EQUAL(wheel->size(), 3);
+
+  advanceClocks(1_ms, 254);
+  BOOST_CHECK_EQUAL(expired.size(), 1);
+  advanceClocks(1_ms);
+  BOOST_REQUIRE_EQUAL(expired.count(&e1), 1);
+  BOOST_CHECK_EQUAL(expired[&e1], 255_ms);
+
+  // reschedule
+  wheel->schedule(e2, 100_ms);
+  advanceClocks(1_ms, 99);
+  BOOST_CHECK_EQUAL(expired.count(&e2), 0);
+  advanceClocks(1_ms);
+  BOOST_REQUIRE_EQUAL(expired.count(&e2), 1);
+  BOOST_CHECK_EQUAL(expired[&e2], 355_ms);
+
+  // cancel
+  wheel->cancel(e3);
+  BOOST_CHECK(!ExpiryWheel::isScheduled(e3));
+  BOOST_CHECK_EQUAL(wheel->size(), 0);
+  advanceClocks(1_s, 80);
+  BOOST_CHECK_EQUAL(expired.count(&e3), 0);
+  wheel->cancel(e3); // no effect
+}
+
+BOOST_AUTO_TEST_CASE(LongDuration)
+{
+  wheel->schedule(*entries[0], 10_days);
+  wheel->schedule(*entries[1], 60_days); // beyond the wheel range, kept in overflow list
+
+  advanceClocks(1_h, 24 * 10 - 1);
+  BOOST_CHECK_EQUAL(expired.size(), 0);
+  advanceClocks(1_h);
+  BOOST_REQUIRE_EQUAL(expired.count(entries[0].get()), 1);
+  BOOST_CHECK_EQUAL(expired[entries[0].get()], 10_days);
+
+  advanceClocks(1_h, 24 * 50 - 1);
+  BOOST_CHECK_EQUAL(expired.size(), 1);
+  advanceClocks(1_h);
+  BOOST_REQUIRE_EQUAL(expired.count(entries[1].get()), 1);
+  BOOST_CHECK_EQUAL(expired[entries[1].get()], 60_days);
+}
+
+BOOST_AUTO_TEST_CASE(Unaligned)
+{
+  advanceClocks(300_us);
+  wheel->schedule(*entries[0], 0_ms);
+  wheel->schedule(*entries[1], 2_ms);
+
+  // a zero duration expires on the next poll, without waiting for a tick boundary
+  pollIo();
+  BOOST_CHECK_EQUAL(expired.count(entries[0].get()), 1);
+
+  // expiry is rounded up to a whole tick, never down
+  advanceClocks(100_us, 19);
+  BOOST_CHECK_EQUAL(expired.count(entries[1].get()), 0);
+  advanceClocks(100_us, 10);
+  BOOST_REQUIRE_EQUAL(expired.count(entries[1].get()), 1);
+  BOOST_CHECK_GE(expired[entries[1].get()], 2300_us);
+  BOOST_CHECK_LE(expired[entries[1].get()], 3300_us);
+}
+
+BOOST_AUTO_TEST_CASE(Random)
+{
+  std::mt19937 rng(2755);
+  std::uniform_int_distribution<int> durationDist(0, 20000);
+  std::map<Entry*, time::nanoseconds> expected;
+
+  for (int step = 0; step < 4; ++step) {
+    for (int i : boost::irange(0, 1000)) {
+      Entry* entry = entries[i].get();
+      if (rng() % 2 == 0 || expired.count(entry) > 0) {
+        continue;
+      }
+      if (rng() % 4 == 0) {
+        wheel->cancel(*entry);
+        expected.erase(entry);
+        continue;
+      }
+      time::milliseconds duration(durationDist(rng));
+      wheel->schedule(*entry, duration);
+      expected[entry] = elapsed() + duration;
+    }
+    advanceClocks(1_ms, 2000);
+  }
+  advanceClocks(10_ms, 2100);
+
+  BOOST_CHECK_EQUAL(wheel->size(), 0);
+  BOOST_CHECK_EQUAL(expired.size(), expected.size());
+  for (const auto& e : expected) {
+    BOOST_REQUIRE_EQUAL(expired.count(e.first), 1);
+    BOOST_CHECK_GE(expired[e.first], e.second);
+    // only the final phase advances in 10ms increments
+    BOOST_CHECK_LE(expired[e.first], e.second + 10_ms);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestPitExpiryWheel
+BOOST_AUTO_TEST_SUITE_END() // Table
+
+} // namespace tests
+} // namespace pit
+} // namespace nfd
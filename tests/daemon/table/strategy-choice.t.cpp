@@ -255,6 +255,30 @@ BOOST_AUTO_TEST_CASE(FindEffectiveStrategyWithMeasurementsEntry)
   BOOST_CHECK_EQUAL(this->findInstanceName(mABCD), strategyNameQ);
 }
 
+BOOST_AUTO_TEST_CASE(FindEffectiveStrategyCacheInvalidation)
+{
+  BOOST_CHECK(sc.insert("/", strategyNameP));
+
+  Pit& pit = forwarder.getPit();
+  shared_ptr<pit::Entry> pitABCD = pit.insert(*makeInterest("/A/B/C/D")).first;
+  measurements::Entry& mAB = forwarder.getMeasurements().get("/A/B");
+  BOOST_CHECK_EQUAL(this->findInstanceName(*pitABCD), strategyNameP);
+  BOOST_CHECK_EQUAL(this->findInstanceName(mAB), strategyNameP);
+
+  BOOST_CHECK(sc.insert("/A/B", strategyNameQ));
+  BOOST_CHECK_EQUAL(this->findInstanceName(*pitABCD), strategyNameQ);
+  BOOST_CHECK_EQUAL(this->findInstanceName(mAB), strategyNameQ);
+
+  // changing the strategy of an existing entry is seen through the cached entry
+  BOOST_CHECK(sc.insert("/A/B", strategyNameP));
+  BOOST_CHECK_EQUAL(this->findInstanceName(*pitABCD), strategyNameP);
+
+  sc.erase("/A/B");
+  BOOST_CHECK(sc.insert("/", strategyNameQ));
+  BOOST_CHECK_EQUAL(this->findInstanceName(*pitABCD), strategyNameQ);
+  BOOST_CHECK_EQUAL(this->findInstanceName(mAB), strategyNameQ);
+}
+
 BOOST_AUTO_TEST_CASE(Erase)
 {
   NameTree& nameTree = forwarder.getNameTree();
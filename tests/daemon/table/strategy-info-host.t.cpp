@@ -78,6 +78,27 @@ public:
   int m_id;
 };
 
+template<int TYPE_ID, size_t SIZE>
+class SizedStrategyInfo : public StrategyInfo
+{
+public:
+  static constexpr int
+  getTypeId()
+  {
+    return TYPE_ID;
+  }
+
+  explicit
+  SizedStrategyInfo(int id)
+    : m_id(id)
+  {
+  }
+
+public:
+  int m_id;
+  std::array<uint8_t, SIZE> m_payload{};
+};
+
 BOOST_AUTO_TEST_SUITE(Table)
 BOOST_FIXTURE_TEST_SUITE(TestStrategyInfoHost, GlobalIoFixture)
 
@@ -132,6 +153,71 @@ BOOST_AUTO_TEST_CASE(Types)
   BOOST_CHECK_EQUAL(host.eraseStrategyInfo<DummyStrategyInfo>(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(ManyTypes)
+{
+  using Info3 = SizedStrategyInfo<3, 1>;
+  using Info4 = SizedStrategyInfo<4, 100>;
+  using Info5 = SizedStrategyInfo<5, StrategyInfo::MAX_POOLED_SIZE>;
+
+  StrategyInfoHost host;
+  g_DummyStrategyInfo_count = 0;
+
+  host.insertStrategyInfo<DummyStrategyInfo>(3301);
+  host.insertStrategyInfo<DummyStrategyInfo2>(3302);
+  host.insertStrategyInfo<Info3>(3303);
+  host.insertStrategyInfo<Info4>(3304);
+  BOOST_CHECK_EQUAL(host.insertStrategyInfo<Info5>(3305).second, true);
+  BOOST_CHECK_EQUAL(host.insertStrategyInfo<Info5>(0).second, false);
+
+  BOOST_REQUIRE(host.getStrategyInfo<DummyStrategyInfo>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfo>()->m_id, 3301);
+  BOOST_REQUIRE(host.getStrategyInfo<DummyStrategyInfo2>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfo2>()->m_id, 3302);
+  BOOST_REQUIRE(host.getStrategyInfo<Info3>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<Info3>()->m_id, 3303);
+  BOOST_REQUIRE(host.getStrategyInfo<Info4>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<Info4>()->m_id, 3304);
+  BOOST_REQUIRE(host.getStrategyInfo<Info5>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<Info5>()->m_id, 3305);
+
+  BOOST_CHECK_EQUAL(host.eraseStrategyInfo<DummyStrategyInfo>(), 1);
+  BOOST_CHECK_EQUAL(g_DummyStrategyInfo_count, 0);
+  BOOST_CHECK_EQUAL(host.eraseStrategyInfo<Info4>(), 1);
+  BOOST_CHECK_EQUAL(host.eraseStrategyInfo<Info4>(), 0);
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfo>() == nullptr);
+  BOOST_CHECK(host.getStrategyInfo<Info4>() == nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<Info3>()->m_id, 3303);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<Info5>()->m_id, 3305);
+
+  host.insertStrategyInfo<Info4>(4404);
+  host.insertStrategyInfo<DummyStrategyInfo>(4401);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfo>()->m_id, 4401);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfo2>()->m_id, 3302);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<Info3>()->m_id, 3303);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<Info4>()->m_id, 4404);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<Info5>()->m_id, 3305);
+
+  host.clearStrategyInfo();
+  BOOST_CHECK_EQUAL(g_DummyStrategyInfo_count, 0);
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfo>() == nullptr);
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfo2>() == nullptr);
+  BOOST_CHECK(host.getStrategyInfo<Info3>() == nullptr);
+  BOOST_CHECK(host.getStrategyInfo<Info4>() == nullptr);
+  BOOST_CHECK(host.getStrategyInfo<Info5>() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(LargeItem)
+{
+  using LargeInfo = SizedStrategyInfo<6, StrategyInfo::MAX_POOLED_SIZE + 1>;
+
+  StrategyInfoHost host;
+  LargeInfo* info = host.insertStrategyInfo<LargeInfo>(6606).first;
+  BOOST_REQUIRE(info != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<LargeInfo>(), info);
+  BOOST_CHECK_EQUAL(info->m_id, 6606);
+  BOOST_CHECK_EQUAL(host.eraseStrategyInfo<LargeInfo>(), 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestStrategyInfoHost
 BOOST_AUTO_TEST_SUITE_END() // Table
 
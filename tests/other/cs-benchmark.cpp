@@ -212,5 +212,75 @@ BOOST_FIXTURE_TEST_CASE(FindCanBePrefixHit, CsBenchmarkFixture)
   std::cout << "find(CanBePrefix-hit) " << (N_INTERESTS * N_CHILDREN * REPEAT) << ": " << d << std::endl;
 }
 
+// insert, then find hit, under each replacement policy
+BOOST_FIXTURE_TEST_CASE(InsertFindHitPolicies, CsBenchmarkFixture)
+{
+  constexpr size_t N_WORKLOAD = CS_CAPACITY * 2;
+  constexpr size_t REPEAT = 4;
+
+  std::vector<shared_ptr<Interest>> interestWorkload = makeInterestWorkload(N_WORKLOAD);
+  std::vector<shared_ptr<Data>> dataWorkload[REPEAT];
+  for (size_t j = 0; j < REPEAT; ++j) {
+    dataWorkload[j] = makeDataWorkload(N_WORKLOAD);
+  }
+
+  for (const std::string& policyName : {"lru", "priority_fifo", "soltani"}) {
+    Cs policyCs;
+    policyCs.setPolicy(cs::Policy::create(policyName));
+    policyCs.setLimit(CS_CAPACITY);
+
+    time::microseconds d = timedRun([&] {
+      for (size_t j = 0; j < REPEAT; ++j) {
+        for (size_t i = 0; i < N_WORKLOAD; ++i) {
+          policyCs.insert(*dataWorkload[j][i], false);
+          policyCs.find(*interestWorkload[i], [] (auto&&...) {}, [] (auto&&...) {});
+        }
+      }
+    });
+
+    std::cout << "insert-find(hit) " << policyName << " " << (N_WORKLOAD * REPEAT) << ": "
+              << d << std::endl;
+  }
+}
+
+// find hit and find miss in a large CS, with and without exact-match index
+BOOST_FIXTURE_TEST_CASE(FindExactIndex, CsBenchmarkFixture)
+{
+  constexpr size_t N_ENTRIES = 1000000;
+  constexpr size_t REPEAT = 4;
+
+  std::vector<shared_ptr<Interest>> hitWorkload = makeInterestWorkload(N_ENTRIES);
+  std::vector<shared_ptr<Interest>> missWorkload = makeInterestWorkload(N_ENTRIES,
+                                                     SimpleNameGenerator("/cs/benchmark/miss"));
+  cs.setLimit(N_ENTRIES);
+  for (const auto& data : makeDataWorkload(N_ENTRIES)) {
+    cs.insert(*data, false);
+  }
+  BOOST_REQUIRE(cs.size() == N_ENTRIES);
+
+  for (bool hasExactIndex : {false, true}) {
+    cs.enableExactIndex(hasExactIndex);
+    const char* label = hasExactIndex ? "with-index" : "without-index";
+
+    time::microseconds d = timedRun([&] {
+      for (size_t j = 0; j < REPEAT; ++j) {
+        for (const auto& interest : hitWorkload) {
+          find(*interest);
+        }
+      }
+    });
+    std::cout << "find(hit) " << label << " " << (N_ENTRIES * REPEAT) << ": " << d << std::endl;
+
+    d = timedRun([&] {
+      for (size_t j = 0; j < REPEAT; ++j) {
+        for (const auto& interest : missWorkload) {
+          find(*interest);
+        }
+      }
+    });
+    std::cout << "find(miss) " << label << " " << (N_ENTRIES * REPEAT) << ": " << d << std::endl;
+  }
+}
+
 } // namespace tests
 } // namespace nfd
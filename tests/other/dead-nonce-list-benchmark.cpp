@@ -0,0 +1,195 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmark-helpers.hpp"
+#include "table/dead-nonce-list.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#ifdef NFD_HAVE_VALGRIND
+#include <valgrind/callgrind.h>
+#endif
+
+// track the bytes held through the global allocator, to report the memory used by each storage
+static size_t g_nHeapBytes = 0;
+static constexpr size_t HEADER_SIZE = alignof(std::max_align_t);
+
+void*
+operator new(std::size_t size)
+{
+  auto p = static_cast<char*>(std::malloc(HEADER_SIZE + size));
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  std::memcpy(p, &size, sizeof(size));
+  g_nHeapBytes += size;
+  return p + HEADER_SIZE;
+}
+
+void
+operator delete(void* p) noexcept
+{
+  if (p == nullptr) {
+    return;
+  }
+  auto base = static_cast<char*>(p) - HEADER_SIZE;
+  std::size_t size;
+  std::memcpy(&size, base, sizeof(size));
+  g_nHeapBytes -= size;
+  std::free(base);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+  operator delete(p);
+}
+
+namespace nfd {
+namespace tests {
+
+class DeadNonceListBenchmarkFixture
+{
+protected:
+  DeadNonceListBenchmarkFixture()
+  {
+#ifdef _DEBUG
+    std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+
+    for (size_t i = 0; i < N_NAMES; ++i) {
+      names.push_back(Name("/dnl/benchmark").appendNumber(i).append("segment"));
+      names.back().wireEncode();
+    }
+  }
+
+  const Name&
+  getName(size_t i) const
+  {
+    return names[i % N_NAMES];
+  }
+
+  static Interest::Nonce
+  getNonce(size_t i)
+  {
+    return Interest::Nonce(static_cast<uint32_t>(i * 2654435761));
+  }
+
+  template<typename F>
+  static void
+  measure(const std::string& label, size_t nOps, F&& f)
+  {
+#ifdef NFD_HAVE_VALGRIND
+    CALLGRIND_START_INSTRUMENTATION;
+#endif
+    auto t1 = time::steady_clock::now();
+    size_t result = f();
+    auto t2 = time::steady_clock::now();
+#ifdef NFD_HAVE_VALGRIND
+    CALLGRIND_STOP_INSTRUMENTATION;
+#endif
+    auto ns = time::duration_cast<time::nanoseconds>(t2 - t1);
+    std::cout << label << ": " << static_cast<double>(ns.count()) / nOps << " ns per op"
+              << " (" << result << " hits)" << std::endl;
+  }
+
+  /** \brief runs the same workload against \p dnl
+   *
+   *  nAdds entries are added, then the nPresent most recent ones are looked up,
+   *  followed by nAbsent entries that were never added.
+   */
+  void
+  run(const std::string& label, DeadNonceList& dnl, size_t heapBefore,
+      size_t nAdds, size_t nPresent, size_t nAbsent)
+  {
+    measure(label + " add", nAdds, [&] {
+      for (size_t i = 0; i < nAdds; ++i) {
+        dnl.add(getName(i), getNonce(i));
+      }
+      return size_t(0);
+    });
+
+    size_t heapBytes = g_nHeapBytes - heapBefore;
+    std::cout << label << " memory: " << heapBytes << " bytes for " << dnl.size() << " entries, "
+              << static_cast<double>(heapBytes) / dnl.size() << " bytes per entry" << std::endl;
+
+    measure(label + " has (present)", nPresent, [&] {
+      size_t nHits = 0;
+      for (size_t i = nAdds - nPresent; i < nAdds; ++i) {
+        nHits += dnl.has(getName(i), getNonce(i));
+      }
+      return nHits;
+    });
+
+    measure(label + " has (absent)", nAbsent, [&] {
+      size_t nHits = 0;
+      for (size_t i = nAdds; i < nAdds + nAbsent; ++i) {
+        nHits += dnl.has(getName(i), getNonce(i));
+      }
+      return nHits;
+    });
+  }
+
+protected:
+  static constexpr size_t N_NAMES = 1000;
+  std::vector<Name> names;
+};
+
+// This test case compares the exact index with the filter on the same workload.
+// The periodic events do not run, so the exact index stays at its initial capacity and evicts
+// the oldest entry on each add, as it does in a steady state. Its memory per entry indicates
+// the footprint at any capacity, while the filter's footprint is fixed.
+BOOST_FIXTURE_TEST_CASE(Storages, DeadNonceListBenchmarkFixture)
+{
+  const size_t nAdds = 1000000;
+  const size_t nPresent = 10000;
+  const size_t nAbsent = 1000000;
+
+  {
+    size_t heapBefore = g_nHeapBytes;
+    DeadNonceList dnl;
+    run("exact", dnl, heapBefore, nAdds, nPresent, nAbsent);
+  }
+
+  for (double fpRate : {1e-3, 1e-4, 1e-5}) {
+    size_t heapBefore = g_nHeapBytes;
+    DeadNonceList dnl;
+    DeadNonceFilter::Options options;
+    options.falsePositiveRate = fpRate;
+    dnl.useFilter(options);
+
+    const DeadNonceFilter& filter = *dnl.getFilter();
+    std::cout << "filter fp-rate=" << fpRate << ": " << filter.getMemoryUsage() << " bytes, "
+              << filter.getNHashes() << " bits set per entry, "
+              << filter.getSliceCapacity() * (DeadNonceFilter::N_SLICES - 1)
+              << " entries per lifetime before rotating early" << std::endl;
+    run("filter fp-rate=" + to_string(fpRate), dnl, heapBefore, nAdds, nPresent, nAbsent);
+  }
+}
+
+} // namespace tests
+} // namespace nfd
@@ -43,8 +43,7 @@ namespace tests {
 class FaceBenchmark
 {
 public:
-  explicit
-  FaceBenchmark(const char* configFileName)
+  FaceBenchmark(const char* configFileName, size_t ioBatchSize)
     : m_terminationSignalSet{getGlobalIoService(), SIGINT, SIGTERM}
     , m_tcpChannel{tcp::Endpoint{boost::asio::ip::tcp::v4(), 6363}, false,
                    [] (auto&&...) { return ndn::nfd::FACE_SCOPE_NON_LOCAL; }}
@@ -57,6 +56,9 @@ public:
 
     parseConfig(configFileName);
 
+    m_udpChannel.setIoBatchSize(ioBatchSize);
+    std::clog << "UDP I/O batch size " << ioBatchSize << std::endl;
+
     m_tcpChannel.listen(std::bind(&FaceBenchmark::onLeftFaceCreated, this, _1),
                         std::bind(&FaceBenchmark::onFaceCreationFailed, _1, _2));
     std::clog << "Listening on " << m_tcpChannel.getUri() << std::endl;
@@ -64,6 +66,8 @@ public:
     m_udpChannel.listen(std::bind(&FaceBenchmark::onLeftFaceCreated, this, _1),
                         std::bind(&FaceBenchmark::onFaceCreationFailed, _1, _2));
     std::clog << "Listening on " << m_udpChannel.getUri() << std::endl;
+
+    scheduleReport();
   }
 
 private:
@@ -144,20 +148,37 @@ private:
     tieFaces(faceL, faceR);
   }
 
-  static void
+  void
   tieFaces(const shared_ptr<Face>& face1, const shared_ptr<Face>& face2)
   {
-    face1->afterReceiveInterest.connect([face2] (const Interest& interest, const EndpointId&) {
+    face1->afterReceiveInterest.connect([this, face2] (const Interest& interest, const EndpointId&) {
+      ++m_nForwarded;
       face2->sendInterest(interest);
     });
-    face1->afterReceiveData.connect([face2] (const Data& data, const EndpointId&) {
+    face1->afterReceiveData.connect([this, face2] (const Data& data, const EndpointId&) {
+      ++m_nForwarded;
       face2->sendData(data);
     });
-    face1->afterReceiveNack.connect([face2] (const ndn::lp::Nack& nack, const EndpointId&) {
+    face1->afterReceiveNack.connect([this, face2] (const ndn::lp::Nack& nack, const EndpointId&) {
+      ++m_nForwarded;
       face2->sendNack(nack);
     });
   }
 
+  /** \brief Prints the number of packets forwarded in the last second, if any
+   */
+  void
+  scheduleReport()
+  {
+    m_reportEvent = getScheduler().schedule(1_s, [this] {
+      if (m_nForwarded > 0) {
+        std::clog << m_nForwarded << " packets/s" << std::endl;
+        m_nForwarded = 0;
+      }
+      scheduleReport();
+    });
+  }
+
   static void
   onFaceCreationFailed(uint32_t status, const std::string& reason)
   {
@@ -169,6 +190,8 @@ private:
   face::TcpChannel m_tcpChannel;
   face::UdpChannel m_udpChannel;
   std::vector<std::pair<FaceUri, FaceUri>> m_faceUris;
+  uint64_t m_nForwarded = 0;
+  scheduler::ScopedEventId m_reportEvent;
 };
 
 } // namespace tests
@@ -181,13 +204,18 @@ main(int argc, char** argv)
   std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
 #endif
 
-  if (argc != 2) {
-    std::cerr << "Usage: " << argv[0] << " <config-file>" << std::endl;
+  if (argc != 2 && argc != 3) {
+    std::cerr << "Usage: " << argv[0] << " <config-file> [udp-io-batch-size]" << std::endl;
     return 2;
   }
 
   try {
-    nfd::tests::FaceBenchmark bench{argv[1]};
+    size_t ioBatchSize = argc == 3 ? boost::lexical_cast<size_t>(argv[2]) : 1;
+    if (ioBatchSize == 0) {
+      std::cerr << "UDP I/O batch size must be positive" << std::endl;
+      return 2;
+    }
+    nfd::tests::FaceBenchmark bench{argv[1], ioBatchSize};
 #ifdef NFD_HAVE_VALGRIND
     CALLGRIND_START_INSTRUMENTATION;
 #endif
@@ -0,0 +1,259 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmark-helpers.hpp"
+#include "face/face.hpp"
+#include "face/generic-link-service.hpp"
+#include "face/internal-transport.hpp"
+#include "fw/face-table.hpp"
+#include "mgmt/command-authenticator.hpp"
+#include "mgmt/fib-manager.hpp"
+#include "rib/fib-updater.hpp"
+#include "rib/rib.hpp"
+#include "table/fib.hpp"
+
+#include <ndn-cxx/mgmt/dispatcher.hpp>
+#include <ndn-cxx/mgmt/nfd/controller.hpp>
+#include <ndn-cxx/security/key-chain.hpp>
+#include <ndn-cxx/util/dummy-client-face.hpp>
+
+#include <deque>
+#include <iostream>
+
+#ifdef NFD_HAVE_VALGRIND
+#include <valgrind/callgrind.h>
+#endif
+
+namespace nfd {
+namespace tests {
+
+class FibUpdateBenchmarkFixture
+{
+protected:
+  FibUpdateBenchmarkFixture()
+    : m_keyChain("pib-memory:", "tpm-memory:")
+    , m_face(m_keyChain)
+    , m_controller(m_face, m_keyChain)
+    , m_fib(m_nameTree)
+    , m_dispatcher(m_face, m_keyChain)
+    , m_authenticator(CommandAuthenticator::create())
+    , m_fibManager(m_fib, m_faceTable, m_dispatcher, *m_authenticator)
+    , m_fibUpdater(m_rib, m_controller)
+  {
+#ifdef _DEBUG
+    std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+
+    m_keyChain.createIdentity("/benchmark");
+
+    m_faceId = addFace();
+
+    // Bulk updates are queued and applied iteratively, as the event loop would do after
+    // the hops to the main thread and back.
+    m_fibUpdater.setBulkFibUpdateFunc([this] (const auto& batchFaceUpdates,
+                                              const auto& otherUpdates, const auto& cb) {
+      m_pending.push_back({batchFaceUpdates, otherUpdates, cb});
+    });
+  }
+
+  FaceId
+  addFace()
+  {
+    auto face = make_shared<Face>(make_unique<face::GenericLinkService>(),
+                                  make_unique<face::InternalForwarderTransport>());
+    m_faceTable.add(face);
+    return face->getId();
+  }
+
+  static rib::RibUpdate
+  makeRibUpdate(rib::RibUpdate::Action action, const Name& name, FaceId faceId,
+                std::underlying_type_t<ndn::nfd::RouteFlags> flags = ndn::nfd::ROUTE_FLAGS_NONE)
+  {
+    rib::Route route;
+    route.faceId = faceId;
+    route.origin = ndn::nfd::ROUTE_ORIGIN_STATIC;
+    route.cost = 10;
+    route.flags = flags;
+    return rib::RibUpdate().setAction(action).setName(name).setRoute(route);
+  }
+
+  void
+  applyPendingUpdates()
+  {
+    while (!m_pending.empty()) {
+      auto item = std::move(m_pending.front());
+      m_pending.pop_front();
+      auto codes = m_fibManager.applyFibUpdates(item.batchFaceUpdates, item.otherUpdates);
+      item.done(codes.first, codes.second);
+    }
+  }
+
+  void
+  applyRibUpdate(const rib::RibUpdate& update)
+  {
+    m_rib.beginApplyUpdate(update, nullptr, nullptr);
+    applyPendingUpdates();
+  }
+
+  template<typename F>
+  static void
+  measure(const char* label, size_t nRoutes, F&& f)
+  {
+#ifdef NFD_HAVE_VALGRIND
+    CALLGRIND_START_INSTRUMENTATION;
+#endif
+    auto t1 = time::steady_clock::now();
+    f();
+    auto t2 = time::steady_clock::now();
+#ifdef NFD_HAVE_VALGRIND
+    CALLGRIND_STOP_INSTRUMENTATION;
+#endif
+    auto us = time::duration_cast<time::microseconds>(t2 - t1);
+    std::cout << label << ": " << us << ", "
+              << static_cast<double>(us.count()) / nRoutes << " us per route" << std::endl;
+  }
+
+protected:
+  ndn::KeyChain m_keyChain;
+  ndn::util::DummyClientFace m_face;
+  ndn::nfd::Controller m_controller;
+
+  FaceTable m_faceTable;
+  NameTree m_nameTree;
+  Fib m_fib;
+  ndn::mgmt::Dispatcher m_dispatcher;
+  shared_ptr<CommandAuthenticator> m_authenticator;
+  FibManager m_fibManager;
+
+  rib::Rib m_rib;
+  rib::FibUpdater m_fibUpdater;
+  FaceId m_faceId = face::INVALID_FACEID;
+
+private:
+  struct PendingBulkUpdate
+  {
+    rib::FibUpdater::FibUpdateList batchFaceUpdates;
+    rib::FibUpdater::FibUpdateList otherUpdates;
+    rib::FibUpdater::BulkFibUpdateCallback done;
+  };
+  std::deque<PendingBulkUpdate> m_pending;
+};
+
+// This test case registers nRoutes prefixes in the RIB and measures the time until all of them
+// are in the FIB, with the FIB updates of each RIB update applied in bulk by FibManager.
+// For comparison, it also measures the cost of only signing and sending one add-nexthop command
+// per route, which is a lower bound of the command-based path.
+BOOST_FIXTURE_TEST_CASE(RouteInsertions, FibUpdateBenchmarkFixture)
+{
+  const size_t nRoutes = 100000;
+
+  std::vector<rib::RibUpdate> ribUpdates;
+  for (size_t i = 0; i < nRoutes; ++i) {
+    ribUpdates.push_back(makeRibUpdate(rib::RibUpdate::REGISTER,
+                                       Name("/bench").appendNumber(i), m_faceId));
+  }
+
+  size_t nSucceeded = 0;
+  measure("bulk RIB to FIB", nRoutes, [&] {
+    for (const auto& update : ribUpdates) {
+      m_rib.beginApplyUpdate(update, [&] { ++nSucceeded; }, nullptr);
+    }
+    applyPendingUpdates();
+  });
+  BOOST_CHECK_EQUAL(nSucceeded, nRoutes);
+  BOOST_CHECK_EQUAL(m_fib.size(), nRoutes);
+
+  measure("signed add-nexthop commands (send only)", nRoutes, [&] {
+    for (const auto& update : ribUpdates) {
+      m_controller.start<ndn::nfd::FibAddNextHopCommand>(
+        ndn::nfd::ControlParameters()
+          .setName(update.getName())
+          .setFaceId(m_faceId)
+          .setCost(10),
+        nullptr, nullptr);
+    }
+  });
+}
+
+// This test case measures RIB updates next to and inside a wide namespace (many entries right
+// under one prefix) and a deep one (a long chain of nested entries). Updates that do not change
+// any inherited route should not depend on the size of these namespaces, while the cost of
+// updates that do is bounded by the number of entries whose inherited routes change.
+BOOST_FIXTURE_TEST_CASE(InheritedRoutes, FibUpdateBenchmarkFixture)
+{
+  const size_t nWide = 100000;
+  const size_t depth = 500;
+  const size_t nUpdates = 1000;
+  const size_t nInheritUpdates = 10;
+
+  const FaceId otherFaceId = addFace();
+
+  applyRibUpdate(makeRibUpdate(rib::RibUpdate::REGISTER, "/wide", m_faceId));
+  for (size_t i = 0; i < nWide; ++i) {
+    applyRibUpdate(makeRibUpdate(rib::RibUpdate::REGISTER, Name("/wide").appendNumber(i),
+                                 m_faceId));
+  }
+
+  Name deep("/deep");
+  applyRibUpdate(makeRibUpdate(rib::RibUpdate::REGISTER, deep, m_faceId));
+  for (size_t i = 0; i < depth; ++i) {
+    deep.appendNumber(i);
+    applyRibUpdate(makeRibUpdate(rib::RibUpdate::REGISTER, deep, m_faceId));
+  }
+
+  measure("new entries outside the namespaces", nUpdates, [&] {
+    for (size_t i = 0; i < nUpdates; ++i) {
+      applyRibUpdate(makeRibUpdate(rib::RibUpdate::REGISTER, Name("/other").appendNumber(i),
+                                   m_faceId));
+    }
+  });
+
+  for (const char* prefix : {"/wide", "/deep"}) {
+    const std::string label(prefix);
+
+    measure((label + ": route without flags on the top entry").data(), 2 * nUpdates, [&] {
+      for (size_t i = 0; i < nUpdates; ++i) {
+        applyRibUpdate(makeRibUpdate(rib::RibUpdate::REGISTER, prefix, otherFaceId));
+        applyRibUpdate(makeRibUpdate(rib::RibUpdate::UNREGISTER, prefix, otherFaceId));
+      }
+    });
+
+    measure((label + ": child-inherit route on the top entry").data(), 2 * nInheritUpdates, [&] {
+      for (size_t i = 0; i < nInheritUpdates; ++i) {
+        applyRibUpdate(makeRibUpdate(rib::RibUpdate::REGISTER, prefix, otherFaceId,
+                                     ndn::nfd::ROUTE_FLAG_CHILD_INHERIT));
+        applyRibUpdate(makeRibUpdate(rib::RibUpdate::UNREGISTER, prefix, otherFaceId,
+                                     ndn::nfd::ROUTE_FLAG_CHILD_INHERIT));
+      }
+    });
+  }
+
+  BOOST_CHECK_EQUAL(m_fib.size(), 1 + nWide + 1 + depth + nUpdates);
+  BOOST_CHECK_EQUAL(m_fib.findExactMatch(Name("/wide").appendNumber(0))->getNextHops().size(), 1);
+  BOOST_CHECK_EQUAL(m_fib.findExactMatch(deep)->getNextHops().size(), 1);
+}
+
+} // namespace tests
+} // namespace nfd
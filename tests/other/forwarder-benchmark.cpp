@@ -0,0 +1,339 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmark-helpers.hpp"
+#include "common/spsc-ring.hpp"
+#include "face/face.hpp"
+#include "face/generic-link-service.hpp"
+#include "fw/face-table.hpp"
+#include "fw/forwarder.hpp"
+#include "fw/shard-selector.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+#ifdef NFD_HAVE_VALGRIND
+#include <valgrind/callgrind.h>
+#endif
+
+namespace nfd {
+namespace tests {
+
+/** \brief A transport that delivers packets handed to it synchronously and counts sent packets.
+ */
+class BenchmarkTransport final : public face::Transport
+{
+public:
+  BenchmarkTransport()
+  {
+    this->setLocalUri(FaceUri("dev://bench"));
+    this->setRemoteUri(FaceUri("dev://bench"));
+    this->setScope(ndn::nfd::FACE_SCOPE_NON_LOCAL);
+    this->setPersistency(ndn::nfd::FACE_PERSISTENCY_PERMANENT);
+    this->setLinkType(ndn::nfd::LINK_TYPE_POINT_TO_POINT);
+    this->setMtu(MTU_UNLIMITED);
+  }
+
+  void
+  deliver(const Block& packet)
+  {
+    this->receive(packet);
+  }
+
+private:
+  void
+  doClose() final
+  {
+    this->setState(face::TransportState::CLOSED);
+  }
+
+  void
+  doSend(const Block&) final
+  {
+    ++nSent;
+  }
+
+public:
+  size_t nSent = 0;
+};
+
+/** \brief A packet as received from the network, and whether it arrives on the producer face.
+ */
+struct Arrival
+{
+  Block wire;
+  bool isData = false;
+};
+
+class ForwarderBenchmarkFixture
+{
+protected:
+  ForwarderBenchmarkFixture()
+    : m_forwarder(m_faceTable)
+  {
+#ifdef _DEBUG
+    std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+  }
+
+  static shared_ptr<Face>
+  addFace(FaceTable& faceTable)
+  {
+    auto transport = make_unique<BenchmarkTransport>();
+    auto face = make_shared<Face>(make_unique<face::GenericLinkService>(), std::move(transport));
+    faceTable.add(face);
+    return face;
+  }
+
+  static BenchmarkTransport&
+  getTransport(Face& face)
+  {
+    return static_cast<BenchmarkTransport&>(*face.getTransport());
+  }
+
+  static void
+  populateFib(Fib& fib, size_t nFibEntries, Face& upstream)
+  {
+    for (size_t i = 0; i < nFibEntries; ++i) {
+      Name prefix("/bench");
+      prefix.append(to_string(i));
+      fib.addOrUpdateNextHop(*fib.insert(prefix).first, upstream, 0);
+    }
+  }
+
+  void
+  generatePackets(size_t nPackets, size_t nFibEntries)
+  {
+    for (size_t i = 0; i < nPackets; ++i) {
+      Name name("/bench");
+      name.append(to_string(i % nFibEntries)).append(to_string(i)).append("seg");
+      Interest interest(name);
+      interest.setNonce(static_cast<uint32_t>(i));
+      const Block& interestWire = interest.wireEncode();
+      interestWires.push_back(make_shared<ndn::Buffer>(interestWire.begin(), interestWire.end()));
+
+      Data data(name);
+      data.setSignatureInfo(ndn::SignatureInfo(tlv::NullSignature));
+      data.setSignatureValue(make_shared<ndn::Buffer>());
+      const Block& dataWire = data.wireEncode();
+      dataWires.push_back(make_shared<ndn::Buffer>(dataWire.begin(), dataWire.end()));
+    }
+  }
+
+  /** \brief Visits the wires of \p nRoundTrip exchanges starting at \p offset, in arrival order.
+   *
+   *  The Data of each exchange arrives \p replyGap Interests after its Interest.
+   */
+  template<typename F>
+  void
+  forEachArrival(size_t offset, size_t nRoundTrip, size_t replyGap, F&& visit) const
+  {
+    for (size_t i = 0; i < nRoundTrip + replyGap; ++i) {
+      if (i < nRoundTrip) {
+        visit(*interestWires[offset + i], false);
+      }
+      if (i >= replyGap) {
+        visit(*dataWires[offset + i - replyGap], true);
+      }
+    }
+  }
+
+  /** \brief Copies a wire image into a fresh buffer and parses it, as a receiving transport would.
+   */
+  static Block
+  receiveWire(const ndn::Buffer& wire)
+  {
+    Block block(make_shared<ndn::Buffer>(wire.begin(), wire.end()));
+    block.parse();
+    return block;
+  }
+
+  template<typename F>
+  static void
+  measure(const char* label, size_t nPackets, F&& f)
+  {
+#ifdef NFD_HAVE_VALGRIND
+    CALLGRIND_START_INSTRUMENTATION;
+#endif
+    auto t1 = time::steady_clock::now();
+    f();
+    auto t2 = time::steady_clock::now();
+#ifdef NFD_HAVE_VALGRIND
+    CALLGRIND_STOP_INSTRUMENTATION;
+#endif
+    auto us = time::duration_cast<time::microseconds>(t2 - t1);
+    std::cout << label << ": " << us << ", "
+              << static_cast<double>(nPackets) / us.count() << " Mpps" << std::endl;
+  }
+
+protected:
+  std::vector<ConstBufferPtr> interestWires;
+  std::vector<ConstBufferPtr> dataWires;
+
+  FaceTable m_faceTable;
+  Forwarder m_forwarder;
+};
+
+// This test case models Interest-Data exchanges between a downstream and an upstream face.
+// Each packet arrives as a wire image that must be copied into a packet buffer and parsed,
+// then passes the link service and the forwarding pipelines.
+// The exchanges are run once with all work on one thread, and once with the receive and parse
+// steps on a separate I/O thread that hands packets to the forwarding thread over an SpscRing.
+BOOST_FIXTURE_TEST_CASE(Exchanges, ForwarderBenchmarkFixture)
+{
+  // number of Interest-Data exchanges per run
+  const size_t nRoundTrip = 500000;
+  // number of Interests between an Interest and its Data
+  const size_t replyGap = 20000;
+  const size_t nFibEntries = 2000;
+  const size_t ringCapacity = 4096;
+
+  auto downstream = addFace(m_faceTable);
+  auto upstream = addFace(m_faceTable);
+  populateFib(m_forwarder.getFib(), nFibEntries, *upstream);
+  generatePackets(2 * nRoundTrip, nFibEntries);
+
+  auto dispatch = [&] (const Block& wire, bool isData) {
+    getTransport(isData ? *upstream : *downstream).deliver(wire);
+  };
+
+  measure("single thread", 2 * nRoundTrip, [&] {
+    forEachArrival(0, nRoundTrip, replyGap, [&] (const ndn::Buffer& wire, bool isData) {
+      dispatch(receiveWire(wire), isData);
+    });
+  });
+  BOOST_CHECK_EQUAL(getTransport(*upstream).nSent, nRoundTrip);
+  BOOST_CHECK_EQUAL(getTransport(*downstream).nSent, nRoundTrip);
+
+  SpscRing<Arrival> ring(ringCapacity);
+  measure("I/O thread", 2 * nRoundTrip, [&] {
+    std::thread ioThread([&] {
+      forEachArrival(nRoundTrip, nRoundTrip, replyGap, [&] (const ndn::Buffer& wire, bool isData) {
+        Arrival arrival{receiveWire(wire), isData};
+        while (!ring.tryPush(std::move(arrival))) {
+          std::this_thread::yield();
+        }
+      });
+    });
+
+    size_t nDispatched = 0;
+    while (nDispatched < 2 * nRoundTrip) {
+      size_t n = ring.consume([&] (Arrival&& arrival) { dispatch(arrival.wire, arrival.isData); });
+      if (n == 0) {
+        std::this_thread::yield();
+      }
+      nDispatched += n;
+    }
+    ioThread.join();
+  });
+  BOOST_CHECK_EQUAL(getTransport(*upstream).nSent, 2 * nRoundTrip);
+  BOOST_CHECK_EQUAL(getTransport(*downstream).nSent, 2 * nRoundTrip);
+}
+
+/** \brief A forwarder that owns one partition of the name space.
+ */
+struct ForwarderShard
+{
+  ForwarderShard()
+    : forwarder(faceTable)
+  {
+  }
+
+  FaceTable faceTable;
+  Forwarder forwarder;
+  shared_ptr<Face> downstream;
+  shared_ptr<Face> upstream;
+  std::vector<Arrival> queue;
+};
+
+// This test case models a forwarding engine that is sharded by a hash of the name prefix.
+// Arriving packets are parsed and dispatched to per-shard queues by a ShardSelector, and each
+// shard runs its own Forwarder with a replica of the FIB and a private PIT, CS and Measurements.
+// The Scheduler used by the forwarding tables is not thread-safe in this build, so the shards
+// are run one after another: the reported aggregate throughput assumes one core per shard, and
+// is limited by the slowest shard.
+BOOST_FIXTURE_TEST_CASE(Shards, ForwarderBenchmarkFixture)
+{
+  const size_t nRoundTrip = 500000;
+  const size_t replyGap = 20000;
+  const size_t nFibEntries = 2000;
+  // /bench/<fib-entry>
+  const size_t shardPrefixLength = 2;
+
+  generatePackets(nRoundTrip, nFibEntries);
+
+  for (size_t nShards : {1, 2, 4, 8}) {
+    fw::ShardSelector selector(nShards, shardPrefixLength);
+    std::vector<unique_ptr<ForwarderShard>> shards;
+    for (size_t i = 0; i < nShards; ++i) {
+      auto shard = make_unique<ForwarderShard>();
+      shard->downstream = addFace(shard->faceTable);
+      shard->upstream = addFace(shard->faceTable);
+      populateFib(shard->forwarder.getFib(), nFibEntries, *shard->upstream);
+      shards.push_back(std::move(shard));
+    }
+
+    auto t1 = time::steady_clock::now();
+    forEachArrival(0, nRoundTrip, replyGap, [&] (const ndn::Buffer& wire, bool isData) {
+      Arrival arrival{receiveWire(wire), isData};
+      auto& shard = *shards[selector(Name(arrival.wire.get(tlv::Name)))];
+      shard.queue.push_back(std::move(arrival));
+    });
+    auto t2 = time::steady_clock::now();
+
+    time::nanoseconds maxShardTime = 0_ns;
+    size_t maxShardLoad = 0;
+    ForwarderCounters total;
+    for (const auto& shard : shards) {
+      auto t3 = time::steady_clock::now();
+      for (const auto& arrival : shard->queue) {
+        getTransport(arrival.isData ? *shard->upstream : *shard->downstream).deliver(arrival.wire);
+      }
+      auto t4 = time::steady_clock::now();
+      maxShardTime = std::max(maxShardTime, t4 - t3);
+      maxShardLoad = std::max(maxShardLoad, shard->queue.size());
+
+      // roll up the per-shard counters
+      const auto& counters = shard->forwarder.getCounters();
+      total.nInInterests.set(total.nInInterests + counters.nInInterests);
+      total.nInData.set(total.nInData + counters.nInData);
+      total.nOutData.set(total.nOutData + counters.nOutData);
+    }
+    BOOST_CHECK_EQUAL(total.nInInterests, nRoundTrip);
+    BOOST_CHECK_EQUAL(total.nInData, nRoundTrip);
+    BOOST_CHECK_EQUAL(total.nOutData, nRoundTrip);
+
+    auto dispatchUs = time::duration_cast<time::microseconds>(t2 - t1);
+    auto shardUs = time::duration_cast<time::microseconds>(maxShardTime);
+    std::cout << nShards << " shards: dispatch " << dispatchUs
+              << ", slowest shard " << shardUs << " (" << maxShardLoad << " packets), "
+              << static_cast<double>(2 * nRoundTrip) / shardUs.count() << " Mpps aggregate"
+              << std::endl;
+  }
+}
+
+} // namespace tests
+} // namespace nfd
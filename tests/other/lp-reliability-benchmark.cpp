@@ -0,0 +1,285 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmark-helpers.hpp"
+#include "common/global.hpp"
+#include "face/face.hpp"
+#include "face/generic-link-service.hpp"
+#include "face/transport.hpp"
+
+#include <ndn-cxx/util/time-unit-test-clock.hpp>
+
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <random>
+
+#ifdef NFD_HAVE_VALGRIND
+#include <valgrind/callgrind.h>
+#endif
+
+namespace nfd {
+namespace tests {
+
+/** \brief Decides which packets are lost on a link.
+ *
+ *  This is a Gilbert-Elliott channel: the link alternates between a good and a bad state, each
+ *  with its own loss rate. Equal loss rates in both states give independent (uniform) losses.
+ */
+class LossPattern
+{
+public:
+  LossPattern(double goodLoss, double badLoss, double goodToBad, double badToGood)
+    : m_goodLoss(goodLoss)
+    , m_badLoss(badLoss)
+    , m_goodToBad(goodToBad)
+    , m_badToGood(badToGood)
+  {
+  }
+
+  bool
+  isLost()
+  {
+    m_isBad = m_dist(m_gen) < (m_isBad ? 1.0 - m_badToGood : m_goodToBad);
+    return m_dist(m_gen) < (m_isBad ? m_badLoss : m_goodLoss);
+  }
+
+private:
+  double m_goodLoss;
+  double m_badLoss;
+  double m_goodToBad;
+  double m_badToGood;
+  bool m_isBad = false;
+  std::mt19937 m_gen{0};
+  std::uniform_real_distribution<double> m_dist{0.0, 1.0};
+};
+
+/** \brief One direction of an in-memory link, with a delay of one clock tick.
+ */
+class LossyTransport final : public face::Transport
+{
+public:
+  LossyTransport(ssize_t mtu, LossPattern lossPattern)
+    : m_lossPattern(lossPattern)
+  {
+    this->setLocalUri(FaceUri("dev://bench"));
+    this->setRemoteUri(FaceUri("dev://bench"));
+    this->setScope(ndn::nfd::FACE_SCOPE_NON_LOCAL);
+    this->setPersistency(ndn::nfd::FACE_PERSISTENCY_PERMANENT);
+    this->setLinkType(ndn::nfd::LINK_TYPE_POINT_TO_POINT);
+    this->setMtu(mtu);
+  }
+
+  void
+  setPeer(LossyTransport& peer)
+  {
+    m_peer = &peer;
+  }
+
+  /** \brief deliver the packets that were sent to this transport during the last tick
+   */
+  void
+  deliverInFlight()
+  {
+    std::deque<Block> packets;
+    packets.swap(m_inFlight);
+    for (const auto& packet : packets) {
+      this->receive(packet);
+    }
+  }
+
+private:
+  void
+  doClose() final
+  {
+    this->setState(face::TransportState::CLOSED);
+  }
+
+  void
+  doSend(const Block& packet) final
+  {
+    ++nSent;
+    if (m_lossPattern.isLost()) {
+      ++nLost;
+      return;
+    }
+    m_peer->m_inFlight.push_back(packet);
+  }
+
+public:
+  size_t nSent = 0;
+  size_t nLost = 0;
+
+private:
+  LossPattern m_lossPattern;
+  LossyTransport* m_peer = nullptr;
+  std::deque<Block> m_inFlight;
+};
+
+class LpReliabilityBenchmarkFixture
+{
+protected:
+  LpReliabilityBenchmarkFixture()
+    : m_steadyClock(make_shared<time::UnitTestSteadyClock>())
+    , m_systemClock(make_shared<time::UnitTestSystemClock>())
+  {
+#ifdef _DEBUG
+    std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+    time::setCustomClocks(m_steadyClock, m_systemClock);
+  }
+
+  ~LpReliabilityBenchmarkFixture()
+  {
+    time::setCustomClocks(nullptr, nullptr);
+  }
+
+  static shared_ptr<Face>
+  makeFace(ssize_t mtu, const LossPattern& lossPattern)
+  {
+    face::GenericLinkService::Options options;
+    options.allowFragmentation = true;
+    options.allowReassembly = true;
+    options.reliabilityOptions.isEnabled = true;
+    return make_shared<Face>(make_unique<face::GenericLinkService>(options),
+                             make_unique<LossyTransport>(mtu, lossPattern));
+  }
+
+  static LossyTransport&
+  getTransport(Face& face)
+  {
+    return static_cast<LossyTransport&>(*face.getTransport());
+  }
+
+  /** \brief advance the clocks by one tick, deliver the packets in flight, and run due timers
+   */
+  void
+  tick(LossyTransport& a, LossyTransport& b)
+  {
+    m_steadyClock->advance(1_ms);
+    m_systemClock->advance(1_ms);
+    a.deliverInFlight();
+    b.deliverInFlight();
+
+    auto& io = getGlobalIoService();
+    if (io.stopped()) {
+#if BOOST_VERSION >= 106600
+      io.restart();
+#else
+      io.reset();
+#endif
+    }
+    io.poll();
+  }
+
+private:
+  shared_ptr<time::UnitTestSteadyClock> m_steadyClock;
+  shared_ptr<time::UnitTestSystemClock> m_systemClock;
+};
+
+// This test case replays loss patterns over a pair of in-memory transports with link-layer
+// reliability enabled on both ends. One end sends Data that is fragmented into three fragments,
+// at a fixed rate per clock tick; the other end only returns Acks, in IDLE packets or piggybacked
+// on its own traffic. The run ends when the sender has no unacknowledged fragments left.
+BOOST_FIXTURE_TEST_CASE(LossPatterns, LpReliabilityBenchmarkFixture)
+{
+  const size_t nPackets = 200000;
+  const size_t nPacketsPerTick = 20;
+  const ssize_t mtu = 1500;
+  const size_t payloadSize = 4000;
+
+  const std::vector<uint8_t> payload(payloadSize, 0xBB);
+  std::vector<shared_ptr<Data>> data;
+  for (size_t i = 0; i < nPackets; ++i) {
+    auto d = make_shared<Data>(Name("/bench").appendNumber(i));
+    d->setContent(payload);
+    d->setSignatureInfo(ndn::SignatureInfo(tlv::NullSignature));
+    d->setSignatureValue(make_shared<ndn::Buffer>());
+    d->wireEncode();
+    data.push_back(std::move(d));
+  }
+
+  struct Scenario
+  {
+    const char* label;
+    LossPattern lossPattern;
+  };
+  std::vector<Scenario> scenarios{
+    {"no loss", LossPattern(0.0, 0.0, 0.0, 1.0)},
+    {"uniform 1%", LossPattern(0.01, 0.01, 0.0, 1.0)},
+    {"uniform 10%", LossPattern(0.1, 0.1, 0.0, 1.0)},
+    {"bursty", LossPattern(0.01, 0.5, 0.01, 0.1)},
+  };
+
+  for (const auto& scenario : scenarios) {
+    auto sender = makeFace(mtu, scenario.lossPattern);
+    auto receiver = makeFace(mtu, scenario.lossPattern);
+    getTransport(*sender).setPeer(getTransport(*receiver));
+    getTransport(*receiver).setPeer(getTransport(*sender));
+    auto senderService = static_cast<face::GenericLinkService*>(sender->getLinkService());
+    auto receiverService = static_cast<face::GenericLinkService*>(receiver->getLinkService());
+    const auto& counters = senderService->getCounters();
+    // every network packet is eventually either acknowledged or given up on
+    auto isDone = [&] {
+      return counters.nAcknowledged + counters.nRetransmitted + counters.nRetxExhausted == nPackets;
+    };
+
+#ifdef NFD_HAVE_VALGRIND
+    CALLGRIND_START_INSTRUMENTATION;
+#endif
+
+    // the clocks seen by the link services are advanced by tick(), so wall time is measured
+    // with a clock that is not overridden
+    auto t1 = std::chrono::steady_clock::now();
+
+    size_t nTicks = 0;
+    for (size_t i = 0; i < nPackets || !isDone(); ++nTicks) {
+      for (size_t j = 0; j < nPacketsPerTick && i < nPackets; ++j, ++i) {
+        sender->sendData(*data[i]);
+      }
+      tick(getTransport(*sender), getTransport(*receiver));
+    }
+
+    auto t2 = std::chrono::steady_clock::now();
+
+#ifdef NFD_HAVE_VALGRIND
+    CALLGRIND_STOP_INSTRUMENTATION;
+#endif
+
+    std::cout << scenario.label << ": "
+              << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count()
+              << " microseconds for " << nTicks << " ticks, "
+              << getTransport(*sender).nSent << " frames sent, "
+              << getTransport(*sender).nLost + getTransport(*receiver).nLost << " frames lost, "
+              << counters.nAcknowledged << " acknowledged, "
+              << counters.nRetransmitted << " retransmitted, "
+              << counters.nRetxExhausted << " retx exhausted, "
+              << receiver->getCounters().nInData << " Data received, "
+              << receiverService->getCounters().nDuplicateSequence << " duplicates" << std::endl;
+  }
+}
+
+} // namespace tests
+} // namespace nfd
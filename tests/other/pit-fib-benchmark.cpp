@@ -24,15 +24,53 @@
  */
 
 #include "benchmark-helpers.hpp"
+#include "common/global.hpp"
+#include "face/face.hpp"
+#include "face/generic-link-service.hpp"
+#include "face/internal-transport.hpp"
+#include "fw/face-table.hpp"
+#include "fw/forwarder.hpp"
+#include "fw/self-learning-strategy.hpp"
+#include "table/cs.hpp"
 #include "table/fib.hpp"
 #include "table/pit.hpp"
 
+#include <cstdlib>
 #include <iostream>
+#include <random>
+
+#include <sys/resource.h>
 
 #ifdef NFD_HAVE_VALGRIND
 #include <valgrind/callgrind.h>
 #endif
 
+// count calls to the global allocator, to report allocations per operation
+static size_t g_nAllocations = 0;
+
+void*
+operator new(std::size_t size)
+{
+  ++g_nAllocations;
+  void* p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void
+operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
 namespace nfd {
 namespace tests {
 
@@ -73,7 +111,11 @@ protected:
 
       Name dataName = interestName;
       extendName(dataName, dataNameLength);
-      data.push_back(make_shared<Data>(dataName));
+      auto d = make_shared<Data>(dataName);
+      d->setSignatureInfo(ndn::SignatureInfo(tlv::NullSignature));
+      d->setSignatureValue(make_shared<ndn::Buffer>());
+      d->wireEncode();
+      data.push_back(std::move(d));
     }
   }
 
@@ -122,6 +164,7 @@ BOOST_FIXTURE_TEST_CASE(SimpleExchanges, PitFibBenchmarkFixture)
   CALLGRIND_START_INSTRUMENTATION;
 #endif
 
+  size_t nAllocations = g_nAllocations;
   auto t1 = time::steady_clock::now();
 
   for (size_t i = 0; i < nRoundTrip + replyGap; ++i) {
@@ -146,7 +189,340 @@ BOOST_FIXTURE_TEST_CASE(SimpleExchanges, PitFibBenchmarkFixture)
   CALLGRIND_STOP_INSTRUMENTATION;
 #endif
 
-  std::cout << time::duration_cast<time::microseconds>(t2 - t1) << std::endl;
+  std::cout << time::duration_cast<time::microseconds>(t2 - t1) << ", "
+            << static_cast<double>(g_nAllocations - nAllocations) / nRoundTrip
+            << " allocations per round trip" << std::endl;
+}
+
+// This test case measures allocator calls and memory usage of a PIT with many pending Interests,
+// each with one in-record and one out-record.
+BOOST_FIXTURE_TEST_CASE(PendingInterests, PitFibBenchmarkFixture)
+{
+  const size_t nPending = 1000000;
+
+  generatePacketsAndPopulateFib(nPending, 1000, 1, 3, 3);
+
+  std::vector<shared_ptr<Face>> faces;
+  for (int i = 0; i < 4; ++i) {
+    faces.push_back(make_shared<Face>(make_unique<face::GenericLinkService>(),
+                                      make_unique<face::InternalForwarderTransport>()));
+  }
+
+  size_t nAllocations = g_nAllocations;
+  auto t1 = time::steady_clock::now();
+
+  for (size_t i = 0; i < nPending; ++i) {
+    const Interest& interest = *interests[i];
+    auto pitEntry = m_pit.insert(interest).first;
+    pitEntry->insertOrUpdateInRecord(*faces[i % faces.size()], interest);
+    pitEntry->insertOrUpdateOutRecord(*faces[(i + 1) % faces.size()], interest);
+  }
+
+  auto t2 = time::steady_clock::now();
+
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  std::cout << time::duration_cast<time::microseconds>(t2 - t1) << ", "
+            << static_cast<double>(g_nAllocations - nAllocations) / nPending
+            << " allocations per Interest, max RSS " << usage.ru_maxrss << " KiB" << std::endl;
+}
+
+// This test case measures allocator calls of a strategy that places StrategyInfo items on
+// the in-record and out-record of every Interest, as self-learning does.
+// The Interests are forwarded in two passes, and the second pass reuses the memory released
+// by the PIT entries of the first pass.
+BOOST_FIXTURE_TEST_CASE(StrategyInfoItems, PitFibBenchmarkFixture)
+{
+  using InRecordInfo = fw::SelfLearningStrategy::InRecordInfo;
+  using OutRecordInfo = fw::SelfLearningStrategy::OutRecordInfo;
+
+  const size_t nInterests = 200000;
+
+  generatePacketsAndPopulateFib(nInterests, 1000, 1, 3, 3);
+
+  auto downstream = make_shared<Face>(make_unique<face::GenericLinkService>(),
+                                      make_unique<face::InternalForwarderTransport>());
+  auto upstream = make_shared<Face>(make_unique<face::GenericLinkService>(),
+                                    make_unique<face::InternalForwarderTransport>());
+
+  for (int pass = 1; pass <= 2; ++pass) {
+    size_t nAllocations = g_nAllocations;
+    auto t1 = time::steady_clock::now();
+
+    for (size_t i = 0; i < nInterests; ++i) {
+      const Interest& interest = *interests[i];
+      auto pitEntry = m_pit.insert(interest).first;
+      auto inRecord = pitEntry->insertOrUpdateInRecord(*downstream, interest);
+      inRecord->insertStrategyInfo<InRecordInfo>().first->isNonDiscoveryInterest = true;
+      auto outRecord = pitEntry->insertOrUpdateOutRecord(*upstream, interest);
+      outRecord->insertStrategyInfo<OutRecordInfo>().first->isNonDiscoveryInterest = true;
+      BOOST_ASSERT(outRecord->getStrategyInfo<OutRecordInfo>() != nullptr);
+    }
+    for (size_t i = 0; i < nInterests; ++i) {
+      m_pit.erase(m_pit.find(*interests[i]).get());
+    }
+
+    auto t2 = time::steady_clock::now();
+
+    std::cout << "pass " << pass << ": " << time::duration_cast<time::microseconds>(t2 - t1)
+              << ", " << static_cast<double>(g_nAllocations - nAllocations) / nInterests
+              << " allocations per Interest" << std::endl;
+  }
+}
+
+// This test case measures the cost of PIT expiry timers with many concurrent Interests of varied
+// lifetimes, once with the PIT expiry wheel and once with one scheduler event per entry.
+BOOST_FIXTURE_TEST_CASE(ExpiryTimers, PitFibBenchmarkFixture)
+{
+  const size_t nPending = 1000000;
+  const int maxLifetime = 1000;
+
+  generatePacketsAndPopulateFib(nPending, 1000, 1, 3, 3);
+
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<int> lifetimeDist(1, maxLifetime);
+  std::vector<time::milliseconds> lifetimes;
+  for (size_t i = 0; i < nPending; ++i) {
+    lifetimes.emplace_back(lifetimeDist(gen));
+  }
+
+  auto runIo = [] {
+    auto& io = getGlobalIoService();
+    io.run();
+#if BOOST_VERSION >= 106600
+    io.restart();
+#else
+    io.reset();
+#endif
+  };
+
+  size_t nExpired = 0;
+  m_pit.afterExpire.connect([&] (const shared_ptr<pit::Entry>& pitEntry) {
+    m_pit.erase(pitEntry.get());
+    ++nExpired;
+  });
+
+  auto t1 = time::steady_clock::now();
+  for (size_t i = 0; i < nPending; ++i) {
+    auto pitEntry = m_pit.insert(*interests[i]).first;
+    m_pit.setExpiryTimer(*pitEntry, lifetimes[i]);
+  }
+  auto t2 = time::steady_clock::now();
+  runIo();
+  auto t3 = time::steady_clock::now();
+  BOOST_CHECK_EQUAL(nExpired, nPending);
+
+  std::cout << "wheel: insert " << time::duration_cast<time::microseconds>(t2 - t1)
+            << ", run " << time::duration_cast<time::microseconds>(t3 - t2) << std::endl;
+
+  nExpired = 0;
+  std::vector<scheduler::ScopedEventId> events(nPending);
+
+  t1 = time::steady_clock::now();
+  for (size_t i = 0; i < nPending; ++i) {
+    auto pitEntry = m_pit.insert(*interests[i]).first;
+    events[i] = getScheduler().schedule(lifetimes[i], [this, &nExpired, pitEntry] {
+      m_pit.erase(pitEntry.get());
+      ++nExpired;
+    });
+  }
+  t2 = time::steady_clock::now();
+  runIo();
+  t3 = time::steady_clock::now();
+  BOOST_CHECK_EQUAL(nExpired, nPending);
+
+  std::cout << "scheduler: insert " << time::duration_cast<time::microseconds>(t2 - t1)
+            << ", run " << time::duration_cast<time::microseconds>(t3 - t2) << std::endl;
+}
+
+// This test case models PIT, FIB, and CS operations with simple Interest-Data exchanges,
+// once with the name hash values cached on each packet and shared by all tables, and once
+// with the cache dropped before each table operation, i.e. with hash values recomputed per table.
+BOOST_FIXTURE_TEST_CASE(SharedNameHashes, PitFibBenchmarkFixture)
+{
+  const size_t nRoundTrip = 1000000;
+  const size_t replyGap = 20000;
+  const size_t nFibEntries = 2000;
+  const size_t fibPrefixLength = 2;
+  const size_t interestNameLength = 5;
+  const size_t dataNameLength = 5;
+
+  generatePacketsAndPopulateFib(nRoundTrip, nFibEntries, fibPrefixLength,
+                                interestNameLength, dataNameLength);
+
+  for (bool isCached : {false, true}) {
+    for (const auto& interest : interests) {
+      interest->removeTag<name_tree::HashSequenceTag>();
+    }
+    for (const auto& d : data) {
+      d->removeTag<name_tree::HashSequenceTag>();
+    }
+    auto dropCache = [isCached] (const auto& packet) {
+      if (!isCached) {
+        packet.template removeTag<name_tree::HashSequenceTag>();
+      }
+    };
+
+    Cs cs(replyGap);
+
+#ifdef NFD_HAVE_VALGRIND
+    CALLGRIND_START_INSTRUMENTATION;
+#endif
+
+    auto t1 = time::steady_clock::now();
+
+    for (size_t i = 0; i < nRoundTrip + replyGap; ++i) {
+      if (i < nRoundTrip) {
+        // process incoming Interest
+        const Interest& interest = *interests[i];
+        auto pitEntry = m_pit.insert(interest).first;
+        dropCache(interest);
+        cs.find(interest, [] (auto&&...) {}, [] (auto&&...) {});
+        m_fib.findLongestPrefixMatch(*pitEntry);
+      }
+      if (i >= replyGap) {
+        // process incoming Data
+        const Data& d = *data[i - replyGap];
+        auto matches = m_pit.findAllDataMatches(d);
+        dropCache(d);
+        cs.insert(d);
+        for (const auto& pitEntry : matches) {
+          m_pit.erase(pitEntry.get());
+        }
+      }
+    }
+
+    auto t2 = time::steady_clock::now();
+
+#ifdef NFD_HAVE_VALGRIND
+    CALLGRIND_STOP_INSTRUMENTATION;
+#endif
+
+    std::cout << (isCached ? "cached " : "uncached ")
+              << time::duration_cast<time::microseconds>(t2 - t1) << std::endl;
+  }
+}
+
+// This test case models PIT and FIB operations with simple Interest-Data exchanges,
+// once for each collision resolution scheme of the NameTree hashtable.
+BOOST_FIXTURE_TEST_CASE(HashtableModes, PitFibBenchmarkFixture)
+{
+  const size_t nRoundTrip = 1000000;
+  const size_t replyGap = 20000;
+  // generatePacketsAndPopulateFib derives nRoundTrip / nFibEntries distinct prefixes,
+  // so this yields 200000 FIB entries and a NameTree with over a million entries
+  const size_t nFibEntries = 5;
+  const size_t fibPrefixLength = 2;
+  const size_t interestNameLength = 4;
+  const size_t dataNameLength = 4;
+
+  generatePacketsAndPopulateFib(nRoundTrip, nFibEntries, fibPrefixLength,
+                                interestNameLength, dataNameLength);
+
+  for (auto mode : {name_tree::HashtableMode::CHAINING, name_tree::HashtableMode::OPEN_ADDRESSING}) {
+    name_tree::HashtableOptions options(1024);
+    options.mode = mode;
+    NameTree nameTree(options);
+    Fib fib(nameTree);
+    Pit pit(nameTree);
+    for (const auto& interest : interests) {
+      fib.insert(interest->getName().getPrefix(fibPrefixLength));
+    }
+
+#ifdef NFD_HAVE_VALGRIND
+    CALLGRIND_START_INSTRUMENTATION;
+#endif
+
+    auto t1 = time::steady_clock::now();
+
+    for (size_t i = 0; i < nRoundTrip + replyGap; ++i) {
+      if (i < nRoundTrip) {
+        auto pitEntry = pit.insert(*interests[i]).first;
+        fib.findLongestPrefixMatch(*pitEntry);
+      }
+      if (i >= replyGap) {
+        auto matches = pit.findAllDataMatches(*data[i - replyGap]);
+        for (const auto& pitEntry : matches) {
+          pit.erase(pitEntry.get());
+        }
+      }
+    }
+
+    auto t2 = time::steady_clock::now();
+
+#ifdef NFD_HAVE_VALGRIND
+    CALLGRIND_STOP_INSTRUMENTATION;
+#endif
+
+    std::cout << mode << ' ' << time::duration_cast<time::microseconds>(t2 - t1) << std::endl;
+  }
+}
+
+// This test case measures repeated FIB and effective strategy lookups for the same PIT entries,
+// as performed by the forwarding pipelines and strategies over the lifetime of an Interest,
+// once with a name tree walk per lookup and once with the results cached on the name tree entry.
+BOOST_FIXTURE_TEST_CASE(CachedLookups, PitFibBenchmarkFixture)
+{
+  const size_t nPending = 200000;
+  const size_t nFibEntries = 10;
+  const size_t fibPrefixLength = 2;
+  const size_t interestNameLength = 8;
+  // number of FIB and strategy lookups per PIT entry
+  const size_t nLookups = 4;
+
+  generatePacketsAndPopulateFib(nPending, nFibEntries, fibPrefixLength,
+                                interestNameLength, interestNameLength);
+
+  FaceTable faceTable;
+  Forwarder forwarder(faceTable);
+  NameTree& nameTree = forwarder.getNameTree();
+  Fib& fib = forwarder.getFib();
+  StrategyChoice& sc = forwarder.getStrategyChoice();
+  std::vector<shared_ptr<pit::Entry>> pitEntries;
+  for (const auto& interest : interests) {
+    fib.insert(interest->getName().getPrefix(fibPrefixLength));
+    pitEntries.push_back(forwarder.getPit().insert(*interest).first);
+  }
+
+  auto hasFibEntry = [] (const name_tree::Entry& nte) { return nte.getFibEntry() != nullptr; };
+  auto hasStrategyChoiceEntry = [] (const name_tree::Entry& nte) {
+    return nte.getStrategyChoiceEntry() != nullptr;
+  };
+
+  for (bool isCached : {false, true}) {
+    size_t nMatchedComponents = 0;
+
+#ifdef NFD_HAVE_VALGRIND
+    CALLGRIND_START_INSTRUMENTATION;
+#endif
+
+    auto t1 = time::steady_clock::now();
+
+    for (size_t i = 0; i < nLookups; ++i) {
+      for (const auto& pitEntry : pitEntries) {
+        if (isCached) {
+          nMatchedComponents += fib.findLongestPrefixMatch(*pitEntry).getPrefix().size();
+          sc.findEffectiveStrategy(*pitEntry);
+        }
+        else {
+          auto fibNte = nameTree.findLongestPrefixMatch(*pitEntry, hasFibEntry);
+          nMatchedComponents += fibNte->getFibEntry()->getPrefix().size();
+          nameTree.findLongestPrefixMatch(*pitEntry, hasStrategyChoiceEntry)
+            ->getStrategyChoiceEntry()->getStrategy();
+        }
+      }
+    }
+
+    auto t2 = time::steady_clock::now();
+
+#ifdef NFD_HAVE_VALGRIND
+    CALLGRIND_STOP_INSTRUMENTATION;
+#endif
+
+    BOOST_CHECK_EQUAL(nMatchedComponents, nLookups * nPending * fibPrefixLength);
+    std::cout << (isCached ? "cached " : "uncached ")
+              << time::duration_cast<time::microseconds>(t2 - t1) << std::endl;
+  }
 }
 
 } // namespace tests
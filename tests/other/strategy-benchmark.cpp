@@ -0,0 +1,233 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmark-helpers.hpp"
+#include "face/face.hpp"
+#include "face/generic-link-service.hpp"
+#include "fw/face-table.hpp"
+#include "fw/forwarder.hpp"
+#include "fw/pending-interest-count.hpp"
+#include "fw/prefix-state-table.hpp"
+#include "fw/rfa-strategy.hpp"
+
+#include <iostream>
+#include <map>
+
+#ifdef NFD_HAVE_VALGRIND
+#include <valgrind/callgrind.h>
+#endif
+
+namespace nfd {
+namespace tests {
+
+using fw::FacePicTable;
+using fw::KnownInFaceTable;
+using fw::RFAStrategy;
+
+/** \brief A transport that discards sent packets.
+ */
+class NullTransport final : public face::Transport
+{
+public:
+  NullTransport()
+  {
+    this->setLocalUri(FaceUri("dev://bench"));
+    this->setRemoteUri(FaceUri("dev://bench"));
+    this->setScope(ndn::nfd::FACE_SCOPE_NON_LOCAL);
+    this->setPersistency(ndn::nfd::FACE_PERSISTENCY_PERMANENT);
+    this->setLinkType(ndn::nfd::LINK_TYPE_POINT_TO_POINT);
+  }
+
+private:
+  void
+  doClose() final
+  {
+    this->setState(face::TransportState::CLOSED);
+  }
+
+  void
+  doSend(const Block&) final
+  {
+  }
+};
+
+class StrategyBenchmarkFixture
+{
+protected:
+  StrategyBenchmarkFixture()
+  {
+#ifdef _DEBUG
+    std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+  }
+
+  void
+  generateNames(size_t nPackets, size_t nPrefixes, size_t nameLength)
+  {
+    for (size_t i = 0; i < nPackets; ++i) {
+      Name name;
+      name.append("bench").append(to_string(i % nPrefixes)).append(to_string(i));
+      while (name.size() < nameLength) {
+        name.append("dup");
+      }
+      names.push_back(std::move(name));
+    }
+  }
+
+  template<typename F>
+  static void
+  measure(const char* label, F&& f)
+  {
+#ifdef NFD_HAVE_VALGRIND
+    CALLGRIND_START_INSTRUMENTATION;
+#endif
+    auto t1 = time::steady_clock::now();
+    f();
+    auto t2 = time::steady_clock::now();
+#ifdef NFD_HAVE_VALGRIND
+    CALLGRIND_STOP_INSTRUMENTATION;
+#endif
+    std::cout << label << ": " << time::duration_cast<time::microseconds>(t2 - t1) << std::endl;
+  }
+
+protected:
+  std::vector<Name> names;
+};
+
+// This test case models the per-prefix PIC bookkeeping of RFA strategy: on each Interest,
+// the counters of the content prefix are looked up, one of them is increased, and later
+// decreased. RFAStrategy keeps them on the Measurements entry of the content prefix.
+BOOST_FIXTURE_TEST_CASE(PrefixPics, StrategyBenchmarkFixture)
+{
+  const size_t nPackets = 200000;
+  const size_t nPrefixes = 2000;
+  const size_t nameLength = 5;
+  const size_t prefixLength = RFAStrategy::PREFIX_LENGTH;
+  const size_t nFaces = 4;
+
+  generateNames(nPackets, nPrefixes, nameLength);
+  size_t checksum = 0;
+
+  // URI-string keyed maps, as used before PICs were kept on Measurements entries
+  std::map<std::string, std::map<FaceId, fw::PendingInterestCount>> legacy;
+  measure("legacy", [&] {
+    for (size_t i = 0; i < nPackets; ++i) {
+      auto& pics = legacy[names[i].getPrefix(prefixLength).toUri()];
+      if (pics.size() < nFaces) {
+        for (FaceId f = 0; f < nFaces; ++f) {
+          pics[f];
+        }
+      }
+      auto& pic = pics[i % nFaces];
+      pic.increase();
+      pic.decrease();
+      checksum += pics.size();
+    }
+  });
+
+  FaceTable faceTable;
+  Forwarder forwarder(faceTable);
+  fib::Entry& fibEntry = *forwarder.getFib().insert("/").first;
+  std::vector<FaceId> faceIds;
+  for (size_t f = 0; f < nFaces; ++f) {
+    auto face = make_shared<Face>(make_unique<face::GenericLinkService>(),
+                                  make_unique<NullTransport>());
+    faceTable.add(face);
+    forwarder.getFib().addOrUpdateNextHop(fibEntry, *face, 0);
+    faceIds.push_back(face->getId());
+  }
+  BOOST_REQUIRE(forwarder.getStrategyChoice().insert("/", RFAStrategy::getStrategyName()));
+  auto& strategy = dynamic_cast<RFAStrategy&>(
+    forwarder.getStrategyChoice().findEffectiveStrategy("/"));
+
+  // PIT entries are created beforehand, so that only the PIC lookup is measured
+  std::vector<shared_ptr<pit::Entry>> pitEntries;
+  for (size_t i = 0; i < nPackets; ++i) {
+    pitEntries.push_back(forwarder.getPit().insert(*make_shared<Interest>(names[i])).first);
+  }
+
+  measure("RFAStrategy::getPics", [&] {
+    for (size_t i = 0; i < nPackets; ++i) {
+      auto& pics = *strategy.getPics(*pitEntries[i], fibEntry);
+      auto& pic = *pics.find(faceIds[i % nFaces]);
+      pic.increase();
+      pic.decrease();
+      checksum -= pics.size();
+    }
+  });
+
+  BOOST_CHECK_EQUAL(checksum, 0);
+  BOOST_CHECK_EQUAL(legacy.size(), strategy.m_picTables->size());
+}
+
+// This test case models the known in-faces bookkeeping of SAF strategy: each Interest name
+// is checked and recorded on arrival, and forgotten when the Data returns.
+BOOST_FIXTURE_TEST_CASE(KnownInFaces, StrategyBenchmarkFixture)
+{
+  const size_t nPackets = 1000000;
+  const size_t nPrefixes = 2000;
+  const size_t nameLength = 5;
+  const size_t replyGap = 20000;
+
+  generateNames(nPackets, nPrefixes, nameLength);
+  size_t nRtx = 0;
+
+  std::map<std::string, std::vector<FaceId>> legacy;
+  measure("legacy", [&] {
+    for (size_t i = 0; i < nPackets + replyGap; ++i) {
+      if (i < nPackets) {
+        auto& faces = legacy[names[i].toUri()];
+        if (std::find(faces.begin(), faces.end(), i % 3) != faces.end()) {
+          ++nRtx;
+        }
+        faces.push_back(i % 3);
+      }
+      if (i >= replyGap) {
+        legacy.erase(names[i - replyGap].toUri());
+      }
+    }
+  });
+
+  KnownInFaceTable table;
+  measure("KnownInFaceTable", [&] {
+    for (size_t i = 0; i < nPackets + replyGap; ++i) {
+      if (i < nPackets) {
+        if (table.contains(names[i], i % 3)) {
+          ++nRtx;
+        }
+        table.add(names[i], i % 3);
+      }
+      if (i >= replyGap) {
+        table.clear(names[i - replyGap]);
+      }
+    }
+  });
+
+  BOOST_CHECK_EQUAL(nRtx, 0);
+  BOOST_CHECK_EQUAL(legacy.size(), table.size());
+}
+
+} // namespace tests
+} // namespace nfd